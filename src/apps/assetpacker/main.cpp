@@ -0,0 +1,127 @@
+// Packs the assets declared in an asset file into a single archive of
+// pre-decoded pixels and PCM that AssetManager::mountArchive() can map.
+//
+// usage: assetpacker <assets.xml> <output.cpak>
+
+#include <capengine/CapEngineException.h>
+#include <capengine/asset_manager.h>
+#include <capengine/assetarchive.h>
+#include <capengine/captypes.h>
+#include <capengine/pcm.h>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <span>
+#include <string>
+
+namespace {
+
+//! The format SDL's renderers create textures in, so uploads need no conversion.
+constexpr uint32_t kPixelFormat = SDL_PIXELFORMAT_ARGB8888;
+
+//! Decodes an image and converts it to kPixelFormat.
+CapEngine::SurfacePtr loadPixels(const std::string& in_path)
+{
+    CapEngine::SurfacePtr pDecoded{IMG_Load(in_path.c_str()), SDL_FreeSurface};
+    if (pDecoded == nullptr) {
+        CAP_THROW(CapEngine::CapEngineException{"Unable to load image at " + in_path + " - " + IMG_GetError()});
+    }
+
+    CapEngine::SurfacePtr pConverted{SDL_ConvertSurfaceFormat(pDecoded.get(), kPixelFormat, 0), SDL_FreeSurface};
+    if (pConverted == nullptr) {
+        CAP_THROW(CapEngine::CapEngineException{"Unable to convert " + in_path + " - " + SDL_GetError()});
+    }
+
+    // bake in the colour key VideoManager applies at load time.  Keyed pixels keep their colour, so bitmap
+    // collision still sees them as empty, and only lose their alpha.
+    SDL_LockSurface(pConverted.get());
+    for (int y = 0; y < pConverted->h; ++y) {
+        auto* pRow = static_cast<uint8_t*>(pConverted->pixels) + static_cast<std::ptrdiff_t>(y) * pConverted->pitch;
+        for (int x = 0; x < pConverted->w; ++x) {
+            uint32_t pixel = 0;
+            std::memcpy(&pixel, pRow + x * sizeof(pixel), sizeof(pixel));
+            if ((pixel & 0x00FFFFFF) == 0x0000FFFF) {
+                pixel = 0x0000FFFF;
+                std::memcpy(pRow + x * sizeof(pixel), &pixel, sizeof(pixel));
+            }
+        }
+    }
+    SDL_UnlockSurface(pConverted.get());
+
+    return pConverted;
+}
+
+//! Adds an image or animation to the archive.
+void addImage(CapEngine::AssetArchiveWriter& io_writer, CapEngine::ArchiveImage in_image)
+{
+    CapEngine::SurfacePtr pSurface = loadPixels(in_image.path);
+    in_image.pixelFormat = kPixelFormat;
+    in_image.width = pSurface->w;
+    in_image.height = pSurface->h;
+    in_image.pitch = pSurface->pitch;
+    in_image.pixels = std::span{static_cast<const std::byte*>(pSurface->pixels),
+                                static_cast<std::size_t>(pSurface->h) * static_cast<std::size_t>(pSurface->pitch)};
+
+    io_writer.addImage(in_image);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <assets.xml> <output" << CapEngine::AssetArchive::kExtension << ">\n";
+        return 1;
+    }
+
+    try {
+        const int flags = IMG_INIT_JPG | IMG_INIT_PNG;
+        if ((IMG_Init(flags) & flags) != flags) {
+            std::cerr << "could not init SDL_Image: " << IMG_GetError() << "\n";
+            return 1;
+        }
+
+        CapEngine::AssetManifest manifest = CapEngine::readAssetManifest(argv[1]);
+        CapEngine::AssetArchiveWriter writer;
+
+        for (auto&& [id, image] : manifest.images) {
+            CapEngine::ArchiveImage archiveImage;
+            archiveImage.kind = CapEngine::AssetKind::Image;
+            archiveImage.id = id;
+            archiveImage.path = image.path;
+            archiveImage.frames = image.frames;
+            addImage(writer, std::move(archiveImage));
+        }
+
+        for (auto&& [id, animation] : manifest.animations) {
+            CapEngine::ArchiveImage archiveImage;
+            archiveImage.kind = CapEngine::AssetKind::Animation;
+            archiveImage.id = id;
+            archiveImage.path = animation.path;
+            archiveImage.numFrames = animation.numFrames;
+            archiveImage.animationTimeMs = animation.animationTimeMs;
+            addImage(writer, std::move(archiveImage));
+        }
+
+        for (auto&& [id, sound] : manifest.sounds) {
+            CapEngine::PCM pcm{sound.path};
+            writer.addSound(id, sound.path, pcm.samples());
+        }
+
+        writer.write(argv[2]);
+        std::cout << "Packed " << manifest.images.size() << " images, " << manifest.animations.size()
+                  << " animations and " << manifest.sounds.size() << " sounds into " << argv[2] << "\n";
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    IMG_Quit();
+    return 0;
+}
@@ -11,25 +11,61 @@
 namespace FlappyPei {
 
 CatGraphicsComponent::CatGraphicsComponent(int in_gapLocation, int in_gapSize)
-    : m_gapLocation(in_gapLocation), m_gapSize(in_gapSize)
 {
+    setGap(in_gapLocation, in_gapSize);
+}
+
+/**
+ * \brief Moves the gap the player has to fly through.
+ *
+ * The textures are only recreated if their heights change.
+ * \param in_gapLocation The top of the gap.
+ * \param in_gapSize The height of the gap.
+ */
+void CatGraphicsComponent::setGap(int in_gapLocation, int in_gapSize)
+{
+    m_gapLocation = in_gapLocation;
+    m_gapSize = in_gapSize;
+    updateTextures();
+}
+
+/**
+ * \brief Rebuilds the textures whose heights no longer match the gap.
+ */
+void CatGraphicsComponent::updateTextures()
+{
+    const int topHeight = m_gapLocation;
+    const int bottomHeight = kLogicalWindowHeight - (m_gapLocation + m_gapSize);
+    if (topHeight == m_topTextureHeight && bottomHeight == m_bottomTextureHeight) {
+        return;
+    }
+
     CapEngine::VideoManager& videoManager = CapEngine::Locator::getVideoManager();
     const CapEngine::Colour colour{235, 174, 52};
-    const int height = m_gapLocation;
 
-    if (height > 0) {
-        m_topTexture = videoManager.createTexturePtr(kCatWidth, height, colour);
+    if (topHeight != m_topTextureHeight) {
+        m_topTexture.reset();
+        if (topHeight > 0) {
+            m_topTexture = videoManager.createTexturePtr(kCatWidth, topHeight, colour);
+        }
+        m_topTextureHeight = topHeight;
     }
 
-    int bottomTextureHeight = kLogicalWindowHeight - (m_gapLocation + m_gapSize);
-    if (bottomTextureHeight > 0) {
-        m_bottomTexture = videoManager.createTexturePtr(kCatWidth, bottomTextureHeight, colour);
+    if (bottomHeight != m_bottomTextureHeight) {
+        m_bottomTexture.reset();
+        if (bottomHeight > 0) {
+            m_bottomTexture = videoManager.createTexturePtr(kCatWidth, bottomHeight, colour);
+        }
+        m_bottomTextureHeight = bottomHeight;
     }
 }
 
 void CatGraphicsComponent::render(CapEngine::GameObject& in_object, const CapEngine::Camera2d& in_camera,
                                   uint32_t in_windowId)
 {
+    // the gap may have been assigned without the textures.
+    updateTextures();
+
     CapEngine::VideoManager& videoManager = CapEngine::Locator::getVideoManager();
     CapEngine::Rect dstRect{
         .x = static_cast<int>(in_object.getPosition().getX()), .y = 0, .w = kCatWidth, .h = m_gapLocation};
@@ -57,4 +93,25 @@ std::unique_ptr<CapEngine::Component> CatGraphicsComponent::clone() const
     return std::make_unique<CatGraphicsComponent>(*this);
 }
 
+/**
+ * \brief Takes the gap of another cat.
+ *
+ * The textures this component already built are kept rather than shared with
+ * the other's, so a pooled cat whose next gap needs the same heights reuses
+ * them.
+ * \param in_other The component to copy.
+ * \return false if it isn't a CatGraphicsComponent.
+ */
+bool CatGraphicsComponent::assign(CapEngine::Component const& in_other)
+{
+    const auto* pOther = dynamic_cast<const CatGraphicsComponent*>(&in_other);
+    if (pOther == nullptr) {
+        return false;
+    }
+
+    m_gapLocation = pOther->m_gapLocation;
+    m_gapSize = pOther->m_gapSize;
+    return true;
+}
+
 }  // namespace FlappyPei
@@ -19,12 +19,20 @@ class CatGraphicsComponent final : public CapEngine::GraphicsComponent {
     void render(CapEngine::GameObject& object, const CapEngine::Camera2d& in_camera, uint32_t in_windowId) override;
     void update(CapEngine::GameObject& object, double timestep) override;
     [[nodiscard]] std::unique_ptr<CapEngine::Component> clone() const override;
+    bool assign(CapEngine::Component const& in_other) override;
+
+    void setGap(int in_gapLocation, int in_gapSize);
 
    private:
+    void updateTextures();
+
     int m_gapLocation = 0;
     int m_gapSize = 0;
     CapEngine::SharedTexturePtr m_topTexture;
     CapEngine::SharedTexturePtr m_bottomTexture;
+    //! The heights the textures were built for, or -1 if they haven't been.
+    int m_topTextureHeight = -1;
+    int m_bottomTextureHeight = -1;
 };
 
 }  // namespace FlappyPei
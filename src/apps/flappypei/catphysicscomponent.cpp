@@ -10,11 +10,22 @@
 namespace FlappyPei {
 
 CatPhysicsComponent::CatPhysicsComponent(int in_gapLocation, int in_gapSize)
-    : m_gapLocation(in_gapLocation),
-      m_gapSize(in_gapSize),
-      m_topMbr(0, 0, kCatWidth, in_gapLocation),
-      m_bottomMbr(0, in_gapLocation + in_gapSize, kCatWidth, kLogicalWindowHeight - (in_gapLocation + in_gapSize))
 {
+    setGap(in_gapLocation, in_gapSize);
+}
+
+/**
+ * \brief Moves the gap the player has to fly through.
+ * \param in_gapLocation The top of the gap.
+ * \param in_gapSize The height of the gap.
+ */
+void CatPhysicsComponent::setGap(int in_gapLocation, int in_gapSize)
+{
+    m_gapLocation = in_gapLocation;
+    m_gapSize = in_gapSize;
+    m_topMbr = CapEngine::Rectangle{0, 0, kCatWidth, static_cast<double>(in_gapLocation)};
+    m_bottomMbr = CapEngine::Rectangle{0, static_cast<double>(in_gapLocation + in_gapSize), kCatWidth,
+                                       static_cast<double>(kLogicalWindowHeight - (in_gapLocation + in_gapSize))};
 }
 
 void CatPhysicsComponent::update(CapEngine::GameObject& object, double timestep)
@@ -48,6 +59,11 @@ std::unique_ptr<CapEngine::Component> CatPhysicsComponent::clone() const
     return std::make_unique<CatPhysicsComponent>(*this);
 }
 
+bool CatPhysicsComponent::assign(CapEngine::Component const& in_other)
+{
+    return CapEngine::assignComponent(*this, in_other);
+}
+
 int CatPhysicsComponent::gapLocation() const
 {
     return m_gapLocation;
@@ -20,10 +20,12 @@ class CatPhysicsComponent : public CapEngine::PhysicsComponent {
     [[nodiscard]] std::optional<CapEngine::Rectangle> boundingPolygon(
         const CapEngine::GameObject& object) const override;
     [[nodiscard]] std::unique_ptr<CapEngine::Component> clone() const override;
+    bool assign(CapEngine::Component const& in_other) override;
     [[nodiscard]] CapEngine::CollisionType collides([[maybe_unused]] CapEngine::Rectangle const& in_mbr) const override;
 
     [[nodiscard]] int gapLocation() const;
     [[nodiscard]] double gapSize() const;
+    void setGap(int in_gapLocation, int in_gapSize);
 
    private:
     int m_gapLocation = 0;
@@ -7,6 +7,7 @@
 #include <capengine/collision.h>
 #include <capengine/gameobject.h>
 #include <capengine/locator.h>
+#include <capengine/objectpool.h>
 
 #include <algorithm>
 #include <memory>
@@ -47,12 +48,22 @@ std::unique_ptr<CapEngine::GameObject> createPlayerObject(uint32_t in_windowId)
     return playerObject;
 }
 
-gsl::not_null<std::unique_ptr<CapEngine::GameObject>> createCatObject(uint32_t in_windowId, int in_gapSize,
-                                                                      int in_previousGapSize, int in_previousGapStart,
-                                                                      int in_maxLocationDifference, int in_velocity,
-                                                                      CapEngine::Vector const& in_initialPosition)
+std::unique_ptr<CapEngine::GameObject> createCatPrototype()
 {
-    auto catObject = std::make_unique<CapEngine::GameObject>();
+    auto catObject = std::make_unique<CapEngine::GameObject>(false);
+    catObject->addComponent(std::make_shared<FlappyPei::CatGraphicsComponent>(0, 0));
+    catObject->addComponent(std::make_shared<FlappyPei::CatPhysicsComponent>(0, 0));
+    catObject->setObjectState(CapEngine::GameObject::ObjectState::Active);
+
+    return catObject;
+}
+
+std::shared_ptr<CapEngine::GameObject> createCatObject(CapEngine::ObjectPool& io_catPool, int in_gapSize,
+                                                       int in_previousGapSize, int in_previousGapStart,
+                                                       int in_maxLocationDifference, int in_velocity,
+                                                       CapEngine::Vector const& in_initialPosition)
+{
+    std::shared_ptr<CapEngine::GameObject> catObject = io_catPool.acquire();
 
     // find min y and max
     int minGapLocation = in_previousGapStart - in_maxLocationDifference - in_gapSize;
@@ -69,8 +80,14 @@ gsl::not_null<std::unique_ptr<CapEngine::GameObject>> createCatObject(uint32_t i
     // generate a random number between minX and maxX
     int gapLocation = generateRandomNumber(minGapLocation, maxGapLocation);
 
-    catObject->addComponent(std::make_shared<FlappyPei::CatGraphicsComponent>(gapLocation, in_gapSize));
-    catObject->addComponent(std::make_shared<FlappyPei::CatPhysicsComponent>(gapLocation, in_gapSize));
+    for (auto&& pComponent : catObject->getComponents()) {
+        if (auto* pGraphics = dynamic_cast<CatGraphicsComponent*>(pComponent.get()); pGraphics != nullptr) {
+            pGraphics->setGap(gapLocation, in_gapSize);
+        }
+        else if (auto* pPhysics = dynamic_cast<CatPhysicsComponent*>(pComponent.get()); pPhysics != nullptr) {
+            pPhysics->setGap(gapLocation, in_gapSize);
+        }
+    }
 
     catObject->setPosition(in_initialPosition);  // Set initial position
     catObject->setVelocity(CapEngine::Vector{in_velocity});
@@ -172,6 +189,7 @@ MainGameState::MainGameState(uint32_t in_windowId)
       m_windowId(in_windowId),
       m_camera({kLogicalWindowHeight, kLogicalWindowWidth}),
       m_playerObject(createPlayerObject(m_windowId)),
+      m_catPool(createCatPrototype()),
       m_levels(makeLevels())
 {
     // register for keyboard events
@@ -231,9 +249,7 @@ void MainGameState::update(double timestepMs)
     // Active state
     if (m_gameState.status == GameStatus::Active) {
         // update cats
-        decltype(m_cats) newCats;
-        std::ranges::for_each(m_cats, [&](const auto& cat) { newCats.push_back(cat->update(timestepMs)); });
-        m_cats = std::move(newCats);
+        std::ranges::for_each(m_cats, [&](const auto& cat) { cat->updateInPlace(timestepMs); });
 
         // update player
         std::unique_ptr<CapEngine::GameObject> newPlayerObject = m_playerObject->update(timestepMs);
@@ -277,7 +293,7 @@ void MainGameState::update(double timestepMs)
                 if (m_levels.size() > 0) {
                     // update velocity of all existing cats to match current level
                     std::ranges::for_each(m_cats,
-                                          [this](gsl::not_null<std::unique_ptr<CapEngine::GameObject>>& in_cat) {
+                                          [this](std::shared_ptr<CapEngine::GameObject>& in_cat) {
                                               CapEngine::Vector velocity = in_cat->getVelocity();
                                               velocity.setX(m_levels.front().velocity);
                                               in_cat->setVelocity(velocity);
@@ -287,7 +303,7 @@ void MainGameState::update(double timestepMs)
 
             // no more levels, check if past the last cat
             else {
-                gsl::not_null<std::unique_ptr<CapEngine::GameObject>> const& lastCat = m_cats.back();
+                std::shared_ptr<CapEngine::GameObject> const& lastCat = m_cats.back();
                 CapEngine::Rectangle lastCatMBR = lastCat->boundingPolygon();
                 CapEngine::Rectangle playerMBR = m_playerObject->boundingPolygon();
                 const int buffer = 40;
@@ -304,9 +320,13 @@ void MainGameState::update(double timestepMs)
             generateCats();
         }
 
-        // clean up dead cats
-        auto result = std::ranges::remove_if(
-            m_cats, [](auto const& gameObject) { return gameObject->getObjectState() == CapEngine::GameObject::Dead; });
+        // recycle dead cats
+        for (auto&& cat : m_cats) {
+            if (cat->getObjectState() == CapEngine::GameObject::Dead) {
+                m_catPool.release(std::move(cat));
+            }
+        }
+        auto result = std::ranges::remove(m_cats, nullptr);
         m_cats.erase(result.begin(), result.end());
     }
 
@@ -342,7 +362,7 @@ void MainGameState::handleKeyboardEvent(const SDL_KeyboardEvent& in_event)
         if (in_event.type == SDL_KEYUP && in_event.keysym.sym == SDLK_SPACE) {
             m_gameState.status = GameStatus::Starting;
             m_telemetry.elapsedTimeMs = 0.0;
-            m_cats.clear();
+            releaseCats(m_cats.begin());
             m_playerObject = createPlayerObject(m_windowId);
         }
     }
@@ -361,7 +381,7 @@ void MainGameState::generateCats()
     std::optional<CapEngine::Rectangle> previousMbr;
 
     if (m_cats.size() > 0) {
-        gsl::not_null<std::unique_ptr<CapEngine::GameObject>> const& lastCat = m_cats.back();
+        std::shared_ptr<CapEngine::GameObject> const& lastCat = m_cats.back();
 
         std::vector<std::shared_ptr<CatPhysicsComponent>> physicsCompoinents =
             lastCat->getComponents<CatPhysicsComponent>();
@@ -377,9 +397,22 @@ void MainGameState::generateCats()
 
     // if this is the first cat or the last cat is fully in the screen
     if (previousMbr == std::nullopt || (previousMbr->x + previousMbr->width) <= kLogicalWindowWidth) {
-        m_cats.push_back(createCatObject(m_windowId, currentLevelSettings.gapSize, previousGapSize, previousGapStart,
+        m_cats.push_back(createCatObject(m_catPool, currentLevelSettings.gapSize, previousGapSize, previousGapStart,
                                          currentLevelSettings.catInterval, currentLevelSettings.velocity, position));
     }
 }
 
+/**
+ * \brief Returns cats to the pool and removes them.
+ * \param in_first The first of the cats to release.  All cats after it are released too.
+ */
+void MainGameState::releaseCats(std::vector<std::shared_ptr<CapEngine::GameObject>>::iterator in_first)
+{
+    for (auto cat = in_first; cat != m_cats.end(); ++cat) {
+        m_catPool.release(std::move(*cat));
+    }
+
+    m_cats.erase(in_first, m_cats.end());
+}
+
 }  // namespace FlappyPei
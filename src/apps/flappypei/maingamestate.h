@@ -5,6 +5,7 @@
 #include <capengine/camera2d.h>
 #include <capengine/gameobject.h>
 #include <capengine/gamestate.h>
+#include <capengine/objectpool.h>
 
 #include <cstdint>
 #include <gsl/gsl-lite.hpp>
@@ -53,13 +54,15 @@ class MainGameState final : public CapEngine::GameState {
 
    private:
     void generateCats();
+    void releaseCats(std::vector<std::shared_ptr<CapEngine::GameObject>>::iterator in_first);
 
     uint32_t m_windowId;                                                   //!< The id of the window.
     Telemetry m_telemetry;                                                 //!< The telemetry data for the game state.
     GameState m_gameState;                                                 //!< The current game state.
     CapEngine::Camera2d m_camera;                                          //!< The camera used for rendering.
     gsl::not_null<std::unique_ptr<CapEngine::GameObject>> m_playerObject;  //!< The player object.
-    std::vector<gsl::not_null<std::unique_ptr<CapEngine::GameObject>>> m_cats;  //!< The cats.
+    CapEngine::ObjectPool m_catPool;                                       //!< Recycles cats that have died.
+    std::vector<std::shared_ptr<CapEngine::GameObject>> m_cats;            //!< The cats.
     std::queue<LevelSettings> m_levels;
 };
 
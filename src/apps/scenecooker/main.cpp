@@ -0,0 +1,42 @@
+// Cooks a scene descriptor file into the binary form CookedScenes maps, so
+// games can load scenes without parsing text json.
+//
+// usage: scenecooker <scenes.json> <output.cscene>
+
+#include <capengine/cookedscenes.h>
+
+#include <jsoncons/json.hpp>
+
+#include <exception>
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <scenes.json> <output" << CapEngine::CookedScenes::kExtension << ">\n";
+        return 1;
+    }
+
+    try {
+        std::ifstream stream{argv[1]};
+        if (!stream) {
+            std::cerr << "could not open " << argv[1] << "\n";
+            return 1;
+        }
+
+        CapEngine::CookedScenesWriter writer;
+        writer.addScenes(jsoncons::json::parse(stream));
+        writer.write(argv[2]);
+
+        // read it back so a bad file is caught here rather than in the game.
+        CapEngine::CookedScenes scenes{argv[2]};
+        std::cout << "Cooked " << scenes.scenes().size() << " scenes into " << argv[2] << "\n";
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,7 +1,10 @@
 #include "EventDispatcher.h"
 #include "CapEngineException.h"
 #include "VideoManager.h"
+#include "defer.h"
+#include "inputrecording.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <memory>
@@ -30,21 +33,34 @@ void EventDispatcher::subscribe(IEventSubscriber *subscriber_in,
         "Error registering event subscriber:  Event subcriber is null");
   }
 
-  if (subscriptionMask == 0x00) {
+  for (std::size_t category = 0; category < kCategoryCount; ++category) {
+    if (subscriptionMask & (1 << category)) {
+      categorySubscribers[category].push_back(subscriber_in);
+    }
+  }
+}
+
+void EventDispatcher::enqueue(SDL_Event event)
+{
+  if (coalesceMotion && coalesce(event)) {
     return;
   }
 
-  subscription newSubscription;
-  newSubscription.subscriber = subscriber_in;
-  newSubscription.subscriptionType = subscriptionMask;
-  subscribers.push_back(newSubscription);
+  eventQueue.push_back(event);
 }
 
-void EventDispatcher::enqueue(SDL_Event event) { eventQueue.push_back(event); }
-
 void EventDispatcher::flushQueue()
 {
-  for (auto &&event : eventQueue) {
+  // events enqueued while dispatching are left for the next flush
+  std::swap(eventQueue, dispatchQueue);
+  dispatching = true;
+  Defer finishDispatch([this]() {
+    dispatching = false;
+    dispatchQueue.clear();
+    removeUnsubscribed();
+  });
+
+  for (auto &&event : dispatchQueue) {
 
     // Call the reshape function if SDL is being used
     if (event.type == SDL_WINDOWEVENT_RESIZED) {
@@ -53,74 +69,20 @@ void EventDispatcher::flushQueue()
       videoManager->callReshapeFunc(w, h);
     }
 
-    for (auto &&subscriber : subscribers) {
-      // check to see if subscriber subscribes to current event types
-      switch (event.type) {
-      case SDL_KEYDOWN:
-      case SDL_KEYUP:
-        if (subscriber.subscriptionType & keyboardEvent) {
-          (subscriber.subscriber)->receiveEvent(event, nullptr);
-        }
-        break;
-      case SDL_TEXTINPUT:
-        if (subscriber.subscriptionType & keyboardEvent) {
-          (subscriber.subscriber)->receiveEvent(event, nullptr);
-        }
-        break;
-      case SDL_TEXTEDITING:
-        if (subscriber.subscriptionType & keyboardEvent) {
-          (subscriber.subscriber)->receiveEvent(event, nullptr);
-        }
-        break;
-      case SDL_MOUSEMOTION:
-        if (subscriber.subscriptionType & mouseEvent) {
-          (subscriber.subscriber)->receiveEvent(event, nullptr);
-        }
-        break;
-      case SDL_MOUSEBUTTONDOWN:
-        if (subscriber.subscriptionType & mouseEvent) {
-          (subscriber.subscriber)->receiveEvent(event, nullptr);
-        }
-        break;
-      case SDL_MOUSEBUTTONUP:
-        if (subscriber.subscriptionType & mouseEvent) {
-          (subscriber.subscriber)->receiveEvent(event, nullptr);
-        }
-        break;
-      case SDL_MOUSEWHEEL:
-        if (subscriber.subscriptionType & mouseEvent) {
-          (subscriber.subscriber)->receiveEvent(event, nullptr);
-        }
-        break;
-      case SDL_QUIT:
-        if (subscriber.subscriptionType & systemEvent) {
-          (subscriber.subscriber)->receiveEvent(event, nullptr);
-        }
-        break;
-      case SDL_WINDOWEVENT:
-        if (subscriber.subscriptionType & windowEvent) {
-          (subscriber.subscriber)->receiveEvent(event, nullptr);
-        }
-        break;
-      case SDL_CONTROLLERAXISMOTION:
-      case SDL_CONTROLLERBUTTONDOWN:
-        if (subscriber.subscriptionType & controllerEvent) {
-          (subscriber.subscriber)->receiveEvent(event, nullptr);
-        }
-        break;
-
-      case SDL_CONTROLLERBUTTONUP:
-      case SDL_CONTROLLERDEVICEADDED:
-      case SDL_CONTROLLERDEVICEREMOVED:
-      case SDL_CONTROLLERDEVICEREMAPPED:
-        if (subscriber.subscriptionType & controllerEvent) {
-          (subscriber.subscriber)->receiveEvent(event, nullptr);
-        }
-        break;
+    const int category = categoryOf(event.type);
+    if (category < 0) {
+      continue;
+    }
+
+    // subscribers added while dispatching start with the next event
+    auto &subscribers = categorySubscribers[category];
+    const std::size_t subscriberCount = subscribers.size();
+    for (std::size_t i = 0; i < subscriberCount; ++i) {
+      if (subscribers[i] != nullptr) {
+        subscribers[i]->receiveEvent(event, nullptr);
       }
     }
   }
-  eventQueue.clear();
 }
 
 bool EventDispatcher::hasEvents() { return eventQueue.size() > 0; }
@@ -129,6 +91,9 @@ void EventDispatcher::getEvents()
 {
   SDL_Event event;
   while (SDL_PollEvent(&event)) {
+    if (recorder != nullptr) {
+      recorder->record(event);
+    }
     enqueue(event);
   }
 }
@@ -143,12 +108,132 @@ SDL_Event *EventDispatcher::copyEvent(SDL_Event *event)
 
 void EventDispatcher::unsubscribe(IEventSubscriber *subscriber_in)
 {
-  auto i = subscribers.begin();
-  while (i != subscribers.end()) {
-    if (i->subscriber == subscriber_in) {
-      i = subscribers.erase(i);
+  for (auto &&subscribers : categorySubscribers) {
+    if (dispatching) {
+      // the lists are being walked, so leave a gap for flushQueue to remove
+      std::replace(subscribers.begin(), subscribers.end(), subscriber_in,
+                   static_cast<IEventSubscriber *>(nullptr));
     } else {
-      i++;
+      std::erase(subscribers, subscriber_in);
     }
   }
 }
+
+//! Enables/Disables coalescing of mouse motion and controller axis events.
+void EventDispatcher::setCoalesceMotion(bool enabled)
+{
+  coalesceMotion = enabled;
+}
+
+//! Sets the recorder given each event polled from SDL.
+/**
+ Events are recorded before they are coalesced, so replaying them through
+ enqueue() coalesces them the same way.
+ \param recorder
+   The recorder, or null to stop recording.  Not owned.
+*/
+void EventDispatcher::setRecorder(InputRecorder *recorder)
+{
+  this->recorder = recorder;
+}
+
+//! Gets the category of an event.
+/**
+ \param eventType
+   The SDL event type.
+ \return
+   The index of the category's subscription mask bit, or -1 if no subscriber
+   can receive it.
+*/
+int EventDispatcher::categoryOf(Uint32 eventType)
+{
+  switch (eventType) {
+  case SDL_MOUSEMOTION:
+  case SDL_MOUSEBUTTONDOWN:
+  case SDL_MOUSEBUTTONUP:
+  case SDL_MOUSEWHEEL:
+    return 0; // mouseEvent
+  case SDL_KEYDOWN:
+  case SDL_KEYUP:
+  case SDL_TEXTINPUT:
+  case SDL_TEXTEDITING:
+    return 1; // keyboardEvent
+  case SDL_QUIT:
+    return 2; // systemEvent
+  case SDL_WINDOWEVENT:
+    return 3; // windowEvent
+  case SDL_CONTROLLERAXISMOTION:
+  case SDL_CONTROLLERBUTTONDOWN:
+  case SDL_CONTROLLERBUTTONUP:
+  case SDL_CONTROLLERDEVICEADDED:
+  case SDL_CONTROLLERDEVICEREMOVED:
+  case SDL_CONTROLLERDEVICEREMAPPED:
+    return 4; // controllerEvent
+  default:
+    return -1;
+  }
+}
+
+//! Merges a motion event into an earlier queued one.
+/**
+ Searches back through the queue for the same mouse or controller axis,
+ stopping at any other event of the same category so that motion is never
+ reordered around clicks, buttons or device changes.
+ \param event
+   The event being enqueued.
+ \return
+   true if it was merged and shouldn't be queued.
+*/
+bool EventDispatcher::coalesce(const SDL_Event &event)
+{
+  if (event.type != SDL_MOUSEMOTION && event.type != SDL_CONTROLLERAXISMOTION) {
+    return false;
+  }
+
+  const int category = categoryOf(event.type);
+  for (auto queued = eventQueue.rbegin(); queued != eventQueue.rend();
+       ++queued) {
+    if (categoryOf(queued->type) != category) {
+      continue;
+    }
+
+    if (event.type == SDL_MOUSEMOTION && queued->type == SDL_MOUSEMOTION) {
+      if (queued->motion.windowID != event.motion.windowID ||
+          queued->motion.which != event.motion.which ||
+          queued->motion.state != event.motion.state) {
+        return false;
+      }
+
+      const int xrel = queued->motion.xrel + event.motion.xrel;
+      const int yrel = queued->motion.yrel + event.motion.yrel;
+      queued->motion = event.motion;
+      queued->motion.xrel = xrel;
+      queued->motion.yrel = yrel;
+      return true;
+    }
+
+    if (event.type == SDL_CONTROLLERAXISMOTION &&
+        queued->type == SDL_CONTROLLERAXISMOTION) {
+      // other axes can be passed over since each axis is absolute
+      if (queued->caxis.which != event.caxis.which ||
+          queued->caxis.axis != event.caxis.axis) {
+        continue;
+      }
+
+      queued->caxis = event.caxis;
+      return true;
+    }
+
+    return false;
+  }
+
+  return false;
+}
+
+//! Removes the gaps unsubscribe() leaves while dispatching.
+void EventDispatcher::removeUnsubscribed()
+{
+  for (auto &&subscribers : categorySubscribers) {
+    std::erase(subscribers, nullptr);
+  }
+}
@@ -4,6 +4,7 @@
 #include "IEventSubscriber.h"
 #include "VideoManager.h"
 #include <SDL2/SDL.h>
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -15,24 +16,46 @@ const int systemEvent = 0x04;
 const int windowEvent = 0x08;
 const int controllerEvent = 0x10;
 
+class InputRecorder;
+
 // Class to recieve game events and dispatch them to subscribed parties
+/*
+  Subscribers are kept in one list per event category, built when they
+  subscribe, so dispatching an event only visits the subscribers that want it.
+
+  Mouse motion and controller axis events queued in the same frame are
+  coalesced into the latest one unless a mouse or controller event that isn't
+  motion came between them.  Coalesced mouse motion keeps the summed relative
+  motion.
+*/
 class EventDispatcher
 {
 private:
-  typedef struct subscription_t {
-    short subscriptionType;
-    IEventSubscriber *subscriber;
-  } subscription;
+  //! number of categories, one per subscription mask bit
+  static constexpr std::size_t kCategoryCount = 5;
 
   EventDispatcher(const EventDispatcher &) {}
   EventDispatcher &operator=(const EventDispatcher &) { return *this; }
   SDL_Event *copyEvent(SDL_Event *event);
+  static int categoryOf(Uint32 eventType);
+  bool coalesce(const SDL_Event &event);
+  void removeUnsubscribed();
 
   static bool instantiated;
-  std::vector<subscription> subscribers;
+  //! subscribers of each category, indexed by the bit of their mask.  null
+  //! entries were unsubscribed while dispatching.
+  std::array<std::vector<IEventSubscriber *>, kCategoryCount>
+      categorySubscribers;
   std::vector<SDL_Event> eventQueue;
+  //! the events being dispatched, swapped with eventQueue so both keep their
+  //! storage
+  std::vector<SDL_Event> dispatchQueue;
   VideoManager *videoManager;
   int queueDelayCount;
+  bool dispatching = false;
+  bool coalesceMotion = true;
+  //! records the events polled from SDL, if set
+  InputRecorder *recorder = nullptr;
 
 public:
   EventDispatcher(VideoManager *videoManager, int queueDelay = 0);
@@ -43,6 +66,8 @@ public:
   void flushQueue();
   bool hasEvents();
   void getEvents();
+  void setCoalesceMotion(bool enabled);
+  void setRecorder(InputRecorder *recorder);
 };
 
 } // namespace CapEngine
@@ -34,6 +34,33 @@ using namespace std;
 
 namespace CapEngine {
 
+namespace {
+
+//! Gets a function that puts a renderer's current target back.
+/**
+ Setting a target resets the viewport, so the viewport an offset target is
+ drawn through, see VideoManager::setRenderTarget(), is put back as well.
+ \param renderer
+   The renderer, before its target is changed.
+ \return
+   The function, e.g. for a Defer.
+*/
+std::function<void()> restoreRenderTarget(SDL_Renderer* renderer)
+{
+    Texture* oldTarget = SDL_GetRenderTarget(renderer);
+    SDL_Rect oldViewport;
+    SDL_RenderGetViewport(renderer, &oldViewport);
+
+    return [renderer, oldTarget, oldViewport]() {
+        SDL_SetRenderTarget(renderer, oldTarget);
+        if (oldTarget != nullptr) {
+            SDL_RenderSetViewport(renderer, &oldViewport);
+        }
+    };
+}
+
+}  // namespace
+
 Window::Window()
 {
 }
@@ -46,8 +73,7 @@ Window::Window(SDL_Window* pWindow, SDL_Renderer* pRenderer, Viewport viewport,
 bool VideoManager::instantiated = false;
 
 VideoManager::VideoManager()
-    : up_fontManager(new FontManager()),
-      logger(nullptr),
+    : logger(nullptr),
       m_window(getNullWindowPtr()),
       m_renderer(getNullRendererPtr()),
       initialized(false),
@@ -59,8 +85,7 @@ VideoManager::VideoManager()
 }
 
 VideoManager::VideoManager(Logger* loggerIn)
-    : up_fontManager(new FontManager()),
-      logger(loggerIn),
+    : logger(loggerIn),
       m_window(getNullWindowPtr()),
       m_renderer(getNullRendererPtr()),
       initialized(false),
@@ -80,7 +105,8 @@ Uint32 VideoManager::initSystem(WindowParams windowParams, bool noWindow)
     Uint32 windowID = -1;
     currentWindowParams = windowParams;
 
-    if (SDL_Init(SDL_INIT_EVERYTHING) == -1) {
+    // video is started by createWindow(), so headless runs never pay for it.
+    if (SDL_Init(SDL_INIT_EVENTS | SDL_INIT_TIMER) == -1) {
         ostringstream errorMsg;
         errorMsg << "Unable to initialize SDL. Shutting down." << endl;
         logger->log(errorMsg.str(), Logger::CERROR, __FILE__, __LINE__);
@@ -126,6 +152,61 @@ TexturePtr VideoManager::createTextureFromSurfacePtr(Uint32 windowId, Surface* s
     return TexturePtr(texture, SDL_DestroyTexture);
 }
 
+//! Creates a texture that can be updated from a surface a part at a time.
+/**
+ \param windowId
+   The window whose renderer the texture belongs to.
+ \param surface
+   The surface to copy.  The texture has its size and pixel format.
+ \return
+   The texture, for use with updateTexture().
+*/
+TexturePtr VideoManager::createStreamingTexturePtr(Uint32 windowId, Surface* surface)
+{
+    CAP_THROW_NULL(surface, "surface is null");
+    Window window = this->getWindow(windowId);
+    assert(window.m_renderer != nullptr);
+
+    TexturePtr pTexture(SDL_CreateTexture(window.m_renderer, surface->format->format, SDL_TEXTUREACCESS_STREAMING,
+                                          surface->w, surface->h),
+                        SDL_DestroyTexture);
+    if (pTexture == nullptr) {
+        CAP_THROW(CapEngineException(std::string("Error creating streaming texture: ") + SDL_GetError()));
+    }
+
+    if (SDL_SetTextureBlendMode(pTexture.get(), SDL_BLENDMODE_BLEND) != 0) {
+        CAP_THROW(CapEngineException(SDL_GetError()));
+    }
+
+    this->updateTexture(pTexture.get(), surface, Rect{0, 0, surface->w, surface->h});
+    return pTexture;
+}
+
+//! Copies part of a surface into a texture made by createStreamingTexturePtr().
+/**
+ Only the pixels in the rect are uploaded, so small changes to a large surface
+ stay cheap.
+ \param texture
+   The texture to update.
+ \param surface
+   The surface the texture was created from.
+ \param rect
+   The part of the surface to copy.  The same part of the texture is updated.
+*/
+void VideoManager::updateTexture(Texture* texture, Surface* surface, const Rect& rect)
+{
+    CAP_THROW_NULL(texture, "texture is null");
+    CAP_THROW_NULL(surface, "surface is null");
+    CAP_THROW_ASSERT(rect.x >= 0 && rect.y >= 0 && rect.x + rect.w <= surface->w && rect.y + rect.h <= surface->h,
+                     "Rect is outside the surface");
+
+    const auto* pixels = static_cast<const Uint8*>(surface->pixels) + (rect.y * surface->pitch) +
+                         (rect.x * surface->format->BytesPerPixel);
+    if (SDL_UpdateTexture(texture, &rect, pixels, surface->pitch) != 0) {
+        CAP_THROW(CapEngineException(std::string("Error updating texture: ") + SDL_GetError()));
+    }
+}
+
 /**
  * \brief Creates a copy of an existing texture.
  * \param sourceTexture The texture to copy from.
@@ -318,14 +399,12 @@ void VideoManager::drawTexture(Texture* in_dstTexture, Texture* in_srcTexture, R
     // rendered to m_texture
     SDL_Renderer* renderer = this->getRenderer();
 
-    Texture* oldTarget = SDL_GetRenderTarget(renderer);
+    Defer deferSetRenderTarget(restoreRenderTarget(renderer));
     auto result = SDL_SetRenderTarget(renderer, in_dstTexture);
     if (result != 0) {
         BOOST_THROW_EXCEPTION(CapEngineException(SDL_GetError()));
     }
 
-    Defer deferSetRenderTarget([renderer, oldTarget]() { SDL_SetRenderTarget(renderer, oldTarget); });
-
     result = SDL_SetTextureBlendMode(in_dstTexture, SDL_BLENDMODE_BLEND);
     if (result != 0) {
         BOOST_THROW_EXCEPTION(CapEngineException(SDL_GetError()));
@@ -356,6 +435,91 @@ void VideoManager::setClipRect(Uint32 windowId, SDL_Rect const* clipRect)
     }
 }
 
+//! Creates a texture a window can draw into instead of itself.
+/**
+ \param windowId
+   The window whose renderer the texture belongs to.
+ \param width
+   The width of the texture.
+ \param height
+   The height of the texture.
+ \return
+   The texture, for use with setRenderTarget().
+*/
+TexturePtr VideoManager::createRenderTargetPtr(Uint32 windowId, int width, int height)
+{
+    Window window = this->getWindow(windowId);
+    assert(window.m_renderer != nullptr);
+
+    TexturePtr pTexture(
+        SDL_CreateTexture(window.m_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height),
+        SDL_DestroyTexture);
+    if (pTexture == nullptr) {
+        CAP_THROW(CapEngineException(std::string("Error creating render target: ") + SDL_GetError()));
+    }
+
+    if (SDL_SetTextureBlendMode(pTexture.get(), SDL_BLENDMODE_BLEND) != 0) {
+        CAP_THROW(CapEngineException(SDL_GetError()));
+    }
+
+    return pTexture;
+}
+
+//! Redirects a window's drawing into a texture.
+/**
+ Drawing still clips and transforms as it would for the window, so a texture
+ smaller than the window can hold part of it by giving the window location of
+ its top left corner.
+ \param windowId
+   The window.
+ \param target
+   A texture from createRenderTargetPtr(), or null to draw to the window again.
+ \param originX
+   The window x location drawn at the left edge of the texture.
+ \param originY
+   The window y location drawn at the top edge of the texture.
+*/
+void VideoManager::setRenderTarget(Uint32 windowId, Texture* target, int originX, int originY)
+{
+    Window window = this->getWindow(windowId);
+    assert(window.m_renderer != nullptr);
+
+    if (SDL_SetRenderTarget(window.m_renderer, target) != 0) {
+        CAP_THROW(CapEngineException(SDL_GetError()));
+    }
+
+    // setting the target resets the viewport to cover it, so only an offset
+    // needs one.
+    if (target != nullptr && (originX != 0 || originY != 0)) {
+        int width = 0;
+        int height = 0;
+        if (SDL_QueryTexture(target, nullptr, nullptr, &width, &height) != 0) {
+            CAP_THROW(CapEngineException(SDL_GetError()));
+        }
+
+        SDL_Rect viewport = {-originX, -originY, originX + width, originY + height};
+        if (SDL_RenderSetViewport(window.m_renderer, &viewport) != 0) {
+            CAP_THROW(CapEngineException(SDL_GetError()));
+        }
+    }
+}
+
+//! Clears what a window is drawing into to transparent.
+/**
+ Unlike clearScreen() the background colour isn't used, so a render target
+ cleared with this only covers what is drawn into it.
+ \param windowId
+   The window.
+*/
+void VideoManager::clearRenderTarget(Uint32 windowId)
+{
+    Window window = this->getWindow(windowId);
+    assert(window.m_renderer != nullptr);
+
+    SDL_SetRenderDrawColor(window.m_renderer, 0, 0, 0, 0);
+    SDL_RenderClear(window.m_renderer);
+}
+
 void VideoManager::shutdown()
 {
     for (auto& i : m_windows) {
@@ -392,6 +556,9 @@ void VideoManager::drawScreen(Uint32 windowID)
     if (showFPS) {
         string sFPS = to_string(fps);
         int fontSize = 14;
+        if (up_fontManager == nullptr) {
+            up_fontManager = std::make_unique<FontManager>();
+        }
         SurfacePtr fpsSurface =
             up_fontManager->getTextSurface(ttfFontPath, sFPS, fontSize, fpsColourR, fpsColourG, fpsColourB);
         Texture* fpsTexture = SDL_CreateTextureFromSurface(pRenderer, fpsSurface.get());
@@ -613,14 +780,12 @@ Texture* VideoManager::createTexture(int width, int height, Colour fillColour)
     }
 
     // write out the fill colour
-    Texture* oldTarget = SDL_GetRenderTarget(renderer);
+    Defer deferSetRenderTarget(restoreRenderTarget(renderer));
     auto result = SDL_SetRenderTarget(renderer, texture);
     if (result != 0) {
         BOOST_THROW_EXCEPTION(CapEngineException(SDL_GetError()));
     }
 
-    Defer deferSetRenderTarget([renderer, oldTarget]() { SDL_SetRenderTarget(renderer, oldTarget); });
-
     result = SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
     if (result != 0) {
         BOOST_THROW_EXCEPTION(CapEngineException(SDL_GetError()));
@@ -721,14 +886,12 @@ SurfacePtr VideoManager::createSurfaceFromTexture(Texture* in_texture)
     SurfacePtr surface = this->createSurfacePtr(width, height);
 
     SDL_Renderer* renderer = this->getRenderer();
-    Texture* oldTarget = SDL_GetRenderTarget(renderer);
+    Defer deferSetRenderTarget(restoreRenderTarget(renderer));
     int result = SDL_SetRenderTarget(renderer, in_texture);
     if (result != 0) {
         BOOST_THROW_EXCEPTION(CapEngineException(SDL_GetError()));
     }
 
-    Defer defer{[renderer, oldTarget]() { SDL_SetRenderTarget(renderer, oldTarget); }};
-
     if (SDL_RenderReadPixels(renderer, nullptr, surface->format->format, surface->pixels, surface->pitch) != 0) {
         BOOST_THROW_EXCEPTION(CapEngineException{"Error reading pixels."});
     }
@@ -907,15 +1070,13 @@ void VideoManager::drawFillRect(Texture* in_texture, Rect rect, Colour fillColou
     SDL_Renderer* renderer = m_windows.at(windowId).m_renderer;
     assert(renderer != nullptr);
 
-    Texture* oldTarget = SDL_GetRenderTarget(renderer);
+    Defer deferSetRenderTarget(restoreRenderTarget(renderer));
     assert(in_texture != nullptr);
     auto result = SDL_SetRenderTarget(renderer, in_texture);
     if (result != 0) {
         BOOST_THROW_EXCEPTION(CapEngineException(SDL_GetError()));
     }
 
-    Defer deferSetRenderTarget([renderer, oldTarget]() { SDL_SetRenderTarget(renderer, oldTarget); });
-
     result = SDL_SetTextureBlendMode(in_texture, SDL_BLENDMODE_BLEND);
     if (result != 0) {
         BOOST_THROW_EXCEPTION(CapEngineException(SDL_GetError()));
@@ -996,6 +1157,10 @@ void VideoManager::setBackgroundColour(Colour colour)
 
 WindowPtr VideoManager::createWindow(WindowParams windowParams)
 {
+    if (SDL_WasInit(SDL_INIT_VIDEO) == 0 && SDL_InitSubSystem(SDL_INIT_VIDEO) != 0) {
+        CAP_THROW(CapEngineException(std::string("Unable to initialize SDL video: ") + SDL_GetError()));
+    }
+
     Uint32 flags = 0;
     SDL_Window* pWindow = nullptr;
 
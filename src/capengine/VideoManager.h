@@ -129,9 +129,14 @@ class VideoManager final {
     Texture* createTextureFromSurface(Uint32 windowID, Surface* surface, bool freeSurface = false);
     TexturePtr createTextureFromSurfacePtr(Surface* surface, bool freeSurface = false);
     TexturePtr createTextureFromSurfacePtr(Uint32 windowId, Surface* surface, bool freeSurface = false);
+    TexturePtr createStreamingTexturePtr(Uint32 windowId, Surface* surface);
+    void updateTexture(Texture* texture, Surface* surface, const Rect& rect);
     TexturePtr copyTexture(Texture* sourceTexture);
     void saveTexture(Texture* texture, const std::string& filePath);
     void setClipRect(Uint32 windowId, SDL_Rect const* clipRect);
+    TexturePtr createRenderTargetPtr(Uint32 windowId, int width, int height);
+    void setRenderTarget(Uint32 windowId, Texture* target, int originX = 0, int originY = 0);
+    void clearRenderTarget(Uint32 windowId);
 
     // opengl support
     void setReshapeFunc(void (*func)(int x, int y));
@@ -181,7 +186,7 @@ class VideoManager final {
     void (*reshapeFunc)(int, int);  // for opengl resize functions
     CapEngine::Time lastRenderTime;
     float fps;
-    std::unique_ptr<CapEngine::FontManager> up_fontManager;
+    std::unique_ptr<CapEngine::FontManager> up_fontManager;  // created when the FPS is first drawn
 
     bool showFPS = false;
     std::string ttfFontPath;
@@ -39,8 +39,8 @@ void AbsoluteLayout::addWidget(std::shared_ptr<Widget> pWidget, int x, int y,
   CAP_THROW_ASSERT(pWidget != nullptr, "Can't add null widget");
   CAP_THROW_ASSERT(x >= 0 && y >= 0, "Invalid X and Y");
 
-  WidgetLocation widgetLocation = {pWidget, x,         y,         width,
-                                   height,  widthUnit, heightUnit};
+  WidgetLocation widgetLocation = {pWidget, x,         y,          width,
+                                   height,  widthUnit, heightUnit, {}};
   m_widgets.push_back(widgetLocation);
 
   pWidget->setParent(this);
@@ -56,7 +56,7 @@ void AbsoluteLayout::addWidget(std::shared_ptr<Widget> pWidget, int x, int y,
   // m_height ? 		height : m_height - y;
 
   // 	pWidget->setSize(newWidth, newHeight);
-  m_updateWidgets = true;
+  this->invalidateMeasure();
 }
 
 //! Removes a widget from the layout
@@ -65,37 +65,40 @@ void AbsoluteLayout::addWidget(std::shared_ptr<Widget> pWidget, int x, int y,
  */
 void AbsoluteLayout::removeWidget(std::shared_ptr<Widget> pWidget)
 {
-  std::remove_if(m_widgets.begin(), m_widgets.end(),
-                 [&pWidget](const WidgetLocation &widgetLocation) {
-                   return widgetLocation.pWidget == pWidget;
-                 });
+  std::erase_if(m_widgets, [&pWidget](const WidgetLocation &widgetLocation) {
+    return widgetLocation.pWidget == pWidget;
+  });
+  this->invalidate();
 }
 
 //! @copydoc Widget::render()
 void AbsoluteLayout::render()
 {
-  if (m_updateWidgets)
-    updateWidgetPositions();
+  this->updateLayout();
 
   for (auto &&widget : m_widgets) {
-    widget.pWidget->render();
+    widget.pWidget->renderCached();
   }
 }
 
 //! @copydoc Widget::setPosition()
 void AbsoluteLayout::setPosition(int x, int y)
 {
-  m_x = x;
-  m_y = y;
-  m_updateWidgets = true;
+  if (x != m_x || y != m_y) {
+    m_x = x;
+    m_y = y;
+    this->invalidateArrange();
+  }
 }
 
 //! @copydoc Widget::setSize()
 void AbsoluteLayout::setSize(int width, int height)
 {
-  m_width = width;
-  m_height = height;
-  m_updateWidgets = true;
+  if (width != m_width || height != m_height) {
+    m_width = width;
+    m_height = height;
+    this->invalidateMeasure();
+  }
 }
 
 //! @copydoc Widget::handleMouseMotionEvent()
@@ -157,33 +160,37 @@ void AbsoluteLayout::setWindowId(Uint32 windowId)
   }
 }
 
-//! update widget positions
-void AbsoluteLayout::updateWidgetPositions()
+//! \copydoc Widget::measure
+void AbsoluteLayout::measure()
 {
+  SDL_Rect layoutRect = {0, 0, m_width, m_height};
 
   for (auto &&widgetLocation : m_widgets) {
-    auto pWidget = widgetLocation.pWidget;
-    assert(pWidget);
-
     SDL_Rect srcRect = {widgetLocation.x, widgetLocation.y,
                         widgetLocation.width, widgetLocation.height};
 
     if (widgetLocation.widthUnit == Unit::Percentage)
-      srcRect.w = m_x + m_width - srcRect.x;
+      srcRect.w = m_width - srcRect.x;
 
     if (widgetLocation.heightUnit == Unit::Percentage)
-      srcRect.h = m_y + m_height - srcRect.y;
+      srcRect.h = m_height - srcRect.y;
 
-    SDL_Rect dstRect = {m_x, m_y, m_width, m_height};
+    std::optional<SDL_Rect> clippedRect = clipRect(srcRect, layoutRect);
+    widgetLocation.rect = clippedRect.value_or(SDL_Rect{0, 0, 0, 0});
+  }
+}
 
-    std::optional<SDL_Rect> clippedRect = clipRect(srcRect, dstRect);
-    assert(clippedRect != std::nullopt);
+//! \copydoc Widget::arrange
+void AbsoluteLayout::arrange()
+{
+  for (auto &&widgetLocation : m_widgets) {
+    auto pWidget = widgetLocation.pWidget;
+    assert(pWidget);
 
-    pWidget->setPosition(clippedRect->x, clippedRect->y);
-    pWidget->setSize(clippedRect->w, clippedRect->h);
+    pWidget->setPosition(m_x + widgetLocation.rect.x,
+                         m_y + widgetLocation.rect.y);
+    pWidget->setSize(widgetLocation.rect.w, widgetLocation.rect.h);
   }
-
-  m_updateWidgets = false;
 }
 
 //! Widget::getChildren
@@ -49,20 +49,21 @@ private:
     int height;      //<! The height of the widget
     Unit widthUnit;  //<! The unit of the width
     Unit heightUnit; //<! The unit of the height
+    SDL_Rect rect;   //<! The measured rect relative to the layout
   };
 
 private:
   AbsoluteLayout();
 
-  void updateWidgetPositions();
+  void measure() override;
+  void arrange() override;
 
-  bool m_updateWidgets = false;
   //! The widgets in this layout
   std::vector<WidgetLocation> m_widgets;
-  int m_x;      //<! The x location within the window
-  int m_y;      //<! The y location withing the window
-  int m_width;  //<! The width
-  int m_height; //<! The height
+  int m_x = 0;      //<! The x location within the window
+  int m_y = 0;      //<! The y location withing the window
+  int m_width = 0;  //<! The width
+  int m_height = 0; //<! The height
 };
 
 } // namespace UI
@@ -45,4 +45,15 @@ void AggregateCommand::unExecute()
   }
 }
 
+//! \copydoc Command::byteSize
+std::size_t AggregateCommand::byteSize() const
+{
+  std::size_t size =
+      sizeof(*this) + m_commands.capacity() * sizeof(std::unique_ptr<Command>);
+  for (auto &&pCommand : m_commands) {
+    size += pCommand->byteSize();
+  }
+  return size;
+}
+
 } // namespace CapEngine
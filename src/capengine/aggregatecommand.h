@@ -20,6 +20,7 @@ public:
 
   void execute() override;
   void unExecute() override;
+  std::size_t byteSize() const override;
 
 private:
   std::vector<std::unique_ptr<Command>> m_commands;
@@ -1,7 +1,12 @@
 // TODO This whole darn file needs refactoring
 #include "asset_manager.h"
 
+#include <SDL2/SDL_image.h>
+
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <memory>
 #include <optional>
@@ -12,6 +17,7 @@
 #include "CapEngineException.h"
 #include "filesystem.h"
 #include "locator.h"
+#include "logging.h"
 #include "xml_parser.h"
 
 using namespace std;
@@ -72,6 +78,60 @@ std::map<string, Frame> parseFrames(XmlParser& parser, XmlNode parentNode)
     return frameMap;
 }
 
+//! Decodes an image into a surface.  Runs on the decode pool so it must not touch the renderer.
+SurfacePtr decodeImage(const std::string& in_path)
+{
+    SurfacePtr pSurface{IMG_Load(in_path.c_str()), SDL_FreeSurface};
+    if (pSurface == nullptr) {
+        CAP_THROW(CapEngineException{"Unable to load image at " + in_path + " - " + IMG_GetError()});
+    }
+
+    // the same colour key VideoManager::loadImage() applies.
+    if (SDL_SetColorKey(pSurface.get(), SDL_TRUE | SDL_RLEACCEL, SDL_MapRGB(pSurface->format, 0, 0xFF, 0xFF)) == -1) {
+        CAP_THROW(CapEngineException{"Error setting the color key of the surface"});
+    }
+    return pSurface;
+}
+
+//! Wraps an archived image's pixels in a surface without copying them.
+SurfacePtr archiveSurface(const AssetArchive& in_archive, const ArchiveEntry& in_entry)
+{
+    // SDL only reads a surface's pixels when creating a texture from it, so the mapping can stay read only.
+    auto pixels = in_archive.data(in_entry);
+    SurfacePtr pSurface{SDL_CreateRGBSurfaceWithFormatFrom(const_cast<std::byte*>(pixels.data()), in_entry.width,
+                                                           in_entry.height, SDL_BITSPERPIXEL(in_entry.pixelFormat),
+                                                           in_entry.pitch, in_entry.pixelFormat),
+                        SDL_FreeSurface};
+    if (pSurface == nullptr) {
+        CAP_THROW(CapEngineException{"Unable to create surface for " + in_archive.path().string() + " - " +
+                                     SDL_GetError()});
+    }
+    return pSurface;
+}
+
+//! Copies an archived sound's samples into a PCM.
+std::unique_ptr<PCM> archivePcm(const AssetArchive& in_archive, const ArchiveEntry& in_entry)
+{
+    auto bytes = in_archive.data(in_entry);
+    std::vector<short> samples(bytes.size() / sizeof(short));
+    std::memcpy(samples.data(), bytes.data(), samples.size() * sizeof(short));
+    return std::make_unique<PCM>(std::string{in_archive.string(in_entry.pathOffset)}, std::move(samples));
+}
+
+//! Estimates the memory a texture uses, assuming 4 bytes per pixel.
+std::size_t textureBytes(const VideoManager& in_videoManager, Texture* in_pTexture)
+{
+    auto [width, height] = in_videoManager.getTextureDims(in_pTexture);
+    return static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4;
+}
+
+//! Whether a future's value can be taken without blocking.
+template <typename T>
+bool isReady(const std::future<T>& in_future)
+{
+    return in_future.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+}
+
 }  // end anonymous namespace
 
 AssetManager::AssetManager(VideoManager& videoManager, SoundPlayer& soundPlayer, std::optional<string> assetFile,
@@ -80,8 +140,10 @@ AssetManager::AssetManager(VideoManager& videoManager, SoundPlayer& soundPlayer,
 {
     if (m_assetFile.has_value()) {
         m_assetFile = std::filesystem::absolute(*assetFile).string();
-        XmlParser parser(*assetFile);
-        parseAssetFile(parser);
+        AssetManifest manifest = readAssetManifest(*m_assetFile);
+        m_imageMap = std::move(manifest.images);
+        m_animationMap = std::move(manifest.animations);
+        m_soundMap = std::move(manifest.sounds);
     }
 
     // if the asset base path is not provided. try to find it.
@@ -104,6 +166,9 @@ AssetManager::AssetManager(VideoManager& videoManager, SoundPlayer& soundPlayer,
 
 AssetManager::~AssetManager()
 {
+    // stop the workers before anything they decoded into is freed.
+    m_pDecodePool.reset();
+
     // free textures in image map
     auto tIter = m_imageMap.begin();
     while (tIter != m_imageMap.end()) {
@@ -139,10 +204,21 @@ void AssetManager::loadImage(int id, string path, int frameWidth, int frameHeigh
     image.path = path;
     image.texture = tempTexture;
     m_imageMap[id] = image;
+    markLoaded(AssetKind::Image, id, textureBytes(m_videoManager, tempTexture));
 }
 
-void AssetManager::parseAssetFile(XmlParser& parser)
+//! Reads the assets declared in an asset file without loading any of them.
+/**
+ \param in_assetFile
+   The asset file.  Relative image paths are resolved against its directory.
+ \return
+   The declared assets.
+*/
+AssetManifest readAssetManifest(const std::string& in_assetFile)
 {
+    XmlParser parser(in_assetFile);
+    AssetManifest manifest;
+
     // get Images nodes at /assets/images/image
     vector<XmlNode> images = parser.getNodes("/assets/textures/texture");
     auto imageIter = images.begin();
@@ -162,7 +238,7 @@ void AssetManager::parseAssetFile(XmlParser& parser)
         auto getPath = [&](std::filesystem::path& in_path) -> std::filesystem::path {
             // convert path to absolute path.
             if (in_path.is_relative()) {
-                return std::filesystem::path(*m_assetFile).parent_path() /= path;
+                return std::filesystem::path(in_assetFile).parent_path() /= path;
             }
             return in_path;
         };
@@ -170,7 +246,7 @@ void AssetManager::parseAssetFile(XmlParser& parser)
         if (isAnimation == "y") {
             int numFrames = std::stoi(parser.getAttribute(*imageIter, "numFrames"));
             int animationTimeMs = std::stoi(parser.getAttribute(*imageIter, "animationTimeMs"));
-            m_animationMap[tId] = AnimatedImage{getPath(path).string(), nullptr, numFrames, animationTimeMs};
+            manifest.animations[tId] = AnimatedImage{getPath(path).string(), nullptr, numFrames, animationTimeMs};
         }
         else {
             Image image;
@@ -181,7 +257,7 @@ void AssetManager::parseAssetFile(XmlParser& parser)
                 image.frames = parseFrames(parser, *imageIter);
             }
 
-            m_imageMap[tId] = image;
+            manifest.images[tId] = image;
         }
     }
 
@@ -201,8 +277,10 @@ void AssetManager::parseAssetFile(XmlParser& parser)
         sound.path = path;
         sound.pcm = nullptr;
 
-        m_soundMap[sId] = sound;
+        manifest.sounds[sId] = sound;
     }
+
+    return manifest;
 }
 
 Image* AssetManager::getImage(int id)
@@ -213,12 +291,15 @@ Image* AssetManager::getImage(int id)
         throw AssetDoesNotExistError("image", id);
     }
 
-    if (iter->second.texture == nullptr) {
-        iter->second.texture = m_videoManager.loadImage(iter->second.path);
+    if (iter->second.texture == nullptr && !finishPendingImage(id, false)) {
+        iter->second.texture = loadTexture(AssetKind::Image, id, iter->second.path);
         if (iter->second.texture == nullptr) {
             throw CapEngineException("Unable to load image at " + iter->second.path);
         }
+        markLoaded(AssetKind::Image, id, textureBytes(m_videoManager, iter->second.texture));
     }
+
+    touch(AssetKind::Image, id);
     return &(iter->second);
 }
 
@@ -229,10 +310,13 @@ std::optional<AnimatedImage> AssetManager::getAnimatedImage(int in_id)
         return std::nullopt;
     }
 
-    if (iter->second.texture == nullptr) {
-        iter->second.texture = Locator::videoManager->loadSharedImage(iter->second.path);
+    if (iter->second.texture == nullptr && !finishPendingImage(in_id, true)) {
+        iter->second.texture =
+            SharedTexturePtr{loadTexture(AssetKind::Animation, in_id, iter->second.path), SDL_DestroyTexture};
+        markLoaded(AssetKind::Animation, in_id, textureBytes(m_videoManager, iter->second.texture.get()));
     }
 
+    touch(AssetKind::Animation, in_id);
     return iter->second;
 }
 
@@ -243,7 +327,16 @@ SoftwareImage AssetManager::getSoftwareImage(int id)
         throw AssetDoesNotExistError("image", id);
     }
 
-    Surface* surface = m_videoManager.loadSurface(iter->second.path);
+    Surface* surface = nullptr;
+    if (const ArchivedAsset* pArchived = this->archived(AssetKind::Image, id)) {
+        // the caller owns the surface, so it needs its own copy of the pixels.
+        SurfacePtr pMapped = archiveSurface(*pArchived->pArchive, *pArchived->pEntry);
+        surface = SDL_ConvertSurfaceFormat(pMapped.get(), pArchived->pEntry->pixelFormat, 0);
+    }
+    else {
+        surface = m_videoManager.loadSurface(iter->second.path);
+    }
+
     SoftwareImage softwareImage;
     softwareImage.path = iter->second.path;
     softwareImage.surface = surface;
@@ -315,13 +408,15 @@ Sound* AssetManager::getSound(int id)
         throw AssetDoesNotExistError("sound", id);
     }
 
-    if (iter->second.pcm == nullptr) {
-        unique_ptr<PCM> upPcm(new PCM(iter->second.path));
-        iter->second.pcm = upPcm.release();
+    if (iter->second.pcm == nullptr && !finishPendingSound(id)) {
+        iter->second.pcm = loadPcm(id, iter->second.path).release();
         if (iter->second.pcm == nullptr) {
             throw CapEngineException("Unable to load image at " + iter->second.path);
         }
+        markLoaded(AssetKind::Sound, id, iter->second.pcm->getLength());
     }
+
+    touch(AssetKind::Sound, id);
     return &(iter->second);
 }
 
@@ -339,6 +434,7 @@ void AssetManager::loadSound(int id, string path)
     sound.path = path;
     sound.pcm = upTempPCM.release();
     m_soundMap[id] = sound;
+    markLoaded(AssetKind::Sound, id, sound.pcm->getLength());
 }
 
 void AssetManager::draw(Uint32 windowID, int id, Rectangle _srcRect, Rectangle _destRect,
@@ -431,4 +527,620 @@ std::optional<std::filesystem::path> AssetManager::getBasePath() const
     return m_basePath;
 }
 
+//! Starts decoding every image and sound that isn't loaded yet on the worker pool.
+/**
+ Decoded images still need their textures created on the main thread, which
+ processUploads() does a few at a time.  Anything used before then is finished
+ on demand, so calling this never changes what the getters return.  Assets are
+ otherwise loaded the first time they are used, so only call this when
+ everything fits in the memory budget.
+*/
+void AssetManager::preloadAll()
+{
+    for (auto&& [id, image] : m_imageMap) {
+        queueImage(id, false);
+    }
+
+    for (auto&& [id, animation] : m_animationMap) {
+        queueImage(id, true);
+    }
+
+    for (auto&& [id, sound] : m_soundMap) {
+        queueSound(id);
+    }
+}
+
+//! Starts decoding a scene's assets and keeps them from being evicted.
+/**
+ Each asset is retained until the hints are passed to release().
+ \param in_hints
+   The assets.
+*/
+void AssetManager::preload(const PreloadHints& in_hints)
+{
+    // check everything first, so nothing is left retained if one is missing.
+    for (int id : in_hints.images) {
+        if (!this->imageExists(id)) {
+            CAP_THROW(AssetDoesNotExistError("image", id));
+        }
+    }
+    for (int id : in_hints.animations) {
+        if (!m_animationMap.contains(id)) {
+            CAP_THROW(AssetDoesNotExistError("animation", id));
+        }
+    }
+    for (int id : in_hints.sounds) {
+        if (!this->soundExists(id)) {
+            CAP_THROW(AssetDoesNotExistError("sound", id));
+        }
+    }
+
+    for (int id : in_hints.images) {
+        this->retain(AssetKind::Image, id);
+        queueImage(id, false);
+    }
+    for (int id : in_hints.animations) {
+        this->retain(AssetKind::Animation, id);
+        queueImage(id, true);
+    }
+    for (int id : in_hints.sounds) {
+        this->retain(AssetKind::Sound, id);
+        queueSound(id);
+    }
+}
+
+//! Releases the assets retained by preload().
+/**
+ \param in_hints
+   The same hints passed to preload().
+*/
+void AssetManager::release(const PreloadHints& in_hints)
+{
+    for (int id : in_hints.images) {
+        this->release(AssetKind::Image, id);
+    }
+    for (int id : in_hints.animations) {
+        this->release(AssetKind::Animation, id);
+    }
+    for (int id : in_hints.sounds) {
+        this->release(AssetKind::Sound, id);
+    }
+}
+
+//! Creates textures for decoded images until the time budget runs out.
+/**
+ Call once a frame from the thread that owns the renderer.  At least one
+ texture is created if one is ready, so loading always progresses even when a
+ single upload takes longer than the budget.  Decoded sounds are taken as well
+ since they need no further work.  Assets that fail to decode are logged
+ and left unloaded, so the error is thrown when they are next fetched.
+ Afterwards, unreferenced assets are evicted until memory is back under the
+ budget.
+ \param in_budgetMs
+   Roughly how long to spend, in milliseconds.
+ \return
+   The number of textures created.
+*/
+std::size_t AssetManager::processUploads(double in_budgetMs)
+{
+    for (std::size_t i = 0; i < m_pendingSounds.size();) {
+        if (isReady(m_pendingSounds[i].pcm)) {
+            try {
+                finishPendingSound(m_pendingSounds[i].id);
+            }
+            catch (const std::exception& e) {
+                logException(e);
+            }
+        }
+        else {
+            ++i;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto budget = std::chrono::duration<double, std::milli>{in_budgetMs};
+
+    std::size_t uploaded = 0;
+    for (auto iter = m_pendingImages.begin(); iter != m_pendingImages.end();) {
+        if (uploaded > 0 && std::chrono::steady_clock::now() - start >= budget) {
+            break;
+        }
+
+        if (!isReady(iter->surface)) {
+            ++iter;
+            continue;
+        }
+
+        // take it out first so a failed decode isn't retried every frame.
+        PendingImage pending = std::move(*iter);
+        iter = m_pendingImages.erase(iter);
+        try {
+            uploadImage(pending);
+            ++uploaded;
+        }
+        catch (const std::exception& e) {
+            logException(e);
+        }
+    }
+
+    if (m_pendingImages.empty() && m_pendingSounds.empty()) {
+        m_queuedCount = 0;
+        m_completedCount = 0;
+    }
+
+    evictToBudget();
+    return uploaded;
+}
+
+//! Blocks until everything queued by preloadAll() or preload() is ready.
+void AssetManager::finishLoading()
+{
+    while (!m_pendingImages.empty()) {
+        PendingImage pending = std::move(m_pendingImages.back());
+        m_pendingImages.pop_back();
+        uploadImage(pending);
+    }
+
+    while (!m_pendingSounds.empty()) {
+        finishPendingSound(m_pendingSounds.back().id);
+    }
+
+    m_queuedCount = 0;
+    m_completedCount = 0;
+}
+
+//! Gets the progress of the loading started by preloadAll() or preload(), e.g. for a loading screen.
+LoadProgress AssetManager::loadProgress() const
+{
+    LoadProgress progress;
+    progress.total = m_queuedCount;
+    progress.completed = m_completedCount;
+    progress.decoded = m_completedCount;
+    for (auto&& pending : m_pendingImages) {
+        progress.decoded += isReady(pending.surface) ? 1 : 0;
+    }
+    for (auto&& pending : m_pendingSounds) {
+        progress.decoded += isReady(pending.pcm) ? 1 : 0;
+    }
+
+    return progress;
+}
+
+//! Creates the texture for a decoded image, waiting for the decode if it hasn't finished.
+/**
+ \param io_pending
+   The image, already removed from m_pendingImages.
+*/
+void AssetManager::uploadImage(PendingImage& io_pending)
+{
+    ++m_completedCount;
+    SurfacePtr pSurface = io_pending.surface.get();  // rethrows decode errors
+
+    if (io_pending.animation) {
+        auto iter = m_animationMap.find(io_pending.id);
+        if (iter != m_animationMap.end() && iter->second.texture == nullptr) {
+            iter->second.texture = SharedTexturePtr{m_videoManager.createTextureFromSurface(pSurface.get()),
+                                                    SDL_DestroyTexture};
+            markLoaded(AssetKind::Animation, io_pending.id, textureBytes(m_videoManager, iter->second.texture.get()));
+        }
+        return;
+    }
+
+    auto iter = m_imageMap.find(io_pending.id);
+    if (iter != m_imageMap.end() && iter->second.texture == nullptr) {
+        iter->second.texture = m_videoManager.createTextureFromSurface(pSurface.get());
+        markLoaded(AssetKind::Image, io_pending.id, textureBytes(m_videoManager, iter->second.texture));
+    }
+}
+
+//! Finishes a queued image now rather than waiting for processUploads().
+/**
+ \param in_id
+   The id of the image.
+ \param in_animation
+   Whether the id is an animation.
+ \return
+   false if the image wasn't queued.
+*/
+bool AssetManager::finishPendingImage(int in_id, bool in_animation)
+{
+    auto iter = std::ranges::find_if(m_pendingImages, [&](const PendingImage& in_pending) {
+        return in_pending.id == in_id && in_pending.animation == in_animation;
+    });
+    if (iter == m_pendingImages.end()) {
+        return false;
+    }
+
+    PendingImage pending = std::move(*iter);
+    m_pendingImages.erase(iter);
+    uploadImage(pending);
+    return true;
+}
+
+//! Finishes a queued sound, waiting for the decode if it hasn't finished.
+/**
+ \param in_id
+   The id of the sound.
+ \return
+   false if the sound wasn't queued.
+*/
+bool AssetManager::finishPendingSound(int in_id)
+{
+    auto iter = std::ranges::find_if(m_pendingSounds,
+                                     [&](const PendingSound& in_pending) { return in_pending.id == in_id; });
+    if (iter == m_pendingSounds.end()) {
+        return false;
+    }
+
+    PendingSound pending = std::move(*iter);
+    m_pendingSounds.erase(iter);
+    ++m_completedCount;
+
+    std::unique_ptr<PCM> pPcm = pending.pcm.get();  // rethrows decode errors
+    auto soundIter = m_soundMap.find(in_id);
+    if (soundIter != m_soundMap.end() && soundIter->second.pcm == nullptr) {
+        soundIter->second.pcm = pPcm.release();
+        markLoaded(AssetKind::Sound, in_id, soundIter->second.pcm->getLength());
+    }
+    return true;
+}
+
+//! Queues an image for decoding unless it is loaded or already queued.
+/**
+ \param in_id
+   The id of the image.
+ \param in_animation
+   Whether the id is an animation.
+*/
+void AssetManager::queueImage(int in_id, bool in_animation)
+{
+    const std::string* pPath = nullptr;
+    if (in_animation) {
+        auto&& animation = m_animationMap.at(in_id);
+        pPath = animation.texture == nullptr ? &animation.path : nullptr;
+    }
+    else {
+        auto&& image = m_imageMap.at(in_id);
+        pPath = image.texture == nullptr ? &image.path : nullptr;
+    }
+
+    const bool pending = std::ranges::any_of(m_pendingImages, [&](const PendingImage& in_pending) {
+        return in_pending.id == in_id && in_pending.animation == in_animation;
+    });
+    if (pPath == nullptr || pending) {
+        return;
+    }
+
+    const AssetKind kind = in_animation ? AssetKind::Animation : AssetKind::Image;
+    if (const ArchivedAsset* pArchived = this->archived(kind, in_id)) {
+        // already decoded, but touching the pages on a worker keeps the page faults off the main thread.
+        m_pendingImages.push_back(PendingImage{
+            in_id, in_animation, decodePool().submit([archived = *pArchived]() {
+                return archiveSurface(*archived.pArchive, *archived.pEntry);
+            })});
+    }
+    else {
+        m_pendingImages.push_back(
+            PendingImage{in_id, in_animation, decodePool().submit([path = *pPath]() { return decodeImage(path); })});
+    }
+    ++m_queuedCount;
+}
+
+//! Queues a sound for decoding unless it is loaded or already queued.
+/**
+ \param in_id
+   The id of the sound.
+*/
+void AssetManager::queueSound(int in_id)
+{
+    auto&& sound = m_soundMap.at(in_id);
+    const bool pending = std::ranges::any_of(m_pendingSounds,
+                                             [&](const PendingSound& in_pending) { return in_pending.id == in_id; });
+    if (sound.pcm != nullptr || pending) {
+        return;
+    }
+
+    if (const ArchivedAsset* pArchived = this->archived(AssetKind::Sound, in_id)) {
+        m_pendingSounds.push_back(PendingSound{in_id, decodePool().submit([archived = *pArchived]() {
+                                                   return archivePcm(*archived.pArchive, *archived.pEntry);
+                                               })});
+    }
+    else {
+        m_pendingSounds.push_back(
+            PendingSound{in_id, decodePool().submit([path = sound.path]() { return std::make_unique<PCM>(path); })});
+    }
+    ++m_queuedCount;
+}
+
+//! Gets the worker pool, starting it on first use.
+ThreadPool& AssetManager::decodePool()
+{
+    if (m_pDecodePool == nullptr) {
+        // IMG_Init is not thread safe, so it has to happen here rather than in the first IMG_Load.
+        const int flags = IMG_INIT_JPG | IMG_INIT_PNG;
+        if ((IMG_Init(flags) & flags) != flags) {
+            CAP_THROW(CapEngineException{std::string{"could not init SDL_Image: "} + IMG_GetError()});
+        }
+
+        m_pDecodePool = std::make_unique<ThreadPool>();
+    }
+
+    return *m_pDecodePool;
+}
+
+//! Stops an asset from being evicted until a matching release().
+/**
+ Code that holds on to an Image* or Sound* across frames should retain the
+ asset, since eviction frees the texture or PCM behind it.
+ \param in_kind
+   The kind of asset.
+ \param in_id
+   The id of the asset.
+*/
+void AssetManager::retain(AssetKind in_kind, int in_id)
+{
+    ++m_residency[{in_kind, in_id}].references;
+}
+
+//! Undoes a retain().
+/**
+ The asset stays loaded but becomes a candidate for eviction once nothing else
+ references it.
+ \param in_kind
+   The kind of asset.
+ \param in_id
+   The id of the asset.
+*/
+void AssetManager::release(AssetKind in_kind, int in_id)
+{
+    auto iter = m_residency.find({in_kind, in_id});
+    assert(iter != m_residency.end() && iter->second.references > 0);
+    if (iter != m_residency.end() && iter->second.references > 0) {
+        --iter->second.references;
+    }
+}
+
+//! Gets the number of retain() calls not yet released.
+int AssetManager::referenceCount(AssetKind in_kind, int in_id) const
+{
+    auto iter = m_residency.find({in_kind, in_id});
+    return iter != m_residency.end() ? iter->second.references : 0;
+}
+
+//! Checks whether an asset is loaded, as opposed to declared and loaded on first use.
+bool AssetManager::isLoaded(AssetKind in_kind, int in_id) const
+{
+    auto iter = m_residency.find({in_kind, in_id});
+    return iter != m_residency.end() && iter->second.bytes > 0;
+}
+
+//! Checks whether an asset is queued by preloadAll() or preload() and not yet finished.
+bool AssetManager::isPending(AssetKind in_kind, int in_id) const
+{
+    if (in_kind == AssetKind::Sound) {
+        return std::ranges::any_of(m_pendingSounds,
+                                   [&](const PendingSound& in_pending) { return in_pending.id == in_id; });
+    }
+
+    const bool animation = in_kind == AssetKind::Animation;
+    return std::ranges::any_of(m_pendingImages, [&](const PendingImage& in_pending) {
+        return in_pending.id == in_id && in_pending.animation == animation;
+    });
+}
+
+//! Sets the memory limits enforced by evictToBudget().
+/**
+ \param in_textureBytes
+   The limit for textures, estimated at 4 bytes per pixel.  0 for no limit.
+ \param in_soundBytes
+   The limit for sound buffers.  0 for no limit.
+*/
+void AssetManager::setMemoryBudget(std::size_t in_textureBytes, std::size_t in_soundBytes)
+{
+    m_memoryBudget.textureBytes = in_textureBytes;
+    m_memoryBudget.soundBytes = in_soundBytes;
+}
+
+//! Gets the memory held by loaded assets.
+AssetMemoryUsage AssetManager::memoryUsage() const
+{
+    return m_memoryUsage;
+}
+
+//! Evicts the least recently used unreferenced assets until memory is within budget.
+/**
+ Retained assets, and animations whose texture is still shared with an
+ AnimatedImage returned by getAnimatedImage(), are never evicted, so usage can
+ stay over budget.  Evicted assets are loaded again the next time they are
+ used.  Called by processUploads(), so textures are only freed between frames.
+ \return
+   The number of assets evicted.
+*/
+std::size_t AssetManager::evictToBudget()
+{
+    std::size_t evicted = 0;
+    while (m_memoryBudget.textureBytes > 0 && m_memoryUsage.textureBytes > m_memoryBudget.textureBytes &&
+           evictLeastRecentlyUsed(true)) {
+        ++evicted;
+    }
+    while (m_memoryBudget.soundBytes > 0 && m_memoryUsage.soundBytes > m_memoryBudget.soundBytes &&
+           evictLeastRecentlyUsed(false)) {
+        ++evicted;
+    }
+
+    return evicted;
+}
+
+//! Evicts every unreferenced asset regardless of the budget, e.g. between levels.
+/**
+ \return
+   The number of assets evicted.
+*/
+std::size_t AssetManager::evictUnreferenced()
+{
+    std::size_t evicted = 0;
+    while (evictLeastRecentlyUsed(true)) {
+        ++evicted;
+    }
+    while (evictLeastRecentlyUsed(false)) {
+        ++evicted;
+    }
+
+    return evicted;
+}
+
+//! Records that an asset has been loaded.
+void AssetManager::markLoaded(AssetKind in_kind, int in_id, std::size_t in_bytes)
+{
+    Residency& residency = m_residency[{in_kind, in_id}];
+    std::size_t& total = in_kind == AssetKind::Sound ? m_memoryUsage.soundBytes : m_memoryUsage.textureBytes;
+
+    total = total - residency.bytes + in_bytes;
+    residency.bytes = in_bytes;
+    residency.lastUsed = ++m_useCounter;
+}
+
+//! Records that an asset was just used.
+void AssetManager::touch(AssetKind in_kind, int in_id)
+{
+    auto iter = m_residency.find({in_kind, in_id});
+    if (iter != m_residency.end()) {
+        iter->second.lastUsed = ++m_useCounter;
+    }
+}
+
+//! Evicts the least recently used asset that nothing references.
+/**
+ \param in_textures
+   true to evict an image or animation, false to evict a sound.
+ \return
+   false if there was nothing that could be evicted.
+*/
+bool AssetManager::evictLeastRecentlyUsed(bool in_textures)
+{
+    auto candidate = m_residency.end();
+    for (auto iter = m_residency.begin(); iter != m_residency.end(); ++iter) {
+        const auto& [key, residency] = *iter;
+        const bool isTexture = key.first != AssetKind::Sound;
+        if (isTexture != in_textures || residency.bytes == 0 || residency.references > 0) {
+            continue;
+        }
+
+        // someone is still drawing with the shared texture, so evicting it frees nothing.
+        if (key.first == AssetKind::Animation && m_animationMap.at(key.second).texture.use_count() > 1) {
+            continue;
+        }
+
+        if (candidate == m_residency.end() || residency.lastUsed < candidate->second.lastUsed) {
+            candidate = iter;
+        }
+    }
+
+    if (candidate == m_residency.end()) {
+        return false;
+    }
+
+    unload(candidate->first.first, candidate->first.second);
+    return true;
+}
+
+//! Frees a loaded asset, leaving it declared so that it loads again on next use.
+void AssetManager::unload(AssetKind in_kind, int in_id)
+{
+    switch (in_kind) {
+        case AssetKind::Image: {
+            Image& image = m_imageMap.at(in_id);
+            m_videoManager.closeTexture(image.texture);
+            image.texture = nullptr;
+            break;
+        }
+        case AssetKind::Animation:
+            m_animationMap.at(in_id).texture.reset();
+            break;
+        case AssetKind::Sound: {
+            Sound& sound = m_soundMap.at(in_id);
+            delete sound.pcm;
+            sound.pcm = nullptr;
+            break;
+        }
+    }
+
+    markLoaded(in_kind, in_id, 0);
+}
+
+//! Makes the assets in an archive available, replacing an asset file.
+/**
+ The archive is memory mapped, and its images and sounds are already decoded,
+ so loading them is mostly page faults.  Assets still load lazily and can be
+ preloaded and evicted like any other.  Throws if an id in the archive is
+ already declared.
+ \param in_path
+   The archive, as written by the assetpacker app.
+*/
+void AssetManager::mountArchive(const std::filesystem::path& in_path)
+{
+    auto pArchive = std::make_unique<AssetArchive>(in_path);
+
+    for (auto&& entry : pArchive->entries()) {
+        const bool exists = (entry.kind == AssetKind::Image && this->imageExists(entry.id)) ||
+                            (entry.kind == AssetKind::Animation && m_animationMap.contains(entry.id)) ||
+                            (entry.kind == AssetKind::Sound && this->soundExists(entry.id));
+        if (exists) {
+            ostringstream errorStream;
+            errorStream << "Asset under id " << entry.id << " in " << in_path.string() << " already exists.";
+            CAP_THROW(CapEngineException(errorStream.str()));
+        }
+    }
+
+    for (auto&& entry : pArchive->entries()) {
+        const std::string path{pArchive->string(entry.pathOffset)};
+        switch (entry.kind) {
+            case AssetKind::Image:
+                m_imageMap[entry.id] = Image{path, nullptr, pArchive->frameMap(entry)};
+                break;
+            case AssetKind::Animation:
+                m_animationMap[entry.id] = AnimatedImage{path, nullptr, entry.numFrames, entry.animationTimeMs};
+                break;
+            case AssetKind::Sound:
+                m_soundMap[entry.id] = Sound{path, nullptr};
+                break;
+        }
+        m_archived[{entry.kind, entry.id}] = ArchivedAsset{pArchive.get(), &entry};
+    }
+
+    m_archives.push_back(std::move(pArchive));
+}
+
+//! Finds where an asset is in the mounted archives.
+/**
+ \return
+   nullptr if the asset isn't from an archive.
+*/
+const AssetManager::ArchivedAsset* AssetManager::archived(AssetKind in_kind, int in_id) const
+{
+    auto iter = m_archived.find({in_kind, in_id});
+    return iter != m_archived.end() ? &iter->second : nullptr;
+}
+
+//! Creates the texture for an image or animation on the calling thread.
+Texture* AssetManager::loadTexture(AssetKind in_kind, int in_id, const std::string& in_path)
+{
+    if (const ArchivedAsset* pArchived = this->archived(in_kind, in_id)) {
+        SurfacePtr pSurface = archiveSurface(*pArchived->pArchive, *pArchived->pEntry);
+        return m_videoManager.createTextureFromSurface(pSurface.get());
+    }
+
+    return m_videoManager.loadImage(in_path);
+}
+
+//! Loads a sound on the calling thread.
+std::unique_ptr<PCM> AssetManager::loadPcm(int in_id, const std::string& in_path)
+{
+    if (const ArchivedAsset* pArchived = this->archived(AssetKind::Sound, in_id)) {
+        return archivePcm(*pArchived->pArchive, *pArchived->pEntry);
+    }
+
+    return std::make_unique<PCM>(in_path);
+}
+
 }  // namespace CapEngine
@@ -1,33 +1,30 @@
 #ifndef ASSET_MANAGER_H
 #define ASSET_MANAGER_H
 
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <future>
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "CapEngineException.h"
 #include "VideoManager.h"
+#include "assetarchive.h"
+#include "assettypes.h"
 #include "captypes.h"
 #include "collision.h"  // Rectangle definition
 #include "pcm.h"
 #include "soundplayer.h"
+#include "threadpool.h"
 #include "vector.h"
 #include "xml_parser.h"
 
 namespace CapEngine {
 
-struct Frame {
-    std::string frameName;
-    int rowNum;
-    int frameWidth;
-    int frameHeight;
-    int numFrames;
-    double animationTime;
-    int horizontalPadding;
-    int verticalPadding;
-};
-
 struct Image {
     std::string path;
     Texture* texture;
@@ -51,6 +48,15 @@ struct Sound {
     PCM* pcm;
 };
 
+//! The assets declared by an asset file, none of them loaded.
+struct AssetManifest {
+    std::map<int, Image> images;
+    std::map<int, AnimatedImage> animations;
+    std::map<int, Sound> sounds;
+};
+
+AssetManifest readAssetManifest(const std::string& in_assetFile);
+
 struct AssetDoesNotExistError : public CapEngineException {
     AssetDoesNotExistError(std::string_view in_type, int in_assetId)
         : CapEngineException([&]() {
@@ -63,6 +69,40 @@ struct AssetDoesNotExistError : public CapEngineException {
     }
 };
 
+//! How far the background loading started by AssetManager::preloadAll() has got.
+struct LoadProgress {
+    std::size_t total = 0;      //!< Assets queued since loading last finished.
+    std::size_t decoded = 0;    //!< Of those, how many the workers have finished decoding.
+    std::size_t completed = 0;  //!< Of those, how many are ready to draw or play.
+
+    //! Returns completed / total, or 1 when nothing is queued.
+    [[nodiscard]] double fraction() const
+    {
+        return total == 0 ? 1.0 : static_cast<double>(completed) / static_cast<double>(total);
+    }
+    //! Returns true once everything queued is ready.
+    [[nodiscard]] bool done() const
+    {
+        return completed == total;
+    }
+};
+
+//! Assets a scene wants warmed before it starts and kept while it runs.
+struct PreloadHints {
+    std::vector<int> images;
+    std::vector<int> animations;
+    std::vector<int> sounds;
+
+    //! Returns the number of assets hinted.
+    [[nodiscard]] std::size_t size() const { return images.size() + animations.size() + sounds.size(); }
+};
+
+//! Bytes held by the assets currently loaded.
+struct AssetMemoryUsage {
+    std::size_t textureBytes = 0;  //!< Estimated from texture dimensions at 4 bytes per pixel.
+    std::size_t soundBytes = 0;    //!< The size of the PCM buffers.
+};
+
 class AssetManager {
    public:
     AssetManager(VideoManager& videoManager, SoundPlayer& soundPlayer,
@@ -92,7 +132,50 @@ class AssetManager {
 
     [[nodiscard]] std::optional<std::filesystem::path> getBasePath() const;
 
+    void mountArchive(const std::filesystem::path& in_path);
+    void preloadAll();
+    void preload(const PreloadHints& in_hints);
+    void release(const PreloadHints& in_hints);
+    std::size_t processUploads(double in_budgetMs);
+    void finishLoading();
+    [[nodiscard]] LoadProgress loadProgress() const;
+
+    void retain(AssetKind in_kind, int in_id);
+    void release(AssetKind in_kind, int in_id);
+    [[nodiscard]] int referenceCount(AssetKind in_kind, int in_id) const;
+    [[nodiscard]] bool isLoaded(AssetKind in_kind, int in_id) const;
+    [[nodiscard]] bool isPending(AssetKind in_kind, int in_id) const;
+
+    void setMemoryBudget(std::size_t in_textureBytes, std::size_t in_soundBytes);
+    [[nodiscard]] AssetMemoryUsage memoryUsage() const;
+    std::size_t evictToBudget();
+    std::size_t evictUnreferenced();
+
    private:
+    //! An image being decoded to a surface on the worker pool.
+    struct PendingImage {
+        int id;
+        bool animation;  //!< Whether id is in m_animationMap rather than m_imageMap.
+        std::future<SurfacePtr> surface;
+    };
+    //! A sound being decoded on the worker pool.
+    struct PendingSound {
+        int id;
+        std::future<std::unique_ptr<PCM>> pcm;
+    };
+    //! Bookkeeping for eviction, kept for every asset that has been loaded or retained.
+    struct Residency {
+        std::size_t bytes = 0;       //!< 0 while the asset is not loaded.
+        std::uint64_t lastUsed = 0;  //!< m_useCounter when the asset was last fetched.
+        int references = 0;          //!< retain() calls not yet matched by release().
+    };
+    using AssetKey = std::pair<AssetKind, int>;
+    //! Where to find an asset that was mounted from an archive.
+    struct ArchivedAsset {
+        const AssetArchive* pArchive;
+        const ArchiveEntry* pEntry;
+    };
+
     std::map<int, Image> m_imageMap;
     std::map<int, AnimatedImage> m_animationMap;
     std::map<int, Sound> m_soundMap;
@@ -100,9 +183,32 @@ class AssetManager {
     SoundPlayer& m_soundPlayer;
     std::optional<std::string> m_assetFile;
     std::optional<std::filesystem::path> m_basePath;
+    std::vector<PendingImage> m_pendingImages;  //!< Decoding or waiting for processUploads().
+    std::vector<PendingSound> m_pendingSounds;  //!< Decoding or waiting for processUploads().
+    std::size_t m_queuedCount = 0;     //!< Assets queued since loading last finished.
+    std::size_t m_completedCount = 0;  //!< Of those, how many are ready.
+    std::map<AssetKey, Residency> m_residency;
+    std::uint64_t m_useCounter = 0;    //!< Incremented each time an asset is fetched.
+    AssetMemoryUsage m_memoryUsage;    //!< Bytes held by loaded assets.
+    AssetMemoryUsage m_memoryBudget;   //!< Limits for evictToBudget(), 0 for no limit.
+    std::vector<std::unique_ptr<AssetArchive>> m_archives;  //!< Mounted by mountArchive().
+    std::map<AssetKey, ArchivedAsset> m_archived;           //!< The assets that load from m_archives.
+    std::unique_ptr<ThreadPool> m_pDecodePool;  //!< Created on the first preload.
 
    private:  // functions
-    void parseAssetFile(XmlParser& parser);
+    void queueImage(int in_id, bool in_animation);
+    void queueSound(int in_id);
+    ThreadPool& decodePool();
+    [[nodiscard]] const ArchivedAsset* archived(AssetKind in_kind, int in_id) const;
+    Texture* loadTexture(AssetKind in_kind, int in_id, const std::string& in_path);
+    std::unique_ptr<PCM> loadPcm(int in_id, const std::string& in_path);
+    void uploadImage(PendingImage& io_pending);
+    bool finishPendingImage(int in_id, bool in_animation);
+    bool finishPendingSound(int in_id);
+    void markLoaded(AssetKind in_kind, int in_id, std::size_t in_bytes);
+    void touch(AssetKind in_kind, int in_id);
+    bool evictLeastRecentlyUsed(bool in_textures);
+    void unload(AssetKind in_kind, int in_id);
 };
 
 }  // namespace CapEngine
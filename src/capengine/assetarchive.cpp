@@ -0,0 +1,279 @@
+#include "assetarchive.h"
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+
+#include "CapEngineException.h"
+#include "sectionfile.h"
+#include "serialization.h"
+
+namespace CapEngine {
+
+namespace {
+
+constexpr std::string_view kFormat = "asset archive";
+
+//! Throws if the archive is malformed.
+void checkArchive(bool in_condition, const std::filesystem::path& in_path, std::string_view in_details)
+{
+    checkSectionFile(in_condition, kFormat, in_path, in_details);
+}
+
+}  // namespace
+
+//! Maps and validates an archive.
+/**
+ \param in_path
+   The archive.  Throws CapEngineException if it can't be read or is malformed.
+*/
+AssetArchive::AssetArchive(const std::filesystem::path& in_path) : m_file(in_path)
+{
+    const auto bytes = m_file.bytes();
+    checkArchive(bytes.size() >= sizeof(ArchiveHeader), in_path, "too small");
+
+    m_pHeader = reinterpret_cast<const ArchiveHeader*>(bytes.data());
+    checkArchive(m_pHeader->magic == kMagic, in_path, "bad magic");
+    checkArchive(m_pHeader->version == kVersion, in_path, "unsupported version");
+    checkArchive(inTable(m_pHeader->stringsOffset, m_pHeader->stringsSize, bytes.size()), in_path,
+                 "string table out of range");
+
+    // records() checks the tables themselves.
+    for (auto&& entry : this->entries()) {
+        checkArchive(entry.compression == ArchiveCompression::None, in_path, "unknown compression");
+        checkArchive(entry.dataSize == entry.decodedSize, in_path, "size mismatch");
+        checkArchive(entry.dataOffset <= bytes.size() && entry.dataSize <= bytes.size() - entry.dataOffset, in_path,
+                     "entry data out of range");
+        checkArchive(static_cast<uint64_t>(entry.firstFrame) + entry.frameCount <= m_pHeader->frameCount, in_path,
+                     "entry frames out of range");
+        checkArchive(entry.kind == AssetKind::Image || entry.kind == AssetKind::Animation ||
+                         entry.kind == AssetKind::Sound,
+                     in_path, "unknown asset kind");
+        if (entry.kind != AssetKind::Sound) {
+            // an unknown format is named SDL_PIXELFORMAT_UNKNOWN, and FourCC
+            // formats have no bytes per pixel to check the pitch against.
+            checkArchive(std::string_view{SDL_GetPixelFormatName(entry.pixelFormat)} != "SDL_PIXELFORMAT_UNKNOWN" &&
+                             !SDL_ISPIXELFORMAT_FOURCC(entry.pixelFormat),
+                         in_path, "unknown pixel format");
+            checkArchive(entry.width >= 0, in_path, "negative image width");
+            const int64_t rowSize = static_cast<int64_t>(entry.width) * SDL_BYTESPERPIXEL(entry.pixelFormat);
+            checkArchive(entry.pitch >= rowSize, in_path, "image pitch is too small");
+            checkArchive(entry.height >= 0 && entry.pitch >= 0 &&
+                             static_cast<uint64_t>(entry.height) * static_cast<uint64_t>(entry.pitch) <= entry.dataSize,
+                         in_path, "image data is too small");
+        }
+    }
+}
+
+//! Returns every entry.
+std::span<const ArchiveEntry> AssetArchive::entries() const
+{
+    return this->records<ArchiveEntry>(m_pHeader->entriesOffset, m_pHeader->entryCount);
+}
+
+//! Returns the sprite sheet rows of an entry.
+std::span<const ArchiveFrame> AssetArchive::frames(const ArchiveEntry& in_entry) const
+{
+    return this->records<ArchiveFrame>(m_pHeader->framesOffset, m_pHeader->frameCount)
+        .subspan(in_entry.firstFrame, in_entry.frameCount);
+}
+
+//! Returns the sprite sheet rows of an entry as they appear in Image::frames.
+std::map<std::string, Frame> AssetArchive::frameMap(const ArchiveEntry& in_entry) const
+{
+    std::map<std::string, Frame> frameMap;
+    for (auto&& frame : this->frames(in_entry)) {
+        std::string name{this->string(frame.nameOffset)};
+        frameMap[name] = Frame{name,
+                               frame.rowNum,
+                               frame.frameWidth,
+                               frame.frameHeight,
+                               frame.numFrames,
+                               frame.animationTime,
+                               frame.horizontalPadding,
+                               frame.verticalPadding};
+    }
+
+    return frameMap;
+}
+
+//! Looks up a string in the string table.
+/**
+ \param in_offset
+   The offset of the string within the table.
+ \return
+   The string, without its terminator.
+*/
+std::string_view AssetArchive::string(uint32_t in_offset) const
+{
+    return readSectionString(m_file, kFormat, m_pHeader->stringsOffset, m_pHeader->stringsSize, in_offset);
+}
+
+//! Returns an entry's data, in place in the mapping.
+std::span<const std::byte> AssetArchive::data(const ArchiveEntry& in_entry) const
+{
+    return m_file.bytes().subspan(in_entry.dataOffset, in_entry.dataSize);
+}
+
+//! Returns the path the archive was opened from.
+const std::filesystem::path& AssetArchive::path() const
+{
+    return m_file.path();
+}
+
+//! Views a table of records in the mapping.
+template <typename T>
+std::span<const T> AssetArchive::records(uint64_t in_offset, std::size_t in_count) const
+{
+    return readSection<T>(m_file, kFormat, in_offset, in_count);
+}
+
+//! Adds an image or animation.
+/**
+ \param in_image
+   The image.  Its pixels are copied.
+*/
+void AssetArchiveWriter::addImage(const ArchiveImage& in_image)
+{
+    CAP_THROW_ASSERT(in_image.kind != AssetKind::Sound, "Sounds are added with addSound()");
+    CAP_THROW_ASSERT(in_image.pixels.size() >= static_cast<std::size_t>(in_image.height) * in_image.pitch,
+                     "Image pixels are smaller than height * pitch");
+    CAP_THROW_ASSERT(!this->contains(in_image.kind, in_image.id), "Asset is already in the archive");
+
+    PendingEntry pending{};
+    pending.entry.kind = in_image.kind;
+    pending.entry.id = in_image.id;
+    pending.entry.pixelFormat = in_image.pixelFormat;
+    pending.entry.width = in_image.width;
+    pending.entry.height = in_image.height;
+    pending.entry.pitch = in_image.pitch;
+    pending.entry.numFrames = in_image.numFrames;
+    pending.entry.animationTimeMs = in_image.animationTimeMs;
+    pending.path = in_image.path;
+    pending.data.assign(in_image.pixels.begin(), in_image.pixels.end());
+
+    for (auto&& [name, frame] : in_image.frames) {
+        ArchiveFrame archiveFrame{};
+        archiveFrame.rowNum = frame.rowNum;
+        archiveFrame.frameWidth = frame.frameWidth;
+        archiveFrame.frameHeight = frame.frameHeight;
+        archiveFrame.numFrames = frame.numFrames;
+        archiveFrame.horizontalPadding = frame.horizontalPadding;
+        archiveFrame.verticalPadding = frame.verticalPadding;
+        archiveFrame.animationTime = frame.animationTime;
+        pending.frames.emplace_back(name, archiveFrame);
+    }
+
+    m_entries.push_back(std::move(pending));
+}
+
+//! Adds a sound.
+/**
+ \param in_id
+   The id of the sound.
+ \param in_path
+   The source file, kept for error messages.
+ \param in_samples
+   The samples as PCM holds them.  They are copied.
+*/
+void AssetArchiveWriter::addSound(int in_id, const std::string& in_path, std::span<const short> in_samples)
+{
+    CAP_THROW_ASSERT(!this->contains(AssetKind::Sound, in_id), "Asset is already in the archive");
+
+    PendingEntry pending{};
+    pending.entry.kind = AssetKind::Sound;
+    pending.entry.id = in_id;
+    pending.path = in_path;
+    const auto bytes = std::as_bytes(in_samples);
+    pending.data.assign(bytes.begin(), bytes.end());
+
+    m_entries.push_back(std::move(pending));
+}
+
+//! Checks whether an asset has been added.
+bool AssetArchiveWriter::contains(AssetKind in_kind, int in_id) const
+{
+    return std::ranges::any_of(m_entries, [&](const PendingEntry& in_pending) {
+        return in_pending.entry.kind == in_kind && in_pending.entry.id == in_id;
+    });
+}
+
+//! Lays out the archive.
+/**
+ \return
+   The bytes of the archive.
+*/
+std::vector<std::byte> AssetArchiveWriter::build() const
+{
+    // string table first, since entries and frames refer into it.
+    std::vector<char> strings;
+    auto addString = [&](const std::string& in_string) {
+        const auto offset = static_cast<uint32_t>(strings.size());
+        strings.insert(strings.end(), in_string.begin(), in_string.end());
+        strings.push_back('\0');
+        return offset;
+    };
+
+    std::vector<ArchiveEntry> entries;
+    std::vector<ArchiveFrame> frames;
+    entries.reserve(m_entries.size());
+    for (auto&& pending : m_entries) {
+        ArchiveEntry entry = pending.entry;
+        entry.pathOffset = addString(pending.path);
+        entry.firstFrame = static_cast<uint32_t>(frames.size());
+        entry.frameCount = static_cast<uint32_t>(pending.frames.size());
+        for (auto&& [name, frame] : pending.frames) {
+            frames.push_back(frame);
+            frames.back().nameOffset = addString(name);
+        }
+        entries.push_back(entry);
+    }
+
+    ArchiveHeader header{};
+    header.magic = AssetArchive::kMagic;
+    header.version = AssetArchive::kVersion;
+    header.entryCount = static_cast<uint32_t>(entries.size());
+    header.frameCount = static_cast<uint32_t>(frames.size());
+    header.entriesOffset = alignSection(sizeof(ArchiveHeader));
+    header.framesOffset = alignSection(header.entriesOffset + entries.size() * sizeof(ArchiveEntry));
+    header.stringsOffset = alignSection(header.framesOffset + frames.size() * sizeof(ArchiveFrame));
+    header.stringsSize = strings.size();
+
+    uint64_t dataOffset = alignSection(header.stringsOffset + header.stringsSize);
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        entries[i].dataOffset = dataOffset;
+        entries[i].dataSize = m_entries[i].data.size();
+        entries[i].decodedSize = m_entries[i].data.size();
+        entries[i].compression = ArchiveCompression::None;
+        dataOffset = alignSection(dataOffset + entries[i].dataSize);
+    }
+
+    std::vector<std::byte> buffer;
+    buffer.reserve(dataOffset);
+    ByteWriter writer{buffer};
+
+    writer.write(header);
+    padSection(buffer);
+    writeSection<ArchiveEntry>(writer, buffer, entries);
+    writeSection<ArchiveFrame>(writer, buffer, frames);
+    writer.writeBytes(std::as_bytes(std::span{strings}));
+    padSection(buffer);
+    for (auto&& pending : m_entries) {
+        writer.writeBytes(pending.data);
+        padSection(buffer);
+    }
+
+    return buffer;
+}
+
+//! Writes the archive to a file.
+/**
+ \param in_path
+   The file to write.  Throws CapEngineException on failure.
+*/
+void AssetArchiveWriter::write(const std::filesystem::path& in_path) const
+{
+    writeSectionFile(in_path, kFormat, this->build());
+}
+
+}  // namespace CapEngine
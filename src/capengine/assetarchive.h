@@ -0,0 +1,155 @@
+#ifndef CAPENGINE_ASSETARCHIVE_H
+#define CAPENGINE_ASSETARCHIVE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "assettypes.h"
+#include "mappedfile.h"
+
+namespace CapEngine {
+
+/**
+   \file
+   A single file holding pre-decoded assets, written offline by the assetpacker
+   app and read in place by AssetManager::mountArchive().
+
+   Layout, with every section 16 byte aligned:
+     ArchiveHeader
+     ArchiveEntry[entryCount]
+     ArchiveFrame[frameCount]
+     string table, nul terminated strings
+     entry data: pixels in the entry's SDL pixel format or int16 PCM samples
+
+   Values are in native byte order, so archives are built per platform.
+*/
+
+//! How an entry's data is stored.
+/**
+   Only None is written today.  The field lets a compressed encoding be added
+   without changing the layout; readers reject values they don't know.
+*/
+enum class ArchiveCompression : uint32_t { None = 0 };
+
+//! The start of an archive.
+struct ArchiveHeader {
+    std::array<char, 4> magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t frameCount;
+    uint64_t entriesOffset;
+    uint64_t framesOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+};
+
+//! An image, animation or sound in an archive.
+struct ArchiveEntry {
+    AssetKind kind;
+    int32_t id;
+    uint64_t dataOffset;
+    uint64_t dataSize;     //!< Bytes stored in the file.
+    uint64_t decodedSize;  //!< Bytes once decompressed.
+    ArchiveCompression compression;
+    uint32_t pixelFormat;  //!< SDL_PixelFormatEnum of an image's pixels.
+    int32_t width;
+    int32_t height;
+    int32_t pitch;
+    int32_t numFrames;        //!< Animations only.
+    int32_t animationTimeMs;  //!< Animations only.
+    uint32_t firstFrame;      //!< Index of the entry's first ArchiveFrame.
+    uint32_t frameCount;      //!< Number of ArchiveFrames the entry has.
+    uint32_t pathOffset;      //!< The source file, in the string table.
+};
+
+//! A sprite sheet row of an image entry.  See Frame.
+struct ArchiveFrame {
+    uint32_t nameOffset;  //!< In the string table.
+    int32_t rowNum;
+    int32_t frameWidth;
+    int32_t frameHeight;
+    int32_t numFrames;
+    int32_t horizontalPadding;
+    int32_t verticalPadding;
+    uint32_t reserved;
+    double animationTime;
+};
+
+static_assert(sizeof(ArchiveHeader) % 8 == 0 && sizeof(ArchiveEntry) % 8 == 0 && sizeof(ArchiveFrame) % 8 == 0,
+              "Archive records must keep the records after them aligned");
+
+//! Reads an asset archive in place.
+/**
+   The whole archive is memory mapped and validated up front.  Nothing is
+   copied, so the spans returned are only valid while the archive is alive.
+*/
+class AssetArchive final {
+   public:
+    explicit AssetArchive(const std::filesystem::path& in_path);
+
+    [[nodiscard]] std::span<const ArchiveEntry> entries() const;
+    [[nodiscard]] std::span<const ArchiveFrame> frames(const ArchiveEntry& in_entry) const;
+    [[nodiscard]] std::map<std::string, Frame> frameMap(const ArchiveEntry& in_entry) const;
+    [[nodiscard]] std::string_view string(uint32_t in_offset) const;
+    [[nodiscard]] std::span<const std::byte> data(const ArchiveEntry& in_entry) const;
+    [[nodiscard]] const std::filesystem::path& path() const;
+
+    static constexpr std::array<char, 4> kMagic = {'C', 'P', 'A', 'K'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr const char* kExtension = ".cpak";
+
+   private:
+    template <typename T>
+    std::span<const T> records(uint64_t in_offset, std::size_t in_count) const;
+
+    MappedFile m_file;                        //!< The archive.
+    const ArchiveHeader* m_pHeader = nullptr;  //!< Points into m_file.
+};
+
+//! An image or animation to add to an archive.
+struct ArchiveImage {
+    AssetKind kind = AssetKind::Image;
+    int id = 0;
+    std::string path;          //!< The source file, kept for error messages.
+    uint32_t pixelFormat = 0;  //!< SDL_PixelFormatEnum of pixels.
+    int width = 0;
+    int height = 0;
+    int pitch = 0;
+    std::span<const std::byte> pixels;  //!< height * pitch bytes.  Copied by addImage().
+    std::map<std::string, Frame> frames;
+    int numFrames = 0;
+    int animationTimeMs = 0;
+};
+
+//! Builds an asset archive.
+class AssetArchiveWriter final {
+   public:
+    void addImage(const ArchiveImage& in_image);
+    void addSound(int in_id, const std::string& in_path, std::span<const short> in_samples);
+    [[nodiscard]] bool contains(AssetKind in_kind, int in_id) const;
+
+    [[nodiscard]] std::vector<std::byte> build() const;
+    void write(const std::filesystem::path& in_path) const;
+
+   private:
+    //! An entry with data that hasn't been laid out yet.
+    struct PendingEntry {
+        ArchiveEntry entry;
+        std::string path;
+        std::vector<std::pair<std::string, ArchiveFrame>> frames;
+        std::vector<std::byte> data;
+    };
+
+    std::vector<PendingEntry> m_entries;  //!< In the order they were added.
+};
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_ASSETARCHIVE_H
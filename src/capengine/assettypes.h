@@ -0,0 +1,26 @@
+#ifndef CAPENGINE_ASSETTYPES_H
+#define CAPENGINE_ASSETTYPES_H
+
+#include <cstdint>
+#include <string>
+
+namespace CapEngine {
+
+//! A row of frames in a sprite sheet.
+struct Frame {
+    std::string frameName;
+    int rowNum;
+    int frameWidth;
+    int frameHeight;
+    int numFrames;
+    double animationTime;
+    int horizontalPadding;
+    int verticalPadding;
+};
+
+//! The kinds of asset AssetManager holds.  Stored in asset archives, so don't reorder.
+enum class AssetKind : uint32_t { Image, Animation, Sound };
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_ASSETTYPES_H
@@ -1,6 +1,8 @@
 #include "bitmapcollisionlayer.h"
 
+#include <algorithm>
 #include <boost/log/trivial.hpp>
+#include <cmath>
 #include <optional>
 #include <utility>
 
@@ -28,10 +30,41 @@ BitmapCollisionLayer::BitmapCollisionLayer(int in_assetId, Rectangle in_position
 //! \copydoc Layer::checkCollision
 BitmapCollisionLayer::CollisionType_t BitmapCollisionLayer::checkCollisions(const GameObject& in_object) const
 {
-    return this->getCollisions(in_object);
+    const Rectangle mbr = this->collisionRectangle(in_object);
+    return detectBitmapCollision(mbr, m_softwareImage->surface);
+}
+
+//! \copydoc Layer::checkCollisions(const GameObject&, CollisionBuffer_t&)
+void BitmapCollisionLayer::checkCollisions(const GameObject& in_object, CollisionBuffer_t& out_collisions) const
+{
+    const Rectangle mbr = this->collisionRectangle(in_object);
+    detectBitmapCollision(mbr, m_softwareImage->surface, out_collisions);
+}
+
+//! Gets the bounding rectangle of an object in the coordinates of the bitmap.
+/**
+ Also loads the bitmap on first use.
+ \param in_object
+   The object.
+ \return
+   The rectangle to test against the bitmap.
+*/
+Rectangle BitmapCollisionLayer::collisionRectangle(const GameObject& in_object) const
+{
+    return this->collisionRectangle(in_object.boundingPolygon(), in_object.getYAxisOrientation());
 }
 
-std::vector<std::pair<CollisionType, Vector>> BitmapCollisionLayer::getCollisions(const GameObject& in_object) const
+//! Converts a box to the coordinates of the bitmap.
+/**
+ Also loads the bitmap on first use.
+ \param in_box
+   The box.
+ \param in_orientation
+   The y axis orientation of the box.
+ \return
+   The rectangle to test against the bitmap.
+*/
+Rectangle BitmapCollisionLayer::collisionRectangle(const Rectangle& in_box, YAxisOrientation in_orientation) const
 {
     assert(Locator::assetManager != nullptr);
 
@@ -40,16 +73,85 @@ std::vector<std::pair<CollisionType, Vector>> BitmapCollisionLayer::getCollision
     }
     assert(m_softwareImage->surface != nullptr);
 
-    // std::cout << "Object position: " << in_object.getPosition() << std::endl;
-    Rectangle mbr = in_object.boundingPolygon();
-    // std::cout << "Object bounding retangle before y flip: " << mbr << std::endl;
-    if (in_object.getYAxisOrientation() == YAxisOrientation::BottomZero) {
+    Rectangle mbr = in_box;
+    if (in_orientation == YAxisOrientation::BottomZero) {
         mbr.y = Locator::videoManager->toScreenCoord(m_softwareImage->surface, mbr.y) - mbr.height;
     }
 
-    // std::cout << "Object bounding rectangle: " << mbr << std::endl;
+    return mbr;
+}
 
-    return detectBitmapCollision(mbr, m_softwareImage->surface);
+//! Finds where a box moving in a straight line first hits the bitmap.
+/**
+ The bitmap has no geometry to intersect with, so the box is stepped along
+ the displacement a pixel at a time.  The side that hits is the axis whose
+ movement alone runs into the bitmap.
+ \param in_box
+   The box at the start of the cast.
+ \param in_displacement
+   How far the box moves.
+ \param in_orientation
+   The y axis orientation of the box.
+ \return
+   The fraction of the displacement the box can move before hitting the
+   bitmap, or nullopt if it doesn't hit it or starts inside it.
+*/
+std::optional<SweptBoxCollision> BitmapCollisionLayer::castBox(const Rectangle& in_box, const Vector& in_displacement,
+                                                               YAxisOrientation in_orientation) const
+{
+    // rays are a pixel wide so the bitmap's edge checks have something to test
+    Rectangle box = in_box;
+    box.width = std::max(box.width, 1.0);
+    box.height = std::max(box.height, 1.0);
+
+    const double dx = in_displacement.getX();
+    const double dy = in_displacement.getY();
+    const int steps = static_cast<int>(std::ceil(std::max(std::abs(dx), std::abs(dy))));
+    if (steps == 0 || this->overlaps(box, in_orientation)) {
+        return std::nullopt;
+    }
+
+    const double stepX = dx / steps;
+    const double stepY = dy / steps;
+
+    for (int step = 1; step <= steps; step++) {
+        const Rectangle next{box.x + stepX * step, box.y + stepY * step, box.width, box.height};
+        if (!this->overlaps(next, in_orientation)) {
+            continue;
+        }
+
+        const Rectangle free{next.x - stepX, next.y - stepY, box.width, box.height};
+        const Rectangle movedOnX{next.x, free.y, box.width, box.height};
+        const bool hitOnX = stepX != 0.0 && (stepY == 0.0 || this->overlaps(movedOnX, in_orientation));
+
+        SweptBoxCollision sweptCollision;
+        sweptCollision.timeOfImpact = static_cast<double>(step - 1) / steps;
+
+        BoxCollision& collision = sweptCollision.collision;
+        if (hitOnX) {
+            collision.collisionType = stepX > 0.0 ? COLLISION_RIGHT : COLLISION_LEFT;
+            collision.collisionNormal = Vector{stepX > 0.0 ? 1.0 : -1.0};
+            collision.representativePoint =
+                Point{stepX > 0.0 ? free.x + free.width : free.x, free.y + free.height / 2.0};
+        }
+        else {
+            collision.collisionType = stepY > 0.0 ? COLLISION_TOP : COLLISION_BOTTOM;
+            collision.collisionNormal = Vector{0.0, stepY > 0.0 ? 1.0 : -1.0};
+            collision.representativePoint =
+                Point{free.x + free.width / 2.0, stepY > 0.0 ? free.y + free.height : free.y};
+        }
+
+        return sweptCollision;
+    }
+
+    return std::nullopt;
+}
+
+//! \copydoc Layer::overlaps
+bool BitmapCollisionLayer::overlaps(const Rectangle& in_box, YAxisOrientation in_orientation) const
+{
+    const Rectangle mbr = this->collisionRectangle(in_box, in_orientation);
+    return !detectBitmapCollision(mbr, m_softwareImage->surface).empty();
 }
 
 //! Register the layer constructor with a factory.
@@ -23,11 +23,19 @@ class BitmapCollisionLayer final : public ImageLayer
     void render(const Camera2d &in_camera, uint32_t in_windowId) override{};
     bool canCollide() const override;
     CollisionType_t checkCollisions(const GameObject &in_object) const override;
+    void checkCollisions(const GameObject &in_object,
+                         CollisionBuffer_t &out_collisions) const override;
     bool resolveCollisions(GameObject &in_object) const override;
+    std::optional<SweptBoxCollision>
+        castBox(const Rectangle &in_box, const Vector &in_displacement,
+                YAxisOrientation in_orientation) const override;
+    bool overlaps(const Rectangle &in_box,
+                  YAxisOrientation in_orientation) const override;
 
   private:
-    std::vector<std::pair<CollisionType, Vector>>
-        getCollisions(const GameObject &in_object) const;
+    Rectangle collisionRectangle(const GameObject &in_object) const;
+    Rectangle collisionRectangle(const Rectangle &in_box,
+                                 YAxisOrientation in_orientation) const;
 
     mutable std::optional<SoftwareImage> m_softwareImage;
 };
@@ -35,7 +43,7 @@ class BitmapCollisionLayer final : public ImageLayer
 //! \override Layer::type()
 inline const std::string BitmapCollisionLayer::type() const
 {
-    return Schema::Scene2d::kVectorCollisionLayerType;
+    return Schema::Scene2d::kBitmapCollisionLayer;
 }
 
 //! \copydoc Layer::canCollide
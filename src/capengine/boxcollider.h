@@ -21,6 +21,7 @@ public:
   ~BoxCollider() override = default;
 
   std::unique_ptr<Component> clone() const override;
+  bool assign(const Component &in_other) override;
 
   static std::unique_ptr<BoxCollider>
       makeComponent(const jsoncons::json &in_json);
@@ -52,6 +53,12 @@ inline std::unique_ptr<Component> BoxCollider::clone() const
   return std::make_unique<BoxCollider>(*this);
 }
 
+//! \copydoc Component::assign
+inline bool BoxCollider::assign(const Component &in_other)
+{
+  return assignComponent(*this, in_other);
+}
+
 } // namespace CapEngine
 
 #endif // CAPENGINE_BOXCOLLIDERCOMPONENT_H
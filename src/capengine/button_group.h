@@ -2,12 +2,12 @@
 #define BUTTON_GROUP_H
 
 #include <SDL2/SDL_events.h>
-#include <boost/signals2/connection.hpp>
 #include <memory>
 #include <vector>
 
 #include "IEventSubscriber.h"
 #include "button.h"
+#include "delegatesignal.h"
 #include "controller.h"
 #include "uiobject.h"
 
@@ -47,8 +47,8 @@ class ButtonGroup : public UIObject
     std::vector<std::unique_ptr<Button>> m_buttons;
     unsigned int m_activeButtonIndex;
     std::vector<std::shared_ptr<Controller>> m_controllers;
-    boost::signals2::scoped_connection m_keyboardEventConnection;
-    boost::signals2::scoped_connection m_controllerEventConnection;
+    ScopedConnection m_keyboardEventConnection;
+    ScopedConnection m_controllerEventConnection;
 };
 } // namespace CapEngine
 
@@ -1,9 +1,12 @@
 #include "collision.h"
 
 #include <algorithm>
+#include <array>
 #include <boost/log/trivial.hpp>
 #include <boost/throw_exception.hpp>
+#include <cmath>
 #include <functional>
+#include <limits>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
@@ -298,13 +301,350 @@ std::optional<BoxCollision> detectBoxCollision(const Rectangle& a, const Rectang
     return boxCollision;
 }
 
-std::optional<BoxCollision> detectBoxCollisionWithContactManifold(
-    const Rectangle& a, const Rectangle& b, RepresentativePointMethod in_representativePointMethod,
-    bool in_preferLeftRight)
+//! Detects the collision between two rectangles and where their faces touch.
+/**
+ The side is chosen the same way as detectBoxCollision.  The manifold has a
+ point at each end of the overlap of the touching faces, which is what a
+ solver needs to keep a box resting flat on another rather than rocking on a
+ single representative point.
+ \param a
+   The first rectangle.
+ \param b
+   The second rectangle.
+ \param in_preferLeftRight
+   Prefer collisions reported on left or right when it could go either way.
+ \return
+   The manifold from a's point of view, or nullopt if there is no collision.
+*/
+std::optional<ContactManifold> detectBoxCollisionWithContactManifold(const Rectangle& a, const Rectangle& b,
+                                                                     bool in_preferLeftRight)
+{
+    const auto boxCollision = detectBoxCollision(a, b, RepresentativePointMethod::Simple, in_preferLeftRight);
+    if (!boxCollision) {
+        return std::nullopt;
+    }
+
+    ContactManifold manifold;
+    manifold.collisionType = boxCollision->collisionType;
+    manifold.collisionNormal = boxCollision->collisionNormal;
+
+    const double overlapMinX = std::max(a.x, b.x);
+    const double overlapMaxX = std::min(a.x + a.width, b.x + b.width);
+    const double overlapMinY = std::max(a.y, b.y);
+    const double overlapMaxY = std::min(a.y + a.height, b.y + b.height);
+
+    switch (manifold.collisionType) {
+        case COLLISION_RIGHT:
+        case COLLISION_LEFT: {
+            const bool right = manifold.collisionType == COLLISION_RIGHT;
+            const double face = right ? a.x + a.width : a.x;
+            manifold.penetration = overlapMaxX - overlapMinX;
+            manifold.points = {Point{face, overlapMinY}, Point{face, overlapMaxY}};
+            manifold.pointCount = overlapMinY < overlapMaxY ? 2 : 1;
+            break;
+        }
+        default: {
+            const bool top = manifold.collisionType == COLLISION_TOP;
+            const double face = top ? a.y + a.height : a.y;
+            manifold.penetration = overlapMaxY - overlapMinY;
+            manifold.points = {Point{overlapMinX, face}, Point{overlapMaxX, face}};
+            manifold.pointCount = overlapMinX < overlapMaxX ? 2 : 1;
+            break;
+        }
+    }
+
+    return manifold;
+}
+
+//! Gets a manifold from the other box's point of view.
+/**
+ \param in_manifold
+   The manifold.
+ \return
+   The manifold with the normal and side reversed.  The points are kept.
+*/
+ContactManifold reversed(const ContactManifold& in_manifold)
+{
+    ContactManifold manifold = in_manifold;
+    manifold.collisionNormal = Vector{-in_manifold.collisionNormal.getX(), -in_manifold.collisionNormal.getY()};
+
+    switch (in_manifold.collisionType) {
+        case COLLISION_LEFT:
+            manifold.collisionType = COLLISION_RIGHT;
+            break;
+        case COLLISION_RIGHT:
+            manifold.collisionType = COLLISION_LEFT;
+            break;
+        case COLLISION_TOP:
+            manifold.collisionType = COLLISION_BOTTOM;
+            break;
+        case COLLISION_BOTTOM:
+            manifold.collisionType = COLLISION_TOP;
+            break;
+        default:
+            break;
+    }
+
+    return manifold;
+}
+
+//! Finds when a moving box first hits a stationary one.
+/**
+ Unlike detectBoxCollision this can't miss a box that a fast object would pass
+ straight through in one timestep.  For two moving boxes pass the velocity of
+ a relative to b.
+ \param a
+   The moving box at the start of the timestep.
+ \param in_velocity
+   The velocity of a in units per second.
+ \param in_timestepMs
+   The timestep in milliseconds.
+ \param b
+   The stationary box.
+ \return
+   The time of impact and the side of a that hits b, or nullopt if they don't
+   touch during the timestep.  Boxes that already overlap are left to
+   detectBoxCollision and also give nullopt.
+*/
+std::optional<SweptBoxCollision> detectSweptBoxCollision(const Rectangle& a, const Vector& in_velocity,
+                                                         double in_timestepMs, const Rectangle& b)
 {
-    // TODO Contact manifold is a more accurate way to perform physics on collisions
-    // It returns more than one representative contact point
-    BOOST_THROW_EXCEPTION(std::runtime_error{"Not Implemented"});
+    const double dx = in_velocity.getX() * (in_timestepMs / 1000.0);
+    const double dy = in_velocity.getY() * (in_timestepMs / 1000.0);
+
+    // The times at which a enters and leaves b's extent on one axis.
+    auto axisTimes = [](double in_aMin, double in_aMax, double in_bMin, double in_bMax,
+                        double in_delta) -> std::optional<std::pair<double, double>> {
+        constexpr double infinity = std::numeric_limits<double>::infinity();
+        if (in_delta > 0.0) {
+            return std::make_pair((in_bMin - in_aMax) / in_delta, (in_bMax - in_aMin) / in_delta);
+        }
+        if (in_delta < 0.0) {
+            return std::make_pair((in_bMax - in_aMin) / in_delta, (in_bMin - in_aMax) / in_delta);
+        }
+        // not moving on this axis so it must already overlap
+        if (in_aMin < in_bMax && in_aMax > in_bMin) {
+            return std::make_pair(-infinity, infinity);
+        }
+        return std::nullopt;
+    };
+
+    const auto xTimes = axisTimes(a.x, a.x + a.width, b.x, b.x + b.width, dx);
+    const auto yTimes = axisTimes(a.y, a.y + a.height, b.y, b.y + b.height, dy);
+    if (!xTimes || !yTimes) {
+        return std::nullopt;
+    }
+
+    const double entry = std::max(xTimes->first, yTimes->first);
+    const double exit = std::min(xTimes->second, yTimes->second);
+
+    if (entry >= exit || entry > 1.0 || entry < 0.0) {
+        return std::nullopt;
+    }
+
+    SweptBoxCollision sweptCollision;
+    sweptCollision.timeOfImpact = entry;
+
+    BoxCollision& boxCollision = sweptCollision.collision;
+    const Rectangle aAtImpact{a.x + dx * entry, a.y + dy * entry, a.width, a.height};
+    const Point centerB{b.x + (b.width / 2.0), b.y + (b.height / 2.0)};
+
+    if (xTimes->first > yTimes->first) {
+        boxCollision.collisionType = dx > 0.0 ? CollisionType::COLLISION_RIGHT : CollisionType::COLLISION_LEFT;
+        boxCollision.collisionNormal = Vector{dx > 0.0 ? 1.0 : -1.0};
+        boxCollision.representativePoint.x = dx > 0.0 ? aAtImpact.x + aAtImpact.width : aAtImpact.x;
+        boxCollision.representativePoint.y = std::clamp(centerB.y, aAtImpact.y, aAtImpact.y + aAtImpact.height);
+    }
+    else {
+        boxCollision.collisionType = dy > 0.0 ? CollisionType::COLLISION_TOP : CollisionType::COLLISION_BOTTOM;
+        boxCollision.collisionNormal = Vector{0.0, dy > 0.0 ? 1.0 : -1.0};
+        boxCollision.representativePoint.y = dy > 0.0 ? aAtImpact.y + aAtImpact.height : aAtImpact.y;
+        boxCollision.representativePoint.x = std::clamp(centerB.x, aAtImpact.x, aAtImpact.x + aAtImpact.width);
+    }
+
+    return sweptCollision;
+}
+
+namespace {
+
+//! The axes to test a box and a segment on and how many of them there are.
+std::pair<std::array<std::pair<double, double>, 3>, std::size_t> separatingAxes(const Segment& in_segment)
+{
+    const double dx = in_segment.end.x - in_segment.start.x;
+    const double dy = in_segment.end.y - in_segment.start.y;
+    const double length = std::sqrt(dx * dx + dy * dy);
+
+    std::array<std::pair<double, double>, 3> axes{std::make_pair(1.0, 0.0), std::make_pair(0.0, 1.0)};
+    std::size_t axisCount = 2;
+    if (length > 0.0 && dx != 0.0 && dy != 0.0) {
+        // axis aligned segments are already covered by the box's axes
+        axes[axisCount++] = std::make_pair(-dy / length, dx / length);
+    }
+
+    return {axes, axisCount};
+}
+
+//! The side of a box a normal points out of, by its larger component.
+CollisionType sideFromNormal(double in_x, double in_y)
+{
+    if (std::abs(in_x) >= std::abs(in_y)) {
+        return in_x > 0.0 ? CollisionType::COLLISION_RIGHT : CollisionType::COLLISION_LEFT;
+    }
+    return in_y > 0.0 ? CollisionType::COLLISION_TOP : CollisionType::COLLISION_BOTTOM;
+}
+
+//! The point on a segment closest to the centre of a box.
+Point closestPointOnSegment(const Segment& in_segment, const Rectangle& in_box)
+{
+    const double dx = in_segment.end.x - in_segment.start.x;
+    const double dy = in_segment.end.y - in_segment.start.y;
+    const double lengthSquared = dx * dx + dy * dy;
+    const Point centre{in_box.x + in_box.width / 2.0, in_box.y + in_box.height / 2.0};
+
+    double t = 0.0;
+    if (lengthSquared > 0.0) {
+        t = std::clamp(((centre.x - in_segment.start.x) * dx + (centre.y - in_segment.start.y) * dy) / lengthSquared,
+                       0.0, 1.0);
+    }
+    return Point{in_segment.start.x + t * dx, in_segment.start.y + t * dy};
+}
+
+}  // namespace
+
+//! Detects if a box overlaps a line segment.
+/**
+ Uses the separating axis test on the box's axes and the segment's normal, so
+ diagonal segments are exact rather than approximated by their bounds.
+ \param a
+   The box.
+ \param in_segment
+   The segment.
+ \return
+   The side of a that was hit, the normal and how deep the segment is inside
+   a, or nullopt if they don't overlap.  Touching isn't an overlap.
+*/
+std::optional<SegmentCollision> detectBoxSegmentCollision(const Rectangle& a, const Segment& in_segment)
+{
+    const auto axes = separatingAxes(in_segment);
+
+    double minPenetration = std::numeric_limits<double>::infinity();
+    std::pair<double, double> normal{0.0, 0.0};
+
+    for (std::size_t i = 0; i < axes.second; i++) {
+        const auto [nx, ny] = axes.first[i];
+
+        const double boxCentre = nx * (a.x + a.width / 2.0) + ny * (a.y + a.height / 2.0);
+        const double boxRadius = (std::abs(nx) * a.width + std::abs(ny) * a.height) / 2.0;
+        const double boxMin = boxCentre - boxRadius;
+        const double boxMax = boxCentre + boxRadius;
+
+        const double start = nx * in_segment.start.x + ny * in_segment.start.y;
+        const double end = nx * in_segment.end.x + ny * in_segment.end.y;
+        const double segmentMin = std::min(start, end);
+        const double segmentMax = std::max(start, end);
+
+        if (boxMax <= segmentMin || segmentMax <= boxMin) {
+            return std::nullopt;
+        }
+
+        // the box can leave by moving either way along the axis
+        const double towards = boxMax - segmentMin;
+        const double away = segmentMax - boxMin;
+        if (towards < minPenetration) {
+            minPenetration = towards;
+            normal = {nx, ny};
+        }
+        if (away < minPenetration) {
+            minPenetration = away;
+            normal = {-nx, -ny};
+        }
+    }
+
+    SegmentCollision collision;
+    collision.collisionType = sideFromNormal(normal.first, normal.second);
+    collision.collisionNormal = Vector{normal.first, normal.second};
+    collision.penetration = minPenetration;
+    collision.representativePoint = closestPointOnSegment(in_segment, a);
+
+    return collision;
+}
+
+//! Finds when a moving box first hits a line segment.
+/**
+ The swept version of detectBoxSegmentCollision.  A box with no size is a
+ ray, for which the representative point is where it crosses the segment.
+ \param a
+   The moving box at the start of the timestep.
+ \param in_velocity
+   The velocity of a in units per second.
+ \param in_timestepMs
+   The timestep in milliseconds.
+ \param in_segment
+   The stationary segment.
+ \return
+   The time of impact and the side of a that hits the segment, or nullopt if
+   they don't touch during the timestep or already overlap.
+*/
+std::optional<SweptBoxCollision> detectSweptBoxSegmentCollision(const Rectangle& a, const Vector& in_velocity,
+                                                                double in_timestepMs, const Segment& in_segment)
+{
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    const double moveX = in_velocity.getX() * (in_timestepMs / 1000.0);
+    const double moveY = in_velocity.getY() * (in_timestepMs / 1000.0);
+    const auto axes = separatingAxes(in_segment);
+
+    double entry = -infinity;
+    double exit = infinity;
+    std::pair<double, double> normal{0.0, 0.0};
+
+    for (std::size_t i = 0; i < axes.second; i++) {
+        const auto [nx, ny] = axes.first[i];
+
+        const double boxCentre = nx * (a.x + a.width / 2.0) + ny * (a.y + a.height / 2.0);
+        const double boxRadius = (std::abs(nx) * a.width + std::abs(ny) * a.height) / 2.0;
+        const double start = nx * in_segment.start.x + ny * in_segment.start.y;
+        const double end = nx * in_segment.end.x + ny * in_segment.end.y;
+        const double segmentMin = std::min(start, end);
+        const double segmentMax = std::max(start, end);
+        const double move = nx * moveX + ny * moveY;
+
+        double axisEntry = -infinity;
+        double axisExit = infinity;
+        if (move > 0.0) {
+            axisEntry = (segmentMin - (boxCentre + boxRadius)) / move;
+            axisExit = (segmentMax - (boxCentre - boxRadius)) / move;
+        }
+        else if (move < 0.0) {
+            axisEntry = (segmentMax - (boxCentre - boxRadius)) / move;
+            axisExit = (segmentMin - (boxCentre + boxRadius)) / move;
+        }
+        else if (boxCentre + boxRadius < segmentMin || segmentMax < boxCentre - boxRadius) {
+            // not moving on this axis and apart on it
+            return std::nullopt;
+        }
+
+        if (axisEntry > entry) {
+            entry = axisEntry;
+            normal = move > 0.0 ? std::make_pair(nx, ny) : std::make_pair(-nx, -ny);
+        }
+        exit = std::min(exit, axisExit);
+    }
+
+    if (entry > exit || entry > 1.0 || entry < 0.0) {
+        return std::nullopt;
+    }
+
+    SweptBoxCollision sweptCollision;
+    sweptCollision.timeOfImpact = entry;
+
+    BoxCollision& boxCollision = sweptCollision.collision;
+    const Rectangle aAtImpact{a.x + moveX * entry, a.y + moveY * entry, a.width, a.height};
+    boxCollision.collisionType = sideFromNormal(normal.first, normal.second);
+    boxCollision.collisionNormal = Vector{normal.first, normal.second};
+    boxCollision.representativePoint = closestPointOnSegment(in_segment, aAtImpact);
+
+    return sweptCollision;
 }
 
 //! Detects if a rectangle is outside another (interior) rectangle.
@@ -568,30 +908,47 @@ bool detectLeftBitmapCollision(const CapEngine::Rectangle& rect, const Surface*
 std::vector<std::pair<CollisionType, Vector>> detectBitmapCollision(const CapEngine::Rectangle& rect,
                                                                     const Surface* bitmapSurface)
 {
-    std::vector<std::pair<CollisionType, Vector>> collisionTypes;
+    std::pmr::vector<std::pair<CollisionType, Vector>> collisionTypes{std::pmr::new_delete_resource()};
+    detectBitmapCollision(rect, bitmapSurface, collisionTypes);
+
+    return {collisionTypes.begin(), collisionTypes.end()};
+}
+
+//! Detects bitmap collision for a rectangle into a caller supplied buffer.
+/**
+ \param rect
+   The rectangle to check.
+ \param bitmapSurface
+   The bitmap surface.
+ \param out_collisions
+   Receives the collision types and points.  It is cleared first.
+*/
+// assumes 32bpp surface
+void detectBitmapCollision(const CapEngine::Rectangle& rect, const Surface* bitmapSurface,
+                           std::pmr::vector<std::pair<CollisionType, Vector>>& out_collisions)
+{
+    out_collisions.clear();
     Vector collisionPoint;
 
     // check top collision
     if (detectTopBitmapCollision(rect, bitmapSurface, collisionPoint)) {
-        collisionTypes.push_back(std::make_pair(COLLISION_TOP, collisionPoint));
+        out_collisions.emplace_back(COLLISION_TOP, collisionPoint);
     }
 
     // check bottom collision
     if (detectBottomBitmapCollision(rect, bitmapSurface, collisionPoint)) {
-        collisionTypes.push_back(std::make_pair(COLLISION_BOTTOM, collisionPoint));
+        out_collisions.emplace_back(COLLISION_BOTTOM, collisionPoint);
     }
 
     // check left side collition
     if (detectLeftBitmapCollision(rect, bitmapSurface, collisionPoint)) {
-        collisionTypes.push_back(std::make_pair(COLLISION_LEFT, collisionPoint));
+        out_collisions.emplace_back(COLLISION_LEFT, collisionPoint);
     }
 
     // check left side collition
     if (detectRightBitmapCollision(rect, bitmapSurface, collisionPoint)) {
-        collisionTypes.push_back(std::make_pair(COLLISION_RIGHT, collisionPoint));
+        out_collisions.emplace_back(COLLISION_RIGHT, collisionPoint);
     }
-
-    return collisionTypes;
 }
 
 //! Detects bitmap collisions for a rectangle.
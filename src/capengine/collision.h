@@ -3,6 +3,8 @@
 
 #include <SDL2/SDL_keycode.h>
 
+#include <array>
+#include <memory_resource>
 #include <optional>
 #include <vector>
 
@@ -77,6 +79,55 @@ struct BoxCollision {
     Point representativePoint;
 };
 
+//! A collision found by sweeping a moving box.
+struct SweptBoxCollision {
+    //! The fraction of the timestep, from 0 to 1, at which the boxes first touch.
+    double timeOfImpact;
+    //! The side of the moving box that was hit and where.
+    BoxCollision collision;
+};
+
+//! The contact between two overlapping boxes.
+struct ContactManifold {
+    //! The side of the first box that was hit.
+    CollisionType collisionType;
+    //! A normal vector for the collision, like BoxCollision::collisionNormal.
+    Vector collisionNormal;
+    //! How far the boxes overlap along the normal.
+    double penetration;
+    //! The ends of where the touching faces overlap, on the first box's face.
+    std::array<Point, 2> points;
+    //! The number of points used, 1 if the faces only meet at a corner.
+    std::size_t pointCount;
+};
+
+//! Where a contact is in its lifetime.
+enum class ContactPhase {
+    Enter,  //!< The objects started touching this frame.
+    Stay,   //!< The objects were already touching.
+    Exit    //!< The objects stopped touching, or one of them was removed.
+};
+
+//! A line segment, used for vector collision geometry.
+struct Segment {
+    Point start;
+    Point end;
+
+    bool operator==(const Segment&) const = default;
+};
+
+//! A box overlapping a segment.
+struct SegmentCollision {
+    //! The side of the box that was hit.
+    CollisionType collisionType;
+    //! Unit normal pointing from the box towards the segment, like BoxCollision::collisionNormal.
+    Vector collisionNormal;
+    //! How far the box must move against the normal to stop overlapping.
+    double penetration;
+    //! The point on the segment closest to the centre of the box.
+    Point representativePoint;
+};
+
 //! structure reprenting a collision via bitmap detection
 struct PixelCollision {
     CollisionType collisionType;
@@ -92,10 +143,14 @@ std::optional<BoxCollision> detectBoxCollision(
     const Rectangle& a, const Rectangle& b,
     RepresentativePointMethod in_representativePointMethod = RepresentativePointMethod::Simple,
     bool preferLeftRight = true);
-std::optional<BoxCollision> detectBoxCollisionWithContactManifold(
-    const Rectangle& a, const Rectangle& b,
-    RepresentativePointMethod in_representativePointMethod = RepresentativePointMethod::Simple,
-    bool preferLeftRight = true);
+std::optional<ContactManifold> detectBoxCollisionWithContactManifold(const Rectangle& a, const Rectangle& b,
+                                                                     bool preferLeftRight = true);
+ContactManifold reversed(const ContactManifold& in_manifold);
+std::optional<SweptBoxCollision> detectSweptBoxCollision(const Rectangle& a, const Vector& in_velocity,
+                                                         double in_timestepMs, const Rectangle& b);
+std::optional<SegmentCollision> detectBoxSegmentCollision(const Rectangle& a, const Segment& in_segment);
+std::optional<SweptBoxCollision> detectSweptBoxSegmentCollision(const Rectangle& a, const Vector& in_velocity,
+                                                                double in_timestepMs, const Segment& in_segment);
 CollisionType detectMBRCollisionInterior(const Rectangle& r1, const Rectangle& r2);
 Relation MBRRelate(const Rectangle& r1, const Rectangle& r2);
 Relation MBRRelate(int x, int y, const Rectangle& r);
@@ -103,6 +158,8 @@ Relation MBRRelate(int x, int y, const Rectangle& r);
 // bitmap collisions
 std::vector<std::pair<CollisionType, Vector>> detectBitmapCollision(const Rectangle& rect,
                                                                     const Surface* bitmapSurface);
+void detectBitmapCollision(const Rectangle& rect, const Surface* bitmapSurface,
+                           std::pmr::vector<std::pair<CollisionType, Vector>>& out_collisions);
 std::vector<PixelCollision> detectBitmapCollisions(const Rectangle& rect, const Surface* bitmapSurface);
 std::vector<PixelCollision> detectBitmapCollisions(std::vector<std::pair<CollisionType, Rectangle>> const& in_rects,
                                                    const Surface* in_bitmapSurface);
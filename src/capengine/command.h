@@ -1,6 +1,8 @@
 #ifndef CAPENGINE_COMMAND_H
 #define CAPENGINE_COMMAND_H
 
+#include <cstddef>
+
 namespace CapEngine
 {
 
@@ -12,6 +14,8 @@ public:
 
   virtual void execute() = 0;
   virtual void unExecute(){};
+  virtual std::size_t byteSize() const { return sizeof(*this); }
+  virtual bool merge(Command & /*next*/) { return false; }
 };
 } // namespace CapEngine
 
@@ -27,4 +31,24 @@ public:
    Unexecutes a command.
 */
 
+/**
+ \fn Command::byteSize()
+ \brief
+   Gets roughly how much memory the command holds, which CommandManager
+   limits the undo history by.
+ \return
+   \li The size in bytes.
+*/
+
+/**
+ \fn Command::merge(Command &next)
+ \brief
+   Tries to merge the command run straight after this one into it, so they
+   are undone as one.
+ \param next
+   \li The command, which has already been executed.
+ \return
+   \li true if it was merged and can be discarded.
+*/
+
 #endif // CAPENGINE_COMMAND_H
@@ -1,27 +1,58 @@
 #include "commandmanager.h"
 
+#include "CapEngineException.h"
+
 namespace CapEngine
 {
 
+//! Constructor
+/**
+ \param maxBytes
+   \li The most memory the undo history can hold.
+*/
+CommandManager::CommandManager(std::size_t maxBytes) : m_maxBytes(maxBytes) {}
+
 //! execute a command
 /**
+ The redo history is dropped.  If the last command can merge the new one, they
+ become a single entry in the undo history.
  \param pCommand
    \li The command to execute.
 */
 void CommandManager::runCommand(std::unique_ptr<Command> pCommand)
 {
+  CAP_THROW_NULL(pCommand, "Null command");
+
   pCommand->execute();
-  m_undoStack.push(std::move(pCommand));
+
+  for (auto &&pRedoCommand : m_redoStack) {
+    m_bytes -= pRedoCommand->byteSize();
+  }
+  m_redoStack.clear();
+
+  if (!m_undoStack.empty()) {
+    Command &last = *m_undoStack.back();
+    const std::size_t lastBytes = last.byteSize();
+    if (last.merge(*pCommand)) {
+      m_bytes = m_bytes - lastBytes + last.byteSize();
+      this->trim();
+      return;
+    }
+  }
+
+  m_bytes += pCommand->byteSize();
+  m_undoStack.push_back(std::move(pCommand));
+  this->trim();
 }
 
 //! Undo the previous command.
 void CommandManager::undo()
 {
   if (m_undoStack.size() > 0) {
-    std::unique_ptr<Command> pCommand = std::move(m_undoStack.top());
-    m_undoStack.pop();
+    std::unique_ptr<Command> pCommand = std::move(m_undoStack.back());
+    m_undoStack.pop_back();
     pCommand->unExecute();
-    m_redoStack.push(std::move(pCommand));
+    m_redoStack.push_back(std::move(pCommand));
   }
 }
 
@@ -29,10 +60,70 @@ void CommandManager::undo()
 void CommandManager::redo()
 {
   if (m_redoStack.size() > 0) {
-    std::unique_ptr<Command> pCommand = std::move(m_redoStack.top());
-    m_redoStack.pop();
+    std::unique_ptr<Command> pCommand = std::move(m_redoStack.back());
+    m_redoStack.pop_back();
     pCommand->execute();
-    m_undoStack.push(std::move(pCommand));
+    m_undoStack.push_back(std::move(pCommand));
+  }
+}
+
+//! Sets the most memory the history can hold.
+/**
+ \param maxBytes
+   \li The size in bytes.  Older commands are dropped to fit.
+*/
+void CommandManager::setMaxBytes(std::size_t maxBytes)
+{
+  m_maxBytes = maxBytes;
+  this->trim();
+}
+
+//! Gets the most memory the history can hold.
+/**
+ \return
+   \li The size in bytes.
+*/
+std::size_t CommandManager::getMaxBytes() const { return m_maxBytes; }
+
+//! Gets the memory the history holds.
+/**
+ \return
+   \li The size in bytes.
+*/
+std::size_t CommandManager::getBytes() const { return m_bytes; }
+
+//! Gets the number of commands that can be undone.
+/**
+ \return
+   \li The number of commands.
+*/
+std::size_t CommandManager::getUndoCount() const { return m_undoStack.size(); }
+
+//! Gets the number of commands that can be redone.
+/**
+ \return
+   \li The number of commands.
+*/
+std::size_t CommandManager::getRedoCount() const { return m_redoStack.size(); }
+
+//! Drops the oldest history until it fits in the limit.
+/**
+ The last command run is kept even if it alone is over the limit, so it can
+ always be undone.
+*/
+void CommandManager::trim()
+{
+  // the oldest undo is the furthest from the present.
+  while (m_bytes > m_maxBytes && m_undoStack.size() > 1) {
+    m_bytes -= m_undoStack.front()->byteSize();
+    m_undoStack.pop_front();
+  }
+
+  // then the redo furthest from it.
+  while (m_bytes > m_maxBytes && !m_redoStack.empty() &&
+         m_undoStack.size() + m_redoStack.size() > 1) {
+    m_bytes -= m_redoStack.front()->byteSize();
+    m_redoStack.pop_front();
   }
 }
 
@@ -3,24 +3,46 @@
 
 #include "command.h"
 
+#include <cstddef>
+#include <deque>
 #include <memory>
-#include <stack>
 
 namespace CapEngine
 {
 
+//! Runs commands and keeps their history for undo and redo.
+/**
+   The history is limited to a number of bytes, as reported by
+   Command::byteSize().  The oldest commands are dropped to stay under it.
+*/
 class CommandManager
 {
 public:
+  static constexpr std::size_t kDefaultMaxBytes = 64 * 1024 * 1024;
+
+  explicit CommandManager(std::size_t maxBytes = kDefaultMaxBytes);
+
   void runCommand(std::unique_ptr<Command> pCommand);
   void undo();
   void redo();
 
+  void setMaxBytes(std::size_t maxBytes);
+  std::size_t getMaxBytes() const;
+  std::size_t getBytes() const;
+  std::size_t getUndoCount() const;
+  std::size_t getRedoCount() const;
+
 private:
-  //! The stack of redo commands
-  std::stack<std::unique_ptr<Command>> m_redoStack;
-  //! the stack of undo commands
-  std::stack<std::unique_ptr<Command>> m_undoStack;
+  void trim();
+
+  //! The most bytes of history to keep
+  std::size_t m_maxBytes;
+  //! The bytes held by both stacks
+  std::size_t m_bytes = 0;
+  //! The stack of redo commands, the next to redo at the back
+  std::deque<std::unique_ptr<Command>> m_redoStack;
+  //! the stack of undo commands, the next to undo at the back
+  std::deque<std::unique_ptr<Command>> m_undoStack;
 };
 
 } // namespace CapEngine
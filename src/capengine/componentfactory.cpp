@@ -39,14 +39,33 @@ std::unique_ptr<Component>
     const std::string subtype =
         in_json[Schema::Components::kComponentSubType].as<std::string>();
 
-    auto &&f = m_factoryFunctions.find(std::make_pair(type, subtype));
-    if (f == m_factoryFunctions.end()) {
+    std::optional<TypeId> typeId = this->findComponentType(type, subtype);
+    if (!typeId) {
         throw ComponentCreationException(
             type, subtype, in_json,
             std::string("No factory method registered for component type"));
     }
 
-    std::unique_ptr<Component> pComponent = f->second(in_json);
+    return this->makeComponent(*typeId, in_json);
+}
+
+//! The factory method for a type that has already been looked up.
+/**
+ \param in_typeId
+   The type, from findComponentType().
+ \param in_json
+   The json describing the component to create.
+ \return
+   The component.
+*/
+std::unique_ptr<Component>
+    ComponentFactory::makeComponent(TypeId in_typeId,
+                                    const jsoncons::json &in_json)
+{
+    CAP_THROW_ASSERT(in_typeId < m_factoryFunctions.size(),
+                     "Unknown component type id");
+    std::unique_ptr<Component> pComponent =
+        m_factoryFunctions[in_typeId](in_json);
 
     // check for metadata
     if (in_json.contains(Schema::Scene2d::kMetadata)) {
@@ -62,6 +81,27 @@ std::unique_ptr<Component>
     return pComponent;
 }
 
+//! Looks up a component type.
+/**
+ \param in_type
+   The type.
+ \param in_subtype
+   The subtype.
+ \return
+   Its id, or nullopt if it isn't registered.
+*/
+std::optional<ComponentFactory::TypeId>
+    ComponentFactory::findComponentType(const std::string &in_type,
+                                        const std::string &in_subtype) const
+{
+    auto &&typeId = m_typeIds.find(std::make_pair(in_type, in_subtype));
+    if (typeId == m_typeIds.end()) {
+        return std::nullopt;
+    }
+
+    return typeId->second;
+}
+
 //! Register a new type of component that can be created.
 /**
  \param in_type
@@ -74,8 +114,9 @@ void ComponentFactory::registerComponentType(const std::string &in_type,
                                              factoryfunc_t in_factoryFunction)
 {
     auto key = std::make_pair(in_type, in_subtype);
-    if (m_factoryFunctions.find(key) == m_factoryFunctions.end()) {
-        m_factoryFunctions.emplace(key, std::move(in_factoryFunction));
+    if (m_typeIds.find(key) == m_typeIds.end()) {
+        m_typeIds.emplace(key, m_factoryFunctions.size());
+        m_factoryFunctions.push_back(std::move(in_factoryFunction));
     } else {
         throw CapEngineException("The component type \"" + in_type +
                                  "\" is already registered");
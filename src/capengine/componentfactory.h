@@ -4,9 +4,12 @@
 #include "CapEngineException.h"
 #include "componentutils.h"
 
+#include <cstddef>
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include <jsoncons/json.hpp>
 
@@ -49,6 +52,8 @@ class ComponentFactory final
 public:
   using factoryfunc_t =
       std::function<std::unique_ptr<Component>(const jsoncons::json &)>;
+  //! Index of a registered component type, valid for the life of the process.
+  using TypeId = std::size_t;
 
 public:
   ComponentFactory(const ComponentFactory &) = delete;
@@ -56,6 +61,11 @@ public:
   static ComponentFactory &getInstance();
 
   std::unique_ptr<Component> makeComponent(const jsoncons::json &in_json);
+  std::unique_ptr<Component> makeComponent(TypeId in_typeId,
+                                           const jsoncons::json &in_json);
+  [[nodiscard]] std::optional<TypeId>
+      findComponentType(const std::string &in_type,
+                        const std::string &in_subtype) const;
   void registerComponentType(const std::string &in_type,
                              const std::string &in_subtype,
                              factoryfunc_t in_factoryFunction);
@@ -63,9 +73,10 @@ public:
 private:
   ComponentFactory() = default;
 
-  //! map of the factory functions
-  std::map<std::pair<std::string, std::string>, factoryfunc_t>
-      m_factoryFunctions;
+  //! the factory functions, indexed by TypeId
+  std::vector<factoryfunc_t> m_factoryFunctions;
+  //! map of type and subtype to TypeId
+  std::map<std::pair<std::string, std::string>, TypeId> m_typeIds;
 };
 
 } // namespace CapEngine
@@ -1,5 +1,6 @@
 #include "components.h"
 
+#include <algorithm>
 #include <string>
 
 namespace CapEngine
@@ -7,10 +8,50 @@ namespace CapEngine
 
 Component::Metadata const &Component::metadata() const { return m_metadata; }
 
-void Component::setMetadata(const std::string &in_key,
+void Component::setMetadata(std::string_view in_key,
                             const MetadataType &in_value)
 {
-    m_metadata[in_key] = in_value;
+    m_metadata.set(in_key, in_value);
+}
+
+void Component::setMetadata(StringId in_key, const MetadataType &in_value)
+{
+    m_metadata.set(in_key, in_value);
+}
+
+//! Subscribes to a kind of message.
+/**
+ \param in_messageId
+   The message id.
+*/
+void Component::subscribe(MessageId in_messageId)
+{
+    if (!this->isSubscribed(in_messageId)) {
+        m_subscriptions.push_back(in_messageId);
+    }
+}
+
+//! Unsubscribes from a kind of message.
+/**
+ \param in_messageId
+   The message id.
+*/
+void Component::unsubscribe(MessageId in_messageId)
+{
+    std::erase(m_subscriptions, in_messageId);
+}
+
+//! Checks if subscribed to a kind of message.
+/**
+ \param in_messageId
+   The message id.
+ \return
+   true if subscribed, false otherwise.
+*/
+bool Component::isSubscribed(MessageId in_messageId) const
+{
+    return std::ranges::find(m_subscriptions, in_messageId) !=
+           m_subscriptions.end();
 }
 
 } // namespace CapEngine
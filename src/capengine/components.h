@@ -4,9 +4,14 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "camera2d.h"
 #include "captypes.h"
+#include "collision.h"
+#include "message.h"
+#include "metadata.h"
+#include "serialization.h"
 
 namespace CapEngine {
 class GameObject;
@@ -23,20 +28,56 @@ class Component {
     virtual void receive(GameObject& /*object*/, int /*messageId*/, const std::string& /*message*/)
     {
     }
+    virtual void receive(GameObject& /*object*/, const Message& /*message*/)
+    {
+    }
     [[nodiscard]] virtual ComponentType getType() const = 0;
 
     [[nodiscard]] virtual std::unique_ptr<Component> clone() const = 0;
+    virtual bool assign(const Component& /*in_other*/)
+    {
+        return false;
+    }
+    virtual void serialize(ByteWriter& /*out_writer*/) const {}
+    virtual void deserialize(ByteReader& /*in_reader*/) {}
 
     //! Metadata collection type
-    using Metadata = std::map<std::string, MetadataType>;
+    using Metadata = MetadataMap;
 
     [[nodiscard]] Metadata const& metadata() const;
-    void setMetadata(const std::string& in_key, const MetadataType& in_value);
+    void setMetadata(std::string_view in_key, const MetadataType& in_value);
+    void setMetadata(StringId in_key, const MetadataType& in_value);
+
+    void subscribe(MessageId in_messageId);
+    void unsubscribe(MessageId in_messageId);
+    [[nodiscard]] bool isSubscribed(MessageId in_messageId) const;
 
    protected:
     Metadata m_metadata;  //!< Holds metadata about the component.
+    std::vector<MessageId> m_subscriptions;  //!< The messages passed to receive(GameObject&, const Message&).
 };
 
+//! Helper for implementing Component::assign with a type's copy assignment.
+/**
+ \param io_component
+   The component to assign to.
+ \param in_other
+   The component to copy from.
+ \return
+   true if in_other is a T and was copied, false otherwise.
+*/
+template <typename T>
+bool assignComponent(T& io_component, const Component& in_other)
+{
+    const auto* pOther = dynamic_cast<const T*>(&in_other);
+    if (pOther == nullptr) {
+        return false;
+    }
+
+    io_component = *pOther;
+    return true;
+}
+
 //! Interface class for physics components
 class PhysicsComponent : public Component {
    public:
@@ -51,6 +92,10 @@ class PhysicsComponent : public Component {
     {
         return false;
     }
+    virtual void handleContact(ContactPhase /*in_phase*/, GameObject& /*in_object*/, GameObject* /*in_pOtherObject*/,
+                               const ContactManifold& /*in_manifold*/)
+    {
+    }
     [[nodiscard]] virtual CollisionType collides([[maybe_unused]] CapEngine::Rectangle const& in_mbr) const
     {
         return CollisionType::COLLISION_NONE;
@@ -102,6 +147,52 @@ class AIComponent : public Component {
     }
 };
 
+/**
+   \fn Component::receive(GameObject&, const Message&)
+   \brief Handles a message the component is subscribed to.
+   Called by MessageBus::dispatch() after the update phase.
+   \param object The object the component belongs to.
+   \param message The message.
+ */
+
+/**
+   \fn PhysicsComponent::handleContact
+   \brief Tells the component about a contact with another object.
+   Scene2d calls this with ContactPhase::Enter on the frame two objects start
+   touching, ContactPhase::Stay on each frame after, and ContactPhase::Exit
+   once they separate.  handleCollision() is only called on enter.
+   \param in_phase Where the contact is in its lifetime.
+   \param in_object The object the component belongs to.
+   \param in_pOtherObject The other object, or nullptr if it was removed.
+   \param in_manifold The contact from in_object's point of view.  On exit
+   it is the last one seen.
+ */
+
+/**
+   \fn Component::serialize
+   \brief Writes the simulation state of the component for a snapshot.
+   Components with state that changes during update() override this and
+   deserialize() so that SnapshotBuffer can roll them back.  The default
+   writes nothing.
+   \param out_writer The writer to append to.
+ */
+
+/**
+   \fn Component::deserialize
+   \brief Restores state written by serialize().
+   \param in_reader The reader positioned at this component's state.
+ */
+
+/**
+   \fn Component::assign
+   \brief Restores this component to the state of another component.
+   Used by ObjectPool to recycle components in place rather than cloning new
+   ones.  Components that don't override this are re-cloned instead.
+   \param in_other The component to copy state from.
+   \return true if the state was copied, false if it is not supported or
+   in_other is a different type.
+ */
+
 }  // namespace CapEngine
 
 #endif // COMPONENTS_H
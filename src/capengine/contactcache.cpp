@@ -0,0 +1,114 @@
+#include "contactcache.h"
+
+#include <utility>
+
+namespace CapEngine {
+
+//! Starts a frame.  Pairs not touched before endFrame() have stopped touching.
+void ContactCache::beginFrame()
+{
+    m_frame++;
+}
+
+//! Records that a pair of objects is touching this frame.
+/**
+ If the pair was already touching and still touches on the same side, the
+ impulses from the last frame are kept for warm starting.
+ \param in_objectId1
+   One of the objects.
+ \param in_objectId2
+   The other object.
+ \param in_manifold
+   The contact from in_objectId1's point of view.
+ \return
+   ContactPhase::Enter if the pair just started touching, ContactPhase::Stay
+   if it already was.
+*/
+ContactPhase ContactCache::touch(ObjectID in_objectId1, ObjectID in_objectId2, const ContactManifold& in_manifold)
+{
+    const Key key = makeKey(in_objectId1, in_objectId2);
+    const ContactManifold manifold = key.first == in_objectId1 ? in_manifold : reversed(in_manifold);
+
+    auto [it, inserted] = m_contacts.try_emplace(key);
+    Contact& contact = it->second;
+
+    // the impulses of a pair now touching on another side don't apply
+    if (inserted || contact.manifold.collisionType != manifold.collisionType) {
+        contact.normalImpulses = {};
+    }
+
+    contact.object1 = key.first;
+    contact.object2 = key.second;
+    contact.manifold = manifold;
+    contact.frame = m_frame;
+
+    return inserted ? ContactPhase::Enter : ContactPhase::Stay;
+}
+
+//! Finishes a frame, forgetting pairs that weren't touched.
+/**
+ \param in_onExit
+   Called with each pair that stopped touching, before it is forgotten.
+*/
+void ContactCache::endFrame(FunctionRef<void(const Contact&)> in_onExit)
+{
+    for (auto it = m_contacts.begin(); it != m_contacts.end();) {
+        if (it->second.frame != m_frame) {
+            in_onExit(it->second);
+            it = m_contacts.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+//! Forgets every pair without reporting them.
+void ContactCache::clear()
+{
+    m_contacts.clear();
+}
+
+//! Finds the contact between two objects.
+/**
+ \param in_objectId1
+   One of the objects.
+ \param in_objectId2
+   The other object.
+ \return
+   The contact, or nullptr if they aren't touching.
+*/
+Contact* ContactCache::find(ObjectID in_objectId1, ObjectID in_objectId2)
+{
+    auto it = m_contacts.find(makeKey(in_objectId1, in_objectId2));
+    return it != m_contacts.end() ? &it->second : nullptr;
+}
+
+//! \copydoc ContactCache::find
+const Contact* ContactCache::find(ObjectID in_objectId1, ObjectID in_objectId2) const
+{
+    auto it = m_contacts.find(makeKey(in_objectId1, in_objectId2));
+    return it != m_contacts.end() ? &it->second : nullptr;
+}
+
+//! Checks if a pair has been touched since beginFrame().
+/**
+ \param in_objectId1
+   One of the objects.
+ \param in_objectId2
+   The other object.
+ \return
+   true if touch() was called for the pair this frame.
+*/
+bool ContactCache::touchedThisFrame(ObjectID in_objectId1, ObjectID in_objectId2) const
+{
+    const Contact* pContact = this->find(in_objectId1, in_objectId2);
+    return pContact != nullptr && pContact->frame == m_frame;
+}
+
+ContactCache::Key ContactCache::makeKey(ObjectID in_objectId1, ObjectID in_objectId2)
+{
+    return in_objectId1 <= in_objectId2 ? Key{in_objectId1, in_objectId2} : Key{in_objectId2, in_objectId1};
+}
+
+}  // namespace CapEngine
@@ -0,0 +1,78 @@
+#ifndef CAPENGINE_CONTACTCACHE_H
+#define CAPENGINE_CONTACTCACHE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+#include "collision.h"
+#include "functionref.h"
+#include "gameobject.h"
+
+namespace CapEngine {
+
+//! A contact between two objects, kept for as long as they touch.
+struct Contact {
+    ObjectID object1 = -1;  //!< The object with the lower id.
+    ObjectID object2 = -1;  //!< The object with the higher id.
+    //! The latest manifold, from object1's point of view.
+    ContactManifold manifold;
+    //! Impulse a solver applied at each manifold point, kept so it can warm start from it next frame.
+    std::array<double, 2> normalImpulses{};
+    uint64_t frame = 0;  //!< The last frame the contact was seen in.
+};
+
+//! Remembers which pairs of objects are touching between frames.
+/**
+   Each frame the scene reports the pairs that touch with touch(), which says
+   whether the pair just started touching or already was.  endFrame() then
+   reports the pairs that weren't seen and forgets them.  Pairs are keyed on
+   their object ids so a contact survives the objects being moved around in
+   the ObjectManager.
+*/
+class ContactCache final {
+   public:
+    void beginFrame();
+    ContactPhase touch(ObjectID in_objectId1, ObjectID in_objectId2, const ContactManifold& in_manifold);
+    void endFrame(FunctionRef<void(const Contact&)> in_onExit);
+    void clear();
+
+    [[nodiscard]] Contact* find(ObjectID in_objectId1, ObjectID in_objectId2);
+    [[nodiscard]] const Contact* find(ObjectID in_objectId1, ObjectID in_objectId2) const;
+    [[nodiscard]] bool touchedThisFrame(ObjectID in_objectId1, ObjectID in_objectId2) const;
+    [[nodiscard]] std::size_t size() const;
+
+   private:
+    //! The ids of a pair, lower first.
+    struct Key {
+        ObjectID first;
+        ObjectID second;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& in_key) const
+        {
+            const std::size_t first = std::hash<ObjectID>{}(in_key.first);
+            return first ^ (std::hash<ObjectID>{}(in_key.second) + 0x9e3779b97f4a7c15ull + (first << 6) + (first >> 2));
+        }
+    };
+
+    static Key makeKey(ObjectID in_objectId1, ObjectID in_objectId2);
+
+    std::unordered_map<Key, Contact, KeyHash> m_contacts;  //!< The pairs that are touching.
+    uint64_t m_frame = 0;                                  //!< The current frame.
+};
+
+//! Gets the number of pairs that are touching.
+inline std::size_t ContactCache::size() const
+{
+    return m_contacts.size();
+}
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_CONTACTCACHE_H
@@ -88,6 +88,10 @@ void ControllerManager::initialize()
 
 ControllerManager::ControllerManager()
 {
+  if (SDL_InitSubSystem(SDL_INIT_GAMECONTROLLER) < 0) {
+    BOOST_THROW_EXCEPTION(CapEngineException(
+        std::string("Unable to initialize game controllers: ") + SDL_GetError()));
+  }
   IEventSubscriber::subscribe(Locator::eventDispatcher, controllerEvent);
 }
 
@@ -0,0 +1,343 @@
+#include "cookedscenes.h"
+
+#include <algorithm>
+
+#include <jsoncons_ext/cbor/cbor.hpp>
+
+#include "CapEngineException.h"
+#include "scene2dschema.h"
+#include "sectionfile.h"
+#include "serialization.h"
+
+namespace CapEngine {
+
+namespace {
+
+constexpr std::string_view kFormat = "cooked scene file";
+
+//! Throws if the file is malformed.
+void checkScenes(bool in_condition, const std::filesystem::path& in_path, std::string_view in_details)
+{
+    checkSectionFile(in_condition, kFormat, in_path, in_details);
+}
+
+}  // namespace
+
+//! Maps and validates a cooked scene file.
+/**
+ \param in_path
+   The file.  Throws CapEngineException if it can't be read or is malformed.
+*/
+CookedScenes::CookedScenes(const std::filesystem::path& in_path) : m_file(in_path)
+{
+    const auto bytes = m_file.bytes();
+    checkScenes(bytes.size() >= sizeof(CookedSceneHeader), in_path, "too small");
+
+    m_pHeader = reinterpret_cast<const CookedSceneHeader*>(bytes.data());
+    checkScenes(m_pHeader->magic == kMagic, in_path, "bad magic");
+    checkScenes(m_pHeader->version == kVersion, in_path, "unsupported version");
+    checkScenes(inTable(m_pHeader->stringsOffset, m_pHeader->stringsSize, bytes.size()), in_path,
+                "string table out of range");
+    checkScenes(inTable(m_pHeader->blobsOffset, m_pHeader->blobsSize, bytes.size()), in_path,
+                "blobs out of range");
+
+    // records() checks the tables themselves.
+    const auto types = this->types();
+    auto checkBlob = [&](const CookedBlob& in_blob) {
+        checkScenes(inTable(in_blob.offset, in_blob.size, m_pHeader->blobsSize), in_path, "blob out of range");
+    };
+    auto checkType = [&](uint32_t in_typeIndex, CookedTypeKind in_kind) {
+        checkScenes(in_typeIndex < types.size() && types[in_typeIndex].kind == in_kind, in_path, "bad type index");
+    };
+
+    for (auto&& scene : this->scenes()) {
+        checkScenes(inTable(scene.firstLayer, scene.layerCount, m_pHeader->layerCount), in_path,
+                    "scene layers out of range");
+        checkScenes(inTable(scene.firstObject, scene.objectCount, m_pHeader->objectCount), in_path,
+                    "scene objects out of range");
+        checkBlob(scene.preload);
+    }
+    for (auto&& layer : this->records<CookedLayer>(m_pHeader->layersOffset, m_pHeader->layerCount)) {
+        checkType(layer.typeIndex, CookedTypeKind::Layer);
+        checkBlob(layer.json);
+    }
+    for (auto&& object : this->records<CookedObject>(m_pHeader->objectsOffset, m_pHeader->objectCount)) {
+        checkScenes(inTable(object.firstComponent, object.componentCount, m_pHeader->componentCount), in_path,
+                    "object components out of range");
+        checkBlob(object.json);
+    }
+    for (auto&& component :
+         this->records<CookedComponent>(m_pHeader->componentsOffset, m_pHeader->componentCount)) {
+        checkType(component.typeIndex, CookedTypeKind::Component);
+        checkBlob(component.json);
+    }
+}
+
+//! Returns the layer and component types the file refers to.
+std::span<const CookedSceneType> CookedScenes::types() const
+{
+    return this->records<CookedSceneType>(m_pHeader->typesOffset, m_pHeader->typeCount);
+}
+
+//! Returns every scene.
+std::span<const CookedSceneRecord> CookedScenes::scenes() const
+{
+    return this->records<CookedSceneRecord>(m_pHeader->scenesOffset, m_pHeader->sceneCount);
+}
+
+//! Finds a scene by its id.
+/**
+ \param in_sceneId
+   The id of the scene.
+ \return
+   The scene, or nullptr if the file doesn't have it.
+*/
+const CookedSceneRecord* CookedScenes::findScene(std::string_view in_sceneId) const
+{
+    const auto scenes = this->scenes();
+    auto scene = std::ranges::find_if(
+        scenes, [&](const CookedSceneRecord& in_scene) { return this->string(in_scene.idOffset) == in_sceneId; });
+
+    return scene != scenes.end() ? &*scene : nullptr;
+}
+
+//! Returns the layers of a scene.
+std::span<const CookedLayer> CookedScenes::layers(const CookedSceneRecord& in_scene) const
+{
+    return this->records<CookedLayer>(m_pHeader->layersOffset, m_pHeader->layerCount)
+        .subspan(in_scene.firstLayer, in_scene.layerCount);
+}
+
+//! Returns the objects of a scene.
+std::span<const CookedObject> CookedScenes::objects(const CookedSceneRecord& in_scene) const
+{
+    return this->records<CookedObject>(m_pHeader->objectsOffset, m_pHeader->objectCount)
+        .subspan(in_scene.firstObject, in_scene.objectCount);
+}
+
+//! Returns the components of an object.
+std::span<const CookedComponent> CookedScenes::components(const CookedObject& in_object) const
+{
+    return this->records<CookedComponent>(m_pHeader->componentsOffset, m_pHeader->componentCount)
+        .subspan(in_object.firstComponent, in_object.componentCount);
+}
+
+//! Looks up a string in the string table.
+/**
+ \param in_offset
+   The offset of the string within the table.
+ \return
+   The string, without its terminator.
+*/
+std::string_view CookedScenes::string(uint32_t in_offset) const
+{
+    return readSectionString(m_file, kFormat, m_pHeader->stringsOffset, m_pHeader->stringsSize, in_offset);
+}
+
+//! Returns the CBOR bytes of a blob, in place in the mapping.
+std::span<const uint8_t> CookedScenes::blob(const CookedBlob& in_blob) const
+{
+    const auto bytes = m_file.bytes().subspan(m_pHeader->blobsOffset + in_blob.offset, in_blob.size);
+    return {reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size()};
+}
+
+//! Decodes a blob.
+/**
+ \param in_blob
+   The blob.
+ \return
+   The json it holds, or null json if the blob is empty.  Throws
+   jsoncons::ser_error if the blob isn't valid CBOR.
+*/
+jsoncons::json CookedScenes::decode(const CookedBlob& in_blob) const
+{
+    if (in_blob.size == 0) {
+        return jsoncons::json{jsoncons::null_type{}};
+    }
+
+    // the parser reads straight out of the mapping.
+    return jsoncons::cbor::decode_cbor<jsoncons::json>(this->blob(in_blob));
+}
+
+//! Returns the path the file was opened from.
+const std::filesystem::path& CookedScenes::path() const
+{
+    return m_file.path();
+}
+
+//! Views a table of records in the mapping.
+template <typename T>
+std::span<const T> CookedScenes::records(uint64_t in_offset, std::size_t in_count) const
+{
+    return readSection<T>(m_file, kFormat, in_offset, in_count);
+}
+
+//! Adds every scene of a scene descriptor file.
+/**
+ \param in_sceneDescriptors
+   The json with the "scenes" array Scene2dState is given.
+*/
+void CookedScenesWriter::addScenes(const jsoncons::json& in_sceneDescriptors)
+{
+    for (auto&& scene : in_sceneDescriptors[Schema::Scene2d::kScenes].array_range()) {
+        this->addScene(scene);
+    }
+}
+
+//! Adds a scene.
+/**
+ \param in_scene
+   The json of one scene, as Scene2d is given.  Throws jsoncons::ser_error if
+   a required field is missing.
+*/
+void CookedScenesWriter::addScene(const jsoncons::json& in_scene)
+{
+    using namespace Schema::Scene2d;
+
+    CookedSceneRecord scene{};
+    scene.idOffset = this->addString(in_scene[kSceneId].as<std::string>());
+    scene.width = in_scene[kWidth].as<int>();
+    scene.height = in_scene[kHeight].as<int>();
+    if (in_scene.contains(kPreload)) {
+        scene.preload = this->addBlob(in_scene[kPreload]);
+    }
+
+    scene.firstLayer = static_cast<uint32_t>(m_layers.size());
+    for (auto&& layerJson : in_scene[kLayers].array_range()) {
+        CookedLayer layer{};
+        layer.typeIndex = this->addType(CookedTypeKind::Layer, layerJson[kLayerType].as<std::string>(), "");
+        layer.order = layerJson[kLayerOrder].as<int>();
+        if (layerJson.contains(kQueryLayer)) {
+            layer.queryLayer = layerJson[kQueryLayer].as<int>();
+            layer.hasQueryLayer = 1;
+        }
+        layer.json = this->addBlob(layerJson);
+        m_layers.push_back(layer);
+    }
+    scene.layerCount = static_cast<uint32_t>(m_layers.size()) - scene.firstLayer;
+
+    scene.firstObject = static_cast<uint32_t>(m_objects.size());
+    for (auto&& objectJson : in_scene[std::string(kObjects)].array_range()) {
+        CookedObject object{};
+        object.firstComponent = static_cast<uint32_t>(m_components.size());
+        for (auto&& componentJson : objectJson[kComponents].array_range()) {
+            CookedComponent component{};
+            component.typeIndex =
+                this->addType(CookedTypeKind::Component,
+                              componentJson[Schema::Components::kComponentType].as<std::string>(),
+                              componentJson[Schema::Components::kComponentSubType].as<std::string>());
+            component.json = this->addBlob(componentJson);
+            m_components.push_back(component);
+        }
+        object.componentCount = static_cast<uint32_t>(m_components.size()) - object.firstComponent;
+
+        jsoncons::json bareObject = objectJson;
+        bareObject.erase(kComponents);
+        object.json = this->addBlob(bareObject);
+        m_objects.push_back(object);
+    }
+    scene.objectCount = static_cast<uint32_t>(m_objects.size()) - scene.firstObject;
+
+    m_scenes.push_back(scene);
+}
+
+//! Lays out the file.
+/**
+ \return
+   The bytes of the file.
+*/
+std::vector<std::byte> CookedScenesWriter::build() const
+{
+    CookedSceneHeader header{};
+    header.magic = CookedScenes::kMagic;
+    header.version = CookedScenes::kVersion;
+    header.typeCount = static_cast<uint32_t>(m_types.size());
+    header.sceneCount = static_cast<uint32_t>(m_scenes.size());
+    header.layerCount = static_cast<uint32_t>(m_layers.size());
+    header.objectCount = static_cast<uint32_t>(m_objects.size());
+    header.componentCount = static_cast<uint32_t>(m_components.size());
+    header.typesOffset = alignSection(sizeof(CookedSceneHeader));
+    header.scenesOffset = alignSection(header.typesOffset + m_types.size() * sizeof(CookedSceneType));
+    header.layersOffset = alignSection(header.scenesOffset + m_scenes.size() * sizeof(CookedSceneRecord));
+    header.objectsOffset = alignSection(header.layersOffset + m_layers.size() * sizeof(CookedLayer));
+    header.componentsOffset = alignSection(header.objectsOffset + m_objects.size() * sizeof(CookedObject));
+    header.stringsOffset = alignSection(header.componentsOffset + m_components.size() * sizeof(CookedComponent));
+    header.stringsSize = m_strings.size();
+    header.blobsOffset = alignSection(header.stringsOffset + header.stringsSize);
+    header.blobsSize = m_blobs.size();
+
+    std::vector<std::byte> buffer;
+    buffer.reserve(alignSection(header.blobsOffset + header.blobsSize));
+    ByteWriter writer{buffer};
+
+    writer.write(header);
+    padSection(buffer);
+    writeSection<CookedSceneType>(writer, buffer, m_types);
+    writeSection<CookedSceneRecord>(writer, buffer, m_scenes);
+    writeSection<CookedLayer>(writer, buffer, m_layers);
+    writeSection<CookedObject>(writer, buffer, m_objects);
+    writeSection<CookedComponent>(writer, buffer, m_components);
+    writer.writeBytes(std::as_bytes(std::span{m_strings}));
+    padSection(buffer);
+    writer.writeBytes(std::as_bytes(std::span{m_blobs}));
+    padSection(buffer);
+
+    return buffer;
+}
+
+//! Writes the file.
+/**
+ \param in_path
+   The file to write.  Throws CapEngineException on failure.
+*/
+void CookedScenesWriter::write(const std::filesystem::path& in_path) const
+{
+    writeSectionFile(in_path, kFormat, this->build());
+}
+
+//! Appends a string to the string table.
+uint32_t CookedScenesWriter::addString(const std::string& in_string)
+{
+    const auto offset = static_cast<uint32_t>(m_strings.size());
+    m_strings.insert(m_strings.end(), in_string.begin(), in_string.end());
+    m_strings.push_back('\0');
+    return offset;
+}
+
+//! Finds or adds a type in the type table.
+/**
+ \return
+   The index of the type.
+*/
+uint32_t CookedScenesWriter::addType(CookedTypeKind in_kind, const std::string& in_type,
+                                     const std::string& in_subtype)
+{
+    auto key = std::make_tuple(in_kind, in_type, in_subtype);
+    auto&& typeIndex = m_typeIndices.find(key);
+    if (typeIndex != m_typeIndices.end()) {
+        return typeIndex->second;
+    }
+
+    CookedSceneType type{};
+    type.kind = in_kind;
+    type.typeOffset = this->addString(in_type);
+    type.subtypeOffset = this->addString(in_subtype);
+
+    const auto index = static_cast<uint32_t>(m_types.size());
+    m_types.push_back(type);
+    m_typeIndices.emplace(std::move(key), index);
+    return index;
+}
+
+//! Appends the CBOR encoding of some json to the blob section.
+CookedBlob CookedScenesWriter::addBlob(const jsoncons::json& in_json)
+{
+    std::vector<uint8_t> encoded;
+    jsoncons::cbor::encode_cbor(in_json, encoded);
+
+    CookedBlob blob{m_blobs.size(), encoded.size()};
+    m_blobs.insert(m_blobs.end(), encoded.begin(), encoded.end());
+    return blob;
+}
+
+}  // namespace CapEngine
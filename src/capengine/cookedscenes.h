@@ -0,0 +1,182 @@
+#ifndef CAPENGINE_COOKEDSCENES_H
+#define CAPENGINE_COOKEDSCENES_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+
+#include "mappedfile.h"
+
+namespace CapEngine {
+
+/**
+   \file
+   Scene descriptors cooked offline by the scenecooker app, so Scene2d can be
+   loaded without parsing text json.  The json files stay the authoring format.
+
+   Layout, with every section 16 byte aligned:
+     CookedSceneHeader
+     CookedSceneType[typeCount]
+     CookedSceneRecord[sceneCount]
+     CookedLayer[layerCount]
+     CookedObject[objectCount]
+     CookedComponent[componentCount]
+     string table, nul terminated strings
+     blobs, the CBOR encoded json of each layer, object and component
+
+   Layers and components name their factory by index into the type table, so a
+   loader looks each type up once per file instead of once per record.  Objects
+   are stored without their components, which follow as CookedComponents.
+
+   Values are in native byte order, so files are cooked per platform.
+*/
+
+//! Which factory a CookedSceneType belongs to.
+enum class CookedTypeKind : uint32_t { Layer = 0, Component = 1 };
+
+//! A span of the blob section.  An empty blob means the value is absent.
+struct CookedBlob {
+    uint64_t offset;  //!< From the start of the blob section.
+    uint64_t size;
+};
+
+//! The start of a cooked scene file.
+struct CookedSceneHeader {
+    std::array<char, 4> magic;
+    uint32_t version;
+    uint32_t typeCount;
+    uint32_t sceneCount;
+    uint32_t layerCount;
+    uint32_t objectCount;
+    uint32_t componentCount;
+    uint32_t reserved;
+    uint64_t typesOffset;
+    uint64_t scenesOffset;
+    uint64_t layersOffset;
+    uint64_t objectsOffset;
+    uint64_t componentsOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    uint64_t blobsOffset;
+    uint64_t blobsSize;
+};
+
+//! A layer type or component type/subtype, in the string table.
+struct CookedSceneType {
+    CookedTypeKind kind;
+    uint32_t typeOffset;
+    uint32_t subtypeOffset;  //!< Components only.
+    uint32_t reserved;
+};
+
+//! A scene.
+struct CookedSceneRecord {
+    uint32_t idOffset;  //!< In the string table.
+    int32_t width;
+    int32_t height;
+    uint32_t firstLayer;
+    uint32_t layerCount;
+    uint32_t firstObject;
+    uint32_t objectCount;
+    uint32_t reserved;
+    CookedBlob preload;  //!< The scene's "preload" json, if it has one.
+};
+
+//! A layer of a scene.
+struct CookedLayer {
+    uint32_t typeIndex;  //!< Into the type table.
+    int32_t order;
+    int32_t queryLayer;
+    uint32_t hasQueryLayer;
+    CookedBlob json;  //!< The json LayerFactory is given.
+};
+
+//! An object of a scene.
+struct CookedObject {
+    uint32_t firstComponent;
+    uint32_t componentCount;
+    CookedBlob json;  //!< The object's json without its components.
+};
+
+//! A component of an object.
+struct CookedComponent {
+    uint32_t typeIndex;  //!< Into the type table.
+    uint32_t reserved;
+    CookedBlob json;  //!< The json ComponentFactory is given.
+};
+
+static_assert(sizeof(CookedSceneHeader) % 8 == 0 && sizeof(CookedSceneType) % 8 == 0 &&
+                  sizeof(CookedSceneRecord) % 8 == 0 && sizeof(CookedLayer) % 8 == 0 &&
+                  sizeof(CookedObject) % 8 == 0 && sizeof(CookedComponent) % 8 == 0,
+              "Cooked scene records must keep the records after them aligned");
+
+//! Reads a cooked scene file in place.
+/**
+   The whole file is memory mapped and its tables validated up front.  Records
+   are read where they lie; only the blobs a loader asks for are decoded.  The
+   spans returned are only valid while the object is alive.
+*/
+class CookedScenes final {
+   public:
+    explicit CookedScenes(const std::filesystem::path& in_path);
+
+    [[nodiscard]] std::span<const CookedSceneType> types() const;
+    [[nodiscard]] std::span<const CookedSceneRecord> scenes() const;
+    [[nodiscard]] const CookedSceneRecord* findScene(std::string_view in_sceneId) const;
+    [[nodiscard]] std::span<const CookedLayer> layers(const CookedSceneRecord& in_scene) const;
+    [[nodiscard]] std::span<const CookedObject> objects(const CookedSceneRecord& in_scene) const;
+    [[nodiscard]] std::span<const CookedComponent> components(const CookedObject& in_object) const;
+    [[nodiscard]] std::string_view string(uint32_t in_offset) const;
+    [[nodiscard]] std::span<const uint8_t> blob(const CookedBlob& in_blob) const;
+    [[nodiscard]] jsoncons::json decode(const CookedBlob& in_blob) const;
+    [[nodiscard]] const std::filesystem::path& path() const;
+
+    static constexpr std::array<char, 4> kMagic = {'C', 'P', 'S', 'C'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr const char* kExtension = ".cscene";
+
+   private:
+    template <typename T>
+    std::span<const T> records(uint64_t in_offset, std::size_t in_count) const;
+
+    MappedFile m_file;                             //!< The cooked file.
+    const CookedSceneHeader* m_pHeader = nullptr;  //!< Points into m_file.
+};
+
+//! Cooks scene descriptors.
+class CookedScenesWriter final {
+   public:
+    void addScenes(const jsoncons::json& in_sceneDescriptors);
+    void addScene(const jsoncons::json& in_scene);
+
+    [[nodiscard]] std::vector<std::byte> build() const;
+    void write(const std::filesystem::path& in_path) const;
+
+   private:
+    uint32_t addString(const std::string& in_string);
+    uint32_t addType(CookedTypeKind in_kind, const std::string& in_type, const std::string& in_subtype);
+    CookedBlob addBlob(const jsoncons::json& in_json);
+
+    std::vector<CookedSceneType> m_types;  //!< The type table.
+    //! Index of each type in m_types.
+    std::map<std::tuple<CookedTypeKind, std::string, std::string>, uint32_t> m_typeIndices;
+    std::vector<CookedSceneRecord> m_scenes;
+    std::vector<CookedLayer> m_layers;
+    std::vector<CookedObject> m_objects;
+    std::vector<CookedComponent> m_components;
+    std::vector<char> m_strings;  //!< The string table.
+    std::vector<uint8_t> m_blobs;  //!< The blob section.
+};
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_COOKEDSCENES_H
@@ -0,0 +1,342 @@
+#ifndef CAPENGINE_DELEGATESIGNAL_H
+#define CAPENGINE_DELEGATESIGNAL_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace CapEngine {
+
+namespace detail {
+
+//! The part of a Signal its connections can reach without knowing its signature.
+class SignalCore {
+   public:
+    virtual ~SignalCore() = default;
+    virtual void disconnect(uint64_t in_id) = 0;
+    [[nodiscard]] virtual bool connected(uint64_t in_id) const = 0;
+};
+
+}  // namespace detail
+
+//! A handle to a slot connected to a Signal.
+/**
+   Copies refer to the same slot.  Dropping a Connection does not disconnect it;
+   use ScopedConnection for that.  It is safe to use after the Signal is gone.
+*/
+class Connection {
+   public:
+    Connection() = default;
+
+    //! Disconnects the slot, if it still is connected.
+    void disconnect()
+    {
+        if (auto pCore = m_pCore.lock()) {
+            pCore->disconnect(m_id);
+        }
+        m_pCore.reset();
+    }
+
+    //! Whether the slot is still connected.
+    [[nodiscard]] bool connected() const
+    {
+        auto pCore = m_pCore.lock();
+        return pCore != nullptr && pCore->connected(m_id);
+    }
+
+   private:
+    template <typename Signature, std::size_t InlineSlots>
+    friend class Signal;
+
+    Connection(std::weak_ptr<detail::SignalCore> in_pCore, uint64_t in_id) : m_pCore(std::move(in_pCore)), m_id(in_id)
+    {
+    }
+
+    std::weak_ptr<detail::SignalCore> m_pCore;  //!< The signal's slots.
+    uint64_t m_id = 0;                          //!< The slot within them.
+};
+
+//! A Connection that disconnects its slot when it is destroyed or reassigned.
+class ScopedConnection {
+   public:
+    ScopedConnection() = default;
+    ScopedConnection(Connection in_connection) : m_connection(std::move(in_connection)) {}
+    ~ScopedConnection() { m_connection.disconnect(); }
+
+    ScopedConnection(const ScopedConnection&) = delete;
+    ScopedConnection& operator=(const ScopedConnection&) = delete;
+
+    ScopedConnection(ScopedConnection&& io_other) noexcept : m_connection(io_other.release()) {}
+
+    ScopedConnection& operator=(ScopedConnection&& io_other) noexcept
+    {
+        if (this != &io_other) {
+            m_connection.disconnect();
+            m_connection = io_other.release();
+        }
+        return *this;
+    }
+
+    ScopedConnection& operator=(Connection in_connection)
+    {
+        m_connection.disconnect();
+        m_connection = std::move(in_connection);
+        return *this;
+    }
+
+    void disconnect() { m_connection.disconnect(); }
+    [[nodiscard]] bool connected() const { return m_connection.connected(); }
+
+    //! Stops managing the slot without disconnecting it.
+    Connection release() { return std::exchange(m_connection, Connection{}); }
+
+   private:
+    Connection m_connection;
+};
+
+template <typename Signature, std::size_t InlineSlots = 4>
+class Signal;
+
+//! A single threaded signal for hot paths.
+/**
+   A replacement for boost::signals2::signal where the locking and slot
+   tracking it does on every emission are not needed.  The first InlineSlots
+   slots are stored in the signal itself, so emitting to a handful of slots
+   touches no memory but the signal and the slots' own callables.
+
+   Slots may connect and disconnect, from any slot, while the signal is being
+   emitted.  Slots connected during an emission are first called by the next
+   one.  A slot disconnected during an emission is not called again, but is
+   only removed once the outermost emission returns.
+
+   Slots are called in the order they were connected, and are each given the
+   same arguments, so they should not be taken as rvalue references.
+*/
+template <typename... Args, std::size_t InlineSlots>
+class Signal<void(Args...), InlineSlots> {
+   public:
+    using slot_type = std::function<void(Args...)>;
+
+    Signal() : m_pCore(std::make_shared<Core>()) {}
+    ~Signal() = default;
+
+    Signal(const Signal&) = delete;
+    Signal& operator=(const Signal&) = delete;
+
+    //! Connects a slot.
+    /**
+     \param in_slot
+       The callable to call on each emission.
+     \return
+       A handle that can disconnect it.
+    */
+    Connection connect(slot_type in_slot)
+    {
+        const uint64_t id = m_pCore->connect(std::move(in_slot));
+        return Connection{m_pCore, id};
+    }
+
+    //! Calls each connected slot.
+    void operator()(Args... in_args) const
+    {
+        // a slot may destroy the signal, so the slots are kept alive until
+        // the emission ends.
+        const std::shared_ptr<Core> pCore = m_pCore;
+        pCore->emit(in_args...);
+    }
+
+    //! Disconnects every slot.
+    void disconnectAll() { m_pCore->disconnectAll(); }
+
+    //! Whether no slots are connected.  Cheap enough to skip building arguments.
+    [[nodiscard]] bool empty() const { return m_pCore->count() == 0; }
+
+    //! The number of connected slots.
+    [[nodiscard]] std::size_t numSlots() const { return m_pCore->count(); }
+
+   private:
+    //! A slot and the id its connections know it by.  Id 0 marks a disconnected slot.
+    struct Slot {
+        slot_type function;
+        uint64_t id = 0;
+    };
+
+    //! The slots.  Shared with connections weakly so they outlive neither.
+    class Core final : public detail::SignalCore {
+       public:
+        uint64_t connect(slot_type in_slot)
+        {
+            const uint64_t id = m_nextId++;
+            if (m_emitting > 0) {
+                // the slots can't move while one of them is running.
+                m_connecting.push_back(Slot{std::move(in_slot), id});
+            }
+            else {
+                this->append(Slot{std::move(in_slot), id});
+            }
+            ++m_count;
+            return id;
+        }
+
+        void emit(Args&... in_args)
+        {
+            const EmitGuard guard{*this};
+            const std::size_t size = m_size;
+            for (std::size_t i = 0; i < size; ++i) {
+                Slot& slot = this->at(i);
+                if (slot.id != 0) {
+                    slot.function(in_args...);
+                }
+            }
+        }
+
+        void disconnect(uint64_t in_id) override
+        {
+            for (std::size_t i = 0; i < m_size; ++i) {
+                Slot& slot = this->at(i);
+                if (slot.id == in_id) {
+                    slot.id = 0;
+                    m_tombstones = true;
+                    --m_count;
+                    if (m_emitting == 0) {
+                        this->compact();
+                    }
+                    return;
+                }
+            }
+            for (auto it = m_connecting.begin(); it != m_connecting.end(); ++it) {
+                if (it->id == in_id) {
+                    m_connecting.erase(it);
+                    --m_count;
+                    return;
+                }
+            }
+        }
+
+        [[nodiscard]] bool connected(uint64_t in_id) const override
+        {
+            if (in_id == 0) {
+                return false;
+            }
+            for (std::size_t i = 0; i < m_size; ++i) {
+                if (this->at(i).id == in_id) {
+                    return true;
+                }
+            }
+            for (const Slot& slot : m_connecting) {
+                if (slot.id == in_id) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void disconnectAll()
+        {
+            for (std::size_t i = 0; i < m_size; ++i) {
+                this->at(i).id = 0;
+            }
+            m_connecting.clear();
+            m_tombstones = m_size > 0;
+            m_count = 0;
+            if (m_emitting == 0) {
+                this->compact();
+            }
+        }
+
+        [[nodiscard]] std::size_t count() const { return m_count; }
+
+       private:
+        //! Tracks the depth of an emission, settling even if a slot throws.
+        class EmitGuard {
+           public:
+            explicit EmitGuard(Core& io_core) : m_core(io_core) { ++m_core.m_emitting; }
+            ~EmitGuard()
+            {
+                if (--m_core.m_emitting == 0) {
+                    m_core.settle();
+                }
+            }
+
+            EmitGuard(const EmitGuard&) = delete;
+            EmitGuard& operator=(const EmitGuard&) = delete;
+
+           private:
+            Core& m_core;
+        };
+
+        Slot& at(std::size_t in_index)
+        {
+            return in_index < InlineSlots ? m_inline[in_index] : m_overflow[in_index - InlineSlots];
+        }
+
+        const Slot& at(std::size_t in_index) const
+        {
+            return in_index < InlineSlots ? m_inline[in_index] : m_overflow[in_index - InlineSlots];
+        }
+
+        void append(Slot&& in_slot)
+        {
+            if (m_size < InlineSlots) {
+                m_inline[m_size] = std::move(in_slot);
+            }
+            else {
+                m_overflow.push_back(std::move(in_slot));
+            }
+            ++m_size;
+        }
+
+        //! Applies the changes made during an emission.
+        void settle()
+        {
+            if (m_tombstones) {
+                this->compact();
+            }
+            for (Slot& slot : m_connecting) {
+                this->append(std::move(slot));
+            }
+            m_connecting.clear();
+        }
+
+        //! Removes disconnected slots, keeping the rest in order.
+        void compact()
+        {
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < m_size; ++i) {
+                if (this->at(i).id != 0) {
+                    if (kept != i) {
+                        this->at(kept) = std::move(this->at(i));
+                    }
+                    ++kept;
+                }
+            }
+            for (std::size_t i = kept; i < std::min(m_size, InlineSlots); ++i) {
+                m_inline[i] = Slot{};
+            }
+            m_overflow.resize(kept > InlineSlots ? kept - InlineSlots : 0);
+            m_size = kept;
+            m_tombstones = false;
+        }
+
+        std::array<Slot, InlineSlots> m_inline;  //!< The first slots.
+        std::vector<Slot> m_overflow;            //!< Slots past InlineSlots.
+        std::size_t m_size = 0;                  //!< Slots in use, including disconnected ones.
+        std::size_t m_count = 0;                 //!< Connected slots, including m_connecting.
+        std::vector<Slot> m_connecting;          //!< Slots connected during an emission.
+        uint64_t m_nextId = 1;
+        int m_emitting = 0;         //!< Depth of nested emissions.
+        bool m_tombstones = false;  //!< Whether any slot in use has been disconnected.
+    };
+
+    //! Shared so connections can tell when the signal has gone.
+    std::shared_ptr<Core> m_pCore;
+};
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_DELEGATESIGNAL_H
@@ -95,9 +95,12 @@ bool Editor::onLoad()
   std::shared_ptr<GridLayout> pLayout =
       UI::GridLayout::create(1, 3, boost::none, std::vector<int>{20, 60, 20});
   assert(pLayout != nullptr);
-  pLayout->setBorder(BorderStyle::Solid, 2);
   pWindow->setLayout(pLayout);
 
+  // lay the panels out once they've all been added.
+  LayoutBatch layoutBatch(*pLayout);
+  pLayout->setBorder(BorderStyle::Solid, 2);
+
   assert(m_pTileset != nullptr);
   m_pTileSetPanel = UI::TileSetPanel::create(this->m_pTileset);
 
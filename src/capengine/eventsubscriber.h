@@ -2,9 +2,9 @@
 #define EVENTSUBSCRIBER_H
 
 #include "IEventSubscriber.h"
+#include "delegatesignal.h"
 #include "gameevent.h"
 
-#include <boost/signals2.hpp>
 #include <optional>
 
 namespace CapEngine
@@ -24,21 +24,21 @@ public:
 
   void receiveEvent(SDL_Event event, Time *time) override;
 
-  // signals
+  // signals, emitted for every event so they avoid boost::signals2
   //! The keyboard event signal
-  boost::signals2::signal<void(SDL_KeyboardEvent)> m_keyboardEventSignal;
+  Signal<void(SDL_KeyboardEvent)> m_keyboardEventSignal;
   //! The mouse motion event signal
-  boost::signals2::signal<void(SDL_MouseMotionEvent)> m_mouseMotionEventSignal;
+  Signal<void(SDL_MouseMotionEvent)> m_mouseMotionEventSignal;
   //! The mouse button event signal
-  boost::signals2::signal<void(SDL_MouseButtonEvent)> m_mouseButtonEventSignal;
+  Signal<void(SDL_MouseButtonEvent)> m_mouseButtonEventSignal;
   //! The mouse wheel event signal
-  boost::signals2::signal<void(SDL_MouseWheelEvent)> m_mouseWheelEventSignal;
+  Signal<void(SDL_MouseWheelEvent)> m_mouseWheelEventSignal;
   //! The window event signal
-  boost::signals2::signal<void(SDL_WindowEvent)> m_windowEventSignal;
+  Signal<void(SDL_WindowEvent)> m_windowEventSignal;
   //! a text edit event
-  boost::signals2::signal<void(SDL_TextInputEvent)> m_textInputEventSignal;
+  Signal<void(SDL_TextInputEvent)> m_textInputEventSignal;
   //! A game event signal
-  boost::signals2::signal<void(const GameEvent &)> m_gameEventSignal;
+  Signal<void(const GameEvent &)> m_gameEventSignal;
 };
 } // namespace CapEngine
 
@@ -0,0 +1,110 @@
+#include "framearena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "CapEngineException.h"
+
+namespace CapEngine {
+
+namespace {
+
+//! Alignment of the arena block itself.
+constexpr std::size_t kBlockAlignment = alignof(std::max_align_t);
+
+}  // namespace
+
+//! Constructor.
+/**
+ \param in_capacity
+   The initial size of the block in bytes.
+ \param in_upstream
+   The resource the block and any overflow allocations come from.
+*/
+FrameArena::FrameArena(std::size_t in_capacity, std::pmr::memory_resource* in_upstream)
+    : m_upstream(in_upstream), m_capacity(in_capacity)
+{
+    CAP_THROW_NULL(m_upstream, "FrameArena upstream resource is null");
+
+    if (m_capacity > 0) {
+        m_block = static_cast<std::byte*>(m_upstream->allocate(m_capacity, kBlockAlignment));
+    }
+}
+
+//! Destructor.
+FrameArena::~FrameArena()
+{
+    for (auto&& overflow : m_overflows) {
+        m_upstream->deallocate(overflow.pointer, overflow.bytes, overflow.alignment);
+    }
+
+    if (m_block != nullptr) {
+        m_upstream->deallocate(m_block, m_capacity, kBlockAlignment);
+    }
+}
+
+//! Releases everything allocated since the last reset.
+/**
+   If the last frame overflowed the block it is grown so that the next frame of
+   the same size fits.
+*/
+void FrameArena::reset()
+{
+    m_highWaterMark = std::max(m_highWaterMark, used());
+
+    for (auto&& overflow : m_overflows) {
+        m_upstream->deallocate(overflow.pointer, overflow.bytes, overflow.alignment);
+    }
+    m_overflows.clear();
+
+    if (m_overflowBytes > 0) {
+        const std::size_t newCapacity = std::max(m_capacity * 2, m_capacity + m_overflowBytes);
+
+        if (m_block != nullptr) {
+            m_upstream->deallocate(m_block, m_capacity, kBlockAlignment);
+        }
+        m_block = static_cast<std::byte*>(m_upstream->allocate(newCapacity, kBlockAlignment));
+        m_capacity = newCapacity;
+    }
+
+    m_offset = 0;
+    m_overflowBytes = 0;
+}
+
+//! \copydoc std::pmr::memory_resource::do_allocate
+void* FrameArena::do_allocate(std::size_t in_bytes, std::size_t in_alignment)
+{
+    if (m_block != nullptr) {
+        const auto base = reinterpret_cast<std::uintptr_t>(m_block);
+        const std::uintptr_t aligned = (base + m_offset + in_alignment - 1) & ~(in_alignment - 1);
+        const std::size_t newOffset = (aligned - base) + in_bytes;
+
+        if (newOffset <= m_capacity) {
+            m_offset = newOffset;
+            return reinterpret_cast<void*>(aligned);
+        }
+    }
+
+    // doesn't fit, fall back to upstream until the next reset grows the block
+    void* pointer = m_upstream->allocate(in_bytes, in_alignment);
+    m_overflows.push_back(Overflow{pointer, in_bytes, in_alignment});
+    m_overflowBytes += in_bytes;
+
+    return pointer;
+}
+
+//! \copydoc std::pmr::memory_resource::do_deallocate
+/**
+   Memory is only reclaimed by reset() so this does nothing.
+*/
+void FrameArena::do_deallocate(void* /*in_pointer*/, std::size_t /*in_bytes*/, std::size_t /*in_alignment*/)
+{
+}
+
+//! \copydoc std::pmr::memory_resource::do_is_equal
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& in_other) const noexcept
+{
+    return this == &in_other;
+}
+
+}  // namespace CapEngine
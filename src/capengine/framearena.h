@@ -0,0 +1,77 @@
+#ifndef CAPENGINE_FRAMEARENA_H
+#define CAPENGINE_FRAMEARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace CapEngine {
+
+//! Linear allocator for temporaries that only live for a single frame.
+/**
+   Allocations bump an offset into one block and are released all at once by
+   reset().  If a frame needs more than the block holds the overflow is served
+   by the upstream resource and the block is grown on the next reset, so once a
+   scene reaches steady state no frame touches the heap.
+
+   Anything allocated from the arena must be destroyed before reset() is called.
+*/
+class FrameArena final : public std::pmr::memory_resource {
+   public:
+    explicit FrameArena(std::size_t in_capacity = kDefaultCapacity,
+                        std::pmr::memory_resource* in_upstream = std::pmr::new_delete_resource());
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void reset();
+
+    [[nodiscard]] std::size_t capacity() const;
+    [[nodiscard]] std::size_t used() const;
+    [[nodiscard]] std::size_t highWaterMark() const;
+
+    static constexpr std::size_t kDefaultCapacity = 64 * 1024;
+
+   private:
+    //! An allocation that did not fit in the block.
+    struct Overflow {
+        void* pointer;
+        std::size_t bytes;
+        std::size_t alignment;
+    };
+
+    void* do_allocate(std::size_t in_bytes, std::size_t in_alignment) override;
+    void do_deallocate(void* in_pointer, std::size_t in_bytes, std::size_t in_alignment) override;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& in_other) const noexcept override;
+
+    std::pmr::memory_resource* m_upstream;  //!< Where the block and overflows come from.
+    std::byte* m_block = nullptr;           //!< The block allocations are carved from.
+    std::size_t m_capacity = 0;             //!< The size of the block.
+    std::size_t m_offset = 0;               //!< Bytes of the block handed out this frame.
+    std::size_t m_overflowBytes = 0;        //!< Bytes that did not fit in the block this frame.
+    std::size_t m_highWaterMark = 0;        //!< Largest number of bytes used by a single frame.
+    std::vector<Overflow> m_overflows;      //!< Overflow allocations to release on reset.
+};
+
+//! Returns the block capacity in bytes.
+inline std::size_t FrameArena::capacity() const
+{
+    return m_capacity;
+}
+
+//! Returns the bytes handed out since the last reset.
+inline std::size_t FrameArena::used() const
+{
+    return m_offset + m_overflowBytes;
+}
+
+//! Returns the largest number of bytes any frame has used.
+inline std::size_t FrameArena::highWaterMark() const
+{
+    return m_highWaterMark;
+}
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_FRAMEARENA_H
@@ -0,0 +1,47 @@
+#ifndef CAPENGINE_FUNCTIONREF_H
+#define CAPENGINE_FUNCTIONREF_H
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace CapEngine {
+
+template <typename Signature>
+class FunctionRef;
+
+//! Non-owning reference to a callable.
+/**
+   Unlike std::function this never allocates, so it can be used for callback
+   based queries on hot paths.  The referenced callable must outlive the
+   FunctionRef, which in practice means it should only be used as a function
+   parameter.
+*/
+template <typename R, typename... Args>
+class FunctionRef<R(Args...)> {
+   public:
+    template <typename F>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, FunctionRef> && std::is_invocable_r_v<R, F&, Args...>)
+    FunctionRef(F&& in_callable) noexcept
+        : m_callable(const_cast<void*>(static_cast<const void*>(std::addressof(in_callable)))),
+          m_invoker([](void* in_pCallable, Args... in_args) -> R {
+              return std::invoke(*static_cast<std::add_pointer_t<std::remove_reference_t<F>>>(in_pCallable),
+                                 std::forward<Args>(in_args)...);
+          })
+    {
+    }
+
+    R operator()(Args... in_args) const
+    {
+        return m_invoker(m_callable, std::forward<Args>(in_args)...);
+    }
+
+   private:
+    void* m_callable;                  //!< The referenced callable.
+    R (*m_invoker)(void*, Args...);  //!< Type erased trampoline to the callable.
+};
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_FUNCTIONREF_H
@@ -1,12 +1,17 @@
 #include "game_management.h"
 
 #include <boost/throw_exception.hpp>
+#include <filesystem>
 #include <memory>
 #include <optional>
+#include <type_traits>
 
 #include "EventDispatcher.h"
 #include "VideoManager.h"
+#include "asset_manager.h"
 #include "bitmapcollisionlayer.h"
+#include "tilecollisionlayer.h"
+#include "vectorcollisionlayer.h"
 #include "boxcollider.h"
 #include "componentfactory.h"
 #include "controller.h"
@@ -16,6 +21,7 @@
 #include "locator.h"
 #include "placeholdergraphics.h"
 #include "runner.h"
+#include "Time.h"
 #include "windowwidget.h"
 #include "logging.h"
 
@@ -24,6 +30,35 @@ namespace
 
 constexpr std::string_view kAssetFileProperty = "CapengineAssetPath";
 
+//! Every subsystem started so far, in the order they were started.
+std::vector<CapEngine::SubsystemTiming> initTimings;
+
+//! Whether initControllers() has run.
+bool controllersStarted = false;
+
+//! Runs a subsystem's start up and records how long it took.
+template <typename F>
+auto timeInit(const char *in_name, bool in_lazy, F &&in_init)
+{
+    const double start = CapEngine::currentTime();
+    auto finish = [&]() {
+        const double ms = CapEngine::currentTime() - start;
+        initTimings.push_back(CapEngine::SubsystemTiming{in_name, ms, in_lazy});
+        BOOST_LOG_SEV(CapEngine::log, boost::log::trivial::debug)
+            << "Started " << in_name << (in_lazy ? " on first use" : "") << " in " << ms << "ms";
+    };
+
+    if constexpr (std::is_void_v<std::invoke_result_t<F>>) {
+        in_init();
+        finish();
+    }
+    else {
+        auto result = in_init();
+        finish();
+        return result;
+    }
+}
+
 }
 
 namespace CapEngine
@@ -31,17 +66,28 @@ namespace CapEngine
 
 bool initted = false;
 
-Uint32 init(WindowParams screenConfig, bool noWindow)
+//! Starts the engine.
+/**
+ \param screenConfig
+   The main window.
+ \param noWindow
+   Skip creating the main window.  SDL video is then only started if a
+   window is created later.
+ \param initFlags
+   The InitFlags of the subsystems to start now rather than on first use.
+ \return
+   The id of the main window.
+*/
+Uint32 init(WindowParams screenConfig, bool noWindow, uint32_t initFlags)
 {
     Uint32 windowID = -1;
     if (!initted) {
-        Locator::videoManager = new VideoManager;
-        windowID = Locator::videoManager->initSystem(screenConfig, noWindow);
+        timeInit("video", false, [&]() {
+            Locator::videoManager = new VideoManager;
+            windowID = Locator::videoManager->initSystem(screenConfig, noWindow);
+        });
 
         Locator::logger = new Logger;
-        Locator::soundPlayer = &(SoundPlayer::getSoundPlayer());
-        Locator::soundPlayer->setState(
-            SoundState::PLAY);  // should change this to be an enum
         Locator::keyboard = new Keyboard;
 
         const int NUMMOUSEBUTTONS = 3;
@@ -49,17 +95,25 @@ Uint32 init(WindowParams screenConfig, bool noWindow)
         Locator::eventDispatcher = new EventDispatcher(Locator::videoManager);
         Locator::eventSubscriber =
             new EventSubscriber(Locator::eventDispatcher);
-        Locator::fontManager = new FontManager();
 
         Locator::assetManager = nullptr;
 
-        // initialize ControllerManager
-        ControllerManager::initialize();
+        if ((initFlags & InitFlags_Audio) != 0) {
+            initAudio();
+        }
+        if ((initFlags & InitFlags_Fonts) != 0) {
+            initFonts();
+        }
+        if ((initFlags & InitFlags_Controllers) != 0) {
+            initControllers();
+        }
 
         // initialise 2d layer types
         LayerFactory& layerFactory = LayerFactory::getInstance();
         ImageLayer::registerConstructor(layerFactory);
         BitmapCollisionLayer::registerConstructor(layerFactory);
+        TileCollisionLayer::registerConstructor(layerFactory);
+        VectorCollisionLayer::registerConstructor(layerFactory);
 
         // initialize components
         ComponentFactory& componentFactory = ComponentFactory::getInstance();
@@ -75,6 +129,65 @@ Uint32 init(WindowParams screenConfig, bool noWindow)
     return windowID;
 }
 
+//! Opens the audio device.
+/**
+ Called by init() with InitFlags_Audio, otherwise by
+ Locator::getSoundPlayer() the first time it is used.
+ \return
+   The sound player, also set as Locator::soundPlayer.
+*/
+SoundPlayer* initAudio()
+{
+    if (Locator::soundPlayer == nullptr) {
+        Locator::soundPlayer = timeInit("audio", initted, []() {
+            SoundPlayer* pSoundPlayer = &(SoundPlayer::getSoundPlayer());
+            pSoundPlayer->setState(
+                SoundState::PLAY);  // should change this to be an enum
+            return pSoundPlayer;
+        });
+    }
+
+    return Locator::soundPlayer;
+}
+
+//! Starts SDL_ttf.
+/**
+ Called by init() with InitFlags_Fonts, otherwise by
+ Locator::getFontManager() the first time it is used.
+ \return
+   The font manager, also set as Locator::fontManager.
+*/
+FontManager* initFonts()
+{
+    if (Locator::fontManager == nullptr) {
+        Locator::fontManager =
+            timeInit("fonts", initted, []() { return new FontManager(); });
+    }
+
+    return Locator::fontManager;
+}
+
+//! Starts game controller support.
+/**
+ Controllers are only noticed as they connect, so unlike audio and fonts
+ this isn't started on first use.  Call it after init() if init() wasn't
+ given InitFlags_Controllers.
+*/
+void initControllers()
+{
+    if (!controllersStarted) {
+        timeInit("controllers", initted, []() { ControllerManager::initialize(); });
+        controllersStarted = true;
+    }
+}
+
+//! Gets how long each subsystem took to start.
+/**
+ \return
+   The subsystems started so far, in the order they were started.
+*/
+const std::vector<SubsystemTiming>& getInitTimings() { return initTimings; }
+
 void destroy()
 {
     if (initted) {
@@ -91,8 +204,21 @@ void destroy()
 
 void loadAssetFile(std::optional<std::string> assetsFile, std::optional<std::string> baseAssetPath)
 {
+    // a packed archive is mounted rather than parsed.
+    std::optional<std::filesystem::path> archive;
+    if (assetsFile.has_value() && std::filesystem::path{*assetsFile}.extension() == AssetArchive::kExtension) {
+        archive = std::filesystem::absolute(*assetsFile);
+        assetsFile = std::nullopt;
+        if (!baseAssetPath.has_value()) {
+            baseAssetPath = archive->parent_path().string();
+        }
+    }
+
     std::unique_ptr<AssetManager> pAssetManager(new AssetManager(
-                                                    *(Locator::videoManager), *(Locator::soundPlayer), assetsFile, baseAssetPath));
+                                                    *(Locator::videoManager), Locator::getSoundPlayer(), assetsFile, baseAssetPath));
+    if (archive.has_value()) {
+        pAssetManager->mountArchive(*archive);
+    }
     Locator::assetManager = pAssetManager.release();
 }
 
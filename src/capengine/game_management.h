@@ -1,8 +1,11 @@
 #ifndef GAME_MANAGEMENT_H
 #define GAME_MANAGEMENT_H
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "VideoManager.h"
 #include "gamestate.h"
@@ -10,10 +13,34 @@
 
 namespace CapEngine {
 
+class FontManager;
+class SoundPlayer;
+
 extern bool initted;
 
-Uint32 init(WindowParams windowParams, bool noWindow = false);
+//! Subsystems init() starts.  Audio and fonts left out are started on first
+//! use through Locator::getSoundPlayer() and Locator::getFontManager().
+enum InitFlags : uint32_t {
+    InitFlags_Audio = 0x01,
+    InitFlags_Fonts = 0x02,
+    InitFlags_Controllers = 0x04,
+    InitFlags_All = InitFlags_Audio | InitFlags_Fonts | InitFlags_Controllers
+};
+
+//! How long a subsystem took to start.
+struct SubsystemTiming {
+    std::string name;
+    double ms = 0.0;
+    bool lazy = false;  //!< Started on first use rather than by init().
+};
+
+Uint32 init(WindowParams windowParams, bool noWindow = false,
+            uint32_t initFlags = InitFlags_All);
 void destroy();
+SoundPlayer* initAudio();
+FontManager* initFonts();
+void initControllers();
+const std::vector<SubsystemTiming>& getInitTimings();
 void loadAssetFile(std::optional<std::string> assetsFile,
                    std::optional<std::string> baseAssetPath);
 void startLoop(std::shared_ptr<GameState> pGameState);
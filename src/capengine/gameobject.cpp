@@ -16,28 +16,6 @@
 
 namespace CapEngine {
 
-namespace {
-
-/**
- * @brief Get a set of specific component types.
- * @param[in] in_components The generic components.
- * @return A collection of components of the specific type.
- */
-template <typename T>
-std::vector<std::shared_ptr<T>> getComponentsOfType(const std::vector<std::shared_ptr<Component>>& in_components)
-{
-    std::vector<std::shared_ptr<T>> components;
-    for (auto&& component : in_components) {
-        auto tComponent = std::dynamic_pointer_cast<T>(component);
-        if (tComponent) {
-            components.push_back(tComponent);
-        }
-    }
-    return components;
-}
-
-}  // namespace
-
 ObjectID GameObject::nextID = 0;
 int GameObject::nextMessageId = 0;
 
@@ -52,6 +30,8 @@ GameObject::GameObject(bool newID)
 /**
    Swap 2 game objects.
 
+   Like assigning, each object keeps the pool it belongs to.
+
    \param io_other
    The other object.
 */
@@ -69,6 +49,9 @@ void GameObject::swap(GameObject& io_other) noexcept
         std::swap(m_objectID, io_other.m_objectID);
         std::swap(m_parentObjectID, io_other.m_parentObjectID);
         std::swap(m_objectType, io_other.m_objectType);
+        std::swap(m_yAxisOrientation, io_other.m_yAxisOrientation);
+        std::swap(m_continuousCollision, io_other.m_continuousCollision);
+        std::swap(m_queryLayer, io_other.m_queryLayer);
         std::swap(m_components, io_other.m_components);
         std::swap(m_metadata, io_other.m_metadata);
     }
@@ -196,14 +179,12 @@ void GameObject::swap(GameObject& io_other) noexcept
 
 void GameObject::render(const Camera2d& in_camera, uint32_t in_windowId)
 {
-    std::vector<std::shared_ptr<Component>> graphicsComponents = this->getComponents(ComponentType::Graphics);
-
-    for (auto&& pComponent : graphicsComponents) {
-        auto pGraphicsComponent = std::dynamic_pointer_cast<GraphicsComponent>(pComponent);
+    this->forEachComponent(ComponentType::Graphics, [&](Component& in_component) {
+        auto* pGraphicsComponent = dynamic_cast<GraphicsComponent*>(&in_component);
         assert(pGraphicsComponent != nullptr);
 
         pGraphicsComponent->render(*this, in_camera, in_windowId);
-    }
+    });
 }
 
 std::unique_ptr<GameObject> GameObject::update(double ms) const
@@ -231,7 +212,7 @@ Rectangle GameObject::boundingPolygon() const
     bool first = true;
 
     for (auto&& pComponent : m_components) {
-        auto pPhysicsComponent = std::dynamic_pointer_cast<PhysicsComponent>(pComponent);
+        const auto* pPhysicsComponent = dynamic_cast<const PhysicsComponent*>(pComponent.get());
 
         if (pPhysicsComponent) {
             std::optional<Rectangle> maybeRectangle = pPhysicsComponent->boundingPolygon(*this);
@@ -267,10 +248,10 @@ bool GameObject::handleCollision(CapEngine::CollisionType type, CapEngine::Colli
         maybeOtherObject = otherObject;
     }
 
-    const auto physicsComponents = getComponentsOfType<PhysicsComponent>(this->m_components);
-
-    return std::ranges::any_of(physicsComponents, [&](auto&& component) {
-        return component->handleCollision(type, class_, *this, maybeOtherObject, collisionLocation);
+    return std::ranges::any_of(m_components, [&](auto&& pComponent) {
+        auto* pPhysicsComponent = dynamic_cast<PhysicsComponent*>(pComponent.get());
+        return pPhysicsComponent != nullptr &&
+               pPhysicsComponent->handleCollision(type, class_, *this, maybeOtherObject, collisionLocation);
     });
 
     // for (auto&& component : physicsComponents) {
@@ -282,16 +263,151 @@ bool GameObject::handleCollision(CapEngine::CollisionType type, CapEngine::Colli
     // return false;
 }
 
+/**
+ * @brief Passes a contact with another object to the physics components.
+ * @param[in] in_phase Where the contact is in its lifetime.
+ * @param[in] in_pOtherObject The other object, or nullptr if it was removed.
+ * @param[in] in_manifold The contact from this object's point of view.
+ */
+void GameObject::handleContact(ContactPhase in_phase, GameObject* in_pOtherObject, const ContactManifold& in_manifold)
+{
+    for (auto&& pComponent : m_components) {
+        auto* pPhysicsComponent = dynamic_cast<PhysicsComponent*>(pComponent.get());
+        if (pPhysicsComponent != nullptr) {
+            pPhysicsComponent->handleContact(in_phase, *this, in_pOtherObject, in_manifold);
+        }
+    }
+}
+
 std::unique_ptr<GameObject> GameObject::clone() const
 {
     return std::make_unique<GameObject>(*this);
 }
 
+//! Resets this object to the state of a prototype.
+/**
+   Unlike copy assignment the components are deep copied.  Components of the
+   same type that aren't shared with another object are assigned to in place
+   (see Component::assign) so that recycling an object doesn't allocate, any
+   others are replaced with clones.  The object id and pool are left unchanged.
+
+   \param in_prototype
+   The object to copy the state of.
+*/
+void GameObject::resetFrom(const GameObject& in_prototype)
+{
+    if (this == &in_prototype) {
+        return;
+    }
+
+    position = in_prototype.position;
+    previousPosition = in_prototype.previousPosition;
+    orientation = in_prototype.orientation;
+    velocity = in_prototype.velocity;
+    acceleration = in_prototype.acceleration;
+    force = in_prototype.force;
+
+    m_pObjectData = in_prototype.m_pObjectData;
+    m_objectState = in_prototype.m_objectState;
+    m_parentObjectID = in_prototype.m_parentObjectID;
+    m_objectType = in_prototype.m_objectType;
+    m_yAxisOrientation = in_prototype.m_yAxisOrientation;
+    m_continuousCollision = in_prototype.m_continuousCollision;
+    m_queryLayer = in_prototype.m_queryLayer;
+    m_metadata = in_prototype.m_metadata;
+
+    const auto& prototypeComponents = in_prototype.m_components;
+    m_components.resize(prototypeComponents.size());
+    for (size_t i = 0; i < prototypeComponents.size(); i++) {
+        assert(prototypeComponents[i] != nullptr);
+
+        const bool reusable = m_components[i] != nullptr && m_components[i].use_count() == 1;
+        if (!reusable || !m_components[i]->assign(*prototypeComponents[i])) {
+            m_components[i] = prototypeComponents[i]->clone();
+        }
+    }
+}
+
+namespace {
+
+void writeVector(ByteWriter& out_writer, const Vector& in_vector)
+{
+    out_writer.write(in_vector.getX());
+    out_writer.write(in_vector.getY());
+    out_writer.write(in_vector.getZ());
+    out_writer.write(in_vector.getD());
+}
+
+Vector readVector(ByteReader& in_reader)
+{
+    const auto x = in_reader.read<double>();
+    const auto y = in_reader.read<double>();
+    const auto z = in_reader.read<double>();
+    const auto d = in_reader.read<double>();
+    return Vector{x, y, z, d};
+}
+
+}  // namespace
+
+//! Writes the simulation state of the object and its components.
+/**
+   Object data, metadata and the pool aren't written since they don't change
+   during a simulation step.  Components write whatever Component::serialize
+   writes.
+
+   \param out_writer
+   The writer to append to.
+*/
+void GameObject::serialize(ByteWriter& out_writer) const
+{
+    out_writer.write(static_cast<int32_t>(m_objectState));
+    out_writer.write(m_parentObjectID);
+    out_writer.write(static_cast<int32_t>(m_objectType));
+    out_writer.write(static_cast<int32_t>(m_yAxisOrientation));
+
+    writeVector(out_writer, position);
+    writeVector(out_writer, previousPosition);
+    writeVector(out_writer, orientation);
+    writeVector(out_writer, velocity);
+    writeVector(out_writer, acceleration);
+    writeVector(out_writer, force);
+
+    for (auto&& pComponent : m_components) {
+        assert(pComponent != nullptr);
+        pComponent->serialize(out_writer);
+    }
+}
+
+//! Restores state written by serialize().
+/**
+   The object must have the same components it had when it was serialized.
+
+   \param in_reader
+   The reader positioned at the object's state.
+*/
+void GameObject::deserialize(ByteReader& in_reader)
+{
+    m_objectState = static_cast<ObjectState>(in_reader.read<int32_t>());
+    m_parentObjectID = in_reader.read<ObjectID>();
+    m_objectType = static_cast<ObjectType>(in_reader.read<int32_t>());
+    m_yAxisOrientation = static_cast<YAxisOrientation>(in_reader.read<int32_t>());
+
+    position = readVector(in_reader);
+    previousPosition = readVector(in_reader);
+    orientation = readVector(in_reader);
+    velocity = readVector(in_reader);
+    acceleration = readVector(in_reader);
+    force = readVector(in_reader);
+
+    for (auto&& pComponent : m_components) {
+        assert(pComponent != nullptr);
+        pComponent->deserialize(in_reader);
+    }
+}
+
 ObjectID GameObject::generateID()
 {
-    std::ostringstream msg;
-    msg << "ID " << (nextID) << " generated";
-    BOOST_LOG_SEV(CapEngine::log, boost::log::trivial::debug) << msg.str();
+    BOOST_LOG_SEV(CapEngine::log, boost::log::trivial::trace) << "ID " << nextID << " generated";
 
     return nextID++;
 }
@@ -313,7 +429,8 @@ GameObject::ObjectState GameObject::getObjectState() const
 
 void GameObject::setObjectState(GameObject::ObjectState objectState)
 {
-    if (Locator::eventSubscriber != nullptr) {
+    // most states change with nothing listening, so skip building the event.
+    if (Locator::eventSubscriber != nullptr && !Locator::eventSubscriber->m_gameEventSignal.empty()) {
         GameObjectStateChangedEvent event(this, m_objectState, objectState);
         Locator::eventSubscriber->m_gameEventSignal(event);
     }
@@ -341,6 +458,26 @@ void GameObject::setParentObjectID(ObjectID id)
     m_parentObjectID = id;
 }
 
+//! Gets the pool the object belongs to.
+/**
+\return
+  The pool or nullptr if the object isn't pooled.
+*/
+ObjectPool* GameObject::getPool() const
+{
+    return m_pool.pPool;
+}
+
+//! Sets the pool the object is returned to when it dies.
+/**
+\param
+  in_pPool The pool.  It must outlive the object.
+*/
+void GameObject::setPool(ObjectPool* in_pPool)
+{
+    m_pool.pPool = in_pPool;
+}
+
 Vector const& GameObject::getPosition() const
 {
     return position;
@@ -404,6 +541,22 @@ void GameObject::send(int id, const std::string& message)
     }
 }
 
+//! Passes a message to the components subscribed to it.
+/**
+ Normally called by MessageBus::dispatch() rather than directly.
+ \param in_message
+   The message.
+*/
+void GameObject::receive(const Message& in_message)
+{
+    for (auto&& pComponent : m_components) {
+        assert(pComponent != nullptr);
+        if (pComponent->isSubscribed(in_message.id)) {
+            pComponent->receive(*this, in_message);
+        }
+    }
+}
+
 /**
    Return the previous position of the object
 */
@@ -423,9 +576,9 @@ void GameObject::setPreviousPosition(Vector position)
 std::ostream& operator<<(std::ostream& stream, CollisionEvent const& collisionEvent)
 {
     std::ostringstream repr;
-    repr << collisionEvent.type << " with " << collisionEvent.object1->getObjectID();
-    if (collisionEvent.object2 != nullptr) {
-        repr << " and " << collisionEvent.object2->getObjectID();
+    repr << collisionEvent.type << " with " << collisionEvent.objectId1;
+    if (!collisionEvent.object2.isNull()) {
+        repr << " and " << collisionEvent.objectId2;
     }
 
     repr << " class: " << collisionEvent.class_;
@@ -495,6 +648,24 @@ std::vector<std::shared_ptr<Component>> GameObject::getComponents(ComponentType
     return components;
 }
 
+//! Calls a function for each component of a given type.
+/**
+   Unlike getComponents(ComponentType) this does not copy the components into a
+   new collection.
+\param
+   in_type The type
+\param
+   in_func The function to call with each matching component.
+*/
+void GameObject::forEachComponent(ComponentType in_type, FunctionRef<void(Component&)> in_func) const
+{
+    for (auto&& pComponent : m_components) {
+        if (pComponent->getType() == in_type) {
+            in_func(*pComponent);
+        }
+    }
+}
+
 /**
  * @brief returns the y axis orientation of the object.
  * @return The y axis orientation.
@@ -513,13 +684,60 @@ void GameObject::setYAxisOrientation(YAxisOrientation in_orientation)
     m_yAxisOrientation = in_orientation;
 }
 
+/**
+ * @brief Checks if the object uses continuous collision detection.
+ * @return true if Scene2d sweeps the object's movement.
+ */
+bool GameObject::hasContinuousCollision() const
+{
+    return m_continuousCollision;
+}
+
+/**
+ * @brief Sets whether the object uses continuous collision detection.
+ *
+ * Enable for objects that move far enough in one update to pass through
+ * other objects.  See detectSweptBoxCollision().
+ * @param[in] in_enabled Whether to sweep the object's movement.
+ */
+void GameObject::setContinuousCollision(bool in_enabled)
+{
+    m_continuousCollision = in_enabled;
+}
+
+/**
+ * @brief Gets the query layer of the object.
+ * @return The bit of QueryFilter::layerMask that selects the object.
+ */
+int GameObject::getQueryLayer() const
+{
+    return m_queryLayer;
+}
+
+/**
+ * @brief Sets the query layer of the object.
+ *
+ * Scene2d's raycasts and shape casts skip objects whose query layer isn't in
+ * the filter's mask.
+ * @param[in] in_queryLayer The layer, 0 to 31.
+ */
+void GameObject::setQueryLayer(int in_queryLayer)
+{
+    CAP_THROW_ASSERT(in_queryLayer >= 0 && in_queryLayer < 32, "Query layer must be from 0 to 31");
+    m_queryLayer = in_queryLayer;
+}
+
 GameObject::Metadata const& GameObject::metadata() const
 {
     return m_metadata;
 }
-void GameObject::setMetadata(std::string const& in_key, MetadataType const& in_value)
+void GameObject::setMetadata(std::string_view in_key, MetadataType const& in_value)
+{
+    m_metadata.set(in_key, in_value);
+}
+void GameObject::setMetadata(StringId in_key, MetadataType const& in_value)
 {
-    m_metadata[in_key] = in_value;
+    m_metadata.set(in_key, in_value);
 }
 
 GameObjectStateChangedEvent::GameObjectStateChangedEvent(GameObject* object, GameObject::ObjectState stateBefore,
@@ -8,7 +8,10 @@
 #include "captypes.h"
 #include "collision.h"
 #include "components.h"
+#include "functionref.h"
 #include "gameevent.h"
+#include "metadata.h"
+#include "slotmap.h"
 #include "vector.h"
 
 namespace CapEngine {
@@ -16,11 +19,19 @@ namespace CapEngine {
 // forward declaractions
 class Camera2d;
 class GameObject;
+class ObjectPool;
 
+using ObjectID = int64_t;
+//! Generational handle to an object held by an ObjectManager.
+using ObjectHandle = Handle<GameObject>;
+
+//! A collision between objects, resolved through ObjectManager::getObject().
 class CollisionEvent {
    public:
-    std::shared_ptr<GameObject> object1;
-    std::shared_ptr<GameObject> object2;
+    ObjectHandle object1;
+    ObjectHandle object2;
+    ObjectID objectId1 = -1;
+    ObjectID objectId2 = -1;
     CollisionType type;
     CollisionClass class_;
 
@@ -38,8 +49,6 @@ class ObjectData {
     virtual ~ObjectData() = default;
 };
 
-using ObjectID = int64_t;
-
 //! Whether coordinate system as top is 0 or bottom is 0
 enum class YAxisOrientation { TopZero, BottomZero };
 
@@ -71,7 +80,11 @@ class GameObject {
     void updateInPlace(double ms);
     [[nodiscard]] Rectangle boundingPolygon() const;
     bool handleCollision(CollisionType, CollisionClass, GameObject* otherObject, Vector const& collisionLocation);
+    void handleContact(ContactPhase in_phase, GameObject* in_pOtherObject, const ContactManifold& in_manifold);
     [[nodiscard]] std::unique_ptr<GameObject> clone() const;
+    void resetFrom(const GameObject& in_prototype);
+    void serialize(ByteWriter& out_writer) const;
+    void deserialize(ByteReader& in_reader);
     // getters and setters
     [[nodiscard]] std::shared_ptr<ObjectData> getObjectData() const;
     void setObjectData(std::shared_ptr<ObjectData> pObjectData);
@@ -81,11 +94,15 @@ class GameObject {
     void setObjectID(ObjectID id);
     [[nodiscard]] ObjectID getParentObjectID() const;
     void send(int messageId, const std::string& message);
+    void receive(const Message& in_message);
     void setParentObjectID(ObjectID id);
+    [[nodiscard]] ObjectPool* getPool() const;
+    void setPool(ObjectPool* in_pPool);
 
     void addComponent(std::shared_ptr<Component> in_pComponent);
     const std::vector<std::shared_ptr<Component>>& getComponents();
     std::vector<std::shared_ptr<Component>> getComponents(ComponentType in_type);
+    void forEachComponent(ComponentType in_type, FunctionRef<void(Component&)> in_func) const;
     template <typename T>
     std::vector<std::shared_ptr<T>> getComponents();
 
@@ -108,13 +125,30 @@ class GameObject {
     [[nodiscard]] YAxisOrientation getYAxisOrientation() const;
     void setYAxisOrientation(YAxisOrientation in_orientation);
 
+    [[nodiscard]] bool hasContinuousCollision() const;
+    void setContinuousCollision(bool in_enabled);
+
+    [[nodiscard]] int getQueryLayer() const;
+    void setQueryLayer(int in_queryLayer);
+
     friend std::ostream& operator<<(std::ostream& stream, GameObject const& object);
 
-    using Metadata = std::map<std::string, MetadataType>;
+    using Metadata = MetadataMap;
     [[nodiscard]] Metadata const& metadata() const;
-    void setMetadata(std::string const& in_key, MetadataType const& in_value);
+    void setMetadata(std::string_view in_key, MetadataType const& in_value);
+    void setMetadata(StringId in_key, MetadataType const& in_value);
 
    private:
+    //! The pool an object belongs to.  Copies and clones of an object don't
+    //! belong to it, and assigning or swapping objects keeps the pool each has.
+    struct PoolMembership {
+        PoolMembership() = default;
+        PoolMembership(const PoolMembership&) noexcept {}
+        PoolMembership& operator=(const PoolMembership&) noexcept { return *this; }
+
+        ObjectPool* pPool = nullptr;
+    };
+
     static ObjectID nextID;
     static int nextMessageId;
     std::shared_ptr<ObjectData> m_pObjectData;
@@ -123,6 +157,12 @@ class GameObject {
     ObjectID m_parentObjectID = -1;
     ObjectType m_objectType = ObjectType_AI;
     YAxisOrientation m_yAxisOrientation = YAxisOrientation::BottomZero;
+    //! Whether Scene2d sweeps this object's movement so it can't tunnel.
+    bool m_continuousCollision = false;
+    //! Which bit of a QueryFilter::layerMask selects this object, 0 to 31.
+    int m_queryLayer = 0;
+    //! The pool this object is returned to when it dies, if any.
+    PoolMembership m_pool;
 
     //! metadata
     Metadata m_metadata;
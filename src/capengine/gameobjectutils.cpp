@@ -25,14 +25,14 @@ ObjectCreationError::ObjectCreationError(const std::string &in_details,
 {
 }
 
-//! Creates a new object from a json string.
+//! Creates a new object from a json string, without its components.
 /**
 	\param in_json
-	The json to create the object from.
+	The json to create the object from.  Its components are ignored.
 	\return
 	The object.
 */
-GameObject makeObject(const jsoncons::json &in_json)
+GameObject makeBareObject(const jsoncons::json &in_json)
 {
     using namespace Schema::Scene2d;
 
@@ -48,6 +48,16 @@ GameObject makeObject(const jsoncons::json &in_json)
         object.setOrientation(JSONUtils::readVector(in_json[kOrientation]));
     }
 
+    // fast objects that need swept collision
+    if (in_json.contains(kContinuousCollision)) {
+        object.setContinuousCollision(in_json[kContinuousCollision].as<bool>());
+    }
+
+    // which layer mask bit selects the object in scene queries
+    if (in_json.contains(kQueryLayer)) {
+        object.setQueryLayer(in_json[kQueryLayer].as<int>());
+    }
+
     // metadata
     if (in_json.contains(Schema::Scene2d::kMetadata)) {
         for (auto &&property :
@@ -59,6 +69,22 @@ GameObject makeObject(const jsoncons::json &in_json)
         }
     }
 
+    return object;
+}
+
+//! Creates a new object from a json string.
+/**
+	\param in_json
+	The json to create the object from.
+	\return
+	The object.
+*/
+GameObject makeObject(const jsoncons::json &in_json)
+{
+    using namespace Schema::Scene2d;
+
+    GameObject object = makeBareObject(in_json);
+
     // get its components
     ComponentFactory &componentFactory = ComponentFactory::getInstance();
     for (auto &&componentJson : in_json[kComponents].array_range()) {
@@ -17,6 +17,7 @@ struct ObjectCreationError : public CapEngineException {
 
 // Utility function for making game objects from JSON data in the Scened2d schema.
 GameObject makeObject(const jsoncons::json &in_json);
+GameObject makeBareObject(const jsoncons::json &in_json);
 
 } // namespace CapEngine
 
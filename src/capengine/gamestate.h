@@ -1,6 +1,8 @@
 #ifndef GAMESTATE_H
 #define GAMESTATE_H
 
+#include <memory>
+
 namespace CapEngine {
 
 class GameState {
@@ -19,5 +21,20 @@ protected:
   bool m_enabled = true;
 };
 
+//! A game state that is still being prepared.  See Runner::switchStateWhenReady().
+class PendingGameState {
+public:
+  virtual ~PendingGameState() = default;
+
+  //! Advances the preparation.  Called on the main thread once per frame.
+  /**
+   \return
+     The state once it is ready, null until then.  It is only returned once.
+  */
+  virtual std::shared_ptr<GameState> poll() = 0;
+  //! How far the preparation has got, from 0 to 1.
+  virtual double progress() const = 0;
+};
+
 } // namespace CapEngine
 #endif // GAMESTATE_H
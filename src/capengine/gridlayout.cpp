@@ -97,20 +97,24 @@ std::shared_ptr<GridLayout> GridLayout::create(int numRows, int numColumns,
 //! @copydoc Widget::setPosition()
 void GridLayout::setPosition(int x, int y)
 {
-    m_position.x = x;
-    m_position.y = y;
+    if (x != m_position.x || y != m_position.y) {
+        m_position.x = x;
+        m_position.y = y;
 
-    updateChildren();
+        // the cells keep their size, so only need moving.
+        this->invalidateArrange();
+    }
 }
 
 //! @copydoc Widget::setSize()
 void GridLayout::setSize(int width, int height)
 {
-    m_position.w = width;
-    m_position.h = height;
-    ;
+    if (width != m_position.w || height != m_position.h) {
+        m_position.w = width;
+        m_position.h = height;
 
-    updateChildren();
+        this->invalidateMeasure();
+    }
 }
 
 //! \copydoc Widget::setWindowId
@@ -142,9 +146,11 @@ void GridLayout::update(double ms)
 //! @copydoc Widget::render()
 void GridLayout::render()
 {
-    for (auto&& row : m_widgetGrid) {
-        for (auto&& cell : row) {
-            this->renderWidget(cell.second, cell.first);
+    this->updateLayout();
+
+    for (int i = 0; i < m_numRows; i++) {
+        for (int j = 0; j < m_numColumns; j++) {
+            this->renderWidget(m_widgetGrid[i][j].second, this->getCellBox(i, j));
         }
     }
 }
@@ -261,20 +267,20 @@ void GridLayout::addWidget(std::shared_ptr<Widget> pWidget, int row, int column,
     if (row >= m_numRows || column >= m_numColumns) CAP_THROW(CapEngineException("Index out of bound"));
 
     if (replaceExisting) {
-        m_widgetGrid[row][column] = std::make_pair(SDL_Rect{}, pWidget);
+        m_widgetGrid[row][column].second = pWidget;
         pWidget->setParent(this);
         pWidget->setWindowId(this->m_windowId);
     }
 
     else {
         if (m_widgetGrid[row][column].second == nullptr) {
-            m_widgetGrid[row][column] = std::make_pair(SDL_Rect{}, pWidget);
+            m_widgetGrid[row][column].second = pWidget;
             pWidget->setParent(this);
             pWidget->setWindowId(this->m_windowId);
         }
     }
 
-    this->updateChildren();
+    this->invalidateArrange();
 }
 
 //! Removes a widget
@@ -289,9 +295,9 @@ void GridLayout::removeWidget(int row, int column)
 {
     if (row >= m_numRows || column >= m_numColumns) CAP_THROW(CapEngineException("Index out of bound"));
 
-    m_widgetGrid[row][column] = std::make_pair(SDL_Rect{}, std::shared_ptr<Widget>());
+    m_widgetGrid[row][column].second.reset();
 
-    this->updateChildren();
+    this->invalidate();
 }
 
 //! Replaces a widget in the layout.
@@ -308,14 +314,15 @@ void GridLayout::replaceWidget(std::shared_ptr<Widget> pWidget, int row, int col
 {
     if (row >= m_numRows || column >= m_numColumns) CAP_THROW(CapEngineException("Index out of bound"));
 
-    m_widgetGrid[row][column] = std::make_pair(SDL_Rect{}, std::move(pWidget));
+    if (pWidget != nullptr) {
+        pWidget->setParent(this);
+        pWidget->setWindowId(this->m_windowId);
+    }
+    m_widgetGrid[row][column].second = std::move(pWidget);
 
-    this->updateChildren();
+    this->invalidateArrange();
 }
 
-//! Updates the size and position of children widgets
-void GridLayout::updateChildren() { this->updateCellBoxes(); }
-
 //! \copydoc Widget::getChildren
 std::vector<std::shared_ptr<Widget>> GridLayout::getChildren()
 {
@@ -340,10 +347,11 @@ void GridLayout::setBorder(BorderStyle borderStyle, unsigned int borderWidth)
 {
     m_borderStyle = borderStyle;
     m_borderWidth = borderWidth;
+    this->invalidateArrange();
 }
 
-//! updates the rect of the cells
-void GridLayout::updateCellBoxes()
+//! \copydoc Widget::measure
+void GridLayout::measure()
 {
     int cellWidth = m_position.w / m_numColumns;
     int cellHeight = m_position.h / m_numRows;
@@ -372,12 +380,7 @@ void GridLayout::updateCellBoxes()
             assert(i < m_widgetGrid.size());
             assert(j < m_widgetGrid[i].size());
 
-            SDL_Rect position{x, y, currentCellWidth, currentCellHeight};
-            m_widgetGrid[i][j].first = position;
-
-            if (m_widgetGrid[i][j].second != nullptr) {
-                this->updateWidgetPosition(*m_widgetGrid[i][j].second, position);
-            }
+            m_widgetGrid[i][j].first = SDL_Rect{x, y, currentCellWidth, currentCellHeight};
 
             // increment x position
             x += currentCellWidth;
@@ -388,6 +391,35 @@ void GridLayout::updateCellBoxes()
     }
 }
 
+//! \copydoc Widget::arrange
+void GridLayout::arrange()
+{
+    for (int i = 0; i < m_numRows; i++) {
+        for (int j = 0; j < m_numColumns; j++) {
+            if (m_widgetGrid[i][j].second != nullptr) {
+                this->updateWidgetPosition(*m_widgetGrid[i][j].second, this->getCellBox(i, j));
+            }
+        }
+    }
+}
+
+//! Gets the rect of a cell in the window.
+/**
+ \param row
+   \li The row of the cell.
+ \param column
+   \li The column of the cell.
+ \return
+   \li The cell box including its border.
+*/
+SDL_Rect GridLayout::getCellBox(int row, int column) const
+{
+    SDL_Rect box = m_widgetGrid[row][column].first;
+    box.x += m_position.x;
+    box.y += m_position.y;
+    return box;
+}
+
 //! Updates the position of a child widget.
 /**
  \param widget
@@ -427,7 +459,7 @@ void GridLayout::renderWidget(std::shared_ptr<Widget>& widget, const SDL_Rect& r
                                     Colour{0, 0, 0, 255});
 
     if (widget != nullptr) {
-        widget->render();
+        widget->renderCached();
     }
 }
 
@@ -54,11 +54,13 @@ private:
              boost::optional<std::vector<int>> maybeRowHeights = boost::none,
              boost::optional<std::vector<int>> maybeColWidths = boost::none);
 
-  void updateChildren();
+  void measure() override;
+  void arrange() override;
   void updateWidgetPosition(Widget &widget, const SDL_Rect &rect);
   void renderWidget(std::shared_ptr<Widget> &widget, const SDL_Rect &rect);
-  void updateCellBoxes();
+  SDL_Rect getCellBox(int row, int column) const;
 
+  //! cell box relative to the layout, and the widget in it
   using widgetinfo_t = std::pair<SDL_Rect, std::shared_ptr<Widget>>;
   using widgetgrid_t = std::vector<std::vector<widgetinfo_t>>;
 
@@ -0,0 +1,125 @@
+#include "allocationtracker.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace CapEngine::testing {
+
+namespace {
+
+//! Nesting depth of AllocationCounters on this thread.
+thread_local int t_trackingDepth = 0;
+//! Allocations made on this thread while tracking.
+thread_local std::size_t t_allocationCount = 0;
+
+} // namespace
+
+//! Constructor.  Starts counting allocations on this thread.
+AllocationCounter::AllocationCounter()
+{
+  if (t_trackingDepth++ == 0) {
+    t_allocationCount = 0;
+  }
+}
+
+//! Destructor.  Stops counting allocations on this thread.
+AllocationCounter::~AllocationCounter() { --t_trackingDepth; }
+
+//! Returns the number of allocations made since counting started.
+std::size_t AllocationCounter::count() const { return t_allocationCount; }
+
+//! Returns true if the allocation functions are hooked in this build.
+bool AllocationCounter::enabled()
+{
+#ifdef CAPENGINE_TRACK_ALLOCATIONS
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // namespace CapEngine::testing
+
+#ifdef CAPENGINE_TRACK_ALLOCATIONS
+
+namespace {
+
+void *trackedAllocate(std::size_t in_size, std::size_t in_alignment)
+{
+  using namespace CapEngine::testing;
+
+  if (t_trackingDepth > 0) {
+    ++t_allocationCount;
+  }
+
+  if (in_size == 0) {
+    in_size = 1;
+  }
+
+  void *pointer = nullptr;
+  if (in_alignment <= alignof(std::max_align_t)) {
+    pointer = std::malloc(in_size);
+  } else {
+    const std::size_t rounded = (in_size + in_alignment - 1) & ~(in_alignment - 1);
+    pointer = std::aligned_alloc(in_alignment, rounded);
+  }
+
+  return pointer;
+}
+
+void *trackedAllocateOrThrow(std::size_t in_size, std::size_t in_alignment)
+{
+  void *pointer = trackedAllocate(in_size, in_alignment);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+} // namespace
+
+// replacements for the global allocation functions
+
+void *operator new(std::size_t in_size)
+{
+  return trackedAllocateOrThrow(in_size, alignof(std::max_align_t));
+}
+
+void *operator new[](std::size_t in_size)
+{
+  return trackedAllocateOrThrow(in_size, alignof(std::max_align_t));
+}
+
+void *operator new(std::size_t in_size, std::align_val_t in_alignment)
+{
+  return trackedAllocateOrThrow(in_size, static_cast<std::size_t>(in_alignment));
+}
+
+void *operator new[](std::size_t in_size, std::align_val_t in_alignment)
+{
+  return trackedAllocateOrThrow(in_size, static_cast<std::size_t>(in_alignment));
+}
+
+void *operator new(std::size_t in_size, const std::nothrow_t &) noexcept
+{
+  return trackedAllocate(in_size, alignof(std::max_align_t));
+}
+
+void *operator new[](std::size_t in_size, const std::nothrow_t &) noexcept
+{
+  return trackedAllocate(in_size, alignof(std::max_align_t));
+}
+
+void operator delete(void *in_pointer) noexcept { std::free(in_pointer); }
+void operator delete[](void *in_pointer) noexcept { std::free(in_pointer); }
+void operator delete(void *in_pointer, std::size_t) noexcept { std::free(in_pointer); }
+void operator delete[](void *in_pointer, std::size_t) noexcept { std::free(in_pointer); }
+void operator delete(void *in_pointer, std::align_val_t) noexcept { std::free(in_pointer); }
+void operator delete[](void *in_pointer, std::align_val_t) noexcept { std::free(in_pointer); }
+void operator delete(void *in_pointer, std::size_t, std::align_val_t) noexcept { std::free(in_pointer); }
+void operator delete[](void *in_pointer, std::size_t, std::align_val_t) noexcept { std::free(in_pointer); }
+void operator delete(void *in_pointer, const std::nothrow_t &) noexcept { std::free(in_pointer); }
+void operator delete[](void *in_pointer, const std::nothrow_t &) noexcept { std::free(in_pointer); }
+
+#endif // CAPENGINE_TRACK_ALLOCATIONS
@@ -0,0 +1,29 @@
+#ifndef CAPENGINETESTING_ALLOCATIONTRACKER_H
+#define CAPENGINETESTING_ALLOCATIONTRACKER_H
+
+#include <cstddef>
+
+namespace CapEngine::testing {
+
+//! Counts calls to the global operator new made on the current thread.
+/**
+   Counting only happens when the gtests are built with
+   CAPENGINE_GTEST_TRACK_ALLOCATIONS, which replaces the global allocation
+   functions for the whole test binary.
+*/
+class AllocationCounter final {
+public:
+  AllocationCounter();
+  ~AllocationCounter();
+
+  AllocationCounter(const AllocationCounter &) = delete;
+  AllocationCounter &operator=(const AllocationCounter &) = delete;
+
+  [[nodiscard]] std::size_t count() const;
+
+  static bool enabled();
+};
+
+} // namespace CapEngine::testing
+
+#endif /* CAPENGINETESTING_ALLOCATIONTRACKER_H */
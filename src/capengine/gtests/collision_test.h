@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <optional>
 
 #include "../collision.h"
@@ -191,4 +192,101 @@ TEST(CollisionTest, TestDetectBoxCollision_Simple)
         ASSERT_EQ((Point{1.5, 2.0}), collision->representativePoint);
     }
 }
+
+TEST(CollisionTest, TestDetectSweptBoxCollision)
+{
+    // a thin wall that a discrete check after the move would miss
+    const Rectangle wall{10, 0, 1, 10};
+
+    {
+        Rectangle a{0, 0, 2, 2};
+        const Vector velocity{600.0, 0.0};  // 20 units in a 33.3ms tick
+
+        ASSERT_EQ(std::nullopt, detectBoxCollision(Rectangle{20, 0, 2, 2}, wall));
+
+        const auto collision = detectSweptBoxCollision(a, velocity, 1000.0 / 30.0, wall);
+        ASSERT_NE(std::nullopt, collision);
+        ASSERT_NEAR(0.4, collision->timeOfImpact, 1e-9);
+        ASSERT_EQ(CollisionType::COLLISION_RIGHT, collision->collision.collisionType);
+        ASSERT_EQ((Vector{1.0, 0.0}), collision->collision.collisionNormal);
+    }
+
+    // moving down onto the wall from above
+    {
+        Rectangle a{9, 20, 2, 2};
+        const auto collision = detectSweptBoxCollision(a, Vector{0.0, -200.0}, 100.0, wall);
+        ASSERT_NE(std::nullopt, collision);
+        ASSERT_NEAR(0.5, collision->timeOfImpact, 1e-9);
+        ASSERT_EQ(CollisionType::COLLISION_BOTTOM, collision->collision.collisionType);
+    }
+
+    // moving away or not far enough
+    {
+        Rectangle a{0, 0, 2, 2};
+        ASSERT_EQ(std::nullopt, detectSweptBoxCollision(a, Vector{-600.0, 0.0}, 100.0, wall));
+        ASSERT_EQ(std::nullopt, detectSweptBoxCollision(a, Vector{10.0, 0.0}, 100.0, wall));
+    }
+
+    // passing above the wall
+    {
+        Rectangle a{0, 11, 2, 2};
+        ASSERT_EQ(std::nullopt, detectSweptBoxCollision(a, Vector{600.0, 0.0}, 100.0, wall));
+    }
+}
+
+TEST(CollisionTest, TestBoxSegmentCollision)
+{
+    const Rectangle a{0, 0, 10, 10};
+
+    // a floor through the bottom of the box
+    {
+        const auto collision = detectBoxSegmentCollision(a, Segment{{-5, 2}, {15, 2}});
+        ASSERT_NE(std::nullopt, collision);
+        ASSERT_EQ(CollisionType::COLLISION_BOTTOM, collision->collisionType);
+        ASSERT_EQ((Vector{0.0, -1.0}), collision->collisionNormal);
+        ASSERT_DOUBLE_EQ(2.0, collision->penetration);
+        ASSERT_EQ((Point{5, 2}), collision->representativePoint);
+    }
+
+    // resting on the floor isn't a collision
+    ASSERT_EQ(std::nullopt, detectBoxSegmentCollision(a, Segment{{-5, 0}, {15, 0}}));
+    ASSERT_EQ(std::nullopt, detectBoxSegmentCollision(a, Segment{{-5, 12}, {15, 12}}));
+}
+
+TEST(CollisionTest, TestBoxDiagonalSegmentCollision)
+{
+    const Segment slope{{0, 0}, {10, 10}};
+
+    // inside the bounds of the segment but under the slope
+    ASSERT_EQ(std::nullopt, detectBoxSegmentCollision(Rectangle{6, 0, 4, 4}, slope));
+
+    // the top left corner pokes through the slope
+    const auto collision = detectBoxSegmentCollision(Rectangle{3, 0, 4, 4}, slope);
+    ASSERT_NE(std::nullopt, collision);
+    ASSERT_NEAR(1.0 / std::sqrt(2.0), collision->penetration, 1e-9);
+    ASSERT_NEAR(-1.0 / std::sqrt(2.0), collision->collisionNormal.getX(), 1e-9);
+    ASSERT_NEAR(1.0 / std::sqrt(2.0), collision->collisionNormal.getY(), 1e-9);
+}
+
+TEST(CollisionTest, TestContactManifold)
+{
+    // b resting on top of a, overlapping it by 1 and part of its width
+    const Rectangle a{0, 0, 10, 10};
+    const Rectangle b{4, 9, 10, 10};
+
+    const auto manifold = detectBoxCollisionWithContactManifold(a, b);
+    ASSERT_NE(std::nullopt, manifold);
+    ASSERT_EQ(CollisionType::COLLISION_TOP, manifold->collisionType);
+    ASSERT_DOUBLE_EQ(1.0, manifold->penetration);
+    ASSERT_EQ(2u, manifold->pointCount);
+    ASSERT_EQ((Point{4, 10}), manifold->points[0]);
+    ASSERT_EQ((Point{10, 10}), manifold->points[1]);
+
+    const ContactManifold other = reversed(*manifold);
+    ASSERT_EQ(CollisionType::COLLISION_BOTTOM, other.collisionType);
+    ASSERT_DOUBLE_EQ(-1.0, other.collisionNormal.getY());
+
+    ASSERT_EQ(std::nullopt, detectBoxCollisionWithContactManifold(a, Rectangle{10, 0, 5, 5}));
+}
+
 }  // namespace CapEngine::testing
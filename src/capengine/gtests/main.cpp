@@ -3,11 +3,36 @@
 
 #include "camera2d_test.h"
 #include "collision_test.h"
+#include "test_assetarchive.h"
+#include "test_assetmanager.h"
 #include "test_colour.h"
+#include "test_commandmanager.h"
+#include "test_contactcache.h"
+#include "test_cookedscenes.h"
+#include "test_delegatesignal.h"
+#include "test_eventdispatcher.h"
+#include "test_framearena.h"
+#include "test_gamemanagement.h"
+#include "test_inputrecording.h"
+#include "test_messagebus.h"
+#include "test_metadata.h"
+#include "test_objectpool.h"
+#include "test_scene2dloader.h"
+#include "test_scenequery.h"
+#include "test_slotmap.h"
+#include "test_snapshotbuffer.h"
+#include "test_threadpool.h"
+#include "test_tilecollisiongrid.h"
+#include "test_tilecollisionlayer.h"
 #include "test_tiledmap.h"
 #include "test_tiledobjectgroup.h"
 #include "test_tiledtilelayer.h"
 #include "test_tiledtileset.h"
+#include "test_tileeditcommand.h"
+#include "test_tilegrid.h"
+#include "test_tilerange.h"
+#include "test_vectorcollisionlayer.h"
+#include "test_widget.h"
 #include "testenvironment.h"
 
 int main(int argc, char** argv)
@@ -0,0 +1,175 @@
+#include <capengine/CapEngineException.h>
+#include <capengine/asset_manager.h>
+#include <capengine/assetarchive.h>
+#include <capengine/locator.h>
+#include <gtest/gtest.h>
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <vector>
+
+namespace CapEngine::testing {
+
+namespace {
+
+//! Writes a 2x3 image with one frame row, an animation and a sound to a temporary archive.
+std::filesystem::path writeTestArchive(std::vector<std::byte>& out_pixels, std::vector<short>& out_samples)
+{
+    out_pixels.resize(2 * 3 * 4);
+    for (std::size_t i = 0; i < out_pixels.size(); ++i) {
+        out_pixels[i] = static_cast<std::byte>(i);
+    }
+    out_samples = {1, -2, 3, -4};
+
+    AssetArchiveWriter writer;
+
+    ArchiveImage image;
+    image.id = 7;
+    image.path = "sheet.png";
+    image.pixelFormat = SDL_PIXELFORMAT_ARGB8888;
+    image.width = 2;
+    image.height = 3;
+    image.pitch = 8;
+    image.pixels = out_pixels;
+    image.frames["walk"] = Frame{"walk", 0, 1, 1, 2, 100.0, 0, 0};
+    writer.addImage(image);
+
+    image.kind = AssetKind::Animation;
+    image.id = 8;
+    image.frames.clear();
+    image.numFrames = 3;
+    image.animationTimeMs = 300;
+    writer.addImage(image);
+
+    writer.addSound(9, "jump.wav", out_samples);
+    EXPECT_THROW(writer.addSound(9, "jump.wav", out_samples), CapEngineException);
+
+    auto path = std::filesystem::temp_directory_path() / "capengine_test_archive.cpak";
+    writer.write(path);
+    return path;
+}
+
+//! Changes the first entry of an archive file in place.
+void editFirstEntry(const std::filesystem::path& in_path, const std::function<void(ArchiveEntry&)>& in_edit)
+{
+    std::vector<char> bytes;
+    {
+        std::ifstream stream{in_path, std::ios::binary};
+        bytes.assign(std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{});
+    }
+
+    ArchiveHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    ArchiveEntry entry;
+    std::memcpy(&entry, bytes.data() + header.entriesOffset, sizeof(entry));
+    in_edit(entry);
+    std::memcpy(bytes.data() + header.entriesOffset, &entry, sizeof(entry));
+
+    std::ofstream stream{in_path, std::ios::binary};
+    stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+}  // namespace
+
+TEST(AssetArchiveTest, TestRoundTrip)
+{
+    std::vector<std::byte> pixels;
+    std::vector<short> samples;
+    auto path = writeTestArchive(pixels, samples);
+
+    AssetArchive archive{path};
+    ASSERT_EQ(3, archive.entries().size());
+
+    const ArchiveEntry& image = archive.entries()[0];
+    ASSERT_EQ(AssetKind::Image, image.kind);
+    ASSERT_EQ(7, image.id);
+    ASSERT_EQ("sheet.png", archive.string(image.pathOffset));
+    ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(archive.data(image).data()) % 16);
+    ASSERT_TRUE(std::ranges::equal(pixels, archive.data(image)));
+
+    auto frames = archive.frameMap(image);
+    ASSERT_EQ(1, frames.size());
+    ASSERT_EQ(2, frames.at("walk").numFrames);
+    ASSERT_DOUBLE_EQ(100.0, frames.at("walk").animationTime);
+
+    const ArchiveEntry& animation = archive.entries()[1];
+    ASSERT_EQ(AssetKind::Animation, animation.kind);
+    ASSERT_EQ(3, animation.numFrames);
+    ASSERT_EQ(300, animation.animationTimeMs);
+    ASSERT_TRUE(archive.frames(animation).empty());
+
+    const ArchiveEntry& sound = archive.entries()[2];
+    ASSERT_EQ(AssetKind::Sound, sound.kind);
+    ASSERT_TRUE(std::ranges::equal(std::as_bytes(std::span{samples}), archive.data(sound)));
+
+    std::filesystem::remove(path);
+}
+
+TEST(AssetArchiveTest, TestRejectsCorruptArchive)
+{
+    auto path = std::filesystem::temp_directory_path() / "capengine_test_corrupt.cpak";
+    {
+        std::ofstream stream{path, std::ios::binary};
+        stream << "not an archive, but long enough to hold a header....";
+    }
+
+    ASSERT_THROW(AssetArchive{path}, CapEngineException);
+    std::filesystem::remove(path);
+
+    // entries that can't be loaded, editing the 2x3 ARGB8888 image
+    const std::vector<std::function<void(ArchiveEntry&)>> edits = {
+        [](ArchiveEntry& io_entry) { io_entry.kind = static_cast<AssetKind>(3); },
+        [](ArchiveEntry& io_entry) { io_entry.width = -1; },
+        [](ArchiveEntry& io_entry) { io_entry.pixelFormat = SDL_PIXELFORMAT_UNKNOWN; },
+        [](ArchiveEntry& io_entry) { io_entry.pixelFormat = 0x12345678; },
+        [](ArchiveEntry& io_entry) { io_entry.pixelFormat = SDL_PIXELFORMAT_YV12; },
+        [](ArchiveEntry& io_entry) { io_entry.pitch = 7; },  // still fits the data
+    };
+    for (std::size_t i = 0; i < edits.size(); ++i) {
+        std::vector<std::byte> pixels;
+        std::vector<short> samples;
+        path = writeTestArchive(pixels, samples);
+        ASSERT_NO_THROW(AssetArchive{path});
+
+        editFirstEntry(path, edits[i]);
+        ASSERT_THROW(AssetArchive{path}, CapEngineException) << "edit " << i;
+        std::filesystem::remove(path);
+    }
+}
+
+TEST(AssetArchiveTest, TestMountArchive)
+{
+    std::vector<std::byte> pixels;
+    std::vector<short> samples;
+    auto path = writeTestArchive(pixels, samples);
+
+    AssetManager assets{*Locator::videoManager, *Locator::soundPlayer, std::nullopt, std::nullopt};
+    assets.mountArchive(path);
+
+    ASSERT_TRUE(assets.imageExists(7));
+    ASSERT_EQ(2, assets.getImageWidth(7));
+    ASSERT_EQ(3, assets.getImageHeight(7));
+    ASSERT_EQ(2, assets.getFrame(7, "walk").numFrames);
+
+    auto animation = assets.getAnimatedImage(8);
+    ASSERT_TRUE(animation.has_value());
+    ASSERT_NE(nullptr, animation->texture);
+    ASSERT_EQ(3, animation->numFrames);
+
+    ASSERT_EQ(samples, assets.getSound(9)->pcm->samples());
+
+    // the same ids can't be mounted twice.
+    ASSERT_THROW(assets.mountArchive(path), CapEngineException);
+    std::filesystem::remove(path);
+}
+
+}  // namespace CapEngine::testing
@@ -0,0 +1,116 @@
+#include <capengine/CapEngineException.h>
+#include <capengine/asset_manager.h>
+#include <capengine/locator.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "testutils.h"
+
+namespace CapEngine::testing {
+
+namespace {
+
+//! tileset.png is 480x320.
+constexpr std::size_t kTilesetBytes = 480 * 320 * 4;
+
+std::string tilesetImagePath()
+{
+    return (getTestFilePath() / "tiled" / "tileset.png").string();
+}
+
+}  // namespace
+
+TEST(AssetManagerTest, TestEvictToBudgetEvictsLeastRecentlyUsed)
+{
+    AssetManager assets{*Locator::videoManager, *Locator::soundPlayer, std::nullopt, std::nullopt};
+    assets.loadImage(1, tilesetImagePath());
+    assets.loadImage(2, tilesetImagePath());
+    ASSERT_EQ(2 * kTilesetBytes, assets.memoryUsage().textureBytes);
+
+    // touching 1 leaves 2 as the least recently used.
+    assets.getImage(1);
+    assets.setMemoryBudget(kTilesetBytes, 0);
+    ASSERT_EQ(1, assets.evictToBudget());
+    ASSERT_TRUE(assets.isLoaded(AssetKind::Image, 1));
+    ASSERT_FALSE(assets.isLoaded(AssetKind::Image, 2));
+    ASSERT_EQ(kTilesetBytes, assets.memoryUsage().textureBytes);
+
+    // evicted assets load again on next use.
+    ASSERT_NE(nullptr, assets.getImage(2)->texture);
+    ASSERT_TRUE(assets.isLoaded(AssetKind::Image, 2));
+}
+
+TEST(AssetManagerTest, TestRetainedAssetsAreNotEvicted)
+{
+    AssetManager assets{*Locator::videoManager, *Locator::soundPlayer, std::nullopt, std::nullopt};
+    assets.loadImage(1, tilesetImagePath());
+    assets.loadImage(2, tilesetImagePath());
+
+    assets.retain(AssetKind::Image, 1);
+    ASSERT_EQ(1, assets.evictUnreferenced());
+    ASSERT_TRUE(assets.isLoaded(AssetKind::Image, 1));
+
+    assets.release(AssetKind::Image, 1);
+    ASSERT_EQ(0, assets.referenceCount(AssetKind::Image, 1));
+    ASSERT_EQ(1, assets.evictUnreferenced());
+    ASSERT_EQ(0, assets.memoryUsage().textureBytes);
+}
+
+TEST(AssetManagerTest, TestPreloadHints)
+{
+    AssetManager assets{*Locator::videoManager, *Locator::soundPlayer, std::nullopt, std::nullopt};
+    assets.loadImage(1, tilesetImagePath());
+    assets.evictUnreferenced();
+    ASSERT_FALSE(assets.isLoaded(AssetKind::Image, 1));
+
+    PreloadHints hints;
+    hints.images = {1};
+    assets.preload(hints);
+    ASSERT_EQ(1, assets.referenceCount(AssetKind::Image, 1));
+    ASSERT_EQ(1, assets.loadProgress().total);
+    ASSERT_TRUE(assets.isPending(AssetKind::Image, 1));
+
+    assets.finishLoading();
+    ASSERT_TRUE(assets.isLoaded(AssetKind::Image, 1));
+    ASSERT_FALSE(assets.isPending(AssetKind::Image, 1));
+    ASSERT_TRUE(assets.loadProgress().done());
+
+    assets.release(hints);
+    ASSERT_EQ(0, assets.referenceCount(AssetKind::Image, 1));
+
+    // nothing is retained when a hinted asset doesn't exist.
+    hints.images = {1, 42};
+    ASSERT_THROW(assets.preload(hints), AssetDoesNotExistError);
+    ASSERT_EQ(0, assets.referenceCount(AssetKind::Image, 1));
+}
+
+TEST(AssetManagerTest, TestPreloadMissingImage)
+{
+    // a copy of the tileset that is deleted once it is loaded.
+    const auto path = std::filesystem::temp_directory_path() / "capengine_test_missing.png";
+    std::filesystem::copy_file(tilesetImagePath(), path, std::filesystem::copy_options::overwrite_existing);
+
+    AssetManager assets{*Locator::videoManager, *Locator::soundPlayer, std::nullopt, std::nullopt};
+    assets.loadImage(1, path.string());
+    assets.loadImage(2, tilesetImagePath());
+    assets.evictUnreferenced();
+    std::filesystem::remove(path);
+
+    assets.preloadAll();
+    while (!assets.loadProgress().done()) {
+        ASSERT_NO_THROW(assets.processUploads(1.0));
+        std::this_thread::yield();
+    }
+
+    // the error comes from where the image is used.
+    ASSERT_FALSE(assets.isLoaded(AssetKind::Image, 1));
+    ASSERT_FALSE(assets.isPending(AssetKind::Image, 1));
+    ASSERT_TRUE(assets.isLoaded(AssetKind::Image, 2));
+    ASSERT_THROW(assets.getImage(1), CapEngineException);
+}
+
+}  // namespace CapEngine::testing
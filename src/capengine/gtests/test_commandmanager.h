@@ -0,0 +1,104 @@
+#include <capengine/commandmanager.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+namespace CapEngine::testing {
+
+namespace {
+
+//! Appends to a list when executed and removes it again when undone.
+class AppendCommand final : public Command {
+   public:
+    AppendCommand(std::vector<int>& io_values, int in_value, std::size_t in_size, bool in_mergeable = false)
+        : m_values(io_values), m_appended{in_value}, m_size(in_size), m_mergeable(in_mergeable)
+    {
+    }
+
+    void execute() override { m_values.insert(m_values.end(), m_appended.begin(), m_appended.end()); }
+    void unExecute() override { m_values.resize(m_values.size() - m_appended.size()); }
+    [[nodiscard]] std::size_t byteSize() const override { return m_size; }
+
+    bool merge(Command& io_next) override
+    {
+        auto* pNext = dynamic_cast<AppendCommand*>(&io_next);
+        if (!m_mergeable || pNext == nullptr || !pNext->m_mergeable) {
+            return false;
+        }
+
+        m_appended.insert(m_appended.end(), pNext->m_appended.begin(), pNext->m_appended.end());
+        m_size += pNext->m_size;
+        return true;
+    }
+
+   private:
+    std::vector<int>& m_values;
+    std::vector<int> m_appended;
+    std::size_t m_size;
+    bool m_mergeable;
+};
+
+}  // namespace
+
+TEST(CommandManagerTest, TestDropsOldestOverBudget)
+{
+    std::vector<int> values;
+    CommandManager manager{250};
+    for (int i = 0; i < 4; i++) {
+        manager.runCommand(std::make_unique<AppendCommand>(values, i, 100));
+    }
+
+    ASSERT_EQ(2, manager.getUndoCount());
+    ASSERT_EQ(200, manager.getBytes());
+
+    manager.undo();
+    manager.undo();
+    manager.undo();  // the history is gone, so nothing happens.
+    ASSERT_EQ((std::vector<int>{0, 1}), values);
+
+    // the last command is kept, even when it is over the budget by itself.
+    manager.setMaxBytes(50);
+    ASSERT_EQ(1, manager.getRedoCount());
+    manager.runCommand(std::make_unique<AppendCommand>(values, 5, 500));
+    ASSERT_EQ(1, manager.getUndoCount());
+    ASSERT_EQ(0, manager.getRedoCount());
+    ASSERT_EQ(500, manager.getBytes());
+}
+
+TEST(CommandManagerTest, TestRunningClearsRedo)
+{
+    std::vector<int> values;
+    CommandManager manager;
+    manager.runCommand(std::make_unique<AppendCommand>(values, 1, 10));
+    manager.runCommand(std::make_unique<AppendCommand>(values, 2, 10));
+    manager.undo();
+    ASSERT_EQ(1, manager.getRedoCount());
+
+    manager.runCommand(std::make_unique<AppendCommand>(values, 3, 10));
+    ASSERT_EQ(0, manager.getRedoCount());
+    ASSERT_EQ(20, manager.getBytes());
+
+    manager.redo();
+    ASSERT_EQ((std::vector<int>{1, 3}), values);
+}
+
+TEST(CommandManagerTest, TestMergesConsecutiveCommands)
+{
+    std::vector<int> values;
+    CommandManager manager;
+    manager.runCommand(std::make_unique<AppendCommand>(values, 1, 10));
+    manager.runCommand(std::make_unique<AppendCommand>(values, 2, 10, true));
+    manager.runCommand(std::make_unique<AppendCommand>(values, 3, 10, true));
+    manager.runCommand(std::make_unique<AppendCommand>(values, 4, 10, true));
+
+    ASSERT_EQ(2, manager.getUndoCount());
+    ASSERT_EQ(40, manager.getBytes());
+
+    manager.undo();
+    ASSERT_EQ((std::vector<int>{1}), values);
+    manager.redo();
+    ASSERT_EQ((std::vector<int>{1, 2, 3, 4}), values);
+}
+
+}  // namespace CapEngine::testing
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+
+#include <jsoncons/json.hpp>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "../componentfactory.h"
+#include "../componentutils.h"
+#include "../contactcache.h"
+#include "../scene2d.h"
+
+namespace CapEngine::testing {
+
+namespace {
+
+ContactManifold makeManifold(CollisionType in_side)
+{
+    const Rectangle a{0, 0, 10, 10};
+    const Rectangle b = in_side == COLLISION_TOP ? Rectangle{0, 9, 10, 10} : Rectangle{9, 0, 10, 10};
+    return *detectBoxCollisionWithContactManifold(a, b);
+}
+
+//! A collision a MovingCollider was told about.
+struct RecordedCollision {
+    ObjectID objectId;
+    ObjectID otherObjectId;
+    CollisionType collisionType;
+};
+
+//! Moves an object along x and records the collisions it is told about.
+class MovingCollider final : public PhysicsComponent {
+   public:
+    static inline constexpr char kType[] = "TestMovingCollider";
+
+    explicit MovingCollider(double in_speed) : m_speed(in_speed) {}
+
+    void update(GameObject& io_object, double in_ms) override
+    {
+        Vector position = io_object.getPosition();
+        position.setX(position.getX() + m_speed * (in_ms / 1000.0));
+        io_object.setPosition(position);
+    }
+    [[nodiscard]] std::unique_ptr<Component> clone() const override
+    {
+        return std::make_unique<MovingCollider>(*this);
+    }
+    bool assign(const Component& in_other) override
+    {
+        return assignComponent(*this, in_other);
+    }
+    bool handleCollision(CollisionType in_collisionType, CollisionClass /*in_collisionClass*/, GameObject& in_object,
+                         std::optional<GameObject*> in_otherObject, const Vector& /*collisionLocation*/) override
+    {
+        collisions().push_back(RecordedCollision{in_object.getObjectID(),
+                                                 in_otherObject ? (*in_otherObject)->getObjectID() : -1,
+                                                 in_collisionType});
+        return false;
+    }
+
+    //! Every collision any MovingCollider was told about.
+    static std::vector<RecordedCollision>& collisions()
+    {
+        static std::vector<RecordedCollision> s_collisions;
+        return s_collisions;
+    }
+
+    static void registerConstructor()
+    {
+        auto& factory = ComponentFactory::getInstance();
+        const std::string type = ComponentUtils::componentTypeToString(ComponentType::Physics);
+        if (!factory.findComponentType(type, kType)) {
+            factory.registerComponentType(type, kType, [](const jsoncons::json& in_json) {
+                return std::make_unique<MovingCollider>(in_json["speed"].as<double>());
+            });
+        }
+    }
+
+   private:
+    double m_speed;
+};
+
+//! A fast object that would pass through a thin wall in one frame.
+/**
+ \param in_wallFirst
+   Whether the wall is added before the moving object.
+*/
+jsoncons::json makeWallScene(bool in_wallFirst)
+{
+    const auto mover = jsoncons::json::parse(R"(
+    {"position": {"x": 0, "y": 0}, "continuousCollision": true,
+     "components": [{"type": "Physics", "subtype": "BoxCollider", "box": {"x": 0, "y": 0, "width": 16, "height": 16}},
+                    {"type": "Physics", "subtype": "TestMovingCollider", "speed": 6000}]})");
+    const auto wall = jsoncons::json::parse(R"(
+    {"position": {"x": 60, "y": 0},
+     "components": [{"type": "Physics", "subtype": "BoxCollider", "box": {"x": 0, "y": 0, "width": 16, "height": 16}},
+                    {"type": "Physics", "subtype": "TestMovingCollider", "speed": 0}]})");
+
+    jsoncons::json scene = jsoncons::json::parse(R"({"width": 640, "height": 480, "layers": [], "objects": []})");
+    scene["objects"].push_back(in_wallFirst ? wall : mover);
+    scene["objects"].push_back(in_wallFirst ? mover : wall);
+    return scene;
+}
+
+}  // namespace
+
+TEST(ContactCacheTest, TestEnterStayExit)
+{
+    ContactCache cache;
+    std::vector<Contact> exited;
+    auto onExit = [&](const Contact& in_contact) { exited.push_back(in_contact); };
+
+    cache.beginFrame();
+    ASSERT_EQ(ContactPhase::Enter, cache.touch(2, 1, makeManifold(COLLISION_TOP)));
+    cache.endFrame(onExit);
+    ASSERT_EQ(1u, cache.size());
+
+    cache.beginFrame();
+    ASSERT_EQ(ContactPhase::Stay, cache.touch(1, 2, reversed(makeManifold(COLLISION_TOP))));
+    cache.endFrame(onExit);
+    ASSERT_TRUE(exited.empty());
+
+    // stored from the lower id's point of view
+    const Contact* pContact = cache.find(2, 1);
+    ASSERT_NE(nullptr, pContact);
+    ASSERT_EQ(1, pContact->object1);
+    ASSERT_EQ(2, pContact->object2);
+    ASSERT_EQ(CollisionType::COLLISION_BOTTOM, pContact->manifold.collisionType);
+
+    cache.beginFrame();
+    cache.endFrame(onExit);
+    ASSERT_EQ(1u, exited.size());
+    ASSERT_EQ(1, exited[0].object1);
+    ASSERT_EQ(0u, cache.size());
+    ASSERT_EQ(nullptr, cache.find(1, 2));
+}
+
+TEST(ContactCacheTest, TestImpulsesAreKeptForWarmStarting)
+{
+    ContactCache cache;
+    auto ignore = [](const Contact&) {};
+
+    cache.beginFrame();
+    cache.touch(1, 2, makeManifold(COLLISION_TOP));
+    cache.find(1, 2)->normalImpulses = {3.0, 4.0};
+    cache.endFrame(ignore);
+
+    cache.beginFrame();
+    cache.touch(1, 2, makeManifold(COLLISION_TOP));
+    cache.endFrame(ignore);
+    ASSERT_DOUBLE_EQ(3.0, cache.find(1, 2)->normalImpulses[0]);
+
+    // touching on another side starts again
+    cache.beginFrame();
+    ASSERT_EQ(ContactPhase::Stay, cache.touch(1, 2, makeManifold(COLLISION_RIGHT)));
+    cache.endFrame(ignore);
+    ASSERT_DOUBLE_EQ(0.0, cache.find(1, 2)->normalImpulses[0]);
+}
+
+TEST(ContactCacheTest, TestTouchedThisFrame)
+{
+    ContactCache cache;
+    auto ignore = [](const Contact&) {};
+
+    cache.beginFrame();
+    ASSERT_FALSE(cache.touchedThisFrame(1, 2));
+    cache.touch(1, 2, makeManifold(COLLISION_TOP));
+    ASSERT_TRUE(cache.touchedThisFrame(2, 1));
+    cache.endFrame(ignore);
+
+    // still cached but not touched yet
+    cache.beginFrame();
+    ASSERT_NE(nullptr, cache.find(1, 2));
+    ASSERT_FALSE(cache.touchedThisFrame(1, 2));
+    cache.endFrame(ignore);
+}
+
+TEST(ContactCacheTest, TestSweptObjectTouchesWall)
+{
+    MovingCollider::registerConstructor();
+
+    for (const bool wallFirst : {false, true}) {
+        MovingCollider::collisions().clear();
+        Scene2d scene{makeWallScene(wallFirst)};
+
+        // 96 pixels in one frame would take the box from -8..8 past the
+        // wall at 52..68, so it is stopped touching it instead
+        scene.update(16.0);
+        ASSERT_EQ(1u, scene.contacts().size()) << "wall first: " << wallFirst;
+        ASSERT_EQ(2u, MovingCollider::collisions().size()) << "wall first: " << wallFirst;
+
+        const RecordedCollision moverCollision =
+            MovingCollider::collisions()[0].collisionType == COLLISION_RIGHT ? MovingCollider::collisions()[0]
+                                                                             : MovingCollider::collisions()[1];
+        const RecordedCollision wallCollision =
+            MovingCollider::collisions()[0].collisionType == COLLISION_RIGHT ? MovingCollider::collisions()[1]
+                                                                             : MovingCollider::collisions()[0];
+        ASSERT_EQ(COLLISION_RIGHT, moverCollision.collisionType);
+        ASSERT_EQ(COLLISION_LEFT, wallCollision.collisionType);
+        ASSERT_EQ(moverCollision.objectId, wallCollision.otherObjectId);
+
+        const Contact* pContact = scene.contacts().find(moverCollision.objectId, wallCollision.objectId);
+        ASSERT_NE(nullptr, pContact);
+        ASSERT_DOUBLE_EQ(0.0, pContact->manifold.penetration);
+        ASSERT_EQ(2u, pContact->manifold.pointCount);
+
+        // still pushing against the wall so the contact stays and the
+        // handlers aren't told again
+        scene.update(16.0);
+        ASSERT_EQ(1u, scene.contacts().size());
+        ASSERT_EQ(2u, MovingCollider::collisions().size());
+    }
+}
+
+}  // namespace CapEngine::testing
@@ -0,0 +1,121 @@
+#include <capengine/CapEngineException.h>
+#include <capengine/cookedscenes.h>
+#include <capengine/scene2dschema.h>
+#include <gtest/gtest.h>
+
+#include <jsoncons/json.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace CapEngine::testing {
+
+namespace {
+
+//! Two scenes sharing a layer type and a component type.
+const char* kTestScenes = R"({
+  "scenes": [
+    {
+      "id": "first",
+      "width": 640,
+      "height": 480,
+      "preload": { "images": [1, 2] },
+      "layers": [
+        { "type": "imagelayer", "order": 1, "assetId": 1 },
+        { "type": "tilecollisionlayer", "order": 0, "queryLayer": 3 }
+      ],
+      "objects": [
+        {
+          "position": { "x": 10, "y": 20 },
+          "components": [
+            { "type": "graphics", "subtype": "placeholder", "width": 8, "height": 8 },
+            { "type": "physics", "subtype": "rigidbody" }
+          ]
+        },
+        { "components": [ { "type": "graphics", "subtype": "placeholder", "width": 4, "height": 4 } ] }
+      ]
+    },
+    {
+      "id": "second",
+      "width": 320,
+      "height": 240,
+      "layers": [ { "type": "imagelayer", "order": 0, "assetId": 2 } ],
+      "objects": []
+    }
+  ]
+})";
+
+}  // namespace
+
+TEST(CookedScenesTest, TestRoundTrip)
+{
+    const jsoncons::json descriptors = jsoncons::json::parse(std::string(kTestScenes));
+    const jsoncons::json& source = descriptors[Schema::Scene2d::kScenes][0];
+
+    CookedScenesWriter writer;
+    writer.addScenes(descriptors);
+    auto path = std::filesystem::temp_directory_path() / "capengine_test_scenes.cscene";
+    writer.write(path);
+
+    CookedScenes scenes{path};
+    ASSERT_EQ(2, scenes.scenes().size());
+    ASSERT_EQ(nullptr, scenes.findScene("third"));
+
+    // each type is stored once however many records use it.
+    ASSERT_EQ(4, scenes.types().size());
+
+    const CookedSceneRecord* pFirst = scenes.findScene("first");
+    ASSERT_NE(nullptr, pFirst);
+    ASSERT_EQ(640, pFirst->width);
+    ASSERT_EQ(480, pFirst->height);
+    ASSERT_EQ(source["preload"], scenes.decode(pFirst->preload));
+
+    auto layers = scenes.layers(*pFirst);
+    ASSERT_EQ(2, layers.size());
+    ASSERT_EQ(1, layers[0].order);
+    ASSERT_EQ(0, layers[0].hasQueryLayer);
+    ASSERT_EQ(1, layers[1].hasQueryLayer);
+    ASSERT_EQ(3, layers[1].queryLayer);
+    ASSERT_EQ("tilecollisionlayer", scenes.string(scenes.types()[layers[1].typeIndex].typeOffset));
+    ASSERT_EQ(source["layers"][0], scenes.decode(layers[0].json));
+    ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(layers.data()) % alignof(CookedLayer));
+
+    auto objects = scenes.objects(*pFirst);
+    ASSERT_EQ(2, objects.size());
+    ASSERT_FALSE(scenes.decode(objects[0].json).contains("components"));
+    ASSERT_EQ(source["objects"][0]["position"], scenes.decode(objects[0].json)["position"]);
+
+    auto components = scenes.components(objects[0]);
+    ASSERT_EQ(2, components.size());
+    const CookedSceneType& rigidBody = scenes.types()[components[1].typeIndex];
+    ASSERT_EQ(CookedTypeKind::Component, rigidBody.kind);
+    ASSERT_EQ("physics", scenes.string(rigidBody.typeOffset));
+    ASSERT_EQ("rigidbody", scenes.string(rigidBody.subtypeOffset));
+    ASSERT_EQ(components[0].typeIndex, scenes.components(objects[1])[0].typeIndex);
+
+    const CookedSceneRecord* pSecond = scenes.findScene("second");
+    ASSERT_NE(nullptr, pSecond);
+    ASSERT_EQ(0, pSecond->preload.size);
+    ASSERT_TRUE(scenes.decode(pSecond->preload).is_null());
+    ASSERT_EQ(layers[0].typeIndex, scenes.layers(*pSecond)[0].typeIndex);
+    ASSERT_TRUE(scenes.objects(*pSecond).empty());
+
+    std::filesystem::remove(path);
+}
+
+TEST(CookedScenesTest, TestRejectsCorruptFile)
+{
+    auto path = std::filesystem::temp_directory_path() / "capengine_test_corrupt.cscene";
+    {
+        std::ofstream stream{path, std::ios::binary};
+        stream << "not a cooked scene file, but long enough to hold a header, which is a little over one hundred "
+                  "bytes long";
+    }
+
+    ASSERT_THROW(CookedScenes{path}, CapEngineException);
+    std::filesystem::remove(path);
+}
+
+}  // namespace CapEngine::testing
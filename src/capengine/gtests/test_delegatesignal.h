@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "../delegatesignal.h"
+
+namespace CapEngine::testing {
+
+TEST(DelegateSignalTest, TestEmitInOrder)
+{
+    Signal<void(int)> signal;
+    std::vector<int> calls;
+
+    // more slots than are stored inline.
+    for (int i = 0; i < 6; i++) {
+        signal.connect([&calls, i](int in_value) { calls.push_back(i * 10 + in_value); });
+    }
+    ASSERT_EQ(6, signal.numSlots());
+
+    signal(1);
+    ASSERT_EQ((std::vector<int>{1, 11, 21, 31, 41, 51}), calls);
+}
+
+TEST(DelegateSignalTest, TestDisconnect)
+{
+    Signal<void(int)> signal;
+    int total = 0;
+
+    Connection first = signal.connect([&total](int in_value) { total += in_value; });
+    {
+        ScopedConnection second = signal.connect([&total](int in_value) { total += in_value * 100; });
+        signal(1);
+        ASSERT_EQ(101, total);
+        ASSERT_TRUE(second.connected());
+    }
+    ASSERT_EQ(1, signal.numSlots());
+
+    signal(1);
+    ASSERT_EQ(102, total);
+
+    first.disconnect();
+    ASSERT_FALSE(first.connected());
+    ASSERT_TRUE(signal.empty());
+    signal(1);
+    ASSERT_EQ(102, total);
+}
+
+TEST(DelegateSignalTest, TestDisconnectDuringEmit)
+{
+    Signal<void()> signal;
+    std::vector<int> calls;
+
+    Connection second;
+    signal.connect([&]() {
+        calls.push_back(1);
+        second.disconnect();
+    });
+    second = signal.connect([&]() { calls.push_back(2); });
+    Connection third;
+    third = signal.connect([&]() {
+        calls.push_back(3);
+        third.disconnect();
+        signal.connect([&]() { calls.push_back(4); });
+    });
+
+    // the slot disconnected earlier in the emission is skipped, the one
+    // connected during it waits for the next.
+    signal();
+    ASSERT_EQ((std::vector<int>{1, 3}), calls);
+    ASSERT_EQ(2, signal.numSlots());
+
+    calls.clear();
+    signal();
+    ASSERT_EQ((std::vector<int>{1, 4}), calls);
+}
+
+TEST(DelegateSignalTest, TestSlotThrows)
+{
+    Signal<void()> signal;
+    std::vector<int> calls;
+
+    Connection throwing = signal.connect([&]() {
+        signal.connect([&]() { calls.push_back(2); });
+        throw std::runtime_error("slot failed");
+    });
+    ASSERT_THROW(signal(), std::runtime_error);
+
+    // the emission still ended, so the slot connected during it is added.
+    throwing.disconnect();
+    ASSERT_EQ(1, signal.numSlots());
+    signal();
+    ASSERT_EQ((std::vector<int>{2}), calls);
+}
+
+TEST(DelegateSignalTest, TestSlotDestroysSignal)
+{
+    auto pSignal = std::make_unique<Signal<void(int)>>();
+    int total = 0;
+
+    pSignal->connect([&](int in_value) {
+        total += in_value;
+        pSignal.reset();
+    });
+    pSignal->connect([&](int in_value) { total += in_value; });
+
+    (*pSignal)(5);
+    ASSERT_EQ(nullptr, pSignal);
+    ASSERT_EQ(10, total);
+}
+
+TEST(DelegateSignalTest, TestConnectionOutlivesSignal)
+{
+    Connection connection;
+    ScopedConnection scoped;
+    {
+        Signal<void()> signal;
+        connection = signal.connect([]() {});
+        scoped = signal.connect([]() {});
+        ASSERT_TRUE(connection.connected());
+    }
+
+    ASSERT_FALSE(connection.connected());
+    connection.disconnect();
+    ASSERT_FALSE(scoped.connected());
+}
+
+}  // namespace CapEngine::testing
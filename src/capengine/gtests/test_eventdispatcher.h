@@ -0,0 +1,105 @@
+#include <capengine/EventDispatcher.h>
+#include <capengine/locator.h>
+#include <gtest/gtest.h>
+
+#include <SDL2/SDL.h>
+
+#include <functional>
+#include <vector>
+
+namespace CapEngine::testing {
+
+namespace {
+
+//! Records the events it receives.
+class RecordingSubscriber final : public IEventSubscriber {
+   public:
+    void receiveEvent(SDL_Event in_event, Time* /*in_time*/) override
+    {
+        events.push_back(in_event);
+        if (onEvent) {
+            onEvent();
+        }
+    }
+
+    std::vector<SDL_Event> events;
+    std::function<void()> onEvent;
+};
+
+SDL_Event mouseMotion(int in_x, int in_y, int in_xrel, int in_yrel)
+{
+    SDL_Event event{};
+    event.type = SDL_MOUSEMOTION;
+    event.motion.x = in_x;
+    event.motion.y = in_y;
+    event.motion.xrel = in_xrel;
+    event.motion.yrel = in_yrel;
+    return event;
+}
+
+SDL_Event axisMotion(Uint8 in_axis, Sint16 in_value)
+{
+    SDL_Event event{};
+    event.type = SDL_CONTROLLERAXISMOTION;
+    event.caxis.axis = in_axis;
+    event.caxis.value = in_value;
+    return event;
+}
+
+}  // namespace
+
+TEST(EventDispatcherTest, TestCoalescesMotion)
+{
+    EventDispatcher& dispatcher = Locator::getEventDispatcher();
+    RecordingSubscriber subscriber;
+    dispatcher.subscribe(&subscriber, mouseEvent | controllerEvent);
+
+    SDL_Event button{};
+    button.type = SDL_MOUSEBUTTONDOWN;
+    SDL_Event key{};
+    key.type = SDL_KEYDOWN;
+
+    dispatcher.enqueue(mouseMotion(1, 1, 1, 1));
+    dispatcher.enqueue(key);
+    dispatcher.enqueue(mouseMotion(2, 3, 1, 2));
+    dispatcher.enqueue(button);
+    dispatcher.enqueue(mouseMotion(4, 4, 2, 1));
+    dispatcher.enqueue(axisMotion(0, 100));
+    dispatcher.enqueue(axisMotion(1, 200));
+    dispatcher.enqueue(axisMotion(0, 300));
+    dispatcher.flushQueue();
+    dispatcher.unsubscribe(&subscriber);
+
+    // keyboard events don't reach it, and motion isn't merged across the click.
+    ASSERT_EQ(5, subscriber.events.size());
+    ASSERT_EQ(SDL_MOUSEMOTION, subscriber.events[0].type);
+    ASSERT_EQ(2, subscriber.events[0].motion.x);
+    ASSERT_EQ(3, subscriber.events[0].motion.y);
+    ASSERT_EQ(2, subscriber.events[0].motion.xrel);
+    ASSERT_EQ(3, subscriber.events[0].motion.yrel);
+    ASSERT_EQ(SDL_MOUSEBUTTONDOWN, subscriber.events[1].type);
+    ASSERT_EQ(4, subscriber.events[2].motion.x);
+    ASSERT_EQ(0, subscriber.events[3].caxis.axis);
+    ASSERT_EQ(300, subscriber.events[3].caxis.value);
+    ASSERT_EQ(1, subscriber.events[4].caxis.axis);
+    ASSERT_EQ(200, subscriber.events[4].caxis.value);
+}
+
+TEST(EventDispatcherTest, TestUnsubscribeWhileDispatching)
+{
+    EventDispatcher& dispatcher = Locator::getEventDispatcher();
+    RecordingSubscriber subscriber;
+    subscriber.onEvent = [&]() { dispatcher.unsubscribe(&subscriber); };
+    dispatcher.subscribe(&subscriber, keyboardEvent);
+
+    SDL_Event key{};
+    key.type = SDL_KEYDOWN;
+    dispatcher.enqueue(key);
+    dispatcher.enqueue(key);
+    dispatcher.flushQueue();
+
+    ASSERT_EQ(1, subscriber.events.size());
+    ASSERT_FALSE(dispatcher.hasEvents());
+}
+
+}  // namespace CapEngine::testing
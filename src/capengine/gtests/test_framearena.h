@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <jsoncons/json.hpp>
+#include <memory_resource>
+#include <vector>
+
+#include "../framearena.h"
+#include "../scene2d.h"
+#include "allocationtracker.h"
+
+namespace CapEngine::testing {
+
+TEST(FrameArenaTest, TestAllocatesFromBlock)
+{
+    FrameArena arena{1024};
+
+    std::pmr::vector<int> values{&arena};
+    values.reserve(16);
+    ASSERT_EQ(16 * sizeof(int), arena.used());
+    ASSERT_EQ(1024, arena.capacity());
+}
+
+TEST(FrameArenaTest, TestGrowsAfterOverflow)
+{
+    FrameArena arena{64};
+
+    {
+        std::pmr::vector<double> values{&arena};
+        values.reserve(32);
+        ASSERT_EQ(32 * sizeof(double), arena.used());
+    }
+
+    arena.reset();
+    ASSERT_EQ(0, arena.used());
+    ASSERT_GE(arena.capacity(), 32 * sizeof(double));
+    ASSERT_GE(arena.highWaterMark(), 32 * sizeof(double));
+}
+
+TEST(FrameArenaTest, TestSteadyStateFramesDoNotAllocate)
+{
+    if (!AllocationCounter::enabled()) {
+        GTEST_SKIP() << "gtests were built without CAPENGINE_GTEST_TRACK_ALLOCATIONS";
+    }
+
+    jsoncons::json sceneJson = jsoncons::json::parse(R"(
+{
+  "width": 640,
+  "height": 480,
+  "layers": [],
+  "objects": []
+}
+)");
+
+    // a mix of overlapping and separate objects so the collision path runs
+    for (int i = 0; i < 32; i++) {
+        jsoncons::json object = jsoncons::json::parse(R"(
+{
+  "components": [
+    {"type": "Physics", "subtype": "BoxCollider", "box": {"x": 0, "y": 0, "width": 16, "height": 16}}
+  ]
+}
+)");
+        jsoncons::json position;
+        position["x"] = (i % 8) * 12;
+        position["y"] = (i / 8) * 40;
+        object["position"] = position;
+        sceneJson["objects"].push_back(object);
+    }
+
+    Scene2d scene{sceneJson};
+
+    const double timestepMs = 16.0;
+    const int warmupTicks = 10;
+    for (int i = 0; i < warmupTicks; i++) {
+        scene.update(timestepMs);
+    }
+
+    const int measuredTicks = 60;
+    AllocationCounter counter;
+    for (int i = 0; i < measuredTicks; i++) {
+        scene.update(timestepMs);
+    }
+
+    ASSERT_EQ(0, counter.count());
+}
+
+}  // namespace CapEngine::testing
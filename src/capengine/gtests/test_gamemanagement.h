@@ -0,0 +1,28 @@
+#include <capengine/game_management.h>
+#include <capengine/locator.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+namespace CapEngine::testing {
+
+TEST(GameManagementTest, TestInitTimings)
+{
+    // the test environment starts everything up front.
+    const auto& timings = getInitTimings();
+    for (const std::string name : {"video", "audio", "fonts", "controllers"}) {
+        auto timing = std::ranges::find(timings, name, &SubsystemTiming::name);
+        ASSERT_NE(timings.end(), timing) << name;
+        ASSERT_GE(timing->ms, 0.0);
+        ASSERT_FALSE(timing->lazy);
+    }
+
+    // starting an already started subsystem does nothing.
+    const std::size_t count = timings.size();
+    ASSERT_EQ(Locator::soundPlayer, initAudio());
+    ASSERT_EQ(Locator::fontManager, &Locator::getFontManager());
+    ASSERT_EQ(count, getInitTimings().size());
+}
+
+}  // namespace CapEngine::testing
@@ -0,0 +1,83 @@
+#include <capengine/CapEngineException.h>
+#include <capengine/inputrecording.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace CapEngine::testing {
+
+TEST(InputRecordingTest, TestRoundTrip)
+{
+    auto path = std::filesystem::temp_directory_path() / "capengine_test_input.rec";
+
+    SDL_Event key{};
+    key.key.type = SDL_KEYDOWN;
+    key.key.windowID = 1;
+    key.key.keysym.sym = SDLK_SPACE;
+
+    SDL_Event text{};
+    text.text.type = SDL_TEXTINPUT;
+    std::strcpy(text.text.text, "a");
+
+    SDL_Event user{};
+    user.user.type = SDL_USEREVENT;
+
+    {
+        InputRecorder recorder{path, 1234, 16.67};
+        recorder.record(key);
+        recorder.record(user);  // can't be replayed, so isn't recorded.
+#if SDL_VERSION_ATLEAST(2, 0, 22)
+        SDL_Event editing{};
+        editing.editExt.type = SDL_TEXTEDITING_EXT;
+        recorder.record(editing);  // points at text SDL allocated, so isn't either.
+#endif
+        recorder.endFrame(2);
+        recorder.endFrame(0);
+        recorder.record(text);
+        recorder.endFrame(1);
+        ASSERT_EQ(3, recorder.frameCount());
+    }
+
+    InputPlayback playback{path};
+    ASSERT_EQ(1234, playback.seed());
+    ASSERT_DOUBLE_EQ(16.67, playback.msPerUpdate());
+    ASSERT_EQ(3, playback.frameCount());
+
+    ASSERT_TRUE(playback.nextFrame());
+    ASSERT_EQ(2, playback.updates());
+    ASSERT_EQ(1, playback.events().size());
+    ASSERT_EQ(0, std::memcmp(&key.key, &playback.events()[0].key, sizeof(SDL_KeyboardEvent)));
+
+    ASSERT_TRUE(playback.nextFrame());
+    ASSERT_EQ(0, playback.updates());
+    ASSERT_TRUE(playback.events().empty());
+
+    ASSERT_TRUE(playback.nextFrame());
+    ASSERT_EQ(1, playback.updates());
+    ASSERT_EQ(1, playback.events().size());
+    ASSERT_STREQ("a", playback.events()[0].text.text);
+
+    ASSERT_FALSE(playback.nextFrame());
+    std::filesystem::remove(path);
+}
+
+TEST(InputRecordingTest, TestRejectsTruncatedFile)
+{
+    auto path = std::filesystem::temp_directory_path() / "capengine_test_truncated.rec";
+    {
+        InputRecorder recorder{path, 1, 16.67};
+        SDL_Event quit{};
+        quit.type = SDL_QUIT;
+        recorder.record(quit);
+        recorder.endFrame(1);
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+    InputPlayback playback{path};
+    ASSERT_THROW(playback.nextFrame(), CapEngineException);
+    std::filesystem::remove(path);
+}
+
+}  // namespace CapEngine::testing
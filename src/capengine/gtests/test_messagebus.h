@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "../components.h"
+#include "../messagebus.h"
+#include "../simpleobjectmanager.h"
+
+namespace CapEngine::testing {
+
+namespace {
+
+struct DamageMessage {
+    int amount;
+    double x;
+    double y;
+};
+
+//! Records the damage messages it receives.
+class DamageCounter final : public CustomComponent {
+   public:
+    void update(GameObject& /*object*/, double /*timestep*/) override {}
+    void receive(GameObject& /*object*/, const Message& in_message) override
+    {
+        m_total += in_message.as<DamageMessage>().amount;
+        m_received++;
+    }
+    [[nodiscard]] std::unique_ptr<Component> clone() const override
+    {
+        return std::make_unique<DamageCounter>(*this);
+    }
+
+    int m_total = 0;
+    int m_received = 0;
+};
+
+std::shared_ptr<GameObject> makeTarget(MessageId in_messageId, GameObject::ObjectType in_type,
+                                       std::shared_ptr<DamageCounter>& out_pCounter)
+{
+    auto pObject = std::make_shared<GameObject>();
+    pObject->setObjectType(in_type);
+    out_pCounter = std::make_shared<DamageCounter>();
+    out_pCounter->subscribe(in_messageId);
+    pObject->addComponent(out_pCounter);
+    return pObject;
+}
+
+}  // namespace
+
+TEST(MessageBusTest, TestMessagesAreQueuedUntilDispatch)
+{
+    const MessageId damageId = GameObject::generateMessageId();
+    SimpleObjectManager objectManager;
+    MessageBus messageBus;
+
+    std::shared_ptr<DamageCounter> pCounter;
+    auto pObject = makeTarget(damageId, GameObject::ObjectType_AI, pCounter);
+    objectManager.addObject(pObject);
+
+    messageBus.post(pObject->getObjectID(), Message::make(damageId, DamageMessage{3, 1.0, 2.0}));
+    messageBus.post(pObject->getObjectID(), Message::make(damageId, DamageMessage{4, 1.0, 2.0}));
+    ASSERT_EQ(2, messageBus.pending());
+    ASSERT_EQ(0, pCounter->m_received);
+
+    messageBus.dispatch(objectManager);
+    ASSERT_EQ(0, messageBus.pending());
+    ASSERT_EQ(2, pCounter->m_received);
+    ASSERT_EQ(7, pCounter->m_total);
+}
+
+TEST(MessageBusTest, TestUnsubscribedComponentsAreSkipped)
+{
+    const MessageId damageId = GameObject::generateMessageId();
+    const MessageId otherId = GameObject::generateMessageId();
+    SimpleObjectManager objectManager;
+    MessageBus messageBus;
+
+    std::shared_ptr<DamageCounter> pCounter;
+    auto pObject = makeTarget(damageId, GameObject::ObjectType_AI, pCounter);
+    objectManager.addObject(pObject);
+
+    messageBus.post(pObject->getObjectID(), Message::make(otherId, DamageMessage{3, 0.0, 0.0}));
+    messageBus.dispatch(objectManager);
+    ASSERT_EQ(0, pCounter->m_received);
+}
+
+TEST(MessageBusTest, TestBroadcastToObjectType)
+{
+    const MessageId damageId = GameObject::generateMessageId();
+    SimpleObjectManager objectManager;
+    MessageBus messageBus;
+
+    std::shared_ptr<DamageCounter> pFirstAi;
+    std::shared_ptr<DamageCounter> pSecondAi;
+    std::shared_ptr<DamageCounter> pPlayer;
+    objectManager.addObject(makeTarget(damageId, GameObject::ObjectType_AI, pFirstAi));
+    objectManager.addObject(makeTarget(damageId, GameObject::ObjectType_AI, pSecondAi));
+    objectManager.addObject(makeTarget(damageId, GameObject::ObjectType_Player, pPlayer));
+
+    messageBus.broadcast(GameObject::ObjectType_AI, Message::make(damageId, DamageMessage{5, 0.0, 0.0}));
+    messageBus.dispatch(objectManager);
+
+    ASSERT_EQ(5, pFirstAi->m_total);
+    ASSERT_EQ(5, pSecondAi->m_total);
+    ASSERT_EQ(0, pPlayer->m_received);
+}
+
+}  // namespace CapEngine::testing
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <variant>
+
+#include "../gameobject.h"
+#include "../metadata.h"
+#include "../stringinterner.h"
+
+namespace CapEngine::testing {
+
+TEST(StringInternerTest, TestSameStringSameId)
+{
+    StringId first{"interner-test-key"};
+    StringId second{std::string{"interner-test-key"}};
+    StringId other{"interner-test-other-key"};
+
+    ASSERT_EQ(first, second);
+    ASSERT_NE(first, other);
+    ASSERT_EQ("interner-test-key", first.str());
+    ASSERT_EQ("", StringId{}.str());
+}
+
+TEST(StringInternerTest, TestFindDoesNotIntern)
+{
+    StringInterner& interner = StringInterner::getInstance();
+    const std::size_t size = interner.size();
+
+    ASSERT_EQ(std::nullopt, interner.find("interner-test-never-interned"));
+    ASSERT_EQ(size, interner.size());
+
+    MetadataMap metadata;
+    ASSERT_EQ(nullptr, metadata.find("interner-test-never-interned"));
+    ASSERT_EQ(size, interner.size());
+
+    StringId id{"interner-test-found"};
+    ASSERT_EQ(id, interner.find("interner-test-found"));
+}
+
+TEST(MetadataMapTest, TestSetAndFind)
+{
+    MetadataMap metadata;
+    metadata.set("health", 10);
+    metadata.set("name", std::string{"cat"});
+    metadata.set("speed", 2.5);
+    metadata.set("health", 20);
+
+    ASSERT_EQ(3, metadata.size());
+    ASSERT_EQ(20, std::get<int>(*metadata.find("health")));
+    ASSERT_EQ("cat", std::get<std::string>(*metadata.find(StringId{"name"})));
+    ASSERT_EQ(nullptr, metadata.find("missing"));
+
+    ASSERT_TRUE(metadata.erase(StringId{"speed"}));
+    ASSERT_FALSE(metadata.contains(StringId{"speed"}));
+    ASSERT_EQ(2, metadata.size());
+}
+
+TEST(MetadataMapTest, TestGameObjectCopiesMetadata)
+{
+    GameObject object;
+    object.setMetadata("team", std::string{"red"});
+
+    GameObject copy = object;
+    ASSERT_EQ(object.metadata(), copy.metadata());
+    ASSERT_EQ("red", std::get<std::string>(*copy.metadata().find("team")));
+}
+
+}  // namespace CapEngine::testing
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <any>
+#include <jsoncons/json.hpp>
+#include <memory>
+
+#include "../boxcollider.h"
+#include "../locator.h"
+#include "../objectpool.h"
+#include "../scene2d.h"
+#include "../simpleobjectmanager.h"
+
+namespace CapEngine::testing {
+
+namespace {
+
+std::unique_ptr<GameObject> makePrototype(Vector in_velocity = Vector{1.0, 2.0})
+{
+    auto pPrototype = std::make_unique<GameObject>(false);
+    pPrototype->addComponent(std::make_shared<BoxCollider>(Rectangle{0, 0, 10, 10}));
+    pPrototype->setVelocity(in_velocity);
+    return pPrototype;
+}
+
+}  // namespace
+
+TEST(ObjectPoolTest, TestReserve)
+{
+    ObjectPool pool{makePrototype(), 4};
+    ASSERT_EQ(4, pool.available());
+    ASSERT_EQ(4, pool.created());
+
+    std::shared_ptr<GameObject> pObject = pool.acquire();
+    ASSERT_EQ(3, pool.available());
+    ASSERT_EQ(&pool, pObject->getPool());
+    ASSERT_EQ(1, pObject->getComponents().size());
+}
+
+TEST(ObjectPoolTest, TestReleaseRecyclesObjectAndComponents)
+{
+    ObjectPool pool{makePrototype()};
+
+    std::shared_ptr<GameObject> pObject = pool.acquire();
+    const GameObject* pRawObject = pObject.get();
+    const Component* pRawComponent = pObject->getComponents()[0].get();
+    const ObjectID firstId = pObject->getObjectID();
+
+    pObject->setPosition(Vector{50.0, 60.0});
+    pObject->setObjectState(GameObject::Dead);
+    pool.release(std::move(pObject));
+    ASSERT_EQ(1, pool.available());
+
+    std::shared_ptr<GameObject> pRecycled = pool.acquire();
+    ASSERT_EQ(pRawObject, pRecycled.get());
+    ASSERT_EQ(pRawComponent, pRecycled->getComponents()[0].get());
+    ASSERT_NE(firstId, pRecycled->getObjectID());
+    ASSERT_EQ(GameObject::Active, pRecycled->getObjectState());
+    ASSERT_EQ((Vector{0.0, 0.0}), pRecycled->getPosition());
+    ASSERT_EQ((Vector{1.0, 2.0}), pRecycled->getVelocity());
+    ASSERT_EQ(1, pool.created());
+}
+
+TEST(ObjectPoolTest, TestSharedObjectsAreNotRecycled)
+{
+    ObjectPool pool{makePrototype()};
+
+    std::shared_ptr<GameObject> pObject = pool.acquire();
+    std::shared_ptr<GameObject> pOtherReference = pObject;
+    pool.release(std::move(pObject));
+
+    ASSERT_EQ(0, pool.available());
+}
+
+TEST(ObjectPoolTest, TestCopiesDontBelongToThePool)
+{
+    ObjectPool pool{makePrototype()};
+    std::shared_ptr<GameObject> pObject = pool.acquire();
+
+    auto pCopy = std::make_shared<GameObject>(*pObject);
+    std::shared_ptr<GameObject> pClone = pObject->clone();
+    ASSERT_EQ(nullptr, pCopy->getPool());
+    ASSERT_EQ(nullptr, pClone->getPool());
+
+    pool.release(std::move(pCopy));
+    pool.release(std::move(pClone));
+    ASSERT_EQ(0, pool.available());
+
+    // assigning to a pooled object leaves it in its pool.
+    *pObject = GameObject{};
+    ASSERT_EQ(&pool, pObject->getPool());
+}
+
+TEST(ObjectPoolTest, TestObjectManagerReturnsDeadObjects)
+{
+    ObjectPool pool{makePrototype()};
+    SimpleObjectManager objectManager;
+
+    objectManager.addObject(pool.acquire());
+    objectManager.addObject(pool.acquire());
+    objectManager.getObjects()[0]->setObjectState(GameObject::Dead);
+
+    objectManager.removeDeadObjects();
+    ASSERT_EQ(1, objectManager.getObjects().size());
+    ASSERT_EQ(1, pool.available());
+}
+
+TEST(ObjectPoolTest, TestSceneUpdateKeepsPools)
+{
+    ObjectPool pool{makePrototype()};
+    ObjectPool otherPool{makePrototype(Vector{3.0, 4.0})};
+
+    Scene2d scene{jsoncons::json::parse(R"({"width": 640, "height": 480, "layers": [], "objects": []})")};
+    auto pObjectManager = std::any_cast<std::shared_ptr<ObjectManager>>(
+        Locator::locate(ObjectManager::kObjectManagerLocatorId));
+
+    std::shared_ptr<GameObject> pObject = pool.acquire();
+    std::shared_ptr<GameObject> pOtherObject = otherPool.acquire();
+    pObject->setPosition(Vector{100.0, 100.0});
+    pOtherObject->setPosition(Vector{300.0, 100.0});
+    const GameObject* pRawObject = pObject.get();
+    const GameObject* pRawOtherObject = pOtherObject.get();
+    pObjectManager->addObject(pObject);
+    pObjectManager->addObject(pOtherObject);
+
+    // updating copies each object to scratch and swaps it back
+    scene.update(16.0);
+    ASSERT_EQ(&pool, pObject->getPool());
+    ASSERT_EQ(&otherPool, pOtherObject->getPool());
+
+    pObject->setObjectState(GameObject::Dead);
+    pOtherObject->setObjectState(GameObject::Dead);
+    pObject.reset();
+    pOtherObject.reset();
+    scene.update(16.0);
+    ASSERT_EQ(1, pool.available());
+    ASSERT_EQ(1, otherPool.available());
+
+    // each object went back to its own pool and prototype
+    std::shared_ptr<GameObject> pRecycled = pool.acquire();
+    std::shared_ptr<GameObject> pOtherRecycled = otherPool.acquire();
+    ASSERT_EQ(pRawObject, pRecycled.get());
+    ASSERT_EQ(pRawOtherObject, pOtherRecycled.get());
+    ASSERT_EQ((Vector{1.0, 2.0}), pRecycled->getVelocity());
+    ASSERT_EQ((Vector{3.0, 4.0}), pOtherRecycled->getVelocity());
+}
+
+}  // namespace CapEngine::testing
@@ -0,0 +1,85 @@
+#include <capengine/asset_manager.h>
+#include <capengine/defer.h>
+#include <capengine/locator.h>
+#include <capengine/scene2dloader.h>
+#include <capengine/scene2dstate.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include "testenvironment.h"
+#include "testutils.h"
+
+namespace CapEngine::testing {
+
+namespace {
+
+//! Writes a scene file with one empty scene.
+std::filesystem::path writeTestSceneFile()
+{
+    auto path = std::filesystem::temp_directory_path() / "capengine_test_loader_scenes.json";
+    std::ofstream stream{path};
+    stream << R"({ "scenes": [ { "id": "empty", "width": 64, "height": 32, "layers": [], "objects": [] } ] })";
+    return path;
+}
+
+//! Polls until the loader produces a state, giving up after a few seconds.
+std::shared_ptr<GameState> pollUntilReady(PendingGameState& io_loader)
+{
+    for (int i = 0; i < 500; ++i) {
+        if (auto pState = io_loader.poll()) {
+            return pState;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return nullptr;
+}
+
+}  // namespace
+
+TEST(Scene2dLoaderTest, TestLoadsInBackground)
+{
+    auto path = writeTestSceneFile();
+    Scene2dLoader loader{path, "empty", TestEnvironment::instance()->getWindowId()};
+
+    auto pState = pollUntilReady(loader);
+    ASSERT_NE(nullptr, std::dynamic_pointer_cast<Scene2dState>(pState));
+    ASSERT_DOUBLE_EQ(1.0, loader.progress());
+
+    // the state is only handed over once.
+    ASSERT_EQ(nullptr, loader.poll());
+    std::filesystem::remove(path);
+}
+
+TEST(Scene2dLoaderTest, TestMissingSceneThrowsFromPoll)
+{
+    auto path = writeTestSceneFile();
+    Scene2dLoader loader{path, "missing", TestEnvironment::instance()->getWindowId()};
+
+    ASSERT_THROW(pollUntilReady(loader), SceneDoesNotExistException);
+    std::filesystem::remove(path);
+}
+
+TEST(Scene2dLoaderTest, TestFailedSceneReleasesPreloadedAssets)
+{
+    AssetManager assets{*Locator::videoManager, *Locator::soundPlayer, std::nullopt, std::nullopt};
+    assets.loadImage(1, (getTestFilePath() / "tiled" / "tileset.png").string());
+    Defer restoreAssetManager{[pOldAssetManager = Locator::assetManager]() { Locator::assetManager = pOldAssetManager; }};
+    Locator::assetManager = &assets;
+
+    // the layer can't be made, so the scene throws after the preload.
+    auto descriptors = jsoncons::json::parse(R"(
+{ "scenes": [ { "id": "broken", "width": 64, "height": 32, "preload": { "images": [1] },
+                "layers": [ { "type": "NoSuchLayer", "order": 0 } ], "objects": [] } ] })");
+    ASSERT_THROW(Scene2dState(descriptors, "broken", TestEnvironment::instance()->getWindowId()),
+                 CapEngineException);
+    ASSERT_EQ(0, assets.referenceCount(AssetKind::Image, 1));
+}
+
+}  // namespace CapEngine::testing
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <jsoncons/json.hpp>
+#include <optional>
+#include <vector>
+
+#include "../scene2d.h"
+#include "../scenequery.h"
+
+namespace CapEngine::testing {
+
+namespace {
+
+//! Two boxes either side of a vertical wall at x = 100.
+jsoncons::json makeQueryScene()
+{
+    return jsoncons::json::parse(R"(
+{
+  "width": 640,
+  "height": 480,
+  "layers": [
+    {"type": "VectorCollisionLayer", "order": 0, "queryLayer": 1,
+     "polylines": [[{"x": 100, "y": -100}, {"x": 100, "y": 100}]]}
+  ],
+  "objects": [
+    {"position": {"x": 50, "y": 10},
+     "components": [{"type": "Physics", "subtype": "BoxCollider", "box": {"x": 0, "y": 0, "width": 16, "height": 16}}]},
+    {"position": {"x": 150, "y": 10}, "queryLayer": 2,
+     "components": [{"type": "Physics", "subtype": "BoxCollider", "box": {"x": 0, "y": 0, "width": 16, "height": 16}}]}
+  ]
+}
+)");
+}
+
+}  // namespace
+
+TEST(SceneQueryTest, TestRaycastIsSortedByDistance)
+{
+    Scene2d scene{makeQueryScene()};
+    std::vector<QueryHit> hits;
+
+    ASSERT_EQ(3u, scene.query().raycast(Point{0, 10}, Vector{1.0, 0.0}, 200.0, hits));
+    ASSERT_DOUBLE_EQ(42.0, hits[0].distance);
+    ASSERT_DOUBLE_EQ(-1.0, hits[0].normal.getX());
+    ASSERT_NE(-1, hits[0].objectId);
+    ASSERT_FALSE(hits[0].object.isNull());
+
+    ASSERT_DOUBLE_EQ(100.0, hits[1].distance);
+    ASSERT_NE(nullptr, hits[1].pLayer);
+    ASSERT_TRUE(hits[1].object.isNull());
+
+    ASSERT_DOUBLE_EQ(142.0, hits[2].distance);
+
+    // too short to reach anything
+    ASSERT_EQ(0u, scene.query().raycast(Point{0, 10}, Vector{1.0, 0.0}, 40.0, hits));
+}
+
+TEST(SceneQueryTest, TestRejectsInvalidQueryLayer)
+{
+    jsoncons::json scene = makeQueryScene();
+    scene["layers"][0]["queryLayer"] = 32;
+    ASSERT_THROW(Scene2d{scene}, SceneLoadException);
+
+    scene["layers"][0]["queryLayer"] = -1;
+    ASSERT_THROW(Scene2d{scene}, SceneLoadException);
+}
+
+TEST(SceneQueryTest, TestFilters)
+{
+    Scene2d scene{makeQueryScene()};
+    std::vector<QueryHit> hits;
+
+    QueryFilter closest;
+    closest.maxHits = 1;
+    ASSERT_EQ(1u, scene.query().segmentCast(Point{0, 10}, Point{200, 10}, hits, closest));
+    ASSERT_DOUBLE_EQ(42.0, hits[0].distance);
+
+    // skip the first box, which is on query layer 0
+    QueryFilter masked;
+    masked.layerMask = (1u << 1) | (1u << 2);
+    ASSERT_EQ(2u, scene.query().segmentCast(Point{0, 10}, Point{200, 10}, hits, masked));
+    ASSERT_NE(nullptr, hits[0].pLayer);
+
+    QueryFilter ignoring;
+    ignoring.layers = false;
+    scene.query().segmentCast(Point{0, 10}, Point{200, 10}, hits);
+    ignoring.ignoreObject = hits[0].objectId;
+    ASSERT_EQ(1u, scene.query().segmentCast(Point{0, 10}, Point{200, 10}, hits, ignoring));
+    ASSERT_DOUBLE_EQ(142.0, hits[0].distance);
+}
+
+TEST(SceneQueryTest, TestBoxCastAndOverlap)
+{
+    Scene2d scene{makeQueryScene()};
+    std::vector<QueryHit> hits;
+
+    ASSERT_EQ(3u, scene.query().boxCast(Rectangle{0, 8, 4, 4}, Vector{200.0, 0.0}, hits));
+    ASSERT_DOUBLE_EQ(38.0, hits[0].distance);
+    ASSERT_DOUBLE_EQ(96.0, hits[1].distance);
+
+    ASSERT_EQ(1u, scene.query().overlapQuery(Rectangle{90, 0, 20, 20}, hits));
+    ASSERT_NE(nullptr, hits[0].pLayer);
+
+    ASSERT_EQ(2u, scene.query().overlapQuery(Rectangle{40, 0, 100, 20}, hits));
+    ASSERT_NE(nullptr, hits[0].pLayer);
+    ASSERT_NE(-1, hits[1].objectId);
+}
+
+TEST(SceneQueryTest, TestRaycastBatch)
+{
+    Scene2d scene{makeQueryScene()};
+
+    const std::vector<Ray> rays{Ray{Point{0, 10}, Vector{1.0, 0.0}, 200.0}, Ray{Point{0, 10}, Vector{0.0, 1.0}, 200.0},
+                                Ray{Point{120, 10}, Vector{1.0, 0.0}, 200.0}};
+    std::vector<std::optional<QueryHit>> closest;
+    scene.query().raycastBatch(rays, closest);
+
+    ASSERT_EQ(3u, closest.size());
+    ASSERT_TRUE(closest[0].has_value());
+    ASSERT_DOUBLE_EQ(42.0, closest[0]->distance);
+    ASSERT_FALSE(closest[1].has_value());
+    ASSERT_TRUE(closest[2].has_value());
+    ASSERT_DOUBLE_EQ(22.0, closest[2]->distance);
+}
+
+}  // namespace CapEngine::testing
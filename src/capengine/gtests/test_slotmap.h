@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "../gameobject.h"
+#include "../simpleobjectmanager.h"
+#include "../slotmap.h"
+
+namespace CapEngine::testing {
+
+TEST(SlotMapTest, TestInsertAndGet)
+{
+    SlotMap<std::string> slotMap;
+    auto first = slotMap.insert("first");
+    auto second = slotMap.insert("second");
+
+    ASSERT_EQ(2, slotMap.size());
+    ASSERT_EQ("first", *slotMap.get(first));
+    ASSERT_EQ("second", *slotMap.get(second));
+    ASSERT_EQ(nullptr, slotMap.get(Handle<std::string>{}));
+}
+
+TEST(SlotMapTest, TestEraseKeepsValuesPacked)
+{
+    SlotMap<int> slotMap;
+    auto first = slotMap.insert(1);
+    auto second = slotMap.insert(2);
+    auto third = slotMap.insert(3);
+
+    ASSERT_TRUE(slotMap.erase(first));
+    ASSERT_FALSE(slotMap.erase(first));
+    ASSERT_EQ(2, slotMap.size());
+    ASSERT_EQ(3, slotMap.values()[0]);
+    ASSERT_EQ(third, slotMap.handleAt(0));
+    ASSERT_EQ(2, *slotMap.get(second));
+    ASSERT_EQ(3, *slotMap.get(third));
+}
+
+TEST(SlotMapTest, TestStaleHandleIsRejected)
+{
+    SlotMap<int> slotMap;
+    auto stale = slotMap.insert(1);
+    slotMap.erase(stale);
+
+    auto reused = slotMap.insert(2);
+    ASSERT_EQ(stale.index(), reused.index());
+    ASSERT_NE(stale, reused);
+    ASSERT_FALSE(slotMap.contains(stale));
+    ASSERT_EQ(nullptr, slotMap.get(stale));
+    ASSERT_EQ(2, *slotMap.get(reused));
+}
+
+TEST(SlotMapTest, TestObjectManagerHandles)
+{
+    SimpleObjectManager objectManager;
+    auto pFirst = std::make_shared<GameObject>();
+    auto pSecond = std::make_shared<GameObject>();
+    const ObjectID secondId = pSecond->getObjectID();
+
+    ObjectHandle firstHandle = objectManager.addObject(pFirst);
+    ObjectHandle secondHandle = objectManager.addObject(pSecond);
+    ASSERT_EQ(pFirst.get(), objectManager.getObject(firstHandle));
+    ASSERT_EQ(secondHandle, objectManager.getHandle(secondId));
+
+    pFirst->setObjectState(GameObject::Dead);
+    objectManager.removeDeadObjects();
+
+    ASSERT_EQ(nullptr, objectManager.getObject(firstHandle));
+    ASSERT_EQ(pSecond.get(), objectManager.getObject(secondHandle));
+    ASSERT_EQ(pSecond.get(), objectManager.findObject(secondId));
+}
+
+}  // namespace CapEngine::testing
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "../simpleobjectmanager.h"
+#include "../snapshotbuffer.h"
+
+namespace CapEngine::testing {
+
+namespace {
+
+//! Moves every object along by its velocity.
+void step(SimpleObjectManager& io_objectManager)
+{
+    for (auto&& pObject : io_objectManager.getObjects()) {
+        pObject->setPosition(pObject->getPosition() + pObject->getVelocity());
+    }
+}
+
+}  // namespace
+
+TEST(SnapshotBufferTest, TestRestoreAndResimulate)
+{
+    SimpleObjectManager objectManager;
+    for (int i = 0; i < 10; i++) {
+        auto pObject = std::make_shared<GameObject>();
+        pObject->setVelocity(Vector{1.0 * i, 2.0});
+        objectManager.addObject(pObject);
+    }
+
+    SnapshotBuffer snapshots{16};
+    for (uint64_t frame = 0; frame < 20; frame++) {
+        step(objectManager);
+        snapshots.capture(frame, objectManager);
+    }
+
+    ASSERT_EQ(16, snapshots.size());
+    ASSERT_EQ(4, snapshots.oldestFrame());
+    ASSERT_FALSE(snapshots.contains(3));
+
+    const Vector finalPosition = objectManager.getObjects()[3]->getPosition();
+
+    // roll back 8 frames, then resimulate to where we were
+    ASSERT_TRUE(snapshots.restore(11, objectManager));
+    ASSERT_DOUBLE_EQ(36.0, objectManager.getObjects()[3]->getPosition().getX());
+    ASSERT_DOUBLE_EQ(24.0, objectManager.getObjects()[3]->getPosition().getY());
+    ASSERT_EQ(11, snapshots.latestFrame());
+
+    for (uint64_t frame = 12; frame < 20; frame++) {
+        step(objectManager);
+        snapshots.capture(frame, objectManager);
+    }
+
+    ASSERT_EQ(finalPosition, objectManager.getObjects()[3]->getPosition());
+}
+
+TEST(SnapshotBufferTest, TestUnchangedFramesAreSmall)
+{
+    SimpleObjectManager objectManager;
+    for (int i = 0; i < 100; i++) {
+        objectManager.addObject(std::make_shared<GameObject>());
+    }
+
+    SnapshotBuffer snapshots{4};
+    snapshots.capture(0, objectManager);
+    const std::size_t wholeFrameBytes = snapshots.bytesUsed();
+
+    snapshots.capture(1, objectManager);
+    ASSERT_LT(snapshots.bytesUsed() - wholeFrameBytes, 16);
+}
+
+TEST(SnapshotBufferTest, TestRestoreUnknownFrame)
+{
+    SimpleObjectManager objectManager;
+    SnapshotBuffer snapshots;
+    ASSERT_FALSE(snapshots.restore(0, objectManager));
+}
+
+}  // namespace CapEngine::testing
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include "../threadpool.h"
+
+namespace CapEngine::testing {
+
+TEST(ThreadPoolTest, TestSubmitReturnsResults)
+{
+    ThreadPool pool{3};
+    ASSERT_EQ(3, pool.threadCount());
+
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 32; ++i) {
+        futures.push_back(pool.submit([i]() { return i * i; }));
+    }
+
+    for (int i = 0; i < 32; ++i) {
+        ASSERT_EQ(i * i, futures[i].get());
+    }
+}
+
+TEST(ThreadPoolTest, TestExceptionIsRethrownFromFuture)
+{
+    ThreadPool pool{1};
+    auto future = pool.submit([]() -> int { throw std::runtime_error("decode failed"); });
+    ASSERT_THROW(future.get(), std::runtime_error);
+
+    // the worker survives the exception.
+    ASSERT_EQ(7, pool.submit([]() { return 7; }).get());
+}
+
+}  // namespace CapEngine::testing
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <jsoncons/json.hpp>
+#include <utility>
+#include <vector>
+
+#include "../CapEngineException.h"
+#include "../tilecollisiongrid.h"
+#include "../tiledmap.h"
+#include "testutils.h"
+
+namespace CapEngine::testing {
+
+TEST(TileCollisionGridTest, TestSetSolid)
+{
+    TileCollisionGrid grid{100, 3, 16, 16};
+    grid.setSolid(0, 0, true);
+    grid.setSolid(99, 2, true);
+
+    ASSERT_TRUE(grid.isSolid(0, 0));
+    ASSERT_TRUE(grid.isSolid(99, 2));
+    ASSERT_FALSE(grid.isSolid(1, 0));
+    ASSERT_FALSE(grid.isSolid(100, 2));
+    ASSERT_FALSE(grid.isSolid(-1, 0));
+
+    grid.setSolid(0, 0, false);
+    ASSERT_FALSE(grid.isSolid(0, 0));
+}
+
+TEST(TileCollisionGridTest, TestOnlyOverlappedTilesAreVisited)
+{
+    TileCollisionGrid grid{130, 4, 16, 16};
+    for (int column = 0; column < grid.columns(); column++) {
+        grid.setSolid(column, 3, true);
+    }
+    grid.setSolid(65, 1, true);
+
+    std::vector<std::pair<int, int>> tiles;
+    // covers columns 63 to 66 and rows 1 to 3, crossing a word boundary
+    grid.forEachSolidTile(Rectangle{63 * 16 + 4, 20, 50, 40},
+                          [&](int in_column, int in_row) { tiles.emplace_back(in_column, in_row); });
+
+    const std::vector<std::pair<int, int>> expected{{65, 1}, {63, 3}, {64, 3}, {65, 3}, {66, 3}};
+    ASSERT_EQ(expected, tiles);
+}
+
+TEST(TileCollisionGridTest, TestEdgesDoNotOverlap)
+{
+    TileCollisionGrid grid{4, 4, 16, 16};
+    grid.setSolid(1, 0, true);
+
+    // touching the left edge of the solid tile only
+    ASSERT_FALSE(grid.anySolid(Rectangle{0, 0, 16, 16}));
+    ASSERT_TRUE(grid.anySolid(Rectangle{0, 0, 17, 16}));
+    ASSERT_FALSE(grid.anySolid(Rectangle{-100, -100, 10, 10}));
+}
+
+namespace {
+
+//! All of the solid tiles in a grid, row major.
+std::vector<std::pair<int, int>> solidTiles(const TileCollisionGrid& in_grid)
+{
+    std::vector<std::pair<int, int>> tiles;
+    in_grid.forEachSolidTile(
+        Rectangle{0, 0, static_cast<double>(in_grid.columns() * in_grid.tileWidth()),
+                  static_cast<double>(in_grid.rows() * in_grid.tileHeight())},
+        [&](int in_column, int in_row) { tiles.emplace_back(in_column, in_row); });
+    return tiles;
+}
+
+}  // namespace
+
+TEST(TileCollisionGridTest, TestFromTiledFile)
+{
+    const auto grid = TileCollisionGrid::fromTiledFile(getTestFilePath() / "tiled" / "collisionmap.json");
+    ASSERT_EQ(4, grid.columns());
+    ASSERT_EQ(3, grid.rows());
+    ASSERT_EQ(16, grid.tileWidth());
+    ASSERT_EQ(16, grid.tileHeight());
+
+    // a solid tile from the external tileset, one from the inline tileset and
+    // every tile in the solid layer
+    const std::vector<std::pair<int, int>> expected{{1, 0}, {2, 1}, {0, 2}, {1, 2}, {3, 2}};
+    ASSERT_EQ(expected, solidTiles(grid));
+}
+
+TEST(TileCollisionGridTest, TestFromTiledMapMatchesJson)
+{
+    const std::filesystem::path mapPath = getTestFilePath() / "tiled" / "collisionmap.json";
+    const TiledMap map{mapPath};
+
+    const auto grid = TileCollisionGrid::fromTiledMap(map);
+    ASSERT_EQ(4, grid.columns());
+    ASSERT_EQ(3, grid.rows());
+    ASSERT_EQ(solidTiles(TileCollisionGrid::fromTiledFile(mapPath)), solidTiles(grid));
+}
+
+TEST(TileCollisionGridTest, TestSolidProperty)
+{
+    const auto json = jsoncons::json::parse(R"({
+        "width": 4, "height": 1, "tilewidth": 8, "tileheight": 8,
+        "tilesets": [
+            {"firstgid": 1, "tiles": [
+                {"id": 0, "properties": [{"name": "capengine-collision", "type": "bool", "value": true}]},
+                {"id": 1, "properties": [{"name": "capengine-collision", "type": "bool", "value": false}]},
+                {"id": 2, "properties": [{"name": "other", "type": "bool", "value": true}]}
+            ]},
+            {"firstgid": 10, "tiles": [
+                {"id": 1, "properties": [{"name": "capengine-collision", "type": "bool", "value": true}]}
+            ]}
+        ],
+        "layers": [
+            {"type": "tilelayer", "width": 4, "height": 1, "data": [2147483649, 2, 3, 11]},
+            {"type": "tilelayer", "width": 4, "height": 1, "data": [0, 10, 0, 0],
+             "properties": [{"name": "capengine-collision", "type": "bool", "value": false}]},
+            {"type": "objectgroup", "objects": []}
+        ]
+    })");
+
+    // the flipped tile and the tile in the second tileset are solid, tile 10
+    // is the first tile of the second tileset and isn't
+    const auto grid = TileCollisionGrid::fromTiledJson(json);
+    const std::vector<std::pair<int, int>> expected{{0, 0}, {3, 0}};
+    ASSERT_EQ(expected, solidTiles(grid));
+}
+
+TEST(TileCollisionGridTest, TestMissingFirstGid)
+{
+    const auto json = jsoncons::json::parse(R"({
+        "width": 1, "height": 1, "tilewidth": 8, "tileheight": 8,
+        "tilesets": [{"tiles": []}],
+        "layers": []
+    })");
+
+    ASSERT_THROW(TileCollisionGrid::fromTiledJson(json), CapEngineException);
+}
+
+}  // namespace CapEngine::testing
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "../boxcollider.h"
+#include "../components.h"
+#include "../gameobject.h"
+#include "../tilecollisionlayer.h"
+
+namespace CapEngine::testing {
+
+namespace {
+
+//! Records the collisions an object is told about.
+class CollisionRecorder final : public PhysicsComponent {
+   public:
+    explicit CollisionRecorder(bool in_handles) : m_handles(in_handles) {}
+
+    void update(GameObject& /*object*/, double /*timestep*/) override {}
+    [[nodiscard]] std::unique_ptr<Component> clone() const override
+    {
+        return std::make_unique<CollisionRecorder>(*this);
+    }
+    bool handleCollision(CollisionType in_collisionType, CollisionClass in_collisionClass, GameObject& /*in_object*/,
+                         std::optional<GameObject*> /*in_otherObject*/, const Vector& /*collisionLocation*/) override
+    {
+        collisions.push_back(in_collisionType);
+        classes.push_back(in_collisionClass);
+        return m_handles;
+    }
+
+    std::vector<CollisionType> collisions;
+    std::vector<CollisionClass> classes;
+
+   private:
+    bool m_handles;
+};
+
+//! A 4x4 map of 16 pixel tiles with one solid tile.
+TileCollisionLayer makeLayer(int in_column, int in_row, Vector in_position = Vector{0.0, 0.0})
+{
+    TileCollisionGrid grid{4, 4, 16, 16};
+    grid.setSolid(in_column, in_row, true);
+    return TileCollisionLayer{std::move(grid), in_position};
+}
+
+//! A 10x10 object centered on a position.
+GameObject makeObject(Vector in_position, YAxisOrientation in_orientation,
+                      const std::shared_ptr<CollisionRecorder>& in_pRecorder)
+{
+    GameObject object{false};
+    object.addComponent(std::make_shared<BoxCollider>(Rectangle{0, 0, 10, 10}));
+    object.addComponent(in_pRecorder);
+    object.setYAxisOrientation(in_orientation);
+    object.setPosition(in_position);
+    return object;
+}
+
+}  // namespace
+
+TEST(TileCollisionLayerTest, TestCheckCollisions)
+{
+    const TileCollisionLayer layer = makeLayer(1, 1);
+    auto pRecorder = std::make_shared<CollisionRecorder>(false);
+
+    // box from 12 to 22 going into the tile from 16 to 32 on the left
+    const GameObject object = makeObject(Vector{17.0, 24.0}, YAxisOrientation::TopZero, pRecorder);
+    const auto collisions = layer.checkCollisions(object);
+    ASSERT_EQ(1u, collisions.size());
+    ASSERT_EQ(CollisionType::COLLISION_RIGHT, collisions.begin()->first);
+
+    // only touching the edge of the tile
+    const GameObject touching = makeObject(Vector{11.0, 24.0}, YAxisOrientation::TopZero, pRecorder);
+    ASSERT_TRUE(layer.checkCollisions(touching).empty());
+
+    const GameObject clear = makeObject(Vector{50.0, 50.0}, YAxisOrientation::TopZero, pRecorder);
+    ASSERT_TRUE(layer.checkCollisions(clear).empty());
+}
+
+TEST(TileCollisionLayerTest, TestOrientationAndPosition)
+{
+    // the top row of the map, which is at the top of the world with
+    // TopZero and at the bottom with BottomZero
+    const TileCollisionLayer layer = makeLayer(1, 0, Vector{100.0, 0.0});
+    auto pRecorder = std::make_shared<CollisionRecorder>(false);
+
+    const GameObject topZero = makeObject(Vector{124.0, 8.0}, YAxisOrientation::TopZero, pRecorder);
+    ASSERT_EQ(1u, layer.checkCollisions(topZero).size());
+
+    const GameObject bottomZero = makeObject(Vector{124.0, 8.0}, YAxisOrientation::BottomZero, pRecorder);
+    ASSERT_TRUE(layer.checkCollisions(bottomZero).empty());
+
+    const GameObject bottomZeroTop = makeObject(Vector{124.0, 56.0}, YAxisOrientation::BottomZero, pRecorder);
+    ASSERT_EQ(1u, layer.checkCollisions(bottomZeroTop).size());
+
+    // without the position offset
+    const GameObject unmoved = makeObject(Vector{24.0, 8.0}, YAxisOrientation::TopZero, pRecorder);
+    ASSERT_TRUE(layer.checkCollisions(unmoved).empty());
+}
+
+TEST(TileCollisionLayerTest, TestResolveCollisions)
+{
+    const TileCollisionLayer layer = makeLayer(1, 1);
+    auto pRecorder = std::make_shared<CollisionRecorder>(false);
+    GameObject object = makeObject(Vector{17.0, 24.0}, YAxisOrientation::TopZero, pRecorder);
+
+    ASSERT_TRUE(layer.resolveCollisions(object));
+
+    // pushed back out of the left of the tile
+    ASSERT_EQ(1u, pRecorder->collisions.size());
+    ASSERT_EQ(CollisionType::COLLISION_RIGHT, pRecorder->collisions[0]);
+    ASSERT_EQ(CollisionClass::COLLISION_WALL, pRecorder->classes[0]);
+    ASSERT_DOUBLE_EQ(11.0, object.getPosition().getX());
+    ASSERT_DOUBLE_EQ(24.0, object.getPosition().getY());
+    ASSERT_FALSE(layer.overlaps(object.boundingPolygon(), YAxisOrientation::TopZero));
+}
+
+TEST(TileCollisionLayerTest, TestResolveCollisionsHandledByObject)
+{
+    const TileCollisionLayer layer = makeLayer(1, 1);
+    auto pRecorder = std::make_shared<CollisionRecorder>(true);
+    GameObject object = makeObject(Vector{17.0, 24.0}, YAxisOrientation::TopZero, pRecorder);
+
+    ASSERT_TRUE(layer.resolveCollisions(object));
+
+    // the object handled it so wasn't moved
+    ASSERT_EQ(1u, pRecorder->collisions.size());
+    ASSERT_DOUBLE_EQ(17.0, object.getPosition().getX());
+    ASSERT_DOUBLE_EQ(24.0, object.getPosition().getY());
+}
+
+}  // namespace CapEngine::testing
@@ -0,0 +1,258 @@
+#include <capengine/commandmanager.h>
+#include <capengine/map2d.h>
+#include <capengine/simplecommand.h>
+#include <capengine/tileeditcommand.h>
+#include <capengine/tilegrid.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+#include "testutils.h"
+
+namespace CapEngine::testing {
+
+namespace {
+
+//! Loads a 4x4 map of 32 pixel tiles, all index 0, from a tileset of 4 tiles.
+std::shared_ptr<Map2D> makeMap()
+{
+    const auto tileSetPath = std::filesystem::temp_directory_path() / "capengine_test_tileedit_tileset.json";
+    {
+        const auto imagePath = getTestFilePath() / "tiled" / "tileset.png";
+        std::ofstream stream{tileSetPath};
+        stream << R"({"imagePath": ")" << imagePath.generic_string()
+               << R"(", "numTiles": 4, "tileWidth": 32, "tileHeight": 32, "tiles": [)";
+        for (int i = 0; i < 4; i++) {
+            stream << (i == 0 ? "" : ",") << R"({"type": "Normal", "position": {"x": )" << i * 32
+                   << R"(, "y": 0, "width": 32, "height": 32}})";
+        }
+        stream << "]}";
+    }
+
+    const auto mapPath = std::filesystem::temp_directory_path() / "capengine_test_tileedit_map.json";
+    {
+        std::ofstream stream{mapPath};
+        stream << R"({"width": 128, "height": 128, "tileset": ")" << tileSetPath.filename().generic_string()
+               << R"(", "tiles": [)";
+        for (int y = 0; y < 4; y++) {
+            stream << (y == 0 ? "[" : ",[");
+            for (int x = 0; x < 4; x++) {
+                stream << (x == 0 ? "" : ",") << R"({"index": 0})";
+            }
+            stream << "]";
+        }
+        stream << "]}";
+    }
+
+    auto pMap = std::make_shared<Map2D>(mapPath.string());
+    std::filesystem::remove(mapPath);
+    std::filesystem::remove(tileSetPath);
+    return pMap;
+}
+
+void assertRun(const TileEditCommand::Run& in_run, int in_x, int in_y, int in_length, int in_oldIndex,
+               int in_newIndex)
+{
+    ASSERT_EQ(in_x, in_run.x);
+    ASSERT_EQ(in_y, in_run.y);
+    ASSERT_EQ(in_length, in_run.length);
+    ASSERT_EQ(in_oldIndex, in_run.oldIndex);
+    ASSERT_EQ(in_newIndex, in_run.newIndex);
+}
+
+//! A 4x4 grid with every tile set to the same index, like a new map.
+TileGrid filledGrid(uint32_t in_index)
+{
+    TileGrid grid{4, 4};
+    for (int y = 0; y < grid.height(); y++) {
+        grid.fillRow(0, y, grid.width(), in_index);
+    }
+    return grid;
+}
+
+//! Checks every tile in the map has the index in the grid.
+void assertMapMatches(const Map2D& in_map, const TileGrid& in_expected)
+{
+    for (int y = 0; y < in_expected.height(); y++) {
+        for (int x = 0; x < in_expected.width(); x++) {
+            const uint32_t index = in_expected.get(x, y);
+            ASSERT_EQ(index == TileGrid::kNoTile ? -1 : static_cast<int>(index), in_map.getTileIndex(x, y))
+                << "at " << x << ", " << y;
+        }
+    }
+}
+
+}  // namespace
+
+TEST(TileEditCommandTest, TestSetTileExtendsRuns)
+{
+    auto pMap = makeMap();
+    pMap->setTile(1, 2, 3);
+
+    TileEditCommand command{pMap};
+    command.setTile(0, 0, 1);
+    command.setTile(1, 0, 1);
+    command.setTile(2, 0, 1);
+    command.setTile(3, 0, 2);  // a different index
+    command.setTile(0, 1, 1);  // the next row
+    command.setTile(2, 1, 1);  // not next to the last tile
+    command.setTile(0, 2, 1);
+    command.setTile(1, 2, 1);  // had a different index
+    command.setTile(0, 3, -5);
+    command.setTile(1, 3, -1);  // any negative index clears
+
+    const auto& runs = command.runs();
+    ASSERT_EQ(7u, runs.size());
+    assertRun(runs[0], 0, 0, 3, 0, 1);
+    assertRun(runs[1], 3, 0, 1, 0, 2);
+    assertRun(runs[2], 0, 1, 1, 0, 1);
+    assertRun(runs[3], 2, 1, 1, 0, 1);
+    assertRun(runs[4], 0, 2, 1, 0, 1);
+    assertRun(runs[5], 1, 2, 1, 3, 1);
+    assertRun(runs[6], 0, 3, 2, 0, -1);
+
+    // nothing changes until it is run
+    ASSERT_EQ(0, pMap->getTileIndex(0, 0));
+    command.execute();
+    ASSERT_EQ(1, pMap->getTileIndex(2, 0));
+    ASSERT_EQ(2, pMap->getTileIndex(3, 0));
+    ASSERT_EQ(0, pMap->getTileIndex(1, 1));
+    ASSERT_EQ(-1, pMap->getTileIndex(1, 3));
+}
+
+TEST(TileEditCommandTest, TestUnExecuteRepeatedTile)
+{
+    auto pMap = makeMap();
+
+    // two parts of a stroke that both change tile 1, 0
+    TileEditCommand first{pMap, 1};
+    first.setTile(0, 0, 1);
+    first.setTile(1, 0, 1);
+    first.execute();
+
+    TileEditCommand second{pMap, 1};
+    second.setTile(1, 0, 2);
+    second.setTile(2, 0, 2);
+    second.execute();
+
+    ASSERT_TRUE(first.merge(second));
+    ASSERT_EQ(3u, first.runs().size());
+    assertRun(first.runs()[1], 1, 0, 1, 1, 2);
+
+    // undoing ends with the index from before the first change
+    first.unExecute();
+    TileGrid expected = filledGrid(0);
+    assertMapMatches(*pMap, expected);
+
+    first.execute();
+    expected.fillRow(0, 0, 1, 1);
+    expected.fillRow(1, 0, 2, 2);
+    assertMapMatches(*pMap, expected);
+}
+
+TEST(TileEditCommandTest, TestMerge)
+{
+    auto pMap = makeMap();
+
+    TileEditCommand command{pMap, 1};
+    command.setTile(0, 0, 1);
+
+    TileEditCommand sameStroke{pMap, 1};
+    sameStroke.setTile(0, 1, 1);
+    ASSERT_TRUE(command.merge(sameStroke));
+    ASSERT_EQ(2u, command.runs().size());
+
+    TileEditCommand otherStroke{pMap, 2};
+    otherStroke.setTile(0, 2, 1);
+    ASSERT_FALSE(command.merge(otherStroke));
+
+    TileEditCommand otherMap{makeMap(), 1};
+    otherMap.setTile(0, 2, 1);
+    ASSERT_FALSE(command.merge(otherMap));
+
+    SimpleCommand notATileEdit{[]() {}};
+    ASSERT_FALSE(command.merge(notATileEdit));
+    ASSERT_EQ(2u, command.runs().size());
+
+    // kNoMerge never merges, even with itself
+    TileEditCommand unmerged{pMap};
+    TileEditCommand alsoUnmerged{pMap};
+    alsoUnmerged.setTile(0, 3, 1);
+    ASSERT_FALSE(unmerged.merge(alsoUnmerged));
+    ASSERT_TRUE(unmerged.runs().empty());
+}
+
+TEST(TileEditCommandTest, TestByteSize)
+{
+    auto pMap = makeMap();
+
+    TileEditCommand command{pMap, 1};
+    ASSERT_EQ(sizeof(TileEditCommand), command.byteSize());
+
+    command.setTile(0, 0, 1);
+    const std::size_t oneRun = command.byteSize();
+    ASSERT_EQ(sizeof(TileEditCommand) + command.runs().capacity() * sizeof(TileEditCommand::Run), oneRun);
+    ASSERT_GE(oneRun, sizeof(TileEditCommand) + sizeof(TileEditCommand::Run));
+
+    // filling a row only makes the run longer
+    command.setTile(1, 0, 1);
+    command.setTile(2, 0, 1);
+    command.setTile(3, 0, 1);
+    ASSERT_EQ(oneRun, command.byteSize());
+
+    TileEditCommand next{pMap, 1};
+    next.setTile(0, 1, 1);
+    next.setTile(0, 2, 1);
+    ASSERT_TRUE(command.merge(next));
+    ASSERT_EQ(sizeof(TileEditCommand) + command.runs().capacity() * sizeof(TileEditCommand::Run),
+              command.byteSize());
+    ASSERT_GE(command.byteSize(), sizeof(TileEditCommand) + 3 * sizeof(TileEditCommand::Run));
+}
+
+TEST(TileEditCommandTest, TestUndoRedo)
+{
+    auto pMap = makeMap();
+    pMap->setTile(3, 3, 3);
+
+    TileGrid original = filledGrid(0);
+    original.set(3, 3, 3);
+    assertMapMatches(*pMap, original);
+
+    // a stroke filling a 3x2 area, in two parts, then clearing a tile
+    CommandManager manager;
+    for (int y = 1; y < 3; y++) {
+        auto pCommand = std::make_unique<TileEditCommand>(pMap, 1);
+        for (int x = 1; x < 4; x++) {
+            pCommand->setTile(x, y, 2);
+        }
+        manager.runCommand(std::move(pCommand));
+    }
+    auto pClear = std::make_unique<TileEditCommand>(pMap);
+    pClear->setTile(3, 3, -1);
+    manager.runCommand(std::move(pClear));
+    ASSERT_EQ(2u, manager.getUndoCount());
+
+    TileGrid edited = original;
+    edited.fillRow(1, 1, 3, 2);
+    edited.fillRow(1, 2, 3, 2);
+    edited.set(3, 3, TileGrid::kNoTile);
+    assertMapMatches(*pMap, edited);
+
+    manager.undo();
+    manager.undo();
+    assertMapMatches(*pMap, original);
+
+    manager.redo();
+    manager.redo();
+    assertMapMatches(*pMap, edited);
+
+    manager.undo();
+    TileGrid stroked = edited;
+    stroked.set(3, 3, 3);
+    assertMapMatches(*pMap, stroked);
+}
+
+}  // namespace CapEngine::testing
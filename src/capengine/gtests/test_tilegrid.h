@@ -0,0 +1,161 @@
+#include <capengine/CapEngineException.h>
+#include <capengine/tilegrid.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace CapEngine::testing {
+
+TEST(TileGridTest, TestSetAndCopy)
+{
+    TileGrid grid{100, 40};
+    ASSERT_EQ(TileGrid::kNoTile, grid.get(99, 39));
+    ASSERT_EQ(sizeof(uint16_t), grid.indexSize());
+
+    grid.set(5, 6, 7);
+    grid.set(99, 39, 0);
+
+    TileGrid copy = grid;
+    for (std::size_t i = 0; i < grid.numChunks(); i++) {
+        ASSERT_TRUE(copy.sharesChunk(grid, i));
+    }
+
+    // only the changed chunk stops being shared.
+    copy.set(5, 6, 8);
+    ASSERT_FALSE(copy.sharesChunk(grid, 0));
+    ASSERT_TRUE(copy.sharesChunk(grid, 1));
+    ASSERT_EQ(7, grid.get(5, 6));
+    ASSERT_EQ(8, copy.get(5, 6));
+    ASSERT_EQ(0, copy.get(99, 39));
+}
+
+TEST(TileGridTest, TestWidensLargeIndexes)
+{
+    TileGrid grid{10, 10};
+    grid.set(1, 1, 3);
+    grid.set(2, 2, 70000);
+
+    ASSERT_EQ(sizeof(uint32_t), grid.indexSize());
+    ASSERT_EQ(3, grid.get(1, 1));
+    ASSERT_EQ(70000, grid.get(2, 2));
+    ASSERT_EQ(TileGrid::kNoTile, grid.get(3, 3));
+}
+
+TEST(TileGridTest, TestFillRow)
+{
+    TileGrid grid{100, 2};
+    grid.fillRow(10, 1, 80, 5);
+
+    ASSERT_EQ(TileGrid::kNoTile, grid.get(9, 1));
+    ASSERT_EQ(5, grid.get(10, 1));
+    ASSERT_EQ(5, grid.get(64, 1));
+    ASSERT_EQ(5, grid.get(89, 1));
+    ASSERT_EQ(TileGrid::kNoTile, grid.get(90, 1));
+    ASSERT_EQ(TileGrid::kNoTile, grid.get(50, 0));
+
+    grid.fillRow(0, 1, 100, TileGrid::kNoTile);
+    ASSERT_EQ(TileGrid::kNoTile, grid.get(50, 1));
+}
+
+TEST(TileGridTest, TestResize)
+{
+    TileGrid grid{40, 40};
+    grid.set(1, 1, 1);
+    grid.set(35, 1, 2);
+    grid.set(20, 20, 3);
+
+    grid.resize(30, 10);
+    ASSERT_EQ(1, grid.get(1, 1));
+
+    // tiles that were cut off don't come back when it grows again.
+    grid.resize(40, 40);
+    ASSERT_EQ(1, grid.get(1, 1));
+    ASSERT_EQ(TileGrid::kNoTile, grid.get(35, 1));
+    ASSERT_EQ(TileGrid::kNoTile, grid.get(20, 20));
+}
+
+TEST(TileGridTest, TestResizeKeepsSharedChunks)
+{
+    TileGrid grid{100, 100};
+    grid.set(1, 1, 1);
+    grid.set(99, 1, 2);
+    const TileGrid saved = grid;
+
+    // still 4 chunks wide, so only the chunk with a tile cut off is copied.
+    grid.resize(98, 100);
+    ASSERT_EQ(saved.numChunks(), grid.numChunks());
+    for (std::size_t i = 0; i < grid.numChunks(); i++) {
+        ASSERT_EQ(i != 3, grid.sharesChunk(saved, i)) << "chunk " << i;
+    }
+    ASSERT_EQ(1, grid.get(1, 1));
+    ASSERT_EQ(2, saved.get(99, 1));
+
+    grid.resize(100, 100);
+    ASSERT_EQ(TileGrid::kNoTile, grid.get(99, 1));
+}
+
+TEST(TileGridTest, TestSaveIncrementally)
+{
+    auto path = std::filesystem::temp_directory_path() / "capengine_test_grid.tiles";
+
+    TileGrid grid{70, 3};
+    grid.set(0, 0, 1);
+    grid.set(69, 2, 2);
+    grid.save(path);
+    TileGrid saved = grid;
+
+    // change (69, 2) in the file behind the grid's back, so rewriting its chunk
+    // would be noticed.
+    {
+        std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+        const std::size_t chunkBytes = TileGrid::kChunkSize * TileGrid::kChunkSize * sizeof(uint16_t);
+        stream.seekp(sizeof(TileGridHeader) + 2 * chunkBytes + (2 * TileGrid::kChunkSize + 5) * sizeof(uint16_t));
+        const uint16_t index = 9;
+        stream.write(reinterpret_cast<const char*>(&index), sizeof(index));
+    }
+
+    grid.set(1, 0, 4);
+    grid.save(path, &saved);
+
+    TileGrid loaded = TileGrid::load(path);
+    ASSERT_EQ(70, loaded.width());
+    ASSERT_EQ(3, loaded.height());
+    ASSERT_EQ(1, loaded.get(0, 0));
+    ASSERT_EQ(4, loaded.get(1, 0));
+    ASSERT_EQ(9, loaded.get(69, 2));
+    ASSERT_EQ(TileGrid::kNoTile, loaded.get(40, 1));
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    ASSERT_THROW(TileGrid::load(path), CapEngineException);
+    std::filesystem::remove(path);
+}
+
+TEST(TileGridTest, TestRejectsHeaderSizeMismatch)
+{
+    auto path = std::filesystem::temp_directory_path() / "capengine_test_bad_grid.tiles";
+    TileGrid{40, 40}.save(path);
+
+    // claim a huge grid in a file that only holds a small one.
+    auto writeSize = [&](uint32_t in_width, uint32_t in_height) {
+        std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+        stream.seekp(offsetof(TileGridHeader, width));
+        stream.write(reinterpret_cast<const char*>(&in_width), sizeof(in_width));
+        stream.write(reinterpret_cast<const char*>(&in_height), sizeof(in_height));
+    };
+
+    writeSize(std::numeric_limits<int32_t>::max(), 40);
+    ASSERT_THROW(TileGrid::load(path), CapEngineException);
+    writeSize(100000, 100000);
+    ASSERT_THROW(TileGrid::load(path), CapEngineException);
+    writeSize(70, 40);
+    ASSERT_THROW(TileGrid::load(path), CapEngineException);
+
+    writeSize(64, 64);
+    ASSERT_EQ(64, TileGrid::load(path).width());
+    std::filesystem::remove(path);
+}
+
+}  // namespace CapEngine::testing
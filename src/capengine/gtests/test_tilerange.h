@@ -0,0 +1,108 @@
+#include <capengine/tilerange.h>
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace CapEngine::testing {
+
+namespace {
+
+void assertRange(const std::optional<SDL_Rect>& in_range, int in_x, int in_y, int in_w, int in_h)
+{
+    ASSERT_TRUE(in_range.has_value());
+    ASSERT_EQ(in_x, in_range->x);
+    ASSERT_EQ(in_y, in_range->y);
+    ASSERT_EQ(in_w, in_range->w);
+    ASSERT_EQ(in_h, in_range->h);
+}
+
+}  // namespace
+
+TEST(TileRangeTest, TestZoomedIn)
+{
+    // 16 pixel tiles at twice the size, panned to 100, 50
+    const TileView view{100.0, 50.0, 32.0, 10, 8};
+
+    // ending exactly on a tile edge doesn't include the next tile
+    assertRange(getTileRange(SDL_Rect{100, 50, 64, 32}, view), 0, 0, 2, 1);
+    assertRange(getTileRange(SDL_Rect{132, 82, 32, 32}, view), 1, 1, 1, 1);
+
+    // a pixel past the edge does
+    assertRange(getTileRange(SDL_Rect{100, 50, 65, 33}, view), 0, 0, 3, 2);
+    assertRange(getTileRange(SDL_Rect{131, 81, 2, 2}, view), 0, 0, 2, 2);
+}
+
+TEST(TileRangeTest, TestZoomedOut)
+{
+    // 16 pixel tiles at half the size, panned up and left past the window
+    const TileView view{-20.0, -12.0, 8.0, 10, 8};
+    assertRange(getTileRange(SDL_Rect{0, 0, 16, 8}, view), 2, 1, 3, 2);
+
+    // a fractional zoom
+    const TileView oneAndAHalf{0.0, 0.0, 24.0, 10, 8};
+    assertRange(getTileRange(SDL_Rect{48, 0, 24, 24}, oneAndAHalf), 2, 0, 1, 1);
+    assertRange(getTileRange(SDL_Rect{47, 0, 26, 24}, oneAndAHalf), 1, 0, 3, 1);
+}
+
+TEST(TileRangeTest, TestOutsideMap)
+{
+    const TileView view{0.0, 0.0, 10.0, 4, 4};
+
+    // clamped to the map
+    assertRange(getTileRange(SDL_Rect{-50, -50, 1000, 1000}, view), 0, 0, 4, 4);
+    assertRange(getTileRange(SDL_Rect{35, 35, 100, 100}, view), 3, 3, 1, 1);
+
+    // ending on the map's left edge or starting on its right edge
+    ASSERT_EQ(std::nullopt, getTileRange(SDL_Rect{-50, 0, 50, 10}, view));
+    ASSERT_EQ(std::nullopt, getTileRange(SDL_Rect{40, 0, 10, 10}, view));
+
+    ASSERT_EQ(std::nullopt, getTileRange(SDL_Rect{0, 0, 0, 10}, view));
+    ASSERT_EQ(std::nullopt, getTileRange(SDL_Rect{10, 10, -10, -10}, view));
+    ASSERT_EQ(std::nullopt, getTileRange(SDL_Rect{0, 0, 10, 10}, TileView{0.0, 0.0, 0.0, 4, 4}));
+}
+
+TEST(TileRangeTest, TestTilesInRect)
+{
+    const TileView view{0.0, 0.0, 10.0, 4, 4};
+    const SDL_Rect visible{0, 0, 40, 40};
+
+    const std::vector<std::pair<int, int>> expected = {{0, 1}, {1, 1}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+    ASSERT_EQ(expected, getTilesInRect(SDL_Rect{5, 15, 20, 10}, visible, view));
+
+    // dragging up and left gives the same tiles
+    ASSERT_EQ(expected, getTilesInRect(SDL_Rect{25, 25, -20, -10}, visible, view));
+    ASSERT_EQ(expected, getTilesInRect(SDL_Rect{25, 15, -20, 10}, visible, view));
+}
+
+TEST(TileRangeTest, TestTilesInRectClippedToVisible)
+{
+    // zoomed in and panned, with only part of the map in the panel
+    const TileView view{-10.0, -10.0, 20.0, 4, 4};
+    const SDL_Rect visible{0, 0, 25, 25};
+
+    const std::vector<std::pair<int, int>> expected = {{0, 0}, {1, 0}, {0, 1}, {1, 1}};
+    ASSERT_EQ(expected, getTilesInRect(SDL_Rect{0, 0, 100, 100}, visible, view));
+    ASSERT_EQ(expected, getTilesInRect(SDL_Rect{100, 100, -100, -100}, visible, view));
+
+    ASSERT_TRUE(getTilesInRect(SDL_Rect{50, 50, 10, 10}, visible, view).empty());
+}
+
+TEST(TileRangeTest, TestPartialUpdateLimit)
+{
+    // a quarter of an 8x8 map is still updated a tile at a time
+    ASSERT_FALSE(exceedsPartialUpdateLimit(0, 8, 8));
+    ASSERT_FALSE(exceedsPartialUpdateLimit(16, 8, 8));
+    ASSERT_TRUE(exceedsPartialUpdateLimit(17, 8, 8));
+
+    // rounds down when the map doesn't divide by four
+    ASSERT_FALSE(exceedsPartialUpdateLimit(3, 5, 3));
+    ASSERT_TRUE(exceedsPartialUpdateLimit(4, 5, 3));
+
+    // maps smaller than four tiles are always redrawn whole
+    ASSERT_FALSE(exceedsPartialUpdateLimit(0, 1, 3));
+    ASSERT_TRUE(exceedsPartialUpdateLimit(1, 1, 3));
+}
+
+}  // namespace CapEngine::testing
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../segmentbvh.h"
+#include "../vectorcollisionlayer.h"
+
+namespace CapEngine::testing {
+
+TEST(SegmentBvhTest, TestEmpty)
+{
+    SegmentBvh bvh;
+    int visited = 0;
+    bvh.query(Rectangle{0, 0, 100, 100}, [&](const Segment&) { visited++; });
+
+    ASSERT_TRUE(bvh.empty());
+    ASSERT_EQ(0, visited);
+}
+
+TEST(SegmentBvhTest, TestQueryMatchesBruteForce)
+{
+    // deterministic pseudo random segments
+    uint32_t seed = 12345;
+    auto next = [&]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<double>(seed % 1000);
+    };
+
+    std::vector<Segment> segments;
+    for (int i = 0; i < 500; i++) {
+        const Point start{next(), next()};
+        segments.push_back(Segment{start, Point{start.x + next() / 20.0, start.y + next() / 20.0}});
+    }
+
+    const SegmentBvh bvh{segments};
+    ASSERT_EQ(segments.size(), bvh.size());
+
+    for (int i = 0; i < 50; i++) {
+        const Rectangle box{next(), next(), 40, 40};
+
+        std::vector<Segment> expected;
+        for (auto&& segment : segments) {
+            if (detectBoxSegmentCollision(box, segment)) {
+                expected.push_back(segment);
+            }
+        }
+
+        std::vector<Segment> found;
+        bvh.query(box, [&](const Segment& in_segment) {
+            if (detectBoxSegmentCollision(box, in_segment)) {
+                found.push_back(in_segment);
+            }
+        });
+
+        ASSERT_EQ(expected.size(), found.size());
+        for (auto&& segment : expected) {
+            ASSERT_NE(found.end(), std::find(found.begin(), found.end(), segment));
+        }
+    }
+}
+
+TEST(VectorCollisionLayerTest, TestContacts)
+{
+    // a floor and a wall
+    const VectorCollisionLayer layer{{Segment{{0, 10}, {100, 10}}, Segment{{50, 0}, {50, 100}}}, Vector{0.0, 0.0}};
+
+    std::vector<SegmentCollision> contacts;
+    layer.contacts(Rectangle{10, 8, 10, 10}, YAxisOrientation::BottomZero,
+                   [&](const SegmentCollision& in_contact) { contacts.push_back(in_contact); });
+
+    ASSERT_EQ(1u, contacts.size());
+    ASSERT_EQ(CollisionType::COLLISION_BOTTOM, contacts[0].collisionType);
+    ASSERT_DOUBLE_EQ(2.0, contacts[0].penetration);
+
+    contacts.clear();
+    layer.contacts(Rectangle{45, 8, 10, 10}, YAxisOrientation::BottomZero,
+                   [&](const SegmentCollision& in_contact) { contacts.push_back(in_contact); });
+    ASSERT_EQ(2u, contacts.size());
+
+    ASSERT_EQ(Schema::Scene2d::kVectorCollisionLayerType, layer.type());
+}
+
+TEST(VectorCollisionLayerTest, TestTiledGeometryIsFlipped)
+{
+    // a floor near the bottom of a 100 pixel high Tiled map
+    const VectorCollisionLayer layer{{Segment{{0, 90}, {100, 90}}}, Vector{0.0, 0.0}, 100.0};
+
+    std::vector<SegmentCollision> contacts;
+    layer.contacts(Rectangle{0, 8, 10, 10}, YAxisOrientation::BottomZero,
+                   [&](const SegmentCollision& in_contact) { contacts.push_back(in_contact); });
+
+    ASSERT_EQ(1u, contacts.size());
+    ASSERT_EQ(CollisionType::COLLISION_BOTTOM, contacts[0].collisionType);
+    ASSERT_DOUBLE_EQ(-1.0, contacts[0].collisionNormal.getY());
+    ASSERT_DOUBLE_EQ(2.0, contacts[0].penetration);
+    ASSERT_DOUBLE_EQ(10.0, contacts[0].representativePoint.y);
+
+    // the same box with y down is nowhere near it
+    contacts.clear();
+    layer.contacts(Rectangle{0, 8, 10, 10}, YAxisOrientation::TopZero,
+                   [&](const SegmentCollision& in_contact) { contacts.push_back(in_contact); });
+    ASSERT_TRUE(contacts.empty());
+}
+
+}  // namespace CapEngine::testing
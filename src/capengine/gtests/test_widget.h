@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "../absolutelayout.h"
+#include "../linearlayout.h"
+#include "../locator.h"
+#include "../widget.h"
+#include "../windowwidget.h"
+
+namespace CapEngine::testing {
+
+namespace {
+
+//! A widget that only records its geometry and how often it is rendered.
+class TestWidget final : public UI::Widget {
+   public:
+    explicit TestWidget(bool in_retained = true) : m_retained(in_retained) {}
+
+    SDL_Rect getPosition() const override { return m_rect; }
+    void setPosition(int in_x, int in_y) override
+    {
+        m_rect.x = in_x;
+        m_rect.y = in_y;
+    }
+    void setSize(int in_width, int in_height) override
+    {
+        if (in_width != m_rect.w || in_height != m_rect.h) {
+            m_rect.w = in_width;
+            m_rect.h = in_height;
+            this->invalidateMeasure();
+        }
+    }
+    void render() override { m_renders++; }
+    bool isRetained() const override { return m_retained; }
+
+    int m_measures = 0;
+    int m_renders = 0;
+
+   protected:
+    void measure() override { m_measures++; }
+
+   private:
+    SDL_Rect m_rect{};
+    bool m_retained;
+};
+
+}  // namespace
+
+TEST(WidgetTest, TestInvalidatePropagatesToRoot)
+{
+    auto pLayout = UI::AbsoluteLayout::create();
+    auto pWidget = std::make_shared<TestWidget>();
+    pLayout->addWidget(pWidget, 0, 0, 10, 10);
+    ASSERT_TRUE(pLayout->isDirty());
+
+    pLayout->markClean();
+    ASSERT_FALSE(pLayout->isDirty());
+    ASSERT_FALSE(pWidget->isDirty());
+
+    pWidget->invalidate();
+    ASSERT_TRUE(pWidget->isDirty());
+    ASSERT_TRUE(pLayout->isDirty());
+}
+
+TEST(WidgetTest, TestSubtreeRetained)
+{
+    auto pLayout = UI::AbsoluteLayout::create();
+    pLayout->addWidget(std::make_shared<TestWidget>(), 0, 0, 10, 10);
+    ASSERT_TRUE(pLayout->isSubtreeRetained());
+
+    auto pLive = std::make_shared<TestWidget>(false);
+    pLayout->addWidget(pLive, 10, 0, 10, 10);
+    ASSERT_FALSE(pLayout->isSubtreeRetained());
+
+    pLayout->removeWidget(pLive);
+    ASSERT_TRUE(pLayout->isSubtreeRetained());
+}
+
+TEST(WidgetTest, TestLayoutOnlyRemeasuresResizedWidgets)
+{
+    auto pLayout = UI::LinearLayout::create(UI::LinearLayout::Orientation::Vertical);
+    auto pFirst = std::make_shared<TestWidget>();
+    auto pSecond = std::make_shared<TestWidget>();
+    {
+        UI::LayoutBatch batch(*pLayout);
+        pLayout->setSize(100, 100);
+        pLayout->addWidget(pFirst);
+        pLayout->addWidget(pSecond);
+
+        pLayout->updateLayout();
+        ASSERT_TRUE(pLayout->isLayoutDirty());
+        ASSERT_EQ(0, pFirst->getPosition().w);
+    }
+    ASSERT_FALSE(pLayout->isLayoutDirty());
+    ASSERT_EQ(50, pSecond->getPosition().y);
+    ASSERT_EQ(50, pSecond->getPosition().h);
+    ASSERT_EQ(1, pFirst->m_measures);
+
+    // moving the layout moves its children without measuring them again.
+    pLayout->setPosition(10, 20);
+    pLayout->updateLayout();
+    ASSERT_EQ(10, pFirst->getPosition().x);
+    ASSERT_EQ(70, pSecond->getPosition().y);
+    ASSERT_EQ(1, pFirst->m_measures);
+    ASSERT_EQ(1, pSecond->m_measures);
+
+    // a widget invalidating itself is laid out alone.
+    pSecond->invalidateMeasure();
+    ASSERT_TRUE(pLayout->isDirty());
+    pLayout->updateLayout();
+    ASSERT_EQ(1, pFirst->m_measures);
+    ASSERT_EQ(2, pSecond->m_measures);
+}
+
+TEST(WidgetTest, TestCleanWindowDoesNotRenderLayout)
+{
+    auto pWindow = UI::WindowWidget::create("WidgetTest", 64, 64, false);
+    pWindow->show();
+    auto pLayout = std::make_shared<TestWidget>();
+    pWindow->setLayout(pLayout);
+
+    pWindow->render();
+    pWindow->render();
+    ASSERT_EQ(1, pLayout->m_renders);
+
+    pLayout->invalidate();
+    pWindow->render();
+    pWindow->render();
+    ASSERT_EQ(2, pLayout->m_renders);
+}
+
+TEST(WidgetTest, TestRetainedChildrenOfLiveLayoutAreCached)
+{
+    auto pWindow = UI::WindowWidget::create("WidgetTest", 64, 64, false);
+    pWindow->show();
+    auto pLayout = UI::AbsoluteLayout::create();
+    auto pRetained = std::make_shared<TestWidget>();
+    auto pLive = std::make_shared<TestWidget>(false);
+    pLayout->addWidget(pRetained, 0, 0, 32, 32);
+    pLayout->addWidget(pLive, 32, 0, 32, 32);
+    pWindow->setLayout(pLayout);
+
+    // only the live widget is rendered every frame
+    pWindow->render();
+    pWindow->render();
+    ASSERT_EQ(1, pRetained->m_renders);
+    ASSERT_EQ(2, pLive->m_renders);
+    ASSERT_EQ(nullptr, pLayout->getRenderCache());
+    ASSERT_EQ(nullptr, pLive->getRenderCache());
+
+    pRetained->invalidate();
+    pWindow->render();
+    ASSERT_EQ(2, pRetained->m_renders);
+    ASSERT_EQ(3, pLive->m_renders);
+
+    // without the live widget the whole layout is cached
+    pLayout->removeWidget(pLive);
+    pWindow->render();
+    pWindow->render();
+    ASSERT_EQ(3, pRetained->m_renders);
+    ASSERT_EQ(3, pLive->m_renders);
+}
+
+TEST(WidgetTest, TestCacheIsWidgetSized)
+{
+    auto pWindow = UI::WindowWidget::create("WidgetTest", 64, 64, false);
+    pWindow->show();
+    auto pLayout = UI::AbsoluteLayout::create();
+    auto pRetained = std::make_shared<TestWidget>();
+    auto pLive = std::make_shared<TestWidget>(false);
+    pLayout->addWidget(pRetained, 8, 16, 32, 24);
+    pLayout->addWidget(pLive, 40, 0, 24, 24);
+    pWindow->setLayout(pLayout);
+
+    pWindow->render();
+    ASSERT_NE(nullptr, pRetained->getRenderCache());
+    ASSERT_EQ(std::make_pair(32, 24), Locator::videoManager->getTextureDims(pRetained->getRenderCache()));
+
+    // resizing the widget renders it into a cache of the new size
+    pRetained->setSize(16, 8);
+    pWindow->render();
+    ASSERT_EQ(2, pRetained->m_renders);
+    ASSERT_EQ(std::make_pair(16, 8), Locator::videoManager->getTextureDims(pRetained->getRenderCache()));
+
+    // moving it only draws the cache somewhere else
+    pRetained->setPosition(0, 0);
+    pWindow->render();
+    ASSERT_EQ(2, pRetained->m_renders);
+}
+
+}  // namespace CapEngine::testing
@@ -0,0 +1,227 @@
+#include "inputrecording.h"
+
+#include <cstring>
+#include <limits>
+
+#include "CapEngineException.h"
+#include "serialization.h"
+
+namespace CapEngine {
+
+namespace {
+
+constexpr uint32_t kMaxPerFrame = std::numeric_limits<uint16_t>::max();
+
+//! Throws if the recording is malformed.
+void checkRecording(bool in_condition, const std::filesystem::path& in_path, const std::string& in_details)
+{
+    if (!in_condition) {
+        CAP_THROW(CapEngineException("Invalid input recording " + in_path.string() + ": " + in_details));
+    }
+}
+
+//! Whether an event can be written and read back as plain bytes.
+bool isReplayable(const SDL_Event& in_event)
+{
+    switch (in_event.type) {
+        case SDL_SYSWMEVENT:
+        case SDL_DROPFILE:
+        case SDL_DROPTEXT:
+#if SDL_VERSION_ATLEAST(2, 0, 22)
+        case SDL_TEXTEDITING_EXT:  // its text is allocated by SDL
+#endif
+            return false;
+        default:
+            return in_event.type < SDL_USEREVENT;
+    }
+}
+
+//! The number of bytes of an event its type uses.
+std::size_t storedSize(uint32_t in_type)
+{
+    switch (in_type) {
+        case SDL_QUIT:
+            return sizeof(SDL_QuitEvent);
+        case SDL_WINDOWEVENT:
+            return sizeof(SDL_WindowEvent);
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            return sizeof(SDL_KeyboardEvent);
+        case SDL_TEXTEDITING:
+            return sizeof(SDL_TextEditingEvent);
+        case SDL_TEXTINPUT:
+            return sizeof(SDL_TextInputEvent);
+        case SDL_MOUSEMOTION:
+            return sizeof(SDL_MouseMotionEvent);
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            return sizeof(SDL_MouseButtonEvent);
+        case SDL_MOUSEWHEEL:
+            return sizeof(SDL_MouseWheelEvent);
+        case SDL_CONTROLLERAXISMOTION:
+            return sizeof(SDL_ControllerAxisEvent);
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+            return sizeof(SDL_ControllerButtonEvent);
+        case SDL_CONTROLLERDEVICEADDED:
+        case SDL_CONTROLLERDEVICEREMOVED:
+        case SDL_CONTROLLERDEVICEREMAPPED:
+            return sizeof(SDL_ControllerDeviceEvent);
+        default:
+            return sizeof(SDL_Event);
+    }
+}
+
+}  // namespace
+
+//! Starts a recording.
+/**
+ \param in_path
+   The file to write.  Throws CapEngineException if it can't be created.
+ \param in_seed
+   The seed the NumberGenerator was given for the session.
+ \param in_msPerUpdate
+   The fixed update step of the session.
+*/
+InputRecorder::InputRecorder(const std::filesystem::path& in_path, uint32_t in_seed, double in_msPerUpdate)
+    : m_path(in_path),
+      m_stream(in_path, std::ios::binary | std::ios::trunc),
+      m_header{kMagic, kVersion, in_seed, static_cast<uint32_t>(sizeof(SDL_Event)), in_msPerUpdate, 0}
+{
+    if (!m_stream) {
+        CAP_THROW(CapEngineException("Unable to create input recording " + in_path.string()));
+    }
+
+    m_stream.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+}
+
+//! Destructor.  Finishes the recording if finish() wasn't called.
+InputRecorder::~InputRecorder()
+{
+    try {
+        this->finish();
+    }
+    catch (...) {
+        // can't throw from a destructor, and the recording is only lost.
+    }
+}
+
+//! Adds an event to the current frame.
+/**
+ \param in_event
+   An event polled from SDL.  Ignored if it can't be replayed.
+*/
+void InputRecorder::record(const SDL_Event& in_event)
+{
+    if (m_finished || !isReplayable(in_event)) {
+        return;
+    }
+
+    if (m_frameEvents == kMaxPerFrame) {
+        this->writeFrame(0);
+    }
+
+    ByteWriter writer{m_frame};
+    writer.writeBytes(std::as_bytes(std::span{&in_event, 1}).first(storedSize(in_event.type)));
+    m_frameEvents++;
+}
+
+//! Ends the current frame.
+/**
+ \param in_updates
+   The number of fixed updates the frame ran.
+*/
+void InputRecorder::endFrame(uint32_t in_updates)
+{
+    if (m_finished) {
+        return;
+    }
+
+    while (in_updates > kMaxPerFrame) {
+        this->writeFrame(kMaxPerFrame);
+        in_updates -= kMaxPerFrame;
+    }
+    this->writeFrame(static_cast<uint16_t>(in_updates));
+}
+
+//! Writes the header's frame count and closes the file.
+void InputRecorder::finish()
+{
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+
+    if (m_frameEvents > 0) {
+        this->writeFrame(0);
+    }
+    m_stream.seekp(0);
+    m_stream.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+    m_stream.close();
+    if (!m_stream) {
+        CAP_THROW(CapEngineException("Unable to write input recording " + m_path.string()));
+    }
+}
+
+//! Writes the current frame and starts the next.
+void InputRecorder::writeFrame(uint16_t in_updates)
+{
+    const uint16_t counts[] = {in_updates, m_frameEvents};
+    m_stream.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+    m_stream.write(reinterpret_cast<const char*>(m_frame.data()), static_cast<std::streamsize>(m_frame.size()));
+
+    m_frame.clear();
+    m_frameEvents = 0;
+    m_header.frameCount++;
+}
+
+//! Opens a recording.
+/**
+ \param in_path
+   A file written by InputRecorder.  Throws CapEngineException if it can't be
+   read, is malformed or was recorded by an incompatible build.
+*/
+InputPlayback::InputPlayback(const std::filesystem::path& in_path) : m_file(in_path), m_offset(sizeof(m_header))
+{
+    const auto bytes = m_file.bytes();
+    checkRecording(bytes.size() >= sizeof(m_header), in_path, "too small");
+
+    std::memcpy(&m_header, bytes.data(), sizeof(m_header));
+    checkRecording(m_header.magic == InputRecorder::kMagic, in_path, "bad magic");
+    checkRecording(m_header.version == InputRecorder::kVersion, in_path, "unsupported version");
+    checkRecording(m_header.eventSize == sizeof(SDL_Event), in_path, "recorded with a different SDL");
+    checkRecording(m_header.msPerUpdate > 0.0, in_path, "bad update step");
+}
+
+//! Reads the next frame.
+/**
+ \return
+   false once every frame has been read.
+*/
+bool InputPlayback::nextFrame()
+{
+    m_events.clear();
+    m_updates = 0;
+    if (m_framesRead == m_header.frameCount) {
+        return false;
+    }
+
+    // ByteReader throws if a frame runs past the end of the file.
+    ByteReader reader{m_file.bytes().subspan(m_offset)};
+    m_updates = reader.read<uint16_t>();
+    const auto eventCount = reader.read<uint16_t>();
+    for (uint16_t i = 0; i < eventCount; i++) {
+        // every event starts with its type, which says how much of it follows.
+        SDL_Event event{};
+        event.type = reader.read<uint32_t>();
+        const auto rest = reader.readBytes(storedSize(event.type) - sizeof(event.type));
+        std::memcpy(reinterpret_cast<std::byte*>(&event) + sizeof(event.type), rest.data(), rest.size());
+        m_events.push_back(event);
+    }
+
+    m_offset = m_file.bytes().size() - reader.remaining();
+    m_framesRead++;
+    return true;
+}
+
+}  // namespace CapEngine
@@ -0,0 +1,135 @@
+#ifndef CAPENGINE_INPUTRECORDING_H
+#define CAPENGINE_INPUTRECORDING_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+#include "mappedfile.h"
+
+namespace CapEngine {
+
+/**
+   \file
+   Recordings of the input a session received, so it can be replayed exactly,
+   e.g. to compare frame timings between builds.
+
+   Layout:
+     InputRecordingHeader
+     per frame of Runner::loop():
+       uint16_t updates, the number of fixed updates the frame ran
+       uint16_t eventCount
+       the events, each stored as only the part of SDL_Event its type uses
+
+   Only events polled from SDL are recorded.  Events a game enqueues itself are
+   enqueued again when it is replayed.  Events that carry pointers, such as
+   drops, user events and window manager events, can't be replayed and are
+   skipped.  Values are in native byte order.
+*/
+
+//! The start of an input recording.
+struct InputRecordingHeader {
+    std::array<char, 4> magic;
+    uint32_t version;
+    uint32_t seed;       //!< The NumberGenerator seed the session ran with.
+    uint32_t eventSize;  //!< sizeof(SDL_Event) where it was recorded.
+    double msPerUpdate;  //!< The fixed update step.
+    uint64_t frameCount;
+};
+
+//! Writes the input of a session as it happens.
+class InputRecorder final {
+   public:
+    InputRecorder(const std::filesystem::path& in_path, uint32_t in_seed, double in_msPerUpdate);
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    void record(const SDL_Event& in_event);
+    void endFrame(uint32_t in_updates);
+    void finish();
+
+    [[nodiscard]] uint64_t frameCount() const;
+
+    static constexpr std::array<char, 4> kMagic = {'C', 'P', 'I', 'R'};
+    static constexpr uint32_t kVersion = 1;
+
+   private:
+    void writeFrame(uint16_t in_updates);
+
+    std::filesystem::path m_path;
+    std::ofstream m_stream;
+    InputRecordingHeader m_header;
+    std::vector<std::byte> m_frame;  //!< Events of the frame being recorded.
+    uint16_t m_frameEvents = 0;      //!< Number of events in m_frame.
+    bool m_finished = false;
+};
+
+//! Reads a recording back one frame at a time.
+class InputPlayback final {
+   public:
+    explicit InputPlayback(const std::filesystem::path& in_path);
+
+    bool nextFrame();
+
+    [[nodiscard]] std::span<const SDL_Event> events() const;
+    [[nodiscard]] uint32_t updates() const;
+    [[nodiscard]] uint32_t seed() const;
+    [[nodiscard]] double msPerUpdate() const;
+    [[nodiscard]] uint64_t frameCount() const;
+
+   private:
+    MappedFile m_file;               //!< The recording.
+    InputRecordingHeader m_header;
+    std::size_t m_offset;            //!< Position of the next frame in m_file.
+    uint64_t m_framesRead = 0;
+    uint32_t m_updates = 0;          //!< Updates of the current frame.
+    std::vector<SDL_Event> m_events;  //!< Events of the current frame.
+};
+
+//! Returns the number of frames ended so far.
+inline uint64_t InputRecorder::frameCount() const
+{
+    return m_header.frameCount;
+}
+
+//! Returns the events of the current frame, in the order they were polled.
+inline std::span<const SDL_Event> InputPlayback::events() const
+{
+    return m_events;
+}
+
+//! Returns how many fixed updates the current frame ran.
+inline uint32_t InputPlayback::updates() const
+{
+    return m_updates;
+}
+
+//! Returns the NumberGenerator seed the session was recorded with.
+inline uint32_t InputPlayback::seed() const
+{
+    return m_header.seed;
+}
+
+//! Returns the fixed update step the session was recorded with.
+inline double InputPlayback::msPerUpdate() const
+{
+    return m_header.msPerUpdate;
+}
+
+//! Returns the number of frames in the recording.
+inline uint64_t InputPlayback::frameCount() const
+{
+    return m_header.frameCount;
+}
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_INPUTRECORDING_H
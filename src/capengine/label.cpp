@@ -59,8 +59,11 @@ std::shared_ptr<Label> Label::create(const std::string &text,
 //! @copydoc Widget::setPosition()
 void Label::setPosition(int x, int y)
 {
-  m_x = x;
-  m_y = y;
+  if (x != m_x || y != m_y) {
+    m_x = x;
+    m_y = y;
+    this->invalidate();
+  }
 }
 
 //! @copydoc Widget::setSize()
@@ -69,6 +72,7 @@ void Label::setSize(int width, int height)
     if (width != m_width || height != m_height) {
         m_width = width;
         m_height = height;
+        this->invalidate();
     }
 }
 
@@ -169,7 +173,29 @@ std::string Label::getText() const { return m_text; }
 void Label::setText(const std::string &text)
 {
   m_text = text;
-  m_texture.release();
+  m_texture.reset();
+  this->invalidate();
+}
+
+//! \copydoc Orientable::setHorizontalAlignment
+void Label::setHorizontalAlignment(HorizontalAlignment horizontalAlignment)
+{
+  Orientable::setHorizontalAlignment(horizontalAlignment);
+  this->invalidate();
+}
+
+//! \copydoc Orientable::setVerticalAlignment
+void Label::setVerticalAlignment(VerticalAlignment verticalAlignment)
+{
+  Orientable::setVerticalAlignment(verticalAlignment);
+  this->invalidate();
+}
+
+//! \copydoc Orientable::setPadding
+void Label::setPadding(int padding, std::set<Location> sides)
+{
+  Orientable::setPadding(padding, sides);
+  this->invalidate();
 }
 
 //! \copydoc Widget::getPosition
@@ -30,6 +30,14 @@ class Label : public Widget, public Orientable
     virtual void setSize(int width, int height) override;
     virtual void render() override;
 
+    // Orientable virtuals
+    void setHorizontalAlignment(
+        HorizontalAlignment horizontalAlignment) override;
+    void setVerticalAlignment(VerticalAlignment verticalAlignment) override;
+    void setPadding(int padding, std::set<Location> sides = {
+                                     Location::Left, Location::Right,
+                                     Location::Top, Location::Bottom}) override;
+
     std::string getText() const;
     void setText(const std::string &text);
     std::pair<int, int> getTextureSize();
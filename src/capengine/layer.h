@@ -6,6 +6,7 @@
 #include "gameobject.h"
 
 #include <boost/variant.hpp>
+#include <memory_resource>
 #include <optional>
 
 namespace CapEngine
@@ -35,6 +36,8 @@ class Layer
   public:
 	using CollisionType_t =
 		std::vector<std::pair<CapEngine::CollisionType, Vector>>;
+	using CollisionBuffer_t =
+		std::pmr::vector<std::pair<CapEngine::CollisionType, Vector>>;
 
   public:
 	virtual ~Layer() = default;
@@ -48,10 +51,39 @@ class Layer
 	{
 		return {};
 	}
+	virtual void checkCollisions(const GameObject &in_object,
+								 CollisionBuffer_t &out_collisions) const
+	{
+		const CollisionType_t collisions = checkCollisions(in_object);
+		out_collisions.assign(collisions.begin(), collisions.end());
+	}
 	virtual bool resolveCollisions(GameObject & /*in_object*/) const
 	{
 		return false;
 	}
+	virtual std::optional<SweptBoxCollision>
+		castBox(const Rectangle & /*in_box*/, const Vector & /*in_displacement*/,
+				YAxisOrientation /*in_orientation*/) const
+	{
+		return std::nullopt;
+	}
+	virtual bool overlaps(const Rectangle & /*in_box*/,
+						  YAxisOrientation /*in_orientation*/) const
+	{
+		return false;
+	}
+
+	int queryLayer() const { return m_queryLayer; }
+	void setQueryLayer(int in_queryLayer)
+	{
+		CAP_THROW_ASSERT(in_queryLayer >= 0 && in_queryLayer < 32,
+						 "Query layer must be from 0 to 31");
+		m_queryLayer = in_queryLayer;
+	}
+
+  private:
+	//! Which bit of a QueryFilter::layerMask selects this layer.
+	int m_queryLayer = 0;
 };
 
 /**
@@ -79,6 +111,35 @@ class Layer
    shape that collides with the object on the layer.
 */
 
+/**
+   \fn Layer::checkCollisions(const GameObject&, CollisionBuffer_t&)
+   \brief Check if a game object collides with anything in the layer, writing
+   the collisions into a caller supplied buffer (usually backed by a
+   FrameArena) instead of returning a new vector.
+   \param in_object The object to check collisions with.
+   \param out_collisions Receives the collisions.  It is cleared first.
+*/
+
+/**
+   \fn Layer::castBox
+   \brief Finds where a box moving in a straight line first hits the layer.
+   Used by Scene2d's raycasts and shape casts.  A ray is a box with no size.
+   \param in_box The box at the start of the cast, in world coordinates.
+   \param in_displacement How far the box moves.
+   \param in_orientation The y axis orientation of the box.
+   \return The fraction of the displacement at which the box first touches
+   the layer and the side of the box that touches, or nullopt if it doesn't.
+   Boxes that start overlapping the layer are left to overlaps().
+*/
+
+/**
+   \fn Layer::overlaps
+   \brief Checks if a box overlaps anything collidable in the layer.
+   \param in_box The box in world coordinates.
+   \param in_orientation The y axis orientation of the box.
+   \return true if it overlaps.
+*/
+
 } // namespace CapEngine
 
 
@@ -34,9 +34,9 @@ std::unique_ptr<Layer> LayerFactory::makeLayer(const jsoncons::json &in_json)
 
   const std::string type =
       in_json[Schema::Scene2d::kLayerType].as<std::string>();
-  auto &&f = m_factoryFunctions.find(type);
-  if (f != m_factoryFunctions.end()) {
-    return f->second(in_json);
+  std::optional<TypeId> typeId = this->findLayerType(type);
+  if (typeId) {
+    return this->makeLayer(*typeId, in_json);
   }
 
   throw LayerCreationException(
@@ -44,6 +44,41 @@ std::unique_ptr<Layer> LayerFactory::makeLayer(const jsoncons::json &in_json)
       std::string("No factory method registered for layer type"));
 }
 
+//! The factory method for a type that has already been looked up.
+/**
+ \param in_typeId
+   The type, from findLayerType().
+ \param in_json
+   The json describing the layer to create.
+ \return
+   The layer.
+*/
+std::unique_ptr<Layer> LayerFactory::makeLayer(TypeId in_typeId,
+                                               const jsoncons::json &in_json)
+{
+  CAP_THROW_ASSERT(in_typeId < m_factoryFunctions.size(),
+                   "Unknown layer type id");
+  return m_factoryFunctions[in_typeId](in_json);
+}
+
+//! Looks up a layer type.
+/**
+ \param in_type
+   The type.
+ \return
+   Its id, or nullopt if it isn't registered.
+*/
+std::optional<LayerFactory::TypeId>
+    LayerFactory::findLayerType(const std::string &in_type) const
+{
+  auto &&typeId = m_typeIds.find(in_type);
+  if (typeId == m_typeIds.end()) {
+    return std::nullopt;
+  }
+
+  return typeId->second;
+}
+
 //! Register a new type of layer that can be created.
 /**
  \param in_type
@@ -54,8 +89,9 @@ std::unique_ptr<Layer> LayerFactory::makeLayer(const jsoncons::json &in_json)
 void LayerFactory::registerLayerType(const std::string &in_type,
                                      factoryfunc_t in_factoryFunction)
 {
-  if (m_factoryFunctions.find(in_type) == m_factoryFunctions.end()) {
-    m_factoryFunctions.emplace(in_type, std::move(in_factoryFunction));
+  if (m_typeIds.find(in_type) == m_typeIds.end()) {
+    m_typeIds.emplace(in_type, m_factoryFunctions.size());
+    m_factoryFunctions.push_back(std::move(in_factoryFunction));
   }
 
   else {
@@ -3,9 +3,12 @@
 
 #include "CapEngineException.h"
 
+#include <cstddef>
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include <jsoncons/json.hpp>
 
@@ -36,6 +39,8 @@ class LayerFactory final
 public:
   using factoryfunc_t =
       std::function<std::unique_ptr<Layer>(const jsoncons::json &)>;
+  //! Index of a registered layer type, valid for the life of the process.
+  using TypeId = std::size_t;
 
 public:
   LayerFactory(const LayerFactory &) = delete;
@@ -43,14 +48,20 @@ public:
   static LayerFactory &getInstance();
 
   std::unique_ptr<Layer> makeLayer(const jsoncons::json &in_json);
+  std::unique_ptr<Layer> makeLayer(TypeId in_typeId,
+                                   const jsoncons::json &in_json);
+  [[nodiscard]] std::optional<TypeId>
+      findLayerType(const std::string &in_type) const;
   void registerLayerType(const std::string &in_type,
                          factoryfunc_t in_factoryFunction);
 
 private:
   LayerFactory() = default;
 
-  //! map of the factory functions
-  std::map<std::string, factoryfunc_t> m_factoryFunctions;
+  //! the factory functions, indexed by TypeId
+  std::vector<factoryfunc_t> m_factoryFunctions;
+  //! map of layer type to TypeId
+  std::map<std::string, TypeId> m_typeIds;
 };
 
 } // namespace CapEngine
@@ -26,30 +26,33 @@ std::shared_ptr<LinearLayout> LinearLayout::create(Orientation orientation)
 //! \copydoc Widget::setPosition
 void LinearLayout::setPosition(int x, int y)
 {
-  m_rect.x = x;
-  m_rect.y = y;
+  if (x != m_rect.x || y != m_rect.y) {
+    m_rect.x = x;
+    m_rect.y = y;
 
-  m_updateChildren = true;
+    this->invalidateArrange();
+  }
 }
 
 //! \copydoc Widget::setSize
 void LinearLayout::setSize(int width, int height)
 {
-  m_rect.w = width;
-  m_rect.h = height;
+  if (width != m_rect.w || height != m_rect.h) {
+    m_rect.w = width;
+    m_rect.h = height;
 
-  m_updateChildren = true;
+    this->invalidateMeasure();
+  }
 }
 
 //! \copydoc Widget::render
 void LinearLayout::render()
 {
-  if (m_updateChildren)
-    this->updateChildren();
+  this->updateLayout();
 
   for (auto &&pWidget : m_widgets) {
     CAP_THROW_NULL(pWidget, "Widget is null");
-    pWidget->render();
+    pWidget->renderCached();
   }
 }
 
@@ -85,19 +88,30 @@ void LinearLayout::addWidget(std::shared_ptr<Widget> pWidget)
   pWidget->setParent(this);
   pWidget->setWindowId(this->m_windowId);
 
-  m_updateChildren = true;
+  this->invalidateMeasure();
 }
 
-//! update size and position of children
-void LinearLayout::updateChildren()
+//! \copydoc Widget::measure
+void LinearLayout::measure()
 {
-  int widgetWidth = m_orientation == Orientation::Horizontal
-                        ? m_rect.w / m_widgets.size()
-                        : m_rect.w;
+  if (m_widgets.empty())
+    return;
 
-  int widgetHeight = m_orientation == Orientation::Vertical
-                         ? m_rect.h / m_widgets.size()
-                         : m_rect.h;
+  int numWidgets = static_cast<int>(m_widgets.size());
+  m_childWidth = m_orientation == Orientation::Horizontal
+                     ? m_rect.w / numWidgets
+                     : m_rect.w;
+
+  m_childHeight = m_orientation == Orientation::Vertical
+                      ? m_rect.h / numWidgets
+                      : m_rect.h;
+}
+
+//! \copydoc Widget::arrange
+void LinearLayout::arrange()
+{
+  int widgetWidth = m_childWidth;
+  int widgetHeight = m_childHeight;
 
   for (size_t i = 0; i < m_widgets.size(); i++) {
     CAP_THROW_NULL(m_widgets[i], "Widget is null");
@@ -117,8 +131,6 @@ void LinearLayout::updateChildren()
       m_widgets[i]->setPosition(m_rect.x, m_rect.y + i * widgetHeight);
     }
   }
-
-  m_updateChildren = false;
 }
 
 //! \copydoc Widget::handleMouseMotionEvent
@@ -196,6 +208,7 @@ LinearLayout::Alignment LinearLayout::getAlignment() const
 void LinearLayout::setAlignment(Alignment alignment)
 {
   m_alignment = alignment;
+  this->invalidateArrange();
 }
 
 } // namespace UI
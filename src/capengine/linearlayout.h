@@ -49,7 +49,8 @@ public:
 private:
   LinearLayout(Orientation orientation);
 
-  void updateChildren();
+  void measure() override;
+  void arrange() override;
 
   //! The orientation of the layout
   Orientation m_orientation = Orientation::Horizontal;
@@ -58,9 +59,10 @@ private:
   //! holds the widgets in this layout
   std::vector<std::shared_ptr<Widget>> m_widgets;
   //! position and size
-  SDL_Rect m_rect;
-  //! flag indicating children need size and position updates
-  bool m_updateChildren = false;
+  SDL_Rect m_rect = {0, 0, 0, 0};
+  //! The size given to each child
+  int m_childWidth = 0;
+  int m_childHeight = 0;
 };
 } // namespace UI
 } // namespace CapEngine
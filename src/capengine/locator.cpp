@@ -7,6 +7,7 @@
 #include "boost/optional.hpp"
 #include "eventsubscriber.h"
 #include "filesystem.h"
+#include "game_management.h"
 
 namespace CapEngine
 {
@@ -97,8 +98,13 @@ Logger& Locator::getLogger()
     return *logger;
 }
 
+//! Gets the sound player, opening the audio device if it isn't yet.
 SoundPlayer& Locator::getSoundPlayer()
 {
+    if (soundPlayer == nullptr && initted) {
+        initAudio();
+    }
+
     if (soundPlayer == nullptr) {
         BOOST_THROW_EXCEPTION(
             CapEngineException("soundPlayer not initialized."));
@@ -155,8 +161,13 @@ EventSubscriber& Locator::getEventSubscriber()
     return *eventSubscriber;
 }
 
+//! Gets the font manager, starting SDL_ttf if it isn't yet.
 FontManager& Locator::getFontManager()
 {
+    if (fontManager == nullptr && initted) {
+        initFonts();
+    }
+
     if (fontManager == nullptr) {
         BOOST_THROW_EXCEPTION(
             CapEngineException("fontManager not initialized."));
@@ -26,13 +26,13 @@ class Locator
 
     static VideoManager* videoManager;
     static Logger* logger;
-    static SoundPlayer* soundPlayer;
+    static SoundPlayer* soundPlayer;  // null until audio starts, see getSoundPlayer()
     static Keyboard* keyboard;
     static Mouse* mouse;
     static AssetManager* assetManager;
     static EventDispatcher* eventDispatcher;
     static EventSubscriber* eventSubscriber;
-    static FontManager* fontManager;
+    static FontManager* fontManager;  // null until fonts start, see getFontManager()
 
     static VideoManager& getVideoManager();
     static Logger& getLogger();
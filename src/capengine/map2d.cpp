@@ -1,5 +1,6 @@
 #include "map2d.h"
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/format.hpp>
@@ -7,6 +8,7 @@
 #include <boost/log/sources/severity_feature.hpp>
 #include <boost/log/trivial.hpp>
 #include <boost/numeric/conversion/cast.hpp>
+#include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -17,6 +19,7 @@
 #include "listproperty.h"
 #include "locator.h"
 #include "logging.h"
+#include "tilerange.h"
 // #include <jsoncons/json_serializing_options.hpp>
 
 using namespace std;
@@ -30,32 +33,8 @@ const char kHeightParameterName[] = "height";
 const char kTilesetParamaterName[] = "tileset";
 const char kTileArrayParameterName[] = "tiles";
 const char kIndexParameterName[] = "index";
-
-//! return a TileTup for the given index into the tileset.
-/**
- \param tileset
-   \li The tileset object.
- \param index
-   \li The index into the tileset
- \return
-   \li the tiletup
-*/
-Map2D::TileTup lookupTile(const TileSet& tileset, int index)
-{
-    Map2D::TileTup tileTup;
-
-    if (!tileset.tileExists(index)) {
-        tileTup.index = -1;
-        tileTup.tileLookupStatus = Map2D::TileLookupStatus_NotFound;
-    }
-    else {
-        tileTup.index = index;
-        tileTup.tileLookupStatus = Map2D::TileLookupStatus_Found;
-        tileTup.tile = tileset.getTile(index);
-    }
-
-    return tileTup;
-}
+const char kTileFileParameterName[] = "tileFile";
+const char kTileFileExtension[] = ".tiles";
 
 }  // namespace
 
@@ -139,6 +118,36 @@ void Map2D::load(jsoncons::json json)
              kTilesetParamaterName)
                 .str()));
 
+    const int tilesWide = width / tileSet->getTileWidth();
+    const int tilesHigh = height / tileSet->getTileHeight();
+
+    // tiles saved by save() are in a tile file next to the json
+    if (json.contains(kTileFileParameterName)) {
+        fs::path tileFilePath =
+            fs::absolute(fs::path(stripPath(configPath)) /
+                         json[kTileFileParameterName].as<std::string>())
+                .lexically_normal();
+        m_tiles = TileGrid::load(tileFilePath);
+
+        if (m_tiles.width() != tilesWide || m_tiles.height() != tilesHigh)
+            BOOST_THROW_EXCEPTION(CapEngineException(
+                (boost::format("Tile file %1% does not match the map size") %
+                 tileFilePath.string())
+                    .str()));
+
+        for (int y = 0; y < tilesHigh; y++) {
+            for (int x = 0; x < tilesWide; x++) {
+                const uint32_t index = m_tiles.get(x, y);
+                if (index != TileGrid::kNoTile && !tileSet->tileExists(index))
+                    m_tiles.set(x, y, TileGrid::kNoTile);
+            }
+        }
+
+        m_savedTiles = m_tiles;
+        m_savedTilesPath = tileFilePath;
+        return;
+    }
+
     if (!json.contains(kTileArrayParameterName))
         BOOST_THROW_EXCEPTION(CapEngineException(
             std::string("Json missing property: ") + kTileArrayParameterName));
@@ -148,13 +157,15 @@ void Map2D::load(jsoncons::json json)
     if (!tileArray.is_array())
         BOOST_THROW_EXCEPTION(CapEngineException("Invalid Tile Array"));
 
-    int i = 0;
+    m_tiles = TileGrid(tilesWide, tilesHigh);
+
+    int y = 0;
     for (auto&& row : tileArray.array_range()) {
         if (!row.is_array())
             BOOST_THROW_EXCEPTION(
                 CapEngineException("Invalid row in Tile Array"));
 
-        std::vector<TileTup> rowOfTiles;
+        int x = 0;
         for (auto&& tile : row.array_range()) {
             if (!tile.contains(kIndexParameterName))
                 BOOST_THROW_EXCEPTION(CapEngineException(
@@ -164,12 +175,15 @@ void Map2D::load(jsoncons::json json)
 
             const int index = tile[kIndexParameterName].as<int>();
 
-            assert(tileSet != nullptr);
-            TileTup tileTup = lookupTile(*tileSet, index);
-            rowOfTiles.push_back(std::move(tileTup));
+            // indexes missing from the tileset are left empty
+            if (x < tilesWide && y < tilesHigh && index >= 0 &&
+                tileSet->tileExists(index))
+                m_tiles.set(x, y, index);
+
+            x++;
         }
 
-        tiles.push_back(std::move(rowOfTiles));
+        y++;
     }
 }
 
@@ -203,8 +217,9 @@ Map2D::Map2D(const Map2D& other)
     : configPath(other.configPath),
       tileSetPath(other.tileSetPath),
       tileSet(other.tileSet),
-      tiles(other.tiles),
-      m_surfaceDirty(other.m_surfaceDirty),
+      m_tiles(other.m_tiles),
+      m_savedTiles(other.m_savedTiles),
+      m_savedTilesPath(other.m_savedTilesPath),
       width(other.width),
       height(other.height),
       m_isDirty(other.m_isDirty)
@@ -223,20 +238,17 @@ void Map2D::drawSurface()
     std::shared_ptr<SDL_Surface> pTileSurface = tileSet->getSurface();
     assert(pTileSurface != nullptr);
 
-    int rowNum = 0;
-    for (auto&& row : tiles) {
-        int columnNum = 0;
-        for (auto&& column : row) {
-            int destX = columnNum * tileSet->getTileSize();
-            int destY = rowNum * tileSet->getTileSize();
-            ;
+    for (int y = 0; y < m_tiles.height(); y++) {
+        for (int x = 0; x < m_tiles.width(); x++) {
+            const Tile* pTile = this->lookupTile(x, y);
+            if (pTile == nullptr) continue;
+
+            int destX = x * tileSet->getTileSize();
+            int destY = y * tileSet->getTileSize();
             Locator::videoManager->blitSurface(
-                pTileSurface.get(), column.tile.xpos, column.tile.ypos,
-                column.tile.width, column.tile.height, newSurface, destX,
-                destY);
-            columnNum++;
+                pTileSurface.get(), pTile->xpos, pTile->ypos, pTile->width,
+                pTile->height, newSurface, destX, destY);
         }
-        rowNum++;
     }
 
 #ifdef DEBUG
@@ -253,12 +265,62 @@ void Map2D::drawSurface()
     BOOST_LOG_SEV(CapEngine::log, boost::log::trivial::debug) << msg.str();
 #endif
 
-    if (surface == nullptr) SDL_FreeSurface(surface);
+    if (surface != nullptr) Locator::videoManager->closeSurface(surface);
 
     surface = newSurface;
+    m_dirtyTiles.clear();
+    m_textureDirty = true;
     BOOST_LOG_SEV(CapEngine::log, boost::log::trivial::debug) << "Drew consolidated map texture";
 }
 
+//! Redraws a single tile of the surface.
+/**
+ \param x
+   \li The x index of the tile.
+ \param y
+   \li The y index of the tile.
+*/
+void Map2D::drawTile(int x, int y)
+{
+    assert(surface != nullptr);
+    const int tileSize = tileSet->getTileSize();
+    Rect dstRect = {x * tileSize, y * tileSize, tileSize, tileSize};
+
+    // clear what was there, in case the tile was deleted or is transparent.
+    SDL_FillRect(surface, &dstRect, 0);
+
+    const Tile* pTile = this->lookupTile(x, y);
+    if (pTile != nullptr) {
+        std::shared_ptr<SDL_Surface> pTileSurface = tileSet->getSurface();
+        assert(pTileSurface != nullptr);
+        Locator::videoManager->blitSurface(pTileSurface.get(), pTile->xpos, pTile->ypos, pTile->width, pTile->height,
+                                           surface, dstRect.x, dstRect.y);
+    }
+
+    m_changedRects.push_back(dstRect);
+}
+
+//! Brings the surface up to date with the tiles.
+void Map2D::updateSurface()
+{
+    if (m_surfaceDirty) {
+        drawSurface();
+        m_surfaceDirty = false;
+        return;
+    }
+
+    const int tileSize = tileSet->getTileSize();
+    if (exceedsPartialUpdateLimit(m_dirtyTiles.size(), width / tileSize, height / tileSize)) {
+        drawSurface();
+        return;
+    }
+
+    for (auto&& [x, y] : m_dirtyTiles) {
+        this->drawTile(x, y);
+    }
+    m_dirtyTiles.clear();
+}
+
 string Map2D::toString()
 {
     unsigned int xRes = 0;
@@ -297,32 +359,76 @@ unique_ptr<Rectangle> Map2D::getTileMBR(int index)
 
 vector<Map2D::CollisionTup> Map2D::getCollisions(const Rectangle& mbr)
 {
-    // do brute force search for collisions of all map MBRs
+    assert(tileSet != nullptr);
     vector<CollisionTup> collisions;
 
-    // TODO reimplement this
-    // for(size_t i = 0; i < tiles.size();  i++){
-    //   unique_ptr<Rectangle> tileMBR = getTileMBR(i);
-    //   CollisionType collisionType = detectMBRCollision(mbr, *tileMBR);
-    //   if(collisionType != COLLISION_NONE){
-    //     CollisionTup collision;
-    //     collision.collisionType = collisionType;
-    //     collision.tile = tiles[i].tile;
-    //     collisions.push_back(collision);
-    //   }
-    // }
+    const int tileWidth = tileSet->getTileWidth();
+    const int tileHeight = tileSet->getTileHeight();
+    const int tilesWide = width / tileWidth;
+    const int tilesHigh = height / tileHeight;
+
+    // only visit the tiles the rectangle overlaps
+    const int firstX = std::max(0, static_cast<int>(std::floor(mbr.x / tileWidth)));
+    const int lastX = std::min(tilesWide - 1, static_cast<int>(std::floor((mbr.x + mbr.width) / tileWidth)));
+    const int firstY = std::max(0, static_cast<int>(std::floor(mbr.y / tileHeight)));
+    const int lastY = std::min(tilesHigh - 1, static_cast<int>(std::floor((mbr.y + mbr.height) / tileHeight)));
+
+    for (int y = firstY; y <= lastY && y < m_tiles.height(); y++) {
+        for (int x = firstX; x <= lastX && x < m_tiles.width(); x++) {
+            const Tile* pTile = this->lookupTile(x, y);
+            if (pTile == nullptr || pTile->type != TILE_SOLID) {
+                continue;
+            }
+
+            const Rectangle tileMBR(x * tileWidth, y * tileHeight, tileWidth, tileHeight);
+            CollisionType collisionType = detectMBRCollision(mbr, tileMBR);
+            if (collisionType != COLLISION_NONE) {
+                collisions.push_back(CollisionTup{*pTile, collisionType});
+            }
+        }
+    }
 
     return collisions;
 }
 
 Surface* Map2D::getSurface()
 {
-    if (m_surfaceDirty) {
-        drawSurface();
-        m_surfaceDirty = false;
+    this->updateSurface();
+    return surface;
+}
+
+//! Gets the map drawn into a texture.
+/**
+ The texture is kept between calls.  Changing a tile only copies that tile to
+ it, so editing a large map doesn't upload all of it again.
+ \param windowId
+   \li The window the texture will be drawn in.
+ \return
+   \li The texture.  It is owned by the map and valid until the next call.
+*/
+Texture* Map2D::getTexture(Uint32 windowId)
+{
+    CAP_THROW_ASSERT(Locator::videoManager != nullptr, "Video Manager is null");
+    this->updateSurface();
+
+    const int tileSize = tileSet->getTileSize();
+    if (exceedsPartialUpdateLimit(m_changedRects.size(), width / tileSize, height / tileSize)) {
+        m_textureDirty = true;
     }
 
-    return surface;
+    if (m_pTexture == nullptr || m_textureWindowId != windowId || m_textureDirty) {
+        m_pTexture = Locator::videoManager->createStreamingTexturePtr(windowId, surface);
+        m_textureWindowId = windowId;
+        m_textureDirty = false;
+    }
+    else {
+        for (auto&& rect : m_changedRects) {
+            Locator::videoManager->updateTexture(m_pTexture.get(), surface, rect);
+        }
+    }
+    m_changedRects.clear();
+
+    return m_pTexture.get();
 }
 
 int Map2D::getWidth() const { return width; }
@@ -332,12 +438,16 @@ int Map2D::getHeight() const { return height; }
 void Map2D::setWidth(int newWidth)
 {
     width = newWidth;
+    m_tiles.resize(width / tileSet->getTileWidth(), m_tiles.height());
+    m_surfaceDirty = true;
     m_isDirty = true;
 }
 
 void Map2D::setHeight(int newHeight)
 {
     height = newHeight;
+    m_tiles.resize(m_tiles.width(), height / tileSet->getTileHeight());
+    m_surfaceDirty = true;
     m_isDirty = true;
 }
 
@@ -351,17 +461,14 @@ int Map2D::getTileSize() const
 void Map2D::deleteTile(int x, int y)
 {
     int tileSize = tileSet->getTileSize();
-    if (x > boost::numeric_cast<int>(width) / tileSize ||
-        y > boost::numeric_cast<int>(height) / tileSize || x < 0 || y < 0) {
+    if (x >= boost::numeric_cast<int>(width) / tileSize ||
+        y >= boost::numeric_cast<int>(height) / tileSize || x < 0 || y < 0) {
         BOOST_THROW_EXCEPTION(CapEngineException("Invalid Tile Index"));
     }
 
-    TileTup tiletup;
-    memset(&tiletup, 0, sizeof(TileTup));
-    tiletup.tileLookupStatus = TileLookupStatus_NoTile;
-
-    tiles[x][y] = tiletup;
+    m_tiles.set(x, y, TileGrid::kNoTile);
 
+    m_dirtyTiles.emplace_back(x, y);
     m_isDirty = true;
 }
 
@@ -384,22 +491,58 @@ void Map2D::setTile(int x, int y, int tileSetIndex)
     int widthInTiles = this->width / tileSet->getTileWidth();
     int heightInTiles = this->height / tileSet->getTileHeight();
 
-    if (x > widthInTiles || y > heightInTiles || x < 0 || y < 0) {
+    if (x >= widthInTiles || y >= heightInTiles || x < 0 || y < 0) {
         BOOST_THROW_EXCEPTION(MapIndexException(x, y));
     }
 
-    Tile tile = tileSet->getTile(tileSetIndex);
+    // a negative index, as returned by getTileIndex(), clears the tile
+    if (tileSetIndex < 0) {
+        this->deleteTile(x, y);
+        return;
+    }
 
-    TileTup tiletup;
-    tiletup.tileLookupStatus = TileLookupStatus_Found;
-    tiletup.index = tileSetIndex;
-    tiletup.tile = tile;
+    if (!tileSet->tileExists(tileSetIndex))
+        BOOST_THROW_EXCEPTION(CapEngineException(
+            "Tile does not exist at index " + std::to_string(tileSetIndex)));
 
-    assert(static_cast<size_t>(y) < tiles.size());
-    assert(static_cast<size_t>(x) < tiles[y].size());
-    tiles[y][x] = tiletup;
+    m_tiles.set(x, y, tileSetIndex);
 
-    m_surfaceDirty = true;
+    m_dirtyTiles.emplace_back(x, y);
+    m_isDirty = true;
+}
+
+//! Set a run of tiles in a row to the same index.
+/**
+ The tiles are written a chunk at a time, so this is much cheaper than calling
+ setTile() for each of them.
+  \param x
+        \li The x location of the first tile.
+  \param y
+        \li The y location of the tiles.
+  \param count
+        \li The number of tiles.
+  \param tileSetIndex
+        \li The index into the tileset, or a negative index to clear the tiles.
+*/
+void Map2D::setTiles(int x, int y, int count, int tileSetIndex)
+{
+    assert(tileSet != nullptr);
+    int widthInTiles = this->width / tileSet->getTileWidth();
+    int heightInTiles = this->height / tileSet->getTileHeight();
+
+    if (count < 0 || x < 0 || y < 0 || x + count > widthInTiles || y >= heightInTiles) {
+        BOOST_THROW_EXCEPTION(MapIndexException(x, y));
+    }
+
+    if (tileSetIndex >= 0 && !tileSet->tileExists(tileSetIndex))
+        BOOST_THROW_EXCEPTION(CapEngineException(
+            "Tile does not exist at index " + std::to_string(tileSetIndex)));
+
+    m_tiles.fillRow(x, y, count, tileSetIndex < 0 ? TileGrid::kNoTile : static_cast<uint32_t>(tileSetIndex));
+
+    for (int i = x; i < x + count; i++) {
+        m_dirtyTiles.emplace_back(i, y);
+    }
     m_isDirty = true;
 }
 
@@ -410,33 +553,46 @@ void Map2D::setTile(int x, int y, int tileSetIndex)
 */
 void Map2D::save(const std::string& filepath) const
 {
+    namespace fs = std::filesystem;
     const std::string path = filepath == "" ? configPath : filepath;
-    if (path == configPath) m_isDirty = false;
+
+    // the tiles go in a binary file next to the json.  Saving to the same file
+    // again only rewrites the chunks changed since.
+    fs::path tileFilePath =
+        fs::absolute(fs::path(path).replace_extension(kTileFileExtension))
+            .lexically_normal();
+    const bool sameTileFile = tileFilePath == m_savedTilesPath;
+    m_tiles.save(tileFilePath, sameTileFile ? &m_savedTiles : nullptr);
+    m_savedTiles = m_tiles;
+    m_savedTilesPath = tileFilePath;
+
+    jsoncons::json json = this->jsonHeader();
+    json.insert_or_assign(kTileFileParameterName,
+                          tileFilePath.filename().string());
 
     std::ofstream f(path);
-    f << jsoncons::pretty_print(this->json());
+    f << jsoncons::pretty_print(json);
+
+    if (path == configPath) m_isDirty = false;
 }
 
 //! return json representationof the map
 /**
+ Unlike save(), the tiles are included as an array.
  \return
    \li The json representation of the map
 */
 jsoncons::json Map2D::json() const
 {
-    jsoncons::json json;
-
-    json.insert_or_assign(kWidthParameterName, this->getWidth());
-    json.insert_or_assign(kHeightParameterName, this->getHeight());
-    json.insert_or_assign(kTilesetParamaterName, tileSetPath);
+    jsoncons::json json = this->jsonHeader();
 
     // the tiles array
     jsoncons::json::array rows;
-    for (auto&& row : tiles) {
+    for (int y = 0; y < m_tiles.height(); y++) {
         jsoncons::json::array cols;
-        for (auto&& tileTup : row) {
+        for (int x = 0; x < m_tiles.width(); x++) {
             jsoncons::json tile;
-            tile.insert_or_assign(kIndexParameterName, tileTup.index);
+            tile.insert_or_assign(kIndexParameterName, this->getTileIndex(x, y));
             cols.emplace_back(tile);
         }
         rows.emplace_back(cols);
@@ -447,6 +603,42 @@ jsoncons::json Map2D::json() const
     return json;
 }
 
+//! return json properties of the map other than its tiles
+/**
+ \return
+   \li The json
+*/
+jsoncons::json Map2D::jsonHeader() const
+{
+    jsoncons::json json;
+
+    json.insert_or_assign(kWidthParameterName, this->getWidth());
+    json.insert_or_assign(kHeightParameterName, this->getHeight());
+    json.insert_or_assign(kTilesetParamaterName, tileSetPath);
+
+    return json;
+}
+
+//! Looks up the tile at a location in the tileset.
+/**
+ \param x
+   \li the x location in the map.
+ \param y
+   \li the y location in the map.
+ \return
+   \li The tile, or null if there isn't one.
+*/
+const Tile* Map2D::lookupTile(int x, int y) const
+{
+    const uint32_t index = m_tiles.get(x, y);
+    if (index == TileGrid::kNoTile) return nullptr;
+
+    // only indexes in the tileset are stored
+    const std::vector<Tile>& tiles = tileSet->getTiles();
+    assert(index < tiles.size());
+    return &tiles[index];
+}
+
 //! Check if Map has been changed since loaded/saved.
 /**
  \return
@@ -473,8 +665,8 @@ int Map2D::getTileIndex(int x, int y) const
         BOOST_THROW_EXCEPTION(MapIndexException(x, y));
     }
 
-    TileTup tile = tiles[y][x];
-    return tile.index;
+    const uint32_t index = m_tiles.get(x, y);
+    return index == TileGrid::kNoTile ? -1 : static_cast<int>(index);
 }
 
 //! Get the path to the tileset configuration file.
@@ -6,8 +6,10 @@
 #include "captypes.h"
 #include "collision.h"
 #include "property.h"
+#include "tilegrid.h"
 #include "tileset.h"
 
+#include <filesystem>
 #include <fstream>
 #include <jsoncons/json.hpp>
 #include <memory>
@@ -31,18 +33,6 @@ class Map2D
 {
 
 public:
-  enum TileLookupStatus {
-    TileLookupStatus_Found,
-    TileLookupStatus_NotFound,
-    TileLookupStatus_NoTile
-  };
-
-  struct TileTup {
-    Tile tile;
-    int index;
-    TileLookupStatus tileLookupStatus;
-  };
-
   struct CollisionTup {
     Tile tile;
     CollisionType collisionType;
@@ -60,6 +50,7 @@ public:
   std::string toString();
   std::vector<CollisionTup> getCollisions(const Rectangle &mbr);
   Surface *getSurface();
+  Texture *getTexture(Uint32 windowId);
   int getWidth() const;
   int getHeight() const;
   int getTileSize() const;
@@ -71,6 +62,7 @@ public:
   void setHeight(int height);
   void deleteTile(int x, int y);
   void setTile(int x, int y, int tileSetIndex);
+  void setTiles(int x, int y, int count, int tileSetIndex);
 
   std::shared_ptr<TileSet> getTileSet();
   std::string getTileSetPath() const;
@@ -80,15 +72,33 @@ public:
 
 private:
   void load(jsoncons::json json);
+  jsoncons::json jsonHeader() const;
+  const Tile *lookupTile(int x, int y) const;
   void drawSurface();
+  void drawTile(int x, int y);
+  void updateSurface();
   std::unique_ptr<Rectangle> getTileMBR(int index);
 
   std::string configPath;
   std::string tileSetPath;
   std::shared_ptr<TileSet> tileSet;
-  std::vector<std::vector<TileTup>> tiles;
+  //! indexes into the tileset, shared with copies of the map until changed
+  TileGrid m_tiles;
+  //! the tiles as last saved to m_savedTilesPath, so saving only writes the
+  //! chunks changed since
+  mutable TileGrid m_savedTiles;
+  mutable std::filesystem::path m_savedTilesPath;
   Surface *surface = nullptr;
   bool m_surfaceDirty = true;
+  //! tiles changed since the surface was drawn, as x, y indexes
+  std::vector<std::pair<int, int>> m_dirtyTiles;
+  //! parts of the surface not yet copied to m_pTexture
+  std::vector<Rect> m_changedRects;
+  //! the surface as a texture, for the window m_textureWindowId
+  TexturePtr m_pTexture = getNullTexturePtr();
+  Uint32 m_textureWindowId = VideoManager::kInvalidWindowId;
+  //! flag indicating the whole texture needs copying from the surface
+  bool m_textureDirty = true;
   unsigned int width = 0;
   unsigned int height = 0;
   //! flag indicating if data has been changed since last save.
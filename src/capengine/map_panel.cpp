@@ -7,7 +7,6 @@
 #include <sstream>
 
 #include "CapEngineException.h"
-#include "aggregatecommand.h"
 #include "captypes.h"
 #include "colour.h"
 #include "control.h"
@@ -17,8 +16,9 @@
 #include "logging.h"
 #include "pancontrol.h"
 #include "scopeguard.h"
-#include "simplecommand.h"
 #include "tilecopycontrol.h"
+#include "tileeditcommand.h"
+#include "tilerange.h"
 #include "uiutils.h"
 #include "utils.h"
 
@@ -39,28 +39,6 @@ void scaleMatrix(CapEngine::Matrix& matrix, float scaleIncrement)
     matrix = matrix + CapEngine::Matrix::createScaleMatrix(scaleIncrement, scaleIncrement, scaleIncrement);
 }
 
-//! Creates a command for setting a tile in a map.
-/**
- \param pMap
-   \li The map to change.
- \param x
-   \li The x index into the map.
- \param y
-   \li The y index into the map.
- \param tileIndex
-   \li The index into the tileset to set.
- \return
-*/
-std::unique_ptr<Command> makeSetTileCommand(std::shared_ptr<Map2D> pMap, int x, int y, int tileIndex)
-{
-    auto execute = [pMap, x, y, tileIndex]() { pMap->setTile(x, y, tileIndex); };
-
-    int oldTileIndex = pMap->getTileIndex(x, y);
-    auto unExecute = [pMap, x, y, oldTileIndex]() { pMap->setTile(x, y, oldTileIndex); };
-
-    return std::make_unique<SimpleCommand>(execute, unExecute);
-}
-
 }  // namespace
 
 //! Constructor
@@ -139,45 +117,33 @@ void MapPanel::render()
 
     if (!m_locationInitialized) doLocationInit();
 
-    Surface* surface = m_pMap->getSurface();
-    if (surface != nullptr) {
-        TexturePtr texture = textureToTexturePtr(videoManager->createTextureFromSurface(m_windowId, surface, false));
-
-        int mapWidth = m_pMap->getWidth();
-        int mapHeight = m_pMap->getHeight();
-        Rect srcRect = {0, 0, 0, 0};
-        Rect dstRect = {m_x, m_y, 0, 0};
+    // only the part of the map that's in the panel is drawn.
+    std::optional<SDL_Rect> maybeTileRange = this->getTileRange(this->getVisibleMapExtents());
+    if (maybeTileRange == std::nullopt) return;
 
-        srcRect.w = mapWidth;
-        srcRect.h = mapHeight;
+    Texture* texture = m_pMap->getTexture(m_windowId);
+    assert(texture != nullptr);
 
-        Vector dstVectorOrigin(static_cast<double>(m_x), static_cast<double>(m_y), 0.0, 1.0);
-        dstVectorOrigin = m_translationMatrix * dstVectorOrigin;
-
-        Vector dstVectorDims(mapWidth, mapHeight, 0.0, 1.0);
-        dstVectorDims = m_scaleMatrix * dstVectorDims;
-
-        dstRect.x = dstVectorOrigin.getX();
-        dstRect.y = dstVectorOrigin.getY();
-        dstRect.w = dstVectorDims.getX();
-        dstRect.h = dstVectorDims.getY();
+    int tileSize = m_pMap->getTileSize();
+    double scaledTileSize = this->getScaledTileSize();
+    Vector mapOrigin = this->getMapOrigin();
 
-        // clip to current rect
-        SDL_Rect clipRect({m_x, m_y, m_width, m_height});
-        ScopeGuard guard([&]() { videoManager->setClipRect(m_windowId, nullptr); });
-        videoManager->setClipRect(m_windowId, &clipRect);
+    Rect srcRect = {maybeTileRange->x * tileSize, maybeTileRange->y * tileSize, maybeTileRange->w * tileSize,
+                    maybeTileRange->h * tileSize};
+    Rect dstRect = {static_cast<int>(round(mapOrigin.getX() + maybeTileRange->x * scaledTileSize)),
+                    static_cast<int>(round(mapOrigin.getY() + maybeTileRange->y * scaledTileSize)),
+                    static_cast<int>(round(maybeTileRange->w * scaledTileSize)),
+                    static_cast<int>(round(maybeTileRange->h * scaledTileSize))};
 
-        Locator::videoManager->drawTexture(m_windowId, texture.get(), &srcRect, &dstRect, false);
+    // clip to current rect
+    SDL_Rect clipRect({m_x, m_y, m_width, m_height});
+    ScopeGuard guard([&]() { videoManager->setClipRect(m_windowId, nullptr); });
+    videoManager->setClipRect(m_windowId, &clipRect);
 
-        // draw outlines over tiles (drag?)
-        this->drawTileOutlines(m_outlinedTiles, Colour(0, 0, 0, 255));
-    }
+    Locator::videoManager->drawTexture(m_windowId, texture, &srcRect, &dstRect, false);
 
-    else {
-        std::ostringstream msg;
-        msg << "Map texture is null";
-        BOOST_LOG_SEV(CapEngine::log, boost::log::trivial::warning) << msg.str();
-    }
+    // draw outlines over tiles (drag?)
+    this->drawTileOutlines(m_outlinedTiles, Colour(0, 0, 0, 255));
 }
 
 //! \copydoc Widget::handleMouseMotionevent
@@ -259,9 +225,8 @@ void MapPanel::handleLeftMouseButtonUp(SDL_MouseButtonEvent event)
                 // find the current loccation in the map
                 std::pair<int, int> hoveredTile = getHoveredTile(x, y);
                 if (hoveredTile.first != -1 && hoveredTile.second != -1) {
-                    std::unique_ptr<Command> pSetTileCommand =
-                        makeSetTileCommand(m_pMap, hoveredTile.first, hoveredTile.second, pTileCopyControl->getIndex());
-                    assert(pSetTileCommand != nullptr);
+                    auto pSetTileCommand = std::make_unique<TileEditCommand>(m_pMap);
+                    pSetTileCommand->setTile(hoveredTile.first, hoveredTile.second, pTileCopyControl->getIndex());
 
                     pEditor->getCommandManager().runCommand(std::move(pSetTileCommand));
                 }
@@ -279,20 +244,15 @@ void MapPanel::handleLeftMouseButtonUp(SDL_MouseButtonEvent event)
                 Rect dragRect = {maybeInitialCoords->first, maybeInitialCoords->second, x - maybeInitialCoords->first,
                                  y - maybeInitialCoords->second};
 
+                // the tiles come a row at a time, so the command stores a run
+                // per row of the fill.
                 std::vector<std::pair<int, int>> tilesInDrag = this->getTilesInRect(dragRect);
-                std::vector<std::unique_ptr<Command>> commands;
-                commands.reserve(tilesInDrag.size());
-
+                auto pFillCommand = std::make_unique<TileEditCommand>(m_pMap);
                 for (auto&& i : tilesInDrag) {
-                    std::unique_ptr<Command> pSetTileCommand =
-                        makeSetTileCommand(m_pMap, i.first, i.second, pTileCopyControl->getIndex());
-                    assert(pSetTileCommand != nullptr);
-
-                    commands.push_back(std::move(pSetTileCommand));
+                    pFillCommand->setTile(i.first, i.second, pTileCopyControl->getIndex());
                 }
 
-                auto pAggregateCommand = std::make_unique<AggregateCommand>(std::move(commands));
-                pEditor->getCommandManager().runCommand(std::move(pAggregateCommand));
+                pEditor->getCommandManager().runCommand(std::move(pFillCommand));
 
                 m_outlinedTiles.clear();
             }
@@ -382,10 +342,10 @@ void MapPanel::drawTileOutlines(const std::vector<std::pair<int, int>>& tiles, C
 {
     CAP_THROW_ASSERT(Locator::videoManager != nullptr, "VideoManager is null");
 
-    for (auto&& tile : tiles) {
-        Vector mapOrigin = m_translationMatrix * Vector(static_cast<double>(m_x), static_cast<double>(m_y), 0.0, 1.0);
-        double scaledTileSize = this->getScaledTileSize();
+    Vector mapOrigin = this->getMapOrigin();
+    double scaledTileSize = this->getScaledTileSize();
 
+    for (auto&& tile : tiles) {
         Rect dstRect = {0, 0, static_cast<int>(round(scaledTileSize)), static_cast<int>(round(scaledTileSize))};
         dstRect.x = round(mapOrigin.getX() + (static_cast<double>(tile.first) * scaledTileSize));
         dstRect.y = round(mapOrigin.getY() + (static_cast<double>(tile.second) * scaledTileSize));
@@ -429,7 +389,7 @@ std::pair<int, int> MapPanel::getHoveredTile(int x, int y) const
 {
     if (isInMap(x, y)) {
         double scaledTileSize = this->getScaledTileSize();
-        Vector mapOrigin = m_translationMatrix * Vector(static_cast<double>(m_x), static_cast<double>(m_y), 0.0, 1.0);
+        Vector mapOrigin = this->getMapOrigin();
 
         int xTile = (x - mapOrigin.getX()) / scaledTileSize;
         int yTile = (y - mapOrigin.getY()) / scaledTileSize;
@@ -460,7 +420,7 @@ bool MapPanel::isInMap(int x, int y) const
 */
 SDL_Rect MapPanel::getMapExtents() const
 {
-    Vector mapOrigin = m_translationMatrix * Vector(static_cast<double>(m_x), static_cast<double>(m_y), 0.0, 1.0);
+    Vector mapOrigin = this->getMapOrigin();
     Vector mapDims = m_scaleMatrix * Vector(m_pMap->getWidth(), m_pMap->getHeight(), 0.0, 1.0);
 
     return {static_cast<int>(mapOrigin.getX()), static_cast<int>(mapOrigin.getY()), static_cast<int>(mapDims.getX()),
@@ -493,74 +453,52 @@ double MapPanel::getScaledTileSize() const
     return static_cast<double>(m_pMap->getTileSize()) * scaleFactor;
 }
 
-//! Get a list of tile rects at the given size and location.
+//! Gets the window location of the map's top left corner.
 /**
- \return
-   \li The list of pairs
-                 \li first is if the tile is visible
-                 \li second is the rectangle.
+ \return The location.
 */
-std::vector<std::tuple<int, int, bool, SDL_Rect>> MapPanel::getTileRects() const
+Vector MapPanel::getMapOrigin() const
 {
-    double scaledTileSize = this->getScaledTileSize();
-    SDL_Rect visibleExtents = this->getVisibleMapExtents();
-    Vector mapOrigin = m_translationMatrix * Vector(static_cast<double>(m_x), static_cast<double>(m_y), 0.0, 1.0);
-    int tileSize = m_pMap->getTileSize();
-    int numTilesWide = m_pMap->getWidth() / tileSize;
-    int numTilesHigh = m_pMap->getHeight() / tileSize;
-
-    std::vector<std::tuple<int, int, bool, SDL_Rect>> rects;
-    for (int x = 0; x < numTilesWide; x++) {
-        for (int y = 0; y < numTilesHigh; y++) {
-            SDL_Rect rect;
-            rect.w = scaledTileSize;
-            rect.h = scaledTileSize;
-
-            Vector location(mapOrigin.getX() + (x * scaledTileSize), mapOrigin.getY() + (y * scaledTileSize), 0, 1);
-
-            rect.x = location.getX();
-            rect.y = location.getY();
-
-            bool visible = detectMBRCollision(rect, visibleExtents) != COLLISION_NONE;
+    return m_translationMatrix * Vector(static_cast<double>(m_x), static_cast<double>(m_y), 0.0, 1.0);
+}
 
-            rects.emplace_back(std::make_tuple(x, numTilesHigh - y, visible, rect));
-        }
-    }
+//! Gets where the map's tiles are drawn, for the current pan and zoom.
+/**
+ \return The view.
+*/
+TileView MapPanel::getTileView() const
+{
+    Vector mapOrigin = this->getMapOrigin();
+    int tileSize = m_pMap->getTileSize();
+    return TileView{mapOrigin.getX(), mapOrigin.getY(), this->getScaledTileSize(), m_pMap->getWidth() / tileSize,
+                    m_pMap->getHeight() / tileSize};
+}
 
-    return rects;
+//! Gets the range of tiles that are in or intersect with the given rect.
+/**
+ \param rect
+   \li The rect in window coordinates.
+ \return
+   \li The first tile's x, y indexes and the number of tiles across and down,
+   or nullopt if the rect doesn't touch the map.
+*/
+std::optional<SDL_Rect> MapPanel::getTileRange(const SDL_Rect& rect) const
+{
+    return CapEngine::getTileRange(rect, this->getTileView());
 }
 
 //! Gets all tiles that are in or intersect with the given rect.
 /**
  \param rect
-   \li The rect to test intersection with.
+   \li The rect to test intersection with.  It may have a negative width or
+   height, e.g. when dragging up or left.
  \return
-   \li The list off tiles in the form of pairs or x,y indexes into the map.
+   \li The list off tiles in the form of pairs or x,y indexes into the map, a
+   row at a time.
 */
 std::vector<std::pair<int, int>> MapPanel::getTilesInRect(const SDL_Rect& rect) const
 {
-    std::vector<std::pair<int, int>> tilesInRect;
-    std::vector<std::tuple<int, int, bool, SDL_Rect>> tileRects = this->getTileRects();
-    Rect visibleMapRect = this->getVisibleMapExtents();
-
-    std::optional<Rect> clippedRect = clipRect(rect, visibleMapRect);
-    if (clippedRect != std::nullopt) {
-        int tileSize = m_pMap->getTileSize();
-        int numTilesWide = m_pMap->getWidth() / tileSize;
-        int numTilesHigh = m_pMap->getHeight() / tileSize;
-
-        for (unsigned int i = 0; i < tileRects.size(); i++) {
-            int x, y;
-            bool visible;
-            SDL_Rect rect;
-            std::tie(x, y, visible, rect) = tileRects[i];
-            if (visible && detectMBRCollision(rect, *clippedRect) != COLLISION_NONE) {
-                tilesInRect.push_back(std::make_pair(x, numTilesHigh - y));
-            }
-        }
-    }
-
-    return tilesInRect;
+    return CapEngine::getTilesInRect(rect, this->getVisibleMapExtents(), this->getTileView());
 }
 
 //! Gets the map held by the panel.
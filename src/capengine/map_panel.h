@@ -4,10 +4,12 @@
 #include "IEventSubscriber.h"
 #include "map2d.h"
 #include "matrix.h"
+#include "tilerange.h"
 #include "vector.h"
 #include "widget.h"
 
 #include <SDL2/SDL.h>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -33,6 +35,8 @@ public:
   virtual void setSize(int width, int height) override;
   virtual void render() override;
   virtual void update(double ms) override;
+  //! The map and its overlays change every frame.
+  virtual bool isRetained() const override { return false; }
 
   virtual void handleMouseMotionEvent(SDL_MouseMotionEvent event) override;
   virtual void handleMouseButtonEvent(SDL_MouseButtonEvent event) override;
@@ -62,7 +66,9 @@ private:
   SDL_Rect getMapExtents() const;
   SDL_Rect getVisibleMapExtents() const;
   double getScaledTileSize() const;
-  std::vector<std::tuple<int, int, bool, SDL_Rect>> getTileRects() const;
+  Vector getMapOrigin() const;
+  TileView getTileView() const;
+  std::optional<SDL_Rect> getTileRange(const SDL_Rect &rect) const;
   std::vector<std::pair<int, int>> getTilesInRect(const SDL_Rect &rect) const;
 
   //! the map that is being edited
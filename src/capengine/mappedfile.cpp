@@ -0,0 +1,70 @@
+#include "mappedfile.h"
+
+#include <fstream>
+
+#include "CapEngineException.h"
+
+#ifdef UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace CapEngine {
+
+//! Opens and maps a file.
+/**
+ \param in_path
+   The file.  Throws CapEngineException if it can't be opened.
+*/
+MappedFile::MappedFile(const std::filesystem::path& in_path) : m_path(in_path)
+{
+#ifdef UNIX
+    const int fd = ::open(in_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        CAP_THROW(CapEngineException("Unable to open " + in_path.string()));
+    }
+
+    struct stat info {};
+    if (::fstat(fd, &info) == -1) {
+        ::close(fd);
+        CAP_THROW(CapEngineException("Unable to stat " + in_path.string()));
+    }
+
+    m_size = static_cast<std::size_t>(info.st_size);
+    if (m_size > 0) {
+        void* pMapping = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (pMapping == MAP_FAILED) {
+            ::close(fd);
+            CAP_THROW(CapEngineException("Unable to map " + in_path.string()));
+        }
+        m_pData = static_cast<const std::byte*>(pMapping);
+    }
+
+    // the mapping keeps the file alive.
+    ::close(fd);
+#else
+    std::ifstream stream{in_path, std::ios::binary | std::ios::ate};
+    if (!stream) {
+        CAP_THROW(CapEngineException("Unable to open " + in_path.string()));
+    }
+
+    m_buffer.resize(static_cast<std::size_t>(stream.tellg()));
+    stream.seekg(0);
+    stream.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+    m_pData = m_buffer.data();
+    m_size = m_buffer.size();
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef UNIX
+    if (m_pData != nullptr) {
+        ::munmap(const_cast<std::byte*>(m_pData), m_size);
+    }
+#endif
+}
+
+}  // namespace CapEngine
@@ -0,0 +1,50 @@
+#ifndef CAPENGINE_MAPPEDFILE_H
+#define CAPENGINE_MAPPEDFILE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace CapEngine {
+
+//! A read only view of a whole file.
+/**
+   On UNIX the file is memory mapped, so nothing is read until a page is
+   touched and the pages are shared with the OS file cache.  Elsewhere the file
+   is read into memory.  Either way the bytes stay valid and unchanged for the
+   lifetime of the object.
+*/
+class MappedFile final {
+   public:
+    explicit MappedFile(const std::filesystem::path& in_path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] std::span<const std::byte> bytes() const;
+    [[nodiscard]] const std::filesystem::path& path() const;
+
+   private:
+    std::filesystem::path m_path;       //!< The file.
+    const std::byte* m_pData = nullptr;  //!< The start of the mapping or of m_buffer.
+    std::size_t m_size = 0;              //!< The size of the file.
+    std::vector<std::byte> m_buffer;     //!< The contents when the file isn't mapped.
+};
+
+//! Returns the contents of the file.
+inline std::span<const std::byte> MappedFile::bytes() const
+{
+    return {m_pData, m_size};
+}
+
+//! Returns the path the file was opened from.
+inline const std::filesystem::path& MappedFile::path() const
+{
+    return m_path;
+}
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_MAPPEDFILE_H
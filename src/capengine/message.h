@@ -0,0 +1,82 @@
+#ifndef CAPENGINE_MESSAGE_H
+#define CAPENGINE_MESSAGE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace CapEngine {
+
+//! Identifies a kind of message.  Allocate with GameObject::generateMessageId().
+using MessageId = int;
+
+//! A fixed size message passed between game objects.
+/**
+   The payload is any trivially copyable type that fits in kMaxPayloadSize
+   bytes, so messages can be queued and copied without allocating.
+*/
+struct Message {
+    static constexpr std::size_t kMaxPayloadSize = 48;
+
+    MessageId id = -1;     //!< The kind of message.
+    int64_t sender = -1;   //!< The ObjectID of the sender, or -1.
+    uint16_t size = 0;     //!< The number of payload bytes in use.
+    alignas(std::max_align_t) std::array<std::byte, kMaxPayloadSize> payload{};
+
+    template <typename T>
+    [[nodiscard]] static Message make(MessageId in_id, const T& in_payload, int64_t in_sender = -1);
+
+    template <typename T>
+    [[nodiscard]] T as() const;
+};
+
+static_assert(std::is_trivially_copyable_v<Message>);
+
+//! Makes a message.
+/**
+ \param in_id
+   The kind of message.
+ \param in_payload
+   The payload, copied into the message.
+ \param in_sender
+   The ObjectID of the sender.
+ \return
+   The message.
+*/
+template <typename T>
+Message Message::make(MessageId in_id, const T& in_payload, int64_t in_sender)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Message payloads must be trivially copyable");
+    static_assert(sizeof(T) <= kMaxPayloadSize, "Message payload is too large");
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Message payload is over aligned");
+
+    Message message;
+    message.id = in_id;
+    message.sender = in_sender;
+    message.size = static_cast<uint16_t>(sizeof(T));
+    std::memcpy(message.payload.data(), &in_payload, sizeof(T));
+
+    return message;
+}
+
+//! Reads the payload of a message.
+/**
+ \return
+   A copy of the payload.
+*/
+template <typename T>
+T Message::as() const
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Message payloads must be trivially copyable");
+    static_assert(sizeof(T) <= kMaxPayloadSize, "Message payload is too large");
+
+    T value;
+    std::memcpy(&value, payload.data(), sizeof(T));
+    return value;
+}
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_MESSAGE_H
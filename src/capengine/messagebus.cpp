@@ -0,0 +1,74 @@
+#include "messagebus.h"
+
+#include <utility>
+
+namespace CapEngine {
+
+//! Constructor.
+/**
+ \param in_reserve
+   The number of messages per frame to reserve space for.
+*/
+MessageBus::MessageBus(std::size_t in_reserve)
+{
+    m_queue.reserve(in_reserve);
+    m_dispatching.reserve(in_reserve);
+}
+
+//! Queues a message for one object.
+/**
+ \param in_target
+   The id of the object to deliver to.
+ \param in_message
+   The message.
+*/
+void MessageBus::post(ObjectID in_target, const Message& in_message)
+{
+    m_queue.push_back(Envelope{in_message, in_target, {}, false});
+}
+
+//! Queues a message for every object of a type.
+/**
+ \param in_objectType
+   The type of objects to deliver to.
+ \param in_message
+   The message.
+*/
+void MessageBus::broadcast(GameObject::ObjectType in_objectType, const Message& in_message)
+{
+    m_queue.push_back(Envelope{in_message, -1, in_objectType, true});
+}
+
+//! Delivers the queued messages.
+/**
+ Messages for objects that no longer exist are dropped.
+ \param io_objectManager
+   The objects to deliver to.
+*/
+void MessageBus::dispatch(ObjectManager& io_objectManager)
+{
+    std::swap(m_queue, m_dispatching);
+
+    for (const Envelope& envelope : m_dispatching) {
+        if (envelope.broadcast) {
+            for (auto&& pObject : io_objectManager.getObjects()) {
+                if (pObject != nullptr && pObject->getObjectType() == envelope.objectType) {
+                    pObject->receive(envelope.message);
+                }
+            }
+        }
+        else if (GameObject* pObject = io_objectManager.findObject(envelope.target); pObject != nullptr) {
+            pObject->receive(envelope.message);
+        }
+    }
+
+    m_dispatching.clear();
+}
+
+//! Drops all queued messages.
+void MessageBus::clear()
+{
+    m_queue.clear();
+}
+
+}  // namespace CapEngine
@@ -0,0 +1,55 @@
+#ifndef CAPENGINE_MESSAGEBUS_H
+#define CAPENGINE_MESSAGEBUS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "gameobject.h"
+#include "message.h"
+#include "objectmanager.h"
+
+namespace CapEngine {
+
+//! Queues messages between game objects and delivers them in a batch.
+/**
+   Messages posted during a frame are held until dispatch(), which Scene2d
+   calls once all objects have been updated.  Messages posted while
+   dispatching are delivered on the next dispatch.  The queues keep their
+   storage between frames so a steady message rate does not allocate.
+*/
+class MessageBus final {
+   public:
+    explicit MessageBus(std::size_t in_reserve = kDefaultReserve);
+
+    void post(ObjectID in_target, const Message& in_message);
+    void broadcast(GameObject::ObjectType in_objectType, const Message& in_message);
+    void dispatch(ObjectManager& io_objectManager);
+    void clear();
+
+    [[nodiscard]] std::size_t pending() const;
+
+    static constexpr std::size_t kDefaultReserve = 256;
+    static constexpr char kMessageBusLocatorId[] = "MessageBus";
+
+   private:
+    //! A queued message and who it is for.
+    struct Envelope {
+        Message message;
+        ObjectID target = -1;                 //!< The recipient, unless broadcast.
+        GameObject::ObjectType objectType{};  //!< The recipients, if broadcast.
+        bool broadcast = false;
+    };
+
+    std::vector<Envelope> m_queue;        //!< Messages for the next dispatch.
+    std::vector<Envelope> m_dispatching;  //!< Messages being delivered.
+};
+
+//! Returns the number of messages waiting for the next dispatch.
+inline std::size_t MessageBus::pending() const
+{
+    return m_queue.size();
+}
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_MESSAGEBUS_H
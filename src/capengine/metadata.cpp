@@ -0,0 +1,95 @@
+#include "metadata.h"
+
+#include <algorithm>
+
+namespace CapEngine {
+
+//! Sets a value, replacing any existing value for the key.
+/**
+ \param in_key
+   The key.
+ \param in_value
+   The value.
+*/
+void MetadataMap::set(StringId in_key, MetadataType in_value)
+{
+    auto it = this->lowerBound(in_key);
+    if (it != m_entries.end() && it->first == in_key) {
+        it->second = std::move(in_value);
+    }
+    else {
+        m_entries.emplace(it, in_key, std::move(in_value));
+    }
+}
+
+//! \copydoc MetadataMap::set(StringId, MetadataType)
+void MetadataMap::set(std::string_view in_key, MetadataType in_value)
+{
+    this->set(StringId{in_key}, std::move(in_value));
+}
+
+//! Removes a value.
+/**
+ \param in_key
+   The key.
+ \return
+   true if there was a value to remove.
+*/
+bool MetadataMap::erase(StringId in_key)
+{
+    auto it = this->lowerBound(in_key);
+    if (it == m_entries.end() || it->first != in_key) {
+        return false;
+    }
+
+    m_entries.erase(it);
+    return true;
+}
+
+//! Looks up a value.
+/**
+ \param in_key
+   The key.
+ \return
+   The value or nullptr if there isn't one.
+*/
+const MetadataType* MetadataMap::find(StringId in_key) const
+{
+    auto it = this->lowerBound(in_key);
+    return (it != m_entries.end() && it->first == in_key) ? &it->second : nullptr;
+}
+
+//! \copydoc MetadataMap::find(StringId) const
+const MetadataType* MetadataMap::find(std::string_view in_key) const
+{
+    // a key that was never interned can't have a value, and interning it here
+    // would grow the interner on every query.
+    std::optional<StringId> maybeKey = StringInterner::getInstance().find(in_key);
+    return maybeKey ? this->find(*maybeKey) : nullptr;
+}
+
+//! Checks for a value.
+/**
+ \param in_key
+   The key.
+ \return
+   true if there is a value for the key.
+*/
+bool MetadataMap::contains(StringId in_key) const
+{
+    return this->find(in_key) != nullptr;
+}
+
+//! Finds the first entry with a key not less than in_key.
+std::vector<MetadataMap::value_type>::iterator MetadataMap::lowerBound(StringId in_key)
+{
+    return std::ranges::lower_bound(m_entries, in_key, {}, &value_type::first);
+}
+
+//! \copydoc MetadataMap::lowerBound(StringId)
+MetadataMap::const_iterator MetadataMap::lowerBound(StringId in_key) const
+{
+    return std::ranges::lower_bound(m_entries, in_key, {}, &value_type::first);
+}
+
+}  // namespace CapEngine
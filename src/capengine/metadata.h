@@ -0,0 +1,60 @@
+#ifndef CAPENGINE_METADATA_H
+#define CAPENGINE_METADATA_H
+
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "captypes.h"
+#include "stringinterner.h"
+
+namespace CapEngine {
+
+//! Metadata attached to objects and components.
+/**
+   A vector of entries sorted by interned key.  Lookups are a binary search
+   over integer keys and copying is one allocation rather than one per node.
+   Short string values fit in std::string's small string buffer.
+*/
+class MetadataMap {
+   public:
+    using value_type = std::pair<StringId, MetadataType>;
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+    void set(StringId in_key, MetadataType in_value);
+    void set(std::string_view in_key, MetadataType in_value);
+    bool erase(StringId in_key);
+
+    [[nodiscard]] const MetadataType* find(StringId in_key) const;
+    [[nodiscard]] const MetadataType* find(std::string_view in_key) const;
+    [[nodiscard]] bool contains(StringId in_key) const;
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return m_entries.size();
+    }
+    [[nodiscard]] bool empty() const
+    {
+        return m_entries.empty();
+    }
+    [[nodiscard]] const_iterator begin() const
+    {
+        return m_entries.begin();
+    }
+    [[nodiscard]] const_iterator end() const
+    {
+        return m_entries.end();
+    }
+
+    bool operator==(const MetadataMap&) const = default;
+
+   private:
+    [[nodiscard]] std::vector<value_type>::iterator lowerBound(StringId in_key);
+    [[nodiscard]] const_iterator lowerBound(StringId in_key) const;
+
+    std::vector<value_type> m_entries;  //!< Sorted by key.
+};
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_METADATA_H
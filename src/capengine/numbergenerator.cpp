@@ -4,9 +4,34 @@
 
 using namespace CapEngine;
 
-NumberGenerator::NumberGenerator() { srand(time(NULL)); }
+unsigned int NumberGenerator::s_seed = 0;
+bool NumberGenerator::s_seeded = false;
+
+//! Constructor.  Seeds from the time unless seed() has been called.
+NumberGenerator::NumberGenerator()
+{
+  if (!s_seeded) {
+    s_seed = static_cast<unsigned int>(time(NULL));
+    srand(s_seed);
+  }
+}
 
 int NumberGenerator::getRandom(int start, int end)
 {
   return rand() % end + start + 1;
 }
+
+//! Seeds the generator, e.g. so a recorded session can be replayed.
+/**
+ \param seed
+   The seed.  Generators constructed afterwards keep it.
+*/
+void NumberGenerator::seed(unsigned int seed)
+{
+  s_seed = seed;
+  s_seeded = true;
+  srand(seed);
+}
+
+//! Gets the seed the generator was last given.
+unsigned int NumberGenerator::getSeed() { return s_seed; }
@@ -8,6 +8,16 @@ class NumberGenerator
 public:
   NumberGenerator();
   int getRandom(int start, int end);
+
+  static void seed(unsigned int seed);
+  static unsigned int getSeed();
+
+private:
+  //! the seed rand() was last given
+  static unsigned int s_seed;
+  //! whether seed() has been called, in which case constructing a generator
+  //! doesn't reseed
+  static bool s_seeded;
 };
 } // namespace CapEngine
 
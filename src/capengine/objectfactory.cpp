@@ -38,9 +38,46 @@ void ObjectFactory::registerFactoryFunction(
   m_functions[objectType] = inFunction;
 }
 
+//! Registers a prototype that objects of a type are pooled copies of.
+/**
+ Objects made from a prototype are recycled when they die rather than
+ destroyed.  A prototype takes precedence over a factory function registered
+ for the same type.
+ \param objectType
+   The type of object.
+ \param pPrototype
+   The prototype.
+ \param reserve
+   The number of objects to create up front.
+*/
+void ObjectFactory::registerPrototype(const std::string &objectType,
+                                      std::unique_ptr<GameObject> pPrototype,
+                                      std::size_t reserve)
+{
+  m_pools[objectType] =
+      std::make_unique<ObjectPool>(std::move(pPrototype), reserve);
+}
+
+//! Gets the pool for a type registered with registerPrototype.
+/**
+ \param objectType
+   The type of object.
+ \return
+   The pool, or nullptr if the type has no prototype.
+*/
+ObjectPool *ObjectFactory::getPool(const std::string &objectType)
+{
+  auto pool = m_pools.find(objectType);
+  return pool != m_pools.end() ? pool->second.get() : nullptr;
+}
+
 std::shared_ptr<GameObject>
     ObjectFactory::makeObject(const std::string &objectType)
 {
+  if (ObjectPool *pPool = getPool(objectType); pPool != nullptr) {
+    return pPool->acquire();
+  }
+
   auto factoryFunction = getFactoryFunction(objectType);
   assert(factoryFunction != nullptr);
 
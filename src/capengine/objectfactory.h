@@ -2,6 +2,7 @@
 #define OBJECTFACTORY_H
 
 #include "gameobject.h"
+#include "objectpool.h"
 
 #include <functional>
 #include <map>
@@ -19,6 +20,10 @@ public:
   void registerFactoryFunction(
       const std::string &objectType,
       std::function<std::shared_ptr<GameObject>(void)> function);
+  void registerPrototype(const std::string &objectType,
+                         std::unique_ptr<GameObject> pPrototype,
+                         std::size_t reserve = 0);
+  ObjectPool *getPool(const std::string &objectType);
 
 protected:
   ObjectFactory() = default;
@@ -28,6 +33,7 @@ protected:
   static ObjectFactory *m_pObjectFactory;
   std::map<std::string, std::function<std::shared_ptr<GameObject>()>>
       m_functions;
+  std::map<std::string, std::unique_ptr<ObjectPool>> m_pools;
 };
 } // namespace CapEngine
 
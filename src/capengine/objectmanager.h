@@ -1,6 +1,7 @@
 #ifndef CAPENGINE_OBJECTMANAGER_H
 #define CAPENGINE_OBJECTMANAGER_H
 
+#include "functionref.h"
 #include "gameobject.h"
 
 namespace CapEngine
@@ -14,10 +15,16 @@ class ObjectManager
     virtual std::vector<std::shared_ptr<GameObject>> &getObjects() = 0;
     virtual std::vector<std::shared_ptr<GameObject>>
         getObjects(const Rectangle &in_rectangle) = 0;
+    virtual void forEachObject(const Rectangle &in_rectangle,
+                               FunctionRef<void(GameObject &)> in_func) = 0;
+
+    virtual GameObject *getObject(ObjectHandle in_handle) = 0;
+    virtual GameObject *findObject(ObjectID in_objectId) = 0;
+    virtual ObjectHandle getHandle(ObjectID in_objectId) const = 0;
 
     virtual std::vector<CollisionEvent> getCollisions() const = 0;
 
-    virtual void addObject(std::shared_ptr<GameObject> in_pObject) = 0;
+    virtual ObjectHandle addObject(std::shared_ptr<GameObject> in_pObject) = 0;
     virtual void removeDeadObjects() = 0;
 
     static constexpr char kObjectManagerLocatorId[] = "ObjectManager";
@@ -45,6 +52,40 @@ class ObjectManager
    \return The objects in the ObjectManager.
  */
 
+/**
+   \fn ObjectManager::forEachObject(const Rectangle&, FunctionRef<void(GameObject&)>)
+   \brief Calls a function for each object touching a rectangle.
+   Unlike getObjects(const Rectangle&) this does not build a collection.
+   \param in_rectangle
+   \li The rectangle that contains the objects to visit.
+   \param in_func
+   \li The function to call for each object.
+ */
+
+/**
+   \fn ObjectManager::getObject(ObjectHandle)
+   \brief Resolves a handle to an object.
+   \param in_handle
+   \li The handle returned by addObject().
+   \return The object, or nullptr if it has been removed.
+ */
+
+/**
+   \fn ObjectManager::findObject(ObjectID)
+   \brief Looks up an object by id, e.g. to resolve GameObject::getParentObjectID().
+   \param in_objectId
+   \li The id of the object.
+   \return The object, or nullptr if there isn't one.
+ */
+
+/**
+   \fn ObjectManager::getHandle(ObjectID)
+   \brief Gets the handle of an object.
+   \param in_objectId
+   \li The id of the object.
+   \return The handle, or a null handle if there is no such object.
+ */
+
 /**
    \fn ObjectManager::getCollisions()
    \brief Gets the collisions in the ObjectManager.
@@ -56,6 +97,7 @@ class ObjectManager
    \brief Add an object to the object manager.
    \param in_pObject
    \li The object to add.
+   \return A handle that stays valid until the object is removed.
  */
 
 } // namespace CapEngine
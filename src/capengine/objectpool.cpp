@@ -0,0 +1,75 @@
+#include "objectpool.h"
+
+#include "CapEngineException.h"
+
+namespace CapEngine {
+
+//! Constructor.
+/**
+ \param in_pPrototype
+   The object that spawned objects are copies of.
+ \param in_reserve
+   The number of objects to create up front.
+*/
+ObjectPool::ObjectPool(std::unique_ptr<GameObject> in_pPrototype, std::size_t in_reserve)
+    : m_pPrototype(std::move(in_pPrototype))
+{
+    CAP_THROW_NULL(m_pPrototype, "ObjectPool prototype is null");
+
+    m_freeList.reserve(in_reserve);
+    for (std::size_t i = 0; i < in_reserve; i++) {
+        m_freeList.push_back(this->makeInstance());
+    }
+}
+
+//! Spawns an object.
+/**
+ Reuses an object from the free list if there is one.
+ \return
+   An object in the state of the prototype with a new object id.
+*/
+std::shared_ptr<GameObject> ObjectPool::acquire()
+{
+    std::shared_ptr<GameObject> pObject;
+
+    if (m_freeList.empty()) {
+        pObject = this->makeInstance();
+    }
+    else {
+        pObject = std::move(m_freeList.back());
+        m_freeList.pop_back();
+    }
+
+    pObject->setObjectID(GameObject::generateID());
+    return pObject;
+}
+
+//! Returns an object to the pool.
+/**
+ The object is reset to the prototype.  Objects that are still referenced
+ elsewhere, or that belong to another pool, are not recycled.
+ \param in_pObject
+   The object.
+*/
+void ObjectPool::release(std::shared_ptr<GameObject> in_pObject)
+{
+    if (in_pObject == nullptr || in_pObject->getPool() != this || in_pObject.use_count() > 1) {
+        return;
+    }
+
+    in_pObject->resetFrom(*m_pPrototype);
+    m_freeList.push_back(std::move(in_pObject));
+}
+
+//! Makes a new copy of the prototype that belongs to this pool.
+std::shared_ptr<GameObject> ObjectPool::makeInstance()
+{
+    auto pObject = std::make_shared<GameObject>(false);
+    pObject->resetFrom(*m_pPrototype);
+    pObject->setPool(this);
+    m_created++;
+
+    return pObject;
+}
+
+}  // namespace CapEngine
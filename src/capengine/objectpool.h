@@ -0,0 +1,63 @@
+#ifndef CAPENGINE_OBJECTPOOL_H
+#define CAPENGINE_OBJECTPOOL_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "gameobject.h"
+
+namespace CapEngine {
+
+//! Recycles game objects cloned from a prototype.
+/**
+   Objects handed out by acquire() remember their pool.  When they die they are
+   passed back with release(), reset to the prototype and kept on a free list,
+   so spawning again reuses the object, its shared_ptr control block and its
+   components instead of allocating new ones.
+
+   The pool must outlive the objects it hands out.
+*/
+class ObjectPool final {
+   public:
+    explicit ObjectPool(std::unique_ptr<GameObject> in_pPrototype, std::size_t in_reserve = 0);
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    [[nodiscard]] std::shared_ptr<GameObject> acquire();
+    void release(std::shared_ptr<GameObject> in_pObject);
+
+    [[nodiscard]] const GameObject& prototype() const;
+    [[nodiscard]] std::size_t available() const;
+    [[nodiscard]] std::size_t created() const;
+
+   private:
+    [[nodiscard]] std::shared_ptr<GameObject> makeInstance();
+
+    std::unique_ptr<GameObject> m_pPrototype;             //!< The object new instances are copies of.
+    std::vector<std::shared_ptr<GameObject>> m_freeList;  //!< Reset objects ready to be handed out.
+    std::size_t m_created = 0;                            //!< The number of objects the pool has made.
+};
+
+//! Returns the prototype objects are reset to.
+inline const GameObject& ObjectPool::prototype() const
+{
+    return *m_pPrototype;
+}
+
+//! Returns the number of objects on the free list.
+inline std::size_t ObjectPool::available() const
+{
+    return m_freeList.size();
+}
+
+//! Returns the number of objects the pool has made.
+inline std::size_t ObjectPool::created() const
+{
+    return m_created;
+}
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_OBJECTPOOL_H
@@ -51,6 +51,16 @@ PCM::PCM(const string filePath) : position(0)
     BOOST_LOG_SEV(CapEngine::log, boost::log::trivial::debug) << msg.str();
 }
 
+//! Creates a PCM from samples that have already been decoded, e.g. from an asset archive.
+/*!
+  \param filePath The file the samples came from.
+  \param samples The samples, as samples() returns them.
+ */
+PCM::PCM(std::string filePath, std::vector<short> samples)
+    : filePath(std::move(filePath)), buf(std::move(samples)), position(0)
+{
+}
+
 // PCM::PCM(const PCM &old)
 // {
 //     position = old.position;
@@ -176,3 +186,9 @@ Uint8 *PCM::getBuf() { return reinterpret_cast<Uint8 *>(buf.data()); }
 
  */
 void PCM::resetPosition() { position = 0; }
+
+//! Return the decoded samples.
+/*!
+
+ */
+const std::vector<short> &PCM::samples() const { return buf; }
@@ -12,6 +12,7 @@ namespace CapEngine
 class PCM {
    public:
     PCM(const std::string filePath);
+    PCM(std::string filePath, std::vector<short> samples);
 
     ~PCM() = default;
     PCM(const PCM& pcm) = default;
@@ -24,6 +25,7 @@ class PCM {
     Uint32 getLength();
     Uint8* getBuf();
     void resetPosition();
+    const std::vector<short>& samples() const;
 
    private:
     const std::string filePath;
@@ -37,6 +37,12 @@ std::unique_ptr<Component> PlaceHolderGraphics::clone() const
   return std::make_unique<PlaceHolderGraphics>(*this);
 }
 
+//! \copydoc Component::assign
+bool PlaceHolderGraphics::assign(const Component &in_other)
+{
+  return assignComponent(*this, in_other);
+}
+
 //! \copydoc GraphicsComponent::render
 void PlaceHolderGraphics::render(GameObject &in_object,
                                  const Camera2d &in_camera,
@@ -19,6 +19,7 @@ public:
   ~PlaceHolderGraphics() override = default;
 
   std::unique_ptr<Component> clone() const override;
+  bool assign(const Component &in_other) override;
 
   static PlaceHolderGraphics makeComponent(const jsoncons::json &in_json);
   static void registerConstructor(ComponentFactory &in_factory);
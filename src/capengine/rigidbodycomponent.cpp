@@ -19,6 +19,12 @@ std::unique_ptr<Component> RigidBodyComponent::clone() const
   return std::make_unique<RigidBodyComponent>(*this);
 }
 
+//! \copydoc Component::assign
+bool RigidBodyComponent::assign(const Component &in_other)
+{
+  return assignComponent(*this, in_other);
+}
+
 //! \copydoc Component::update
 void RigidBodyComponent::update(GameObject &object, double timestep)
 {
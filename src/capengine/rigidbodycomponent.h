@@ -17,6 +17,7 @@ public:
   ~RigidBodyComponent() override = default;
 
   std::unique_ptr<Component> clone() const override;
+  bool assign(const Component &in_other) override;
 
   static std::unique_ptr<RigidBodyComponent>
       makeComponent(const jsoncons::json &in_json);
@@ -1,13 +1,18 @@
 #include "runner.h"
 
+#include <algorithm>
 #include <boost/log/trivial.hpp>
+#include <numeric>
+#include <random>
 #include <sstream>
 
 #include "CapEngineException.h"
+#include "asset_manager.h"
 #include "filesystem.h"
 #include "game_management.h"
 #include "locator.h"
 #include "logging.h"
+#include "numbergenerator.h"
 #include "widget.h"
 
 namespace CapEngine {
@@ -75,6 +80,34 @@ void Runner::switchState(std::shared_ptr<GameState> pGameState)
     this->pushState(std::move(pGameState));
 }
 
+//! Switch to a state once it has been prepared.
+/**
+ The current states keep running until then, or are paused under the
+ transition state if there is one.  Replaces any switch already pending.
+ \param in_pPendingState
+   The state being prepared, e.g. a Scene2dLoader.
+ \param in_pTransitionState
+   Optional state, e.g. a loading screen, pushed over the current ones until
+   the switch.  The states below it are still rendered.
+*/
+void Runner::switchStateWhenReady(std::shared_ptr<PendingGameState> in_pPendingState,
+                                  std::shared_ptr<GameState> in_pTransitionState)
+{
+    CAP_THROW_NULL(in_pPendingState, "Pending state is null");
+
+    m_pPendingState = std::move(in_pPendingState);
+    if (in_pTransitionState != nullptr) {
+        this->pushState(std::move(in_pTransitionState));
+    }
+}
+
+//! Get the state switchStateWhenReady() is waiting on.
+/**
+ \return
+   The pending state, or null if no switch is pending.
+*/
+std::shared_ptr<PendingGameState> Runner::pendingState() const { return m_pPendingState; }
+
 void Runner::end() { m_quit = true; }
 
 void Runner::loop()
@@ -84,6 +117,22 @@ void Runner::loop()
     int subscriptionMask = mouseEvent | keyboardEvent | systemEvent | windowEvent;
     // Locator::eventDispatcher->subscribe(this, subscriptionMask);
     IEventSubscriber::subscribe(Locator::eventDispatcher, subscriptionMask);
+    if (m_pPlayback != nullptr) {
+        this->replayFrames();
+    }
+    else {
+        this->runFrames();
+    }
+    CapEngine::destroy();
+}
+
+//! Runs frames in real time until the game quits.
+void Runner::runFrames()
+{
+    if (m_pRecorder != nullptr) {
+        Locator::eventDispatcher->setRecorder(m_pRecorder.get());
+    }
+
     double previous = currentTime();
     double lag = 0.0;
     while (!m_quit) {
@@ -98,13 +147,81 @@ void Runner::loop()
             Locator::eventDispatcher->flushQueue();
         }
 
+        uint32_t updates = 0;
         while (lag >= m_msPerUpdate) {
             update();
             lag -= m_msPerUpdate;
+            updates++;
         }
+
+        if (m_pRecorder != nullptr) {
+            m_pRecorder->endFrame(updates);
+        }
+
+        if (Locator::assetManager != nullptr) {
+            Locator::assetManager->processUploads(m_assetUploadBudgetMs);
+        }
+        pollPendingState();
         render(1.0);
     }
-    CapEngine::destroy();
+
+    if (m_pRecorder != nullptr) {
+        Locator::eventDispatcher->setRecorder(nullptr);
+        m_pRecorder->finish();
+        m_pRecorder.reset();
+    }
+}
+
+//! Runs the frames of the recording given to replayInput(), as fast as possible.
+/**
+ Each frame dispatches the input recorded for it and runs as many fixed updates
+ as it did when recorded.  The time each frame takes is kept for
+ replayFrameTimes() and summarised in the log.
+*/
+void Runner::replayFrames()
+{
+    m_replayFrameTimes.clear();
+    m_replayFrameTimes.reserve(m_pPlayback->frameCount());
+
+    while (!m_quit && m_pPlayback->nextFrame()) {
+        const double start = currentTime();
+
+        // recorded input replaces real input, but events the game pushes itself still arrive.
+        SDL_PumpEvents();
+        SDL_FlushEvents(SDL_FIRSTEVENT, SDL_USEREVENT - 1);
+        Locator::eventDispatcher->getEvents();
+        for (const SDL_Event& event : m_pPlayback->events()) {
+            Locator::eventDispatcher->enqueue(event);
+        }
+        if (Locator::eventDispatcher->hasEvents()) {
+            Locator::eventDispatcher->flushQueue();
+        }
+
+        for (uint32_t i = 0; i < m_pPlayback->updates(); i++) {
+            update();
+        }
+
+        if (Locator::assetManager != nullptr) {
+            Locator::assetManager->processUploads(m_assetUploadBudgetMs);
+        }
+        pollPendingState();
+        if (!m_replayHeadless) {
+            render(1.0);
+        }
+
+        m_replayFrameTimes.push_back(currentTime() - start);
+    }
+    m_pPlayback.reset();
+
+    if (!m_replayFrameTimes.empty()) {
+        std::vector<double> sorted = m_replayFrameTimes;
+        std::sort(sorted.begin(), sorted.end());
+        const double total = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+        BOOST_LOG_SEV(CapEngine::log, boost::log::trivial::info)
+            << "Replayed " << sorted.size() << " frames in " << total << "ms, mean "
+            << total / static_cast<double>(sorted.size()) << "ms, 99th percentile "
+            << sorted[(sorted.size() - 1) * 99 / 100] << "ms, max " << sorted.back() << "ms";
+    }
 }
 
 void Runner::exit() { m_quit = true; }
@@ -125,6 +242,20 @@ void Runner::update()
     }
 }
 
+//! Switch to the pending state if it is ready.
+void Runner::pollPendingState()
+{
+    if (m_pPendingState == nullptr) {
+        return;
+    }
+
+    std::shared_ptr<GameState> pReadyState = m_pPendingState->poll();
+    if (pReadyState != nullptr) {
+        m_pPendingState.reset();
+        this->switchState(std::move(pReadyState));
+    }
+}
+
 void Runner::render(double /*frameFactor*/)
 {
     Locator::videoManager->clearAll();
@@ -215,4 +346,57 @@ void Runner::receiveEvent(const SDL_Event event, CapEngine::Time* /*time*/)
 */
 void Runner::setDefaultQuitEvents(bool enabled) { m_defaultQuitEventsEnabled = enabled; }
 
+//! Sets how long each frame may spend creating textures for preloaded images.
+/**
+ \param in_budgetMs
+   The budget in milliseconds.  See AssetManager::processUploads().
+*/
+void Runner::setAssetUploadBudget(double in_budgetMs) { m_assetUploadBudgetMs = in_budgetMs; }
+
+//! Records the session's input so it can be replayed with replayInput().
+/**
+ Reseeds NumberGenerator with a new seed, which is kept in the recording, so
+ call it before creating any state that draws random numbers.  Recording stops
+ when loop() returns.
+ \param in_path
+   The file to write.
+*/
+void Runner::recordInput(const std::filesystem::path& in_path)
+{
+    CAP_THROW_ASSERT(m_pPlayback == nullptr, "Can't record input while replaying it");
+
+    const uint32_t seed = std::random_device{}();
+    NumberGenerator::seed(seed);
+    m_pRecorder = std::make_unique<InputRecorder>(in_path, seed, m_msPerUpdate);
+}
+
+//! Makes loop() replay a recording instead of running in real time.
+/**
+ Restores the recorded NumberGenerator seed and update step, so call it before
+ creating any state that draws random numbers.  The replay only matches the
+ recorded session if the game depends on nothing but its input, its updates and
+ NumberGenerator, e.g. not on the wall clock or on when background loads finish.
+ loop() returns at the end of the recording.
+ \param in_path
+   A file written by recordInput().
+ \param in_headless
+   true to skip rendering.
+*/
+void Runner::replayInput(const std::filesystem::path& in_path, bool in_headless)
+{
+    CAP_THROW_ASSERT(m_pRecorder == nullptr, "Can't replay input while recording it");
+
+    m_pPlayback = std::make_unique<InputPlayback>(in_path);
+    NumberGenerator::seed(m_pPlayback->seed());
+    m_msPerUpdate = m_pPlayback->msPerUpdate();
+    m_replayHeadless = in_headless;
+}
+
+//! Gets how long each frame of the last replay took.
+/**
+ \return
+   The frame times in ms, e.g. for comparing builds.
+*/
+const std::vector<double>& Runner::replayFrameTimes() const { return m_replayFrameTimes; }
+
 }  // namespace CapEngine
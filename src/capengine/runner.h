@@ -4,9 +4,11 @@
 #include "IEventSubscriber.h"
 #include "control.h"
 #include "gamestate.h"
+#include "inputrecording.h"
 #include "timestep.h"
 
 #include <SDL2/SDL.h>
+#include <filesystem>
 #include <memory>
 #include <vector>
 
@@ -25,6 +27,9 @@ class Runner : public IEventSubscriber
     void switchState(std::shared_ptr<GameState> pGameState);
     void popState(bool resumePrevious = true);
     void pushState(std::shared_ptr<GameState> pGameState);
+    void switchStateWhenReady(std::shared_ptr<PendingGameState> in_pPendingState,
+                              std::shared_ptr<GameState> in_pTransitionState = nullptr);
+    [[nodiscard]] std::shared_ptr<PendingGameState> pendingState() const;
     std::shared_ptr<GameState> peekState();
     void receiveEvent(const SDL_Event event,
                       CapEngine::Time *time) override; // IEventSubscriber
@@ -32,6 +37,11 @@ class Runner : public IEventSubscriber
     void end();
 
     void setDefaultQuitEvents(bool enabled = true);
+    void setAssetUploadBudget(double in_budgetMs);
+
+    void recordInput(const std::filesystem::path &in_path);
+    void replayInput(const std::filesystem::path &in_path, bool in_headless = false);
+    [[nodiscard]] const std::vector<double> &replayFrameTimes() const;
 
   protected:
     Runner();
@@ -40,6 +50,9 @@ class Runner : public IEventSubscriber
     void exit();
     void render(double frameFactor);
     void update();
+    void pollPendingState();
+    void runFrames();
+    void replayFrames();
 
     static Runner *s_pRunner;
     std::vector<std::shared_ptr<GameState>> m_gameStates;
@@ -51,6 +64,18 @@ class Runner : public IEventSubscriber
     double m_msPerUpdate; // 16.67 = 60fps, 33.33 = 30fps
     //! flag indicating if exiting on window close/q keypress is enabled.
     bool m_defaultQuitEventsEnabled = true;
+    //! ms per frame spent creating textures for images decoded in the background.
+    double m_assetUploadBudgetMs = 4.0;
+    //! state to switch to once it is ready, polled once per frame.
+    std::shared_ptr<PendingGameState> m_pPendingState;
+    //! writes the session's input, if recordInput() was called.
+    std::unique_ptr<InputRecorder> m_pRecorder;
+    //! the recording loop() replays, if replayInput() was called.
+    std::unique_ptr<InputPlayback> m_pPlayback;
+    //! whether replayed frames skip rendering.
+    bool m_replayHeadless = false;
+    //! ms each replayed frame took.
+    std::vector<double> m_replayFrameTimes;
 };
 
 } // namespace CapEngine
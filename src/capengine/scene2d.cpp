@@ -1,5 +1,6 @@
 #include "scene2d.h"
 #include "CapEngineException.h"
+#include "componentfactory.h"
 #include "logger.h"
 #include "objectmanager.h"
 #include "simpleobjectmanager.h"
@@ -16,6 +17,50 @@ namespace CapEngine
 namespace
 {
 
+//! Gets the contact of a box stopped by a sweep against another box.
+/**
+ The boxes only touch, so unlike detectBoxCollisionWithContactManifold the
+ side comes from the sweep rather than from the overlap.
+ \param a
+   The box that was swept, where it stopped.
+ \param b
+   The box it stopped against.
+ \param in_collision
+   The side of a that was hit, from the sweep.
+ \return
+   The manifold from a's point of view.
+*/
+ContactManifold touchingManifold(const Rectangle &a, const Rectangle &b,
+                                 const BoxCollision &in_collision)
+{
+    ContactManifold manifold;
+    manifold.collisionType = in_collision.collisionType;
+    manifold.collisionNormal = in_collision.collisionNormal;
+    manifold.penetration = 0.0;
+
+    if (manifold.collisionType == COLLISION_LEFT ||
+        manifold.collisionType == COLLISION_RIGHT) {
+        const double face = manifold.collisionType == COLLISION_RIGHT
+                                ? a.x + a.width
+                                : a.x;
+        const double minY = std::max(a.y, b.y);
+        const double maxY = std::max(minY, std::min(a.y + a.height, b.y + b.height));
+        manifold.points = {Point{face, minY}, Point{face, maxY}};
+        manifold.pointCount = minY < maxY ? 2 : 1;
+    }
+    else {
+        const double face = manifold.collisionType == COLLISION_TOP
+                                ? a.y + a.height
+                                : a.y;
+        const double minX = std::max(a.x, b.x);
+        const double maxX = std::max(minX, std::min(a.x + a.width, b.x + b.width));
+        manifold.points = {Point{minX, face}, Point{maxX, face}};
+        manifold.pointCount = minX < maxX ? 2 : 1;
+    }
+
+    return manifold;
+}
+
 //! updates the camera size based on the window size
 /**
  \param in_windowId
@@ -36,6 +81,18 @@ void updateCameraSize(uint32_t in_windowId, Camera2d &io_camera)
     io_camera.setWidth(width);
     io_camera.setHeight(height);
 }
+
+//! Checks a query layer read from a scene.
+/**
+ \param in_queryLayer
+   The query layer.
+ \return
+   true if it can select a bit of a QueryFilter::layerMask.
+*/
+bool isValidQueryLayer(int in_queryLayer)
+{
+    return in_queryLayer >= 0 && in_queryLayer < 32;
+}
 } // namespace
 
 //! Constructor
@@ -45,11 +102,38 @@ void updateCameraSize(uint32_t in_windowId, Camera2d &io_camera)
 */
 Scene2d::Scene2d(const jsoncons::json &in_json)
     : m_camera(0, 0), m_pObjectManager(std::make_shared<SimpleObjectManager>()),
+      m_pMessageBus(std::make_shared<MessageBus>()),
+      m_pSceneQuery(std::make_shared<SceneQuery>(m_pObjectManager)),
       m_endSceneCB(std::nullopt)
 {
     this->load(in_json);
-    Locator::insertOrReplace(ObjectManager::kObjectManagerLocatorId,
-                             m_pObjectManager);
+    this->registerServices();
+}
+
+//! Constructor
+/**
+ \param in_scenes
+   The cooked scene file.  It can be destroyed once the scene is constructed.
+ \param in_scene
+   The scene to load, from in_scenes.
+*/
+Scene2d::Scene2d(const CookedScenes &in_scenes,
+                 const CookedSceneRecord &in_scene)
+    : m_camera(0, 0), m_pObjectManager(std::make_shared<SimpleObjectManager>()),
+      m_pMessageBus(std::make_shared<MessageBus>()),
+      m_pSceneQuery(std::make_shared<SceneQuery>(m_pObjectManager)),
+      m_endSceneCB(std::nullopt)
+{
+    this->load(in_scenes, in_scene);
+    this->registerServices();
+}
+
+//! Destructor.
+Scene2d::~Scene2d()
+{
+    // the query may outlive the scene through the Locator, but the layers
+    // don't
+    m_pSceneQuery->setLayers({});
 }
 
 //! load the scene from json.
@@ -71,18 +155,23 @@ void Scene2d::load(const jsoncons::json &in_json)
         for (auto &&layer : in_json[kLayers].array_range()) {
             std::unique_ptr<Layer> pLayer = layerFactory.makeLayer(layer);
             const int layerOrder = layer[kLayerOrder].as<int>();
+            if (layer.contains(kQueryLayer)) {
+                const int queryLayer = layer[kQueryLayer].as<int>();
+                if (!isValidQueryLayer(queryLayer)) {
+                    throw SceneLoadException(
+                        in_json, "Query layer must be from 0 to 31");
+                }
+                pLayer->setQueryLayer(queryLayer);
+            }
 
             m_layers.emplace(layerOrder, std::move(pLayer));
         }
+        this->setQueryLayers();
 
         // get the objects
         for (auto &&objectJson : in_json[std::string(kObjects)].array_range()) {
             try {
-                GameObject object = makeObject(objectJson);
-                auto pHeapObject = std::make_unique<GameObject>(object);
-
-                CAP_THROW_NULL(m_pObjectManager, "ObjectManager is null");
-                m_pObjectManager->addObject(std::move(pHeapObject));
+                this->addObject(makeObject(objectJson));
             } catch (const ObjectCreationError &e) {
                 // log and move on
                 CapEngine::logException(e);
@@ -95,6 +184,131 @@ void Scene2d::load(const jsoncons::json &in_json)
     }
 }
 
+//! load the scene from a cooked scene file.
+/**
+ \param in_scenes
+   The cooked scene file.
+ \param in_scene
+   The scene to load, from in_scenes.
+*/
+void Scene2d::load(const CookedScenes &in_scenes,
+                   const CookedSceneRecord &in_scene)
+{
+    const std::string sceneId{in_scenes.string(in_scene.idOffset)};
+
+    try {
+        m_sceneSize.width = in_scene.width;
+        m_sceneSize.height = in_scene.height;
+
+        // look each type up once rather than once per layer or component
+        LayerFactory &layerFactory = LayerFactory::getInstance();
+        ComponentFactory &componentFactory = ComponentFactory::getInstance();
+        const auto types = in_scenes.types();
+        std::vector<std::optional<std::size_t>> typeIds;
+        typeIds.reserve(types.size());
+        for (auto &&type : types) {
+            const std::string typeName{in_scenes.string(type.typeOffset)};
+            if (type.kind == CookedTypeKind::Layer) {
+                typeIds.push_back(layerFactory.findLayerType(typeName));
+            } else {
+                typeIds.push_back(componentFactory.findComponentType(
+                    typeName, std::string(in_scenes.string(type.subtypeOffset))));
+            }
+        }
+
+        // get the layers
+        for (auto &&layer : in_scenes.layers(in_scene)) {
+            const jsoncons::json layerJson = in_scenes.decode(layer.json);
+            if (!typeIds[layer.typeIndex]) {
+                throw LayerCreationException(
+                    std::string(
+                        in_scenes.string(types[layer.typeIndex].typeOffset)),
+                    layerJson,
+                    "No factory method registered for layer type");
+            }
+
+            std::unique_ptr<Layer> pLayer =
+                layerFactory.makeLayer(*typeIds[layer.typeIndex], layerJson);
+            if (layer.hasQueryLayer != 0) {
+                if (!isValidQueryLayer(layer.queryLayer)) {
+                    throw SceneLoadException(sceneId, in_scenes.path(),
+                                             "Query layer must be from 0 to 31");
+                }
+                pLayer->setQueryLayer(layer.queryLayer);
+            }
+
+            m_layers.emplace(layer.order, std::move(pLayer));
+        }
+        this->setQueryLayers();
+
+        // get the objects
+        for (auto &&object : in_scenes.objects(in_scene)) {
+            try {
+                GameObject gameObject =
+                    makeBareObject(in_scenes.decode(object.json));
+                for (auto &&component : in_scenes.components(object)) {
+                    const jsoncons::json componentJson =
+                        in_scenes.decode(component.json);
+                    const CookedSceneType &type = types[component.typeIndex];
+                    if (!typeIds[component.typeIndex]) {
+                        throw ComponentCreationException(
+                            std::string(in_scenes.string(type.typeOffset)),
+                            std::string(in_scenes.string(type.subtypeOffset)),
+                            componentJson,
+                            "No factory method registered for component "
+                            "type");
+                    }
+
+                    gameObject.addComponent(componentFactory.makeComponent(
+                        *typeIds[component.typeIndex], componentJson));
+                }
+
+                this->addObject(std::move(gameObject));
+            } catch (const ObjectCreationError &e) {
+                // log and move on
+                CapEngine::logException(e);
+            }
+        }
+    }
+
+    catch (const jsoncons::ser_error &e) {
+        throw SceneLoadException(sceneId, in_scenes.path(), e.what());
+    }
+}
+
+//! Makes the scene's services available through the Locator.
+void Scene2d::registerServices()
+{
+    Locator::insertOrReplace(ObjectManager::kObjectManagerLocatorId,
+                             m_pObjectManager);
+    Locator::insertOrReplace(MessageBus::kMessageBusLocatorId, m_pMessageBus);
+    Locator::insertOrReplace(SceneQuery::kSceneQueryLocatorId, m_pSceneQuery);
+}
+
+//! Gives the scene query the layers it can hit.
+void Scene2d::setQueryLayers()
+{
+    std::vector<const Layer *> collidableLayers;
+    for (auto &&layer : m_layers) {
+        if (layer.second->canCollide()) {
+            collidableLayers.push_back(layer.second.get());
+        }
+    }
+    m_pSceneQuery->setLayers(std::move(collidableLayers));
+}
+
+//! Adds a loaded object to the scene.
+/**
+ \param in_object
+   The object.
+*/
+void Scene2d::addObject(GameObject in_object)
+{
+    CAP_THROW_NULL(m_pObjectManager, "ObjectManager is null");
+    m_pObjectManager->addObject(
+        std::make_unique<GameObject>(std::move(in_object)));
+}
+
 //! update function for the scene.
 /**
  \param in_ms
@@ -102,8 +316,12 @@ void Scene2d::load(const jsoncons::json &in_json)
 */
 void Scene2d::update(double in_ms)
 {
+    // nothing from the previous frame is still using the arena
+    m_frameArena.reset();
+
     // remove dead objects
     m_pObjectManager->removeDeadObjects();
+    m_contacts.beginFrame();
 
     // update layers
     for (auto &&i : m_layers) {
@@ -114,14 +332,27 @@ void Scene2d::update(double in_ms)
     // update objects
     CAP_THROW_NULL(m_pObjectManager, "ObjectManager is null");
 
+    Layer::CollisionBuffer_t layerCollisions{&m_frameArena};
+
     auto &objects = m_pObjectManager->getObjects();
     for (size_t i = 0; i < objects.size(); i++) {
 
         CAP_THROW_NULL(objects[i], "Object in objectmanager is null");
-        auto pUpdateObject = objects[i]->update(in_ms);
-        if (!pUpdateObject) {
-            BOOST_LOG_SEV(CapEngine::log, boost::log::trivial::warning) << "GameObject::update returned nullptr";
-            continue;
+
+        // update a copy of the object so that collisions below are checked
+        // against the other objects' committed state.  Assigning into the
+        // scratch object reuses its storage instead of allocating a new object.
+        m_scratchObject = *objects[i];
+        const bool sweep = m_scratchObject.hasContinuousCollision();
+        const Rectangle before =
+            sweep ? m_scratchObject.boundingPolygon() : Rectangle{};
+        m_scratchObject.updateInPlace(in_ms);
+
+        // stop fast objects where they first touch another object so that
+        // the checks below see the collision instead of tunnelling through
+        std::optional<SweptContact> sweptContact;
+        if (sweep) {
+            sweptContact = this->sweepScratchObject(i, before, in_ms);
         }
 
         // collision with layers
@@ -129,13 +360,13 @@ void Scene2d::update(double in_ms)
 
             // is layer collidable
             if (layer.second->canCollide()) {
-                const auto maybeCollisions =
-                    layer.second->checkCollisions(*pUpdateObject);
+                layer.second->checkCollisions(m_scratchObject,
+                                              layerCollisions);
 
                 // is there a collision
-                if (maybeCollisions.size() > 0) {
+                if (layerCollisions.size() > 0) {
                     const auto succeeded =
-                        layer.second->resolveCollisions(*pUpdateObject);
+                        layer.second->resolveCollisions(m_scratchObject);
 
                     if (!succeeded){
                         BOOST_LOG_SEV(CapEngine::log, boost::log::trivial::warning) << "Collisions could not be resolved";
@@ -144,29 +375,149 @@ void Scene2d::update(double in_ms)
             }
         }
 
+        const Rectangle scratchBox = m_scratchObject.boundingPolygon();
         for (size_t j = i + 1; j < objects.size(); j++) {
-            auto pOtherObject = objects[j];
+            auto &pOtherObject = objects[j];
             CAP_THROW_NULL(objects[j], "Object in objectmanager is null");
 
-            CollisionType collisionType =
-                detectMBRCollision(pUpdateObject->boundingPolygon(),
-                                   pOtherObject->boundingPolygon());
+            auto manifold = detectBoxCollisionWithContactManifold(
+                scratchBox, pOtherObject->boundingPolygon());
 
-            if (collisionType != CollisionType::COLLISION_NONE) {
-                std::cout << "Object collision detected" << std::endl;
+            // a sweep leaves the boxes touching without overlapping
+            if (!manifold && sweptContact && sweptContact->index == j) {
+                manifold = sweptContact->manifold;
+            }
 
-                pUpdateObject->handleCollision(
-                    collisionType, CollisionClass::COLLISION_UNKNOWN,
-                    pOtherObject.get(), {});
-                pOtherObject->handleCollision(collisionType,
-                                              CollisionClass::COLLISION_UNKNOWN,
-                                              pUpdateObject.get(), {});
+            if (manifold) {
+                this->touchScratchObject(*pOtherObject, *manifold);
+            }
+        }
+
+        // objects before this one were checked against where it was, so
+        // the contact it was stopped at hasn't been seen yet
+        if (sweptContact && sweptContact->index < i) {
+            GameObject &other = *objects[sweptContact->index];
+            if (!m_contacts.touchedThisFrame(m_scratchObject.getObjectID(),
+                                             other.getObjectID())) {
+                this->touchScratchObject(other, sweptContact->manifold);
             }
         }
 
         // keep updated object
-        objects[i] = std::move(pUpdateObject);
+        objects[i]->swap(m_scratchObject);
     }
+
+    // tell objects about contacts that ended, including with removed objects
+    m_contacts.endFrame([&](const Contact &in_contact) {
+        GameObject *pObject1 = m_pObjectManager->findObject(in_contact.object1);
+        GameObject *pObject2 = m_pObjectManager->findObject(in_contact.object2);
+        if (pObject1 != nullptr) {
+            pObject1->handleContact(ContactPhase::Exit, pObject2,
+                                    in_contact.manifold);
+        }
+        if (pObject2 != nullptr) {
+            pObject2->handleContact(ContactPhase::Exit, pObject1,
+                                    reversed(in_contact.manifold));
+        }
+    });
+
+    // deliver messages sent during the update
+    CAP_THROW_NULL(m_pMessageBus, "MessageBus is null");
+    m_pMessageBus->dispatch(*m_pObjectManager);
+}
+
+//! Moves the scratch object back to where it first hits another object.
+/**
+ \param in_index
+   The index of the object the scratch object is a copy of.
+ \param in_before
+   The bounding box of the object before it was updated.
+ \param in_ms
+   The timestep.
+ \return
+   The object it was stopped against, if any.
+*/
+std::optional<Scene2d::SweptContact>
+    Scene2d::sweepScratchObject(std::size_t in_index,
+                                const Rectangle &in_before, double in_ms)
+{
+    if (in_ms <= 0.0) {
+        return std::nullopt;
+    }
+
+    const Rectangle after = m_scratchObject.boundingPolygon();
+    const double dx = after.x - in_before.x;
+    const double dy = after.y - in_before.y;
+    if (dx == 0.0 && dy == 0.0) {
+        return std::nullopt;
+    }
+
+    // sweep with the distance actually moved, whatever the components did
+    const Vector velocity{dx * (1000.0 / in_ms), dy * (1000.0 / in_ms)};
+
+    std::optional<SweptBoxCollision> closest;
+    std::size_t closestIndex = 0;
+    auto &objects = m_pObjectManager->getObjects();
+    for (size_t j = 0; j < objects.size(); j++) {
+        if (j == in_index) {
+            continue;
+        }
+
+        const auto maybeCollision = detectSweptBoxCollision(
+            in_before, velocity, in_ms, objects[j]->boundingPolygon());
+        if (maybeCollision &&
+            (!closest || maybeCollision->timeOfImpact < closest->timeOfImpact)) {
+            closest = maybeCollision;
+            closestIndex = j;
+        }
+    }
+
+    if (!closest) {
+        return std::nullopt;
+    }
+
+    if (closest->timeOfImpact < 1.0) {
+        Vector position = m_scratchObject.getPosition();
+        position.setX(position.getX() - dx * (1.0 - closest->timeOfImpact));
+        position.setY(position.getY() - dy * (1.0 - closest->timeOfImpact));
+        m_scratchObject.setPosition(position);
+    }
+
+    return SweptContact{
+        closestIndex,
+        touchingManifold(m_scratchObject.boundingPolygon(),
+                         objects[closestIndex]->boundingPolygon(),
+                         closest->collision)};
+}
+
+//! Records a contact between the scratch object and another object.
+/**
+ Handlers only hear about a collision when the contact starts.
+ \param io_other
+   The other object.
+ \param in_manifold
+   The contact from the scratch object's point of view.
+*/
+void Scene2d::touchScratchObject(GameObject &io_other,
+                                 const ContactManifold &in_manifold)
+{
+    const ContactPhase phase = m_contacts.touch(
+        m_scratchObject.getObjectID(), io_other.getObjectID(), in_manifold);
+    const ContactManifold otherManifold = reversed(in_manifold);
+
+    if (phase == ContactPhase::Enter) {
+        const Vector location{in_manifold.points[0].x,
+                              in_manifold.points[0].y};
+        m_scratchObject.handleCollision(in_manifold.collisionType,
+                                        CollisionClass::COLLISION_UNKNOWN,
+                                        &io_other, location);
+        io_other.handleCollision(otherManifold.collisionType,
+                                 CollisionClass::COLLISION_UNKNOWN,
+                                 &m_scratchObject, location);
+    }
+
+    m_scratchObject.handleContact(phase, &io_other, in_manifold);
+    io_other.handleContact(phase, &m_scratchObject, otherManifold);
 }
 
 //! render function for the scene.
@@ -186,11 +537,9 @@ void Scene2d::render(uint32_t in_windowId)
 
     CAP_THROW_NULL(m_pObjectManager, "ObjectManager is null");
     // render objects
-    for (auto &&pObject :
-         m_pObjectManager->getObjects(m_camera.getViewingRectangle())) {
-        assert(pObject != nullptr);
-        pObject->render(m_camera, in_windowId);
-    }
+    m_pObjectManager->forEachObject(
+        m_camera.getViewingRectangle(),
+        [&](GameObject &io_object) { io_object.render(m_camera, in_windowId); });
 }
 
 void Scene2d::setEndSceneCB(std::function<void()> in_endSceneCB)
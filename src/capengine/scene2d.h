@@ -4,12 +4,17 @@
 #include "CapEngineException.h"
 #include "camera2d.h"
 #include "collision.h"
+#include "contactcache.h"
+#include "cookedscenes.h"
+#include "framearena.h"
 #include "gameobject.h"
 #include "gameobjectutils.h"
 #include "layer.h"
 #include "layerfactory.h"
 #include "locator.h"
+#include "messagebus.h"
 #include "scene2dschema.h"
+#include "scenequery.h"
 #include "simpleobjectmanager.h"
 #include "vector.h"
 
@@ -23,17 +28,35 @@ namespace CapEngine
 
 //! Exception class for scene that does not exist.
 struct SceneLoadException : public CapEngineException {
-    explicit SceneLoadException(const jsoncons::json in_json,
+    //! The most json the message includes, since scenes can be large.
+    static constexpr std::size_t kMaxJsonLength = 1024;
+
+    explicit SceneLoadException(const jsoncons::json &in_json,
                                 const std::string &in_details)
         : CapEngineException([&]() {
+              std::string json = in_json.to_string();
+              if (json.size() > kMaxJsonLength) {
+                  json.resize(kMaxJsonLength);
+                  json += "...";
+              }
+
               std::stringstream msg;
               msg << "The scene could not be loaded.  Details:" << std::endl
                   << in_details << std::endl
-                  << jsoncons::pretty_print(in_json);
+                  << json;
               return msg.str();
           }())
     {
     }
+
+    SceneLoadException(const std::string &in_sceneId,
+                       const std::filesystem::path &in_path,
+                       const std::string &in_details)
+        : CapEngineException("The cooked scene \"" + in_sceneId +
+                             "\" in " + in_path.string() +
+                             " could not be loaded.  Details:\n" + in_details)
+    {
+    }
 };
 
 //! class for representing a game scene.
@@ -41,17 +64,41 @@ class Scene2d final
 {
   public:
     explicit Scene2d(const jsoncons::json &in_json);
+    Scene2d(const CookedScenes &in_scenes, const CookedSceneRecord &in_scene);
+    ~Scene2d();
 
     void update(double in_ms);
     void render(uint32_t in_windowId);
     void setEndSceneCB(std::function<void()> in_endSceneCB);
 
+    [[nodiscard]] const SceneQuery &query() const;
+    [[nodiscard]] ContactCache &contacts();
+
   private:
     void load(const jsoncons::json &in_json);
+    void load(const CookedScenes &in_scenes, const CookedSceneRecord &in_scene);
+    void registerServices();
+    void setQueryLayers();
+    void addObject(GameObject in_object);
+    //! The object a swept object was stopped against.
+    struct SweptContact {
+        std::size_t index;        //!< The index of the other object.
+        ContactManifold manifold; //!< The contact from the swept object.
+    };
+
+    std::optional<SweptContact> sweepScratchObject(std::size_t in_index,
+                                                   const Rectangle &in_before,
+                                                   double in_ms);
+    void touchScratchObject(GameObject &io_other,
+                            const ContactManifold &in_manifold);
 
     std::shared_ptr<ObjectManager>
         m_pObjectManager; //<! Holds the objects and performs collision
                           // checking.
+    std::shared_ptr<MessageBus>
+        m_pMessageBus; //<! Messages between objects, delivered after update.
+    std::shared_ptr<SceneQuery>
+        m_pSceneQuery; //<! Raycasts and shape casts against the scene.
     std::multimap<int, std::unique_ptr<Layer>>
         m_layers; //<! Map of layers ordered by their drawing order.  0 = front.
     std::string m_sceneID; //<! The id of the scene.
@@ -59,8 +106,19 @@ class Scene2d final
     Camera2d m_camera;     //<! The camera.
     //! optional callback for when scene ends
     std::optional<std::function<void()>> m_endSceneCB;
+    FrameArena m_frameArena; //<! Storage for temporaries that live for one
+                             // update or render.
+    GameObject m_scratchObject{false}; //<! Reused as the copy each object is
+                                       // updated into before being committed.
+    ContactCache m_contacts; //<! The pairs of objects that are touching.
 };
 
+//! Gets the raycasts and shape casts against the scene.
+inline const SceneQuery &Scene2d::query() const { return *m_pSceneQuery; }
+
+//! Gets the pairs of objects that are touching, with their manifolds.
+inline ContactCache &Scene2d::contacts() { return m_contacts; }
+
 } // namespace CapEngine
 
 #endif // CAPENGINE_SCENE2D
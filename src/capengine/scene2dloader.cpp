@@ -0,0 +1,177 @@
+#include "scene2dloader.h"
+
+#include <chrono>
+#include <fstream>
+
+#include "CapEngineException.h"
+#include "locator.h"
+#include "scene2dschema.h"
+#include "scene2dstate.h"
+
+namespace CapEngine {
+
+//! Starts parsing the scene file.
+/**
+ \param in_path
+   A json scene descriptor file, or a file cooked by scenecooker if it has
+   CookedScenes::kExtension.
+ \param in_sceneId
+   The id of the scene to load.
+ \param in_windowId
+   The id of the window the scene renders to.
+*/
+Scene2dLoader::Scene2dLoader(std::filesystem::path in_path, std::string in_sceneId, uint32_t in_windowId)
+    : m_sceneId(std::move(in_sceneId)), m_windowId(in_windowId)
+{
+    m_parsing = std::async(std::launch::async, [path = std::move(in_path), sceneId = m_sceneId]() {
+        return parse(path, sceneId);
+    });
+}
+
+//! Destructor.  Releases the preloaded assets if the state was never built.
+Scene2dLoader::~Scene2dLoader()
+{
+    if (m_preloaded && Locator::assetManager != nullptr) {
+        Locator::assetManager->release(m_parsed->hints);
+    }
+}
+
+//! Advances the load.
+/**
+ Rethrows anything the worker threw, e.g. SceneDoesNotExistException.
+ \return
+   The state once the file is parsed and the preloaded assets are resident.
+*/
+std::shared_ptr<GameState> Scene2dLoader::poll()
+{
+    if (m_finished) {
+        return nullptr;
+    }
+
+    if (!m_parsed) {
+        if (m_parsing.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return nullptr;
+        }
+
+        m_parsed = m_parsing.get();
+        if (Locator::assetManager != nullptr) {
+            Locator::assetManager->preload(m_parsed->hints);
+            m_preloaded = true;
+        }
+    }
+
+    if (m_preloaded && this->finishedCount() < m_parsed->hints.size()) {
+        return nullptr;
+    }
+
+    // the state retains the hints itself, so ours can go once it exists.
+    std::shared_ptr<GameState> pState;
+    if (m_parsed->pCooked != nullptr) {
+        pState = std::make_shared<Scene2dState>(*m_parsed->pCooked, m_sceneId, m_windowId);
+    }
+    else {
+        pState = std::make_shared<Scene2dState>(std::move(m_parsed->descriptors), m_sceneId, m_windowId);
+    }
+
+    if (m_preloaded) {
+        Locator::assetManager->release(m_parsed->hints);
+        m_preloaded = false;
+    }
+    m_parsed.reset();
+    m_finished = true;
+
+    return pState;
+}
+
+//! How far the load has got.
+/**
+ Parsing counts as one step and each preloaded asset as another.
+ \return
+   From 0 to 1.
+*/
+double Scene2dLoader::progress() const
+{
+    if (m_finished) {
+        return 1.0;
+    }
+    if (!m_parsed) {
+        return 0.0;
+    }
+
+    const std::size_t steps = 1 + m_parsed->hints.size();
+    const std::size_t done = 1 + (m_preloaded ? this->finishedCount() : m_parsed->hints.size());
+    return static_cast<double>(done) / static_cast<double>(steps);
+}
+
+//! Reads the scene file.  Runs on the worker.
+/**
+ \param in_path
+   The scene file.
+ \param in_sceneId
+   The scene to find in it.
+ \return
+   The parsed file and the scene's preload hints.
+*/
+Scene2dLoader::ParsedScene Scene2dLoader::parse(const std::filesystem::path& in_path, const std::string& in_sceneId)
+{
+    using namespace Schema::Scene2d;
+
+    ParsedScene parsed;
+    if (in_path.extension() == CookedScenes::kExtension) {
+        parsed.pCooked = std::make_unique<CookedScenes>(in_path);
+        const CookedSceneRecord* pScene = parsed.pCooked->findScene(in_sceneId);
+        if (pScene == nullptr) {
+            CAP_THROW(SceneDoesNotExistException(in_sceneId));
+        }
+        if (pScene->preload.size != 0) {
+            parsed.hints = readPreloadHints(parsed.pCooked->decode(pScene->preload));
+        }
+
+        return parsed;
+    }
+
+    std::ifstream stream{in_path};
+    if (!stream) {
+        CAP_THROW(CapEngineException("Unable to open scene file " + in_path.string()));
+    }
+    parsed.descriptors = jsoncons::json::parse(stream);
+
+    bool found = false;
+    for (auto&& scene : parsed.descriptors[kScenes].array_range()) {
+        if (scene[kSceneId].as<std::string>() == in_sceneId) {
+            found = true;
+            if (scene.contains(kPreload)) {
+                parsed.hints = readPreloadHints(scene[kPreload]);
+            }
+        }
+    }
+    if (!found) {
+        CAP_THROW(SceneDoesNotExistException(in_sceneId));
+    }
+
+    return parsed;
+}
+
+//! Counts the preloaded assets that are no longer loading.
+/**
+ Assets that failed to load count as finished, so the scene still loads and the
+ error is thrown where the asset is used.
+*/
+std::size_t Scene2dLoader::finishedCount() const
+{
+    const AssetManager& assets = *Locator::assetManager;
+    std::size_t count = 0;
+    for (int id : m_parsed->hints.images) {
+        count += assets.isPending(AssetKind::Image, id) ? 0 : 1;
+    }
+    for (int id : m_parsed->hints.animations) {
+        count += assets.isPending(AssetKind::Animation, id) ? 0 : 1;
+    }
+    for (int id : m_parsed->hints.sounds) {
+        count += assets.isPending(AssetKind::Sound, id) ? 0 : 1;
+    }
+
+    return count;
+}
+
+}  // namespace CapEngine
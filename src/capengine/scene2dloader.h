@@ -0,0 +1,62 @@
+#ifndef CAPENGINE_SCENE2DLOADER_H
+#define CAPENGINE_SCENE2DLOADER_H
+
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <jsoncons/json.hpp>
+
+#include "asset_manager.h"
+#include "cookedscenes.h"
+#include "gamestate.h"
+
+namespace CapEngine {
+
+//! Prepares a Scene2dState without stalling the game loop.
+/**
+   The scene file is read and parsed on a worker thread.  Once it has been, the
+   scene's "preload" assets are queued with the AssetManager, which decodes them
+   on its own workers while Runner spreads their uploads over frames.  The state
+   itself is constructed on the main thread once they are resident, since layers
+   create textures and the scene registers itself with the Locator.
+
+   Pass it to Runner::switchStateWhenReady().  Destroying it early waits for the
+   parse to finish and releases the preloaded assets.
+*/
+class Scene2dLoader final : public PendingGameState {
+   public:
+    Scene2dLoader(std::filesystem::path in_path, std::string in_sceneId, uint32_t in_windowId);
+    ~Scene2dLoader() override;
+
+    Scene2dLoader(const Scene2dLoader&) = delete;
+    Scene2dLoader& operator=(const Scene2dLoader&) = delete;
+
+    std::shared_ptr<GameState> poll() override;
+    [[nodiscard]] double progress() const override;
+
+   private:
+    //! What the worker produces.
+    struct ParsedScene {
+        jsoncons::json descriptors;            //!< The whole json file, for json scenes.
+        std::unique_ptr<CookedScenes> pCooked;  //!< The mapped file, for cooked scenes.
+        PreloadHints hints;
+    };
+
+    static ParsedScene parse(const std::filesystem::path& in_path, const std::string& in_sceneId);
+    [[nodiscard]] std::size_t finishedCount() const;
+
+    std::string m_sceneId;
+    uint32_t m_windowId;
+    std::future<ParsedScene> m_parsing;   //!< Valid until the worker's result is taken.
+    std::optional<ParsedScene> m_parsed;  //!< Set once the worker has finished.
+    bool m_preloaded = false;             //!< Whether the hints are retained by this loader.
+    bool m_finished = false;              //!< Whether poll() has returned the state.
+};
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_SCENE2DLOADER_H
@@ -25,11 +25,16 @@ const char *kMetadata = "metadata";
 // scenes
 const char *kScenes = "scenes";
 const char *kSceneId = "id";
+const char *kPreload = "preload";
+const char *kPreloadImages = "images";
+const char *kPreloadAnimations = "animations";
+const char *kPreloadSounds = "sounds";
 
 // layers
 const char *kLayers = "layers";
 const char *kLayerOrder = "order";
 const char *kLayerType = "type";
+const char *kQueryLayer = "queryLayer";
 
 // image layers
 const char *kImageLayerType = "ImageLayer";
@@ -39,10 +44,20 @@ const char *kBitmapCollisionLayer = "BitmapCollisionLayer";
 
 // vector layer
 const char *kVectorCollisionLayerType = "VectorCollisionLayer";
+const char *kPolygons = "polygons";
+const char *kPolylines = "polylines";
+const char *kObjectGroup = "objectGroup";
+// kTiledMap
+// kPosition
+
+// tile collision layer
+const char *kTileCollisionLayerType = "TileCollisionLayer";
+const char *kTiledMap = "map";
 
 // objects
 const char *kObjects = "objects";
 const char *kComponents = "components";
+const char *kContinuousCollision = "continuousCollision";
 
 } // namespace Scene2d
 
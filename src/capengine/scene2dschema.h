@@ -26,11 +26,16 @@ extern const char *kMetadata;
 // scenes
 extern const char *kScenes;
 extern const char *kSceneId;
+extern const char *kPreload;
+extern const char *kPreloadImages;
+extern const char *kPreloadAnimations;
+extern const char *kPreloadSounds;
 
 // layers
 extern const char *kLayers;
 extern const char *kLayerOrder;
 extern const char *kLayerType;
+extern const char *kQueryLayer;
 
 // image layers
 extern const char *kImageLayerType;
@@ -38,11 +43,24 @@ extern const char *kImageLayerType;
 // kPosition
 extern const char *kBitmapCollisionLayer;
 
+// vector collision layer
 extern const char *kVectorCollisionLayerType;
+extern const char *kPolygons;
+extern const char *kPolylines;
+extern const char *kObjectGroup;
+// kTiledMap
+// kPosition
+
+// tile collision layer
+extern const char *kTileCollisionLayerType;
+extern const char *kTiledMap;
+// kPosition
 
 // objects
 extern const char *kObjects;
 extern const char *kComponents;
+extern const char *kContinuousCollision;
+// kQueryLayer
 
 } // namespace Scene2d
 
@@ -1,11 +1,32 @@
 #include "scene2dstate.h"
 
+#include "locator.h"
 #include "scene2dschema.h"
 #include "simpleobjectmanager.h"
 
 namespace CapEngine
 {
 
+//! Reads the asset ids of a scene's "preload" json.
+PreloadHints readPreloadHints(const jsoncons::json &in_preload)
+{
+    using namespace Schema::Scene2d;
+
+    PreloadHints hints;
+    auto readIds = [&](const char *in_key, std::vector<int> &out_ids) {
+        if (in_preload.contains(in_key)) {
+            for (auto &&id : in_preload[in_key].array_range()) {
+                out_ids.push_back(id.as<int>());
+            }
+        }
+    };
+
+    readIds(kPreloadImages, hints.images);
+    readIds(kPreloadAnimations, hints.animations);
+    readIds(kPreloadSounds, hints.sounds);
+    return hints;
+}
+
 //! Constructor.
 /**
  \param in_sceneDescriptors
@@ -24,6 +45,10 @@ Scene2dState::Scene2dState(jsoncons::json in_sceneDescriptors,
 
     for (auto &&scene : m_sceneDescriptors[kScenes].array_range()) {
         if (scene[kSceneId] == m_sceneId) {
+            // start decoding before the scene loads so the two overlap.
+            if (scene.contains(kPreload)) {
+                this->preload(readPreloadHints(scene[kPreload]));
+            }
             m_pScene.reset(new Scene2d(scene));
         }
     }
@@ -33,6 +58,56 @@ Scene2dState::Scene2dState(jsoncons::json in_sceneDescriptors,
     }
 }
 
+//! Constructor.
+/**
+ \param in_scenes
+   The cooked scenes.  They can be destroyed once the state is constructed.
+ \param in_sceneID
+   The id of the scene to load.
+ \param
+   The id of the window to use.
+*/
+Scene2dState::Scene2dState(const CookedScenes &in_scenes,
+                           std::string in_sceneId, uint32_t in_windowId)
+    : m_sceneId(std::move(in_sceneId)), m_windowId(in_windowId)
+{
+    const CookedSceneRecord *pScene = in_scenes.findScene(m_sceneId);
+    if (pScene == nullptr) {
+        BOOST_THROW_EXCEPTION(SceneDoesNotExistException(m_sceneId));
+    }
+
+    // start decoding before the scene loads so the two overlap.
+    if (pScene->preload.size != 0) {
+        this->preload(readPreloadHints(in_scenes.decode(pScene->preload)));
+    }
+    m_pScene.reset(new Scene2d(in_scenes, *pScene));
+}
+
+//! Destructor.
+Scene2dState::~Scene2dState() = default;
+
+//! Destructor.  Lets the preloaded assets be evicted.
+Scene2dState::PreloadedAssets::~PreloadedAssets()
+{
+    if (Locator::assetManager != nullptr) {
+        Locator::assetManager->release(hints);
+    }
+}
+
+//! Asks the asset manager to start loading a scene's assets.
+/**
+ \param in_hints
+   The assets.  They stay retained until the state is destroyed.
+*/
+void Scene2dState::preload(PreloadHints in_hints)
+{
+    if (Locator::assetManager != nullptr) {
+        // only kept once retained, so they aren't released if preloading throws.
+        Locator::assetManager->preload(in_hints);
+        m_preloaded.hints = std::move(in_hints);
+    }
+}
+
 //! \copydoc GameState::render
 void Scene2dState::render()
 {
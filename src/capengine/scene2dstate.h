@@ -2,6 +2,7 @@
 #define CAPENGINE_SCENE2DSTATE_H
 
 #include "CapEngineException.h"
+#include "asset_manager.h"
 #include "gamestate.h"
 #include "scene2d.h"
 #include "simpleobjectmanager.h"
@@ -17,19 +18,24 @@ struct SceneDoesNotExistException : public CapEngineException {
       : CapEngineException(std::string("Scene does not exist: ") + in_scenedId) {}
 };
 
+PreloadHints readPreloadHints(const jsoncons::json &in_preload);
+
 //! Game State for 2d scenes.
 class Scene2dState : public GameState {
 public:
   Scene2dState(jsoncons::json in_sceneDescriptors, std::string in_sceneId, uint32_t in_windowId);
+  Scene2dState(const CookedScenes &in_scenes, std::string in_sceneId, uint32_t in_windowId);
 
-  ~Scene2dState() override = default;
+  ~Scene2dState() override;
   void render() override;
   void update(double ms) override;
   void setEndSceneCB(std::function<void()> in_endSceneCB);
   void addUpdateCB(std::function<void(double ms)> in_updateCB);
 
 protected:
-  //! Descriptors of all the available scenes.
+  void preload(PreloadHints in_hints);
+
+  //! Descriptors of all the available scenes.  Empty for cooked scenes.
   jsoncons::json m_sceneDescriptors;
   //! The id of the scene to load.
   std::string m_sceneId;
@@ -39,6 +45,19 @@ protected:
   uint32_t m_windowId;
   //! Update hooks
   std::vector<std::function<void(double ms)>> m_updateHooks;
+  //! Releases preloaded assets when destroyed, including when a constructor
+  //! throws after preloading them.
+  struct PreloadedAssets {
+    PreloadedAssets() = default;
+    PreloadedAssets(const PreloadedAssets &) = delete;
+    PreloadedAssets &operator=(const PreloadedAssets &) = delete;
+    ~PreloadedAssets();
+
+    PreloadHints hints;
+  };
+
+  //! The assets the scene asked to preload, retained until it is destroyed.
+  PreloadedAssets m_preloaded;
 };
 } // namespace CapEngine
 
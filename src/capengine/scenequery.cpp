@@ -0,0 +1,403 @@
+#include "scenequery.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "CapEngineException.h"
+
+namespace CapEngine {
+
+namespace {
+
+//! How far the object broadphase bounds are grown so rounding can't miss an object.
+constexpr double kBroadphasePadding = 1.0;
+
+bool inMask(int in_queryLayer, uint32_t in_layerMask)
+{
+    return ((in_layerMask >> in_queryLayer) & 1u) != 0;
+}
+
+double lengthOf(const Vector& in_vector)
+{
+    return std::sqrt(in_vector.getX() * in_vector.getX() + in_vector.getY() * in_vector.getY());
+}
+
+Point centreOf(const Rectangle& in_box)
+{
+    return Point{in_box.x + in_box.width / 2.0, in_box.y + in_box.height / 2.0};
+}
+
+//! The bounds of a box over the whole of a cast, padded for the broadphase.
+Rectangle sweptBounds(const Rectangle& in_box, const Vector& in_displacement)
+{
+    const Rectangle end{in_box.x + in_displacement.getX(), in_box.y + in_displacement.getY(), in_box.width,
+                        in_box.height};
+    const Rectangle bounds = join(in_box, end);
+    return Rectangle{bounds.x - kBroadphasePadding, bounds.y - kBroadphasePadding,
+                     bounds.width + 2 * kBroadphasePadding, bounds.height + 2 * kBroadphasePadding};
+}
+
+//! Sorts hits closest first and keeps the closest in_maxHits.
+void sortHits(std::vector<QueryHit>& io_hits, std::size_t in_maxHits)
+{
+    auto closer = [](const QueryHit& in_lhs, const QueryHit& in_rhs) {
+        if (in_lhs.distance != in_rhs.distance) {
+            return in_lhs.distance < in_rhs.distance;
+        }
+        return in_lhs.objectId < in_rhs.objectId;
+    };
+
+    if (in_maxHits < io_hits.size()) {
+        std::partial_sort(io_hits.begin(), io_hits.begin() + static_cast<std::ptrdiff_t>(in_maxHits), io_hits.end(),
+                          closer);
+        io_hits.resize(in_maxHits);
+    }
+    else {
+        std::sort(io_hits.begin(), io_hits.end(), closer);
+    }
+}
+
+}  // namespace
+
+//! Constructor.
+/**
+ \param in_pObjectManager
+   The objects to query.
+*/
+SceneQuery::SceneQuery(std::shared_ptr<ObjectManager> in_pObjectManager)
+    : m_pObjectManager(std::move(in_pObjectManager))
+{
+    CAP_THROW_NULL(m_pObjectManager, "ObjectManager is null");
+}
+
+//! Sets the layers to query.
+/**
+ \param in_layers
+   The collidable layers.  They must outlive their use by queries.
+*/
+void SceneQuery::setLayers(std::vector<const Layer*> in_layers)
+{
+    m_layers = std::move(in_layers);
+}
+
+//! Finds what a ray hits.
+/**
+ \param in_origin
+   Where the ray starts.
+ \param in_direction
+   The direction of the ray.
+ \param in_maxDistance
+   How far the ray goes.
+ \param out_hits
+   Receives the hits, closest first.  It is cleared first.
+ \param in_filter
+   What can be hit.
+ \return
+   The number of hits.
+*/
+std::size_t SceneQuery::raycast(const Point& in_origin, const Vector& in_direction, double in_maxDistance,
+                                std::vector<QueryHit>& out_hits, const QueryFilter& in_filter) const
+{
+    out_hits.clear();
+
+    const double length = lengthOf(in_direction);
+    if (length == 0.0 || in_maxDistance <= 0.0) {
+        return 0;
+    }
+
+    const double scale = in_maxDistance / length;
+    this->cast(Rectangle{in_origin.x, in_origin.y, 0.0, 0.0},
+               Vector{in_direction.getX() * scale, in_direction.getY() * scale}, out_hits, in_filter);
+    return out_hits.size();
+}
+
+//! Finds what the line between two points hits.
+/**
+ \param in_start
+   The start of the line.
+ \param in_end
+   The end of the line.
+ \param out_hits
+   Receives the hits, closest to in_start first.  It is cleared first.
+ \param in_filter
+   What can be hit.
+ \return
+   The number of hits.
+*/
+std::size_t SceneQuery::segmentCast(const Point& in_start, const Point& in_end, std::vector<QueryHit>& out_hits,
+                                    const QueryFilter& in_filter) const
+{
+    out_hits.clear();
+    this->cast(Rectangle{in_start.x, in_start.y, 0.0, 0.0}, Vector{in_end.x - in_start.x, in_end.y - in_start.y},
+               out_hits, in_filter);
+    return out_hits.size();
+}
+
+//! Finds what a box moving in a straight line hits.
+/**
+ \param in_box
+   The box at the start.
+ \param in_displacement
+   How far the box moves.
+ \param out_hits
+   Receives the hits, closest first.  It is cleared first.
+ \param in_filter
+   What can be hit.
+ \return
+   The number of hits.
+*/
+std::size_t SceneQuery::boxCast(const Rectangle& in_box, const Vector& in_displacement,
+                                std::vector<QueryHit>& out_hits, const QueryFilter& in_filter) const
+{
+    out_hits.clear();
+    this->cast(in_box, in_displacement, out_hits, in_filter);
+    return out_hits.size();
+}
+
+//! Finds what overlaps a box.
+/**
+ \param in_box
+   The box.
+ \param out_hits
+   Receives the hits, closest to the centre of the box first.  Layers are at
+   distance 0.  It is cleared first.
+ \param in_filter
+   What can be hit.
+ \return
+   The number of hits.
+*/
+std::size_t SceneQuery::overlapQuery(const Rectangle& in_box, std::vector<QueryHit>& out_hits,
+                                     const QueryFilter& in_filter) const
+{
+    out_hits.clear();
+    const Point centre = centreOf(in_box);
+
+    if (in_filter.layers) {
+        for (const Layer* pLayer : m_layers) {
+            if (inMask(pLayer->queryLayer(), in_filter.layerMask) &&
+                pLayer->overlaps(in_box, in_filter.orientation)) {
+                QueryHit hit;
+                hit.point = centre;
+                hit.pLayer = pLayer;
+                out_hits.push_back(hit);
+            }
+        }
+    }
+
+    if (in_filter.objects) {
+        m_pObjectManager->forEachObject(in_box, [&](GameObject& in_object) {
+            if (!this->includes(in_object, in_filter)) {
+                return;
+            }
+
+            const Rectangle bounds = in_object.boundingPolygon();
+            if (!detectBoxCollision(in_box, bounds)) {
+                return;
+            }
+
+            QueryHit hit;
+            hit.point = centreOf(bounds);
+            hit.distance = std::hypot(hit.point.x - centre.x, hit.point.y - centre.y);
+            hit.objectId = in_object.getObjectID();
+            hit.object = m_pObjectManager->getHandle(hit.objectId);
+            out_hits.push_back(hit);
+        });
+    }
+
+    sortHits(out_hits, in_filter.maxHits);
+    return out_hits.size();
+}
+
+//! Finds the closest hit of each of many rays.
+/**
+ The objects near all of the rays are gathered once and every ray is tested
+ against that list, which is much cheaper than a raycast() per ray when the
+ rays are close together, such as line of sight checks from one agent.
+ \param in_rays
+   The rays.
+ \param out_closest
+   Receives the closest hit of each ray, or nullopt if it hit nothing.
+ \param in_filter
+   What can be hit.  maxHits is ignored.
+*/
+void SceneQuery::raycastBatch(std::span<const Ray> in_rays, std::vector<std::optional<QueryHit>>& out_closest,
+                              const QueryFilter& in_filter) const
+{
+    out_closest.assign(in_rays.size(), std::nullopt);
+    if (in_rays.empty()) {
+        return;
+    }
+
+    // everything any of the rays could reach
+    m_candidates.clear();
+    if (in_filter.objects) {
+        std::optional<Rectangle> bounds;
+        for (auto&& ray : in_rays) {
+            const double length = lengthOf(ray.direction);
+            if (length == 0.0 || ray.maxDistance <= 0.0) {
+                continue;
+            }
+            const double scale = ray.maxDistance / length;
+            const Rectangle rayBounds =
+                sweptBounds(Rectangle{ray.origin.x, ray.origin.y, 0.0, 0.0},
+                            Vector{ray.direction.getX() * scale, ray.direction.getY() * scale});
+            bounds = bounds ? join(*bounds, rayBounds) : rayBounds;
+        }
+
+        if (bounds) {
+            m_pObjectManager->forEachObject(*bounds, [&](GameObject& in_object) {
+                if (this->includes(in_object, in_filter)) {
+                    m_candidates.push_back(Candidate{in_object.boundingPolygon(), in_object.getObjectID()});
+                }
+            });
+        }
+    }
+
+    for (std::size_t i = 0; i < in_rays.size(); i++) {
+        const Ray& ray = in_rays[i];
+        const double length = lengthOf(ray.direction);
+        if (length == 0.0 || ray.maxDistance <= 0.0) {
+            continue;
+        }
+
+        const double scale = ray.maxDistance / length;
+        const Rectangle box{ray.origin.x, ray.origin.y, 0.0, 0.0};
+        const Vector displacement{ray.direction.getX() * scale, ray.direction.getY() * scale};
+        std::optional<QueryHit>& closest = out_closest[i];
+
+        if (in_filter.layers) {
+            this->castLayers(box, displacement, ray.maxDistance, in_filter, [&](const QueryHit& in_hit) {
+                if (!closest || in_hit.distance < closest->distance) {
+                    closest = in_hit;
+                }
+            });
+        }
+
+        for (auto&& candidate : m_candidates) {
+            const auto collision = detectSweptBoxCollision(box, displacement, 1000.0, candidate.bounds);
+            if (collision && (!closest || collision->timeOfImpact * ray.maxDistance < closest->distance)) {
+                closest = this->objectHit(candidate.objectId, *collision, ray.maxDistance);
+            }
+        }
+    }
+}
+
+//! Casts a box against the layers and objects.
+/**
+ \param in_box
+   The box at the start.
+ \param in_displacement
+   How far it moves.
+ \param out_hits
+   Receives the hits.
+ \param in_filter
+   What can be hit.
+*/
+void SceneQuery::cast(const Rectangle& in_box, const Vector& in_displacement, std::vector<QueryHit>& out_hits,
+                      const QueryFilter& in_filter) const
+{
+    const double length = lengthOf(in_displacement);
+    if (length == 0.0 || in_filter.maxHits == 0) {
+        return;
+    }
+
+    // when only the closest hit is wanted nothing beyond the closest so far
+    // needs to be looked at
+    double reach = 1.0;
+    const bool closestOnly = in_filter.maxHits == 1;
+
+    if (in_filter.layers) {
+        this->castLayers(in_box, in_displacement, length, in_filter, [&](const QueryHit& in_hit) {
+            out_hits.push_back(in_hit);
+            if (closestOnly) {
+                reach = std::min(reach, in_hit.distance / length);
+            }
+        });
+    }
+
+    if (in_filter.objects) {
+        const Vector reachable{in_displacement.getX() * reach, in_displacement.getY() * reach};
+        m_pObjectManager->forEachObject(sweptBounds(in_box, reachable), [&](GameObject& in_object) {
+            if (!this->includes(in_object, in_filter)) {
+                return;
+            }
+
+            const auto collision =
+                detectSweptBoxCollision(in_box, in_displacement, 1000.0, in_object.boundingPolygon());
+            if (collision && collision->timeOfImpact <= reach) {
+                out_hits.push_back(this->objectHit(in_object.getObjectID(), *collision, length));
+                if (closestOnly) {
+                    reach = collision->timeOfImpact;
+                }
+            }
+        });
+    }
+
+    sortHits(out_hits, in_filter.maxHits);
+}
+
+//! Casts a box against the collidable layers.
+/**
+ \param in_box
+   The box at the start.
+ \param in_displacement
+   How far it moves.
+ \param in_length
+   The length of in_displacement.
+ \param in_filter
+   What can be hit.
+ \param in_func
+   Called with the hit on each layer that is hit.
+*/
+void SceneQuery::castLayers(const Rectangle& in_box, const Vector& in_displacement, double in_length,
+                            const QueryFilter& in_filter, FunctionRef<void(const QueryHit&)> in_func) const
+{
+    for (const Layer* pLayer : m_layers) {
+        if (!inMask(pLayer->queryLayer(), in_filter.layerMask)) {
+            continue;
+        }
+
+        const auto collision = pLayer->castBox(in_box, in_displacement, in_filter.orientation);
+        if (!collision) {
+            continue;
+        }
+
+        QueryHit hit;
+        hit.distance = collision->timeOfImpact * in_length;
+        hit.point = collision->collision.representativePoint;
+        hit.normal = Vector{-collision->collision.collisionNormal.getX(), -collision->collision.collisionNormal.getY()};
+        hit.pLayer = pLayer;
+        in_func(hit);
+    }
+}
+
+//! Checks if a filter lets an object be hit.
+bool SceneQuery::includes(const GameObject& in_object, const QueryFilter& in_filter) const
+{
+    return in_object.getObjectState() != GameObject::Dead && in_object.getObjectID() != in_filter.ignoreObject &&
+           inMask(in_object.getQueryLayer(), in_filter.layerMask);
+}
+
+//! Makes the hit for an object.
+/**
+ \param in_objectId
+   The object.
+ \param in_collision
+   Where the cast hits it.
+ \param in_length
+   The length of the cast.
+ \return
+   The hit.
+*/
+QueryHit SceneQuery::objectHit(ObjectID in_objectId, const SweptBoxCollision& in_collision, double in_length) const
+{
+    QueryHit hit;
+    hit.distance = in_collision.timeOfImpact * in_length;
+    hit.point = in_collision.collision.representativePoint;
+    hit.normal = Vector{-in_collision.collision.collisionNormal.getX(), -in_collision.collision.collisionNormal.getY()};
+    hit.objectId = in_objectId;
+    hit.object = m_pObjectManager->getHandle(in_objectId);
+    return hit;
+}
+
+}  // namespace CapEngine
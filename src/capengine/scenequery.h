@@ -0,0 +1,109 @@
+#ifndef CAPENGINE_SCENEQUERY_H
+#define CAPENGINE_SCENEQUERY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "collision.h"
+#include "functionref.h"
+#include "gameobject.h"
+#include "layer.h"
+#include "objectmanager.h"
+
+namespace CapEngine {
+
+//! Limits what a SceneQuery can hit.
+struct QueryFilter {
+    static constexpr uint32_t kAllLayers = std::numeric_limits<uint32_t>::max();
+
+    //! Bits of GameObject::getQueryLayer() and Layer::queryLayer() to include.
+    uint32_t layerMask = kAllLayers;
+    bool objects = true;  //!< Whether objects can be hit.
+    bool layers = true;   //!< Whether collidable layers can be hit.
+    //! An object that is never hit, usually the one doing the query.
+    ObjectID ignoreObject = -1;
+    //! Only the closest this many hits are kept.  1 gives just the closest and lets the query stop early.
+    std::size_t maxHits = std::numeric_limits<std::size_t>::max();
+    //! The y axis orientation of the query's coordinates.
+    YAxisOrientation orientation = YAxisOrientation::BottomZero;
+};
+
+//! Something a query hit.
+struct QueryHit {
+    //! Distance along the cast, or from the centre of the box for overlapQuery().
+    double distance = 0.0;
+    //! Where the hit happened.
+    Point point;
+    //! Normal of the surface that was hit, facing back at the cast.  Zero for overlapQuery().
+    Vector normal{0.0, 0.0, 0.0, 0.0};
+    ObjectHandle object;             //!< The object that was hit, null for a layer.
+    ObjectID objectId = -1;          //!< The id of the object that was hit, -1 for a layer.
+    const Layer* pLayer = nullptr;   //!< The layer that was hit, nullptr for an object.
+};
+
+//! A ray for SceneQuery::raycastBatch().
+struct Ray {
+    Point origin;
+    Vector direction;  //!< Needn't be normalised.
+    double maxDistance = 0.0;
+};
+
+//! Raycasts and shape casts against the objects and collidable layers of a scene.
+/**
+   Scene2d owns one and registers it with the Locator under
+   kSceneQueryLocatorId so components can use it.  Objects are found through
+   ObjectManager::forEachObject() with the bounds of the cast, and each layer
+   answers through Layer::castBox() and Layer::overlaps().  Shapes that start
+   overlapping something only hit it in overlapQuery().
+
+   Results are written into a caller supplied vector, which keeps its
+   storage, sorted closest first.
+*/
+class SceneQuery final {
+   public:
+    explicit SceneQuery(std::shared_ptr<ObjectManager> in_pObjectManager);
+
+    void setLayers(std::vector<const Layer*> in_layers);
+
+    std::size_t raycast(const Point& in_origin, const Vector& in_direction, double in_maxDistance,
+                        std::vector<QueryHit>& out_hits, const QueryFilter& in_filter = {}) const;
+    std::size_t segmentCast(const Point& in_start, const Point& in_end, std::vector<QueryHit>& out_hits,
+                            const QueryFilter& in_filter = {}) const;
+    std::size_t boxCast(const Rectangle& in_box, const Vector& in_displacement, std::vector<QueryHit>& out_hits,
+                        const QueryFilter& in_filter = {}) const;
+    std::size_t overlapQuery(const Rectangle& in_box, std::vector<QueryHit>& out_hits,
+                             const QueryFilter& in_filter = {}) const;
+
+    void raycastBatch(std::span<const Ray> in_rays, std::vector<std::optional<QueryHit>>& out_closest,
+                      const QueryFilter& in_filter = {}) const;
+
+    static constexpr char kSceneQueryLocatorId[] = "SceneQuery";
+
+   private:
+    //! An object gathered once for a batch of rays.
+    struct Candidate {
+        Rectangle bounds;
+        ObjectID objectId;
+    };
+
+    void cast(const Rectangle& in_box, const Vector& in_displacement, std::vector<QueryHit>& out_hits,
+              const QueryFilter& in_filter) const;
+    void castLayers(const Rectangle& in_box, const Vector& in_displacement, double in_length,
+                    const QueryFilter& in_filter, FunctionRef<void(const QueryHit&)> in_func) const;
+    [[nodiscard]] bool includes(const GameObject& in_object, const QueryFilter& in_filter) const;
+    [[nodiscard]] QueryHit objectHit(ObjectID in_objectId, const SweptBoxCollision& in_collision,
+                                     double in_length) const;
+
+    std::shared_ptr<ObjectManager> m_pObjectManager;  //!< The objects.
+    std::vector<const Layer*> m_layers;               //!< The collidable layers, owned by the scene.
+    mutable std::vector<Candidate> m_candidates;      //!< Reused by raycastBatch().
+};
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_SCENEQUERY_H
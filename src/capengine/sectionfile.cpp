@@ -0,0 +1,78 @@
+#include "sectionfile.h"
+
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "CapEngineException.h"
+
+namespace CapEngine {
+
+//! Throws if a file is malformed.
+/**
+ \param in_condition
+   Whether the file is well formed.
+ \param in_format
+   The name of the format, e.g. "asset archive".
+ \param in_path
+   The file.
+ \param in_details
+   What is wrong with it.
+*/
+void checkSectionFile(bool in_condition, std::string_view in_format, const std::filesystem::path& in_path,
+                      std::string_view in_details)
+{
+    if (!in_condition) {
+        CAP_THROW(CapEngineException("Invalid " + std::string(in_format) + " " + in_path.string() + ": " +
+                                     std::string(in_details)));
+    }
+}
+
+//! Looks up a string in a string table.
+/**
+ \param in_file
+   The file.
+ \param in_format
+   The name of the format, for the error if the string is malformed.
+ \param in_tableOffset
+   The offset of the string table, which must be within the file.
+ \param in_tableSize
+   The size of the string table.
+ \param in_offset
+   The offset of the string within the table.
+ \return
+   The string, without its terminator.
+*/
+std::string_view readSectionString(const MappedFile& in_file, std::string_view in_format, uint64_t in_tableOffset,
+                                   uint64_t in_tableSize, uint32_t in_offset)
+{
+    checkSectionFile(in_offset < in_tableSize, in_format, in_file.path(), "string out of range");
+
+    const char* pStart = reinterpret_cast<const char*>(in_file.bytes().data() + in_tableOffset + in_offset);
+    const std::size_t maxLength = in_tableSize - in_offset;
+    const void* pEnd = std::memchr(pStart, '\0', maxLength);
+    checkSectionFile(pEnd != nullptr, in_format, in_file.path(), "unterminated string");
+
+    return {pStart, static_cast<std::size_t>(static_cast<const char*>(pEnd) - pStart)};
+}
+
+//! Writes a built file.
+/**
+ \param in_path
+   The file to write.
+ \param in_format
+   The name of the format, for the error if it can't be written.
+ \param in_bytes
+   The contents.  Throws CapEngineException on failure.
+*/
+void writeSectionFile(const std::filesystem::path& in_path, std::string_view in_format,
+                      std::span<const std::byte> in_bytes)
+{
+    std::ofstream stream{in_path, std::ios::binary | std::ios::trunc};
+    stream.write(reinterpret_cast<const char*>(in_bytes.data()), static_cast<std::streamsize>(in_bytes.size()));
+    if (!stream) {
+        CAP_THROW(CapEngineException("Unable to write " + std::string(in_format) + " " + in_path.string()));
+    }
+}
+
+}  // namespace CapEngine
@@ -0,0 +1,97 @@
+#ifndef CAPENGINE_SECTIONFILE_H
+#define CAPENGINE_SECTIONFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "mappedfile.h"
+#include "serialization.h"
+
+namespace CapEngine {
+
+/**
+   \file
+   Helpers shared by the binary formats that are memory mapped and read in
+   place, e.g. AssetArchive and CookedScenes.  Such a file is a header followed
+   by sections, each starting on a kSectionAlignment boundary: tables of
+   fixed size records, a string table of nul terminated strings, and raw data.
+*/
+
+//! The alignment of each section.
+constexpr std::size_t kSectionAlignment = 16;
+
+//! Rounds an offset up to the next section boundary.
+constexpr uint64_t alignSection(uint64_t in_offset)
+{
+    return (in_offset + kSectionAlignment - 1) & ~static_cast<uint64_t>(kSectionAlignment - 1);
+}
+
+//! Pads the buffer up to the next section boundary.
+inline void padSection(std::vector<std::byte>& io_buffer)
+{
+    io_buffer.resize(alignSection(io_buffer.size()), std::byte{0});
+}
+
+//! Checks that a range of records lies within a table.
+constexpr bool inTable(uint64_t in_first, uint64_t in_count, uint64_t in_tableSize)
+{
+    return in_first <= in_tableSize && in_count <= in_tableSize - in_first;
+}
+
+void checkSectionFile(bool in_condition, std::string_view in_format, const std::filesystem::path& in_path,
+                      std::string_view in_details);
+std::string_view readSectionString(const MappedFile& in_file, std::string_view in_format, uint64_t in_tableOffset,
+                                   uint64_t in_tableSize, uint32_t in_offset);
+void writeSectionFile(const std::filesystem::path& in_path, std::string_view in_format,
+                      std::span<const std::byte> in_bytes);
+
+//! Appends a table of records and pads it to the next section.
+/**
+ \param io_writer
+   A writer appending to io_buffer.
+ \param io_buffer
+   The file being built.
+ \param in_records
+   The records.
+*/
+template <typename T>
+void writeSection(ByteWriter& io_writer, std::vector<std::byte>& io_buffer, std::span<const T> in_records)
+{
+    for (auto&& record : in_records) {
+        io_writer.write(record);
+    }
+    padSection(io_buffer);
+}
+
+//! Views a table of records in place in a mapped file.
+/**
+ \param in_file
+   The file.
+ \param in_format
+   The name of the format, for the error if the table is malformed.
+ \param in_offset
+   The offset of the table.
+ \param in_count
+   The number of records.
+ \return
+   The records.  Throws CapEngineException if they aren't within the file.
+*/
+template <typename T>
+std::span<const T> readSection(const MappedFile& in_file, std::string_view in_format, uint64_t in_offset,
+                               std::size_t in_count)
+{
+    const auto bytes = in_file.bytes();
+    checkSectionFile(in_offset % alignof(T) == 0, in_format, in_file.path(), "misaligned table");
+    checkSectionFile(in_offset <= bytes.size() && in_count <= (bytes.size() - in_offset) / sizeof(T), in_format,
+                     in_file.path(), "table out of range");
+
+    return {reinterpret_cast<const T*>(bytes.data() + in_offset), in_count};
+}
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_SECTIONFILE_H
@@ -0,0 +1,147 @@
+#include "segmentbvh.h"
+
+#include <algorithm>
+#include <array>
+
+namespace CapEngine {
+
+namespace {
+
+//! Segments per leaf before a node is split.
+constexpr uint32_t kMaxLeafSize = 4;
+
+//! Enough for any tree built by median splits over 2^32 segments.
+constexpr std::size_t kMaxDepth = 64;
+
+Rectangle segmentBounds(const Segment& in_segment)
+{
+    const double minX = std::min(in_segment.start.x, in_segment.end.x);
+    const double minY = std::min(in_segment.start.y, in_segment.end.y);
+    return Rectangle{minX, minY, std::max(in_segment.start.x, in_segment.end.x) - minX,
+                     std::max(in_segment.start.y, in_segment.end.y) - minY};
+}
+
+//! Like detectMBRCollision but horizontal and vertical segments have no area, so touching counts.
+bool touches(const Rectangle& in_a, const Rectangle& in_b)
+{
+    return in_a.x <= in_b.x + in_b.width && in_b.x <= in_a.x + in_a.width && in_a.y <= in_b.y + in_b.height &&
+           in_b.y <= in_a.y + in_a.height;
+}
+
+}  // namespace
+
+//! Builds the hierarchy.
+/**
+ \param in_segments
+   The segments.  Their order is not kept.
+*/
+SegmentBvh::SegmentBvh(std::vector<Segment> in_segments) : m_segments(std::move(in_segments))
+{
+    if (m_segments.empty()) {
+        return;
+    }
+
+    m_nodes.reserve(2 * (m_segments.size() / kMaxLeafSize + 1));
+    this->build(0, static_cast<uint32_t>(m_segments.size()));
+}
+
+//! Builds the node for a run of segments and everything below it.
+/**
+ \param in_first
+   The first segment.
+ \param in_count
+   The number of segments.
+ \return
+   The index of the node.
+*/
+uint32_t SegmentBvh::build(uint32_t in_first, uint32_t in_count)
+{
+    const uint32_t nodeIndex = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.emplace_back();
+
+    Rectangle bounds = segmentBounds(m_segments[in_first]);
+    double minX = (m_segments[in_first].start.x + m_segments[in_first].end.x) / 2.0;
+    double maxX = minX;
+    double minY = (m_segments[in_first].start.y + m_segments[in_first].end.y) / 2.0;
+    double maxY = minY;
+    for (uint32_t i = in_first + 1; i < in_first + in_count; i++) {
+        bounds = join(bounds, segmentBounds(m_segments[i]));
+
+        const double centreX = (m_segments[i].start.x + m_segments[i].end.x) / 2.0;
+        const double centreY = (m_segments[i].start.y + m_segments[i].end.y) / 2.0;
+        minX = std::min(minX, centreX);
+        maxX = std::max(maxX, centreX);
+        minY = std::min(minY, centreY);
+        maxY = std::max(maxY, centreY);
+    }
+    m_nodes[nodeIndex].bounds = bounds;
+
+    if (in_count <= kMaxLeafSize) {
+        m_nodes[nodeIndex].first = in_first;
+        m_nodes[nodeIndex].count = in_count;
+        return nodeIndex;
+    }
+
+    // split at the median centre along the axis the centres are most spread on
+    const bool splitOnX = (maxX - minX) >= (maxY - minY);
+    const auto begin = m_segments.begin() + in_first;
+    const uint32_t half = in_count / 2;
+    std::nth_element(begin, begin + half, begin + in_count, [splitOnX](const Segment& in_lhs, const Segment& in_rhs) {
+        return splitOnX ? in_lhs.start.x + in_lhs.end.x < in_rhs.start.x + in_rhs.end.x
+                        : in_lhs.start.y + in_lhs.end.y < in_rhs.start.y + in_rhs.end.y;
+    });
+
+    this->build(in_first, half);
+    const uint32_t right = this->build(in_first + half, in_count - half);
+    m_nodes[nodeIndex].right = right;
+
+    return nodeIndex;
+}
+
+//! Visits the segments whose bounds touch a box.
+/**
+ The segments themselves may not touch the box, use detectBoxSegmentCollision
+ to check.
+ \param in_box
+   The box.
+ \param in_func
+   Called with each segment.
+*/
+void SegmentBvh::query(const Rectangle& in_box, FunctionRef<void(const Segment&)> in_func) const
+{
+    if (m_nodes.empty()) {
+        return;
+    }
+
+    std::array<uint32_t, kMaxDepth> stack;
+    std::size_t stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const Node& node = m_nodes[stack[--stackSize]];
+        if (!touches(node.bounds, in_box)) {
+            continue;
+        }
+
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                if (touches(segmentBounds(m_segments[i]), in_box)) {
+                    in_func(m_segments[i]);
+                }
+            }
+            continue;
+        }
+
+        const uint32_t nodeIndex = static_cast<uint32_t>(&node - m_nodes.data());
+        stack[stackSize++] = node.right;
+        stack[stackSize++] = nodeIndex + 1;
+    }
+}
+
+//! Gets the bounds of all of the segments.
+Rectangle SegmentBvh::bounds() const
+{
+    return m_nodes.empty() ? Rectangle{0.0, 0.0, 0.0, 0.0} : m_nodes.front().bounds;
+}
+
+}  // namespace CapEngine
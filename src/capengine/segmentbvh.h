@@ -0,0 +1,66 @@
+#ifndef CAPENGINE_SEGMENTBVH_H
+#define CAPENGINE_SEGMENTBVH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "collision.h"
+#include "functionref.h"
+
+namespace CapEngine {
+
+//! Bounding volume hierarchy over line segments.
+/**
+   Built once from static geometry.  Nodes are stored depth first in a flat
+   array so a node's left child immediately follows it, and the segments are
+   reordered so each leaf owns a contiguous run of them.  A query only
+   descends into nodes whose bounds touch the box, so it is O(log n) for a
+   box that touches a handful of segments.
+*/
+class SegmentBvh final {
+   public:
+    SegmentBvh() = default;
+    explicit SegmentBvh(std::vector<Segment> in_segments);
+
+    void query(const Rectangle& in_box, FunctionRef<void(const Segment&)> in_func) const;
+
+    [[nodiscard]] const std::vector<Segment>& segments() const;
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] Rectangle bounds() const;
+
+   private:
+    struct Node {
+        Rectangle bounds;
+        uint32_t first = 0;  //!< The first segment of a leaf.
+        uint32_t count = 0;  //!< The number of segments in a leaf, 0 for interior nodes.
+        uint32_t right = 0;  //!< The right child of an interior node.  The left is the next node.
+    };
+
+    uint32_t build(uint32_t in_first, uint32_t in_count);
+
+    std::vector<Segment> m_segments;  //!< The segments, grouped by leaf.
+    std::vector<Node> m_nodes;        //!< The nodes, depth first.
+};
+
+//! Gets the segments in leaf order.
+inline const std::vector<Segment>& SegmentBvh::segments() const
+{
+    return m_segments;
+}
+
+//! Gets the number of segments.
+inline std::size_t SegmentBvh::size() const
+{
+    return m_segments.size();
+}
+
+//! Checks if there are no segments.
+inline bool SegmentBvh::empty() const
+{
+    return m_segments.empty();
+}
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_SEGMENTBVH_H
@@ -0,0 +1,95 @@
+#ifndef CAPENGINE_SERIALIZATION_H
+#define CAPENGINE_SERIALIZATION_H
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "CapEngineException.h"
+
+namespace CapEngine {
+
+//! Appends plain values to a byte buffer.
+/**
+   Values are written in native byte order, so the output is only meant to be
+   read back by the same build, e.g. for snapshots and rollback.
+*/
+class ByteWriter {
+   public:
+    explicit ByteWriter(std::vector<std::byte>& io_buffer) : m_buffer(io_buffer) {}
+
+    template <typename T>
+    void write(const T& in_value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written");
+
+        const std::size_t offset = m_buffer.size();
+        m_buffer.resize(offset + sizeof(T));
+        std::memcpy(m_buffer.data() + offset, &in_value, sizeof(T));
+    }
+
+    void writeBytes(std::span<const std::byte> in_bytes)
+    {
+        m_buffer.insert(m_buffer.end(), in_bytes.begin(), in_bytes.end());
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return m_buffer.size();
+    }
+
+    //! Overwrites a value written earlier, e.g. a length prefix.
+    template <typename T>
+    void patch(std::size_t in_offset, const T& in_value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written");
+        CAP_THROW_ASSERT(in_offset + sizeof(T) <= m_buffer.size(), "Patch is out of range");
+
+        std::memcpy(m_buffer.data() + in_offset, &in_value, sizeof(T));
+    }
+
+   private:
+    std::vector<std::byte>& m_buffer;  //!< The buffer being appended to.
+};
+
+//! Reads plain values written by a ByteWriter.
+class ByteReader {
+   public:
+    explicit ByteReader(std::span<const std::byte> in_bytes) : m_bytes(in_bytes) {}
+
+    template <typename T>
+    [[nodiscard]] T read()
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read");
+        CAP_THROW_ASSERT(m_offset + sizeof(T) <= m_bytes.size(), "Read past the end of the buffer");
+
+        T value;
+        std::memcpy(&value, m_bytes.data() + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return value;
+    }
+
+    [[nodiscard]] std::span<const std::byte> readBytes(std::size_t in_count)
+    {
+        CAP_THROW_ASSERT(m_offset + in_count <= m_bytes.size(), "Read past the end of the buffer");
+
+        auto bytes = m_bytes.subspan(m_offset, in_count);
+        m_offset += in_count;
+        return bytes;
+    }
+
+    [[nodiscard]] std::size_t remaining() const
+    {
+        return m_bytes.size() - m_offset;
+    }
+
+   private:
+    std::span<const std::byte> m_bytes;  //!< The buffer being read.
+    std::size_t m_offset = 0;            //!< The position of the next read.
+};
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_SERIALIZATION_H
@@ -22,4 +22,11 @@ void SimpleCommand::execute() { m_executeFunction(); }
 //! \copydoc Command::unExecute
 void SimpleCommand::unExecute() { m_unExecuteFunction(); }
 
+//! \copydoc Command::byteSize
+std::size_t SimpleCommand::byteSize() const
+{
+  // what the functions capture can't be seen, so only count the functions.
+  return sizeof(*this);
+}
+
 } // namespace CapEngine
@@ -17,6 +17,7 @@ public:
 
   void execute() override;
   void unExecute() override;
+  std::size_t byteSize() const override;
 
 private:
   std::function<void()> m_executeFunction;
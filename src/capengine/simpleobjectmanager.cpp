@@ -1,20 +1,21 @@
 #include "simpleobjectmanager.h"
 #include "CapEngineException.h"
 #include "collision.h"
-
-#include <iostream>
+#include "objectpool.h"
 
 namespace CapEngine
 {
 
 //! Gets the game objects held by this object manager.
 /**
+   Objects must be added and removed through the object manager, not through
+   the returned vector.
    \return
   The objects.
 */
 std::vector<std::shared_ptr<GameObject>> &SimpleObjectManager::getObjects()
 {
-    return m_objects;
+    return m_objects.values();
 }
 
 //! Gets any objects that intersect a rectangle.
@@ -40,6 +41,67 @@ std::vector<std::shared_ptr<GameObject>>
     return ret;
 }
 
+//! Calls a function for each object that intersects a rectangle.
+/**
+ \param in_rectangle
+   The rectangle.
+ \param in_func
+   The function to call with each intersecting object.
+*/
+void SimpleObjectManager::forEachObject(const Rectangle &in_rectangle,
+                                        FunctionRef<void(GameObject &)> in_func)
+{
+    for (auto &&pObject : m_objects) {
+        CAP_THROW_NULL(pObject, "Object is null");
+        Relation relation = MBRRelate(pObject->boundingPolygon(), in_rectangle);
+        if (relation == TOUCH || relation == INSIDE) {
+            in_func(*pObject);
+        }
+    }
+}
+
+//! Resolves a handle to an object.
+/**
+ \param in_handle
+   The handle.
+ \return
+   The object or nullptr if it has been removed.
+*/
+GameObject *SimpleObjectManager::getObject(ObjectHandle in_handle)
+{
+    std::shared_ptr<GameObject> *ppObject = m_objects.get(in_handle);
+    return ppObject != nullptr ? ppObject->get() : nullptr;
+}
+
+//! Looks up an object by id.
+/**
+ \param in_objectId
+   The id.
+ \return
+   The object or nullptr if there isn't one.
+*/
+GameObject *SimpleObjectManager::findObject(ObjectID in_objectId)
+{
+    return this->getObject(this->getHandle(in_objectId));
+}
+
+//! Gets the handle of an object.
+/**
+ \param in_objectId
+   The id of the object.
+ \return
+   The handle or a null handle if there is no such object.
+*/
+ObjectHandle SimpleObjectManager::getHandle(ObjectID in_objectId) const
+{
+    auto it = m_handles.find(in_objectId);
+    if (it == m_handles.end() || !m_objects.contains(it->second)) {
+        return ObjectHandle{};
+    }
+
+    return it->second;
+}
+
 //! Returns a vector of collisions if there are any.
 /**
  \return
@@ -48,28 +110,23 @@ std::vector<std::shared_ptr<GameObject>>
 std::vector<CollisionEvent> SimpleObjectManager::getCollisions() const
 {
     std::vector<CollisionEvent> collisions;
-    auto currentObject = this->m_objects.begin();
-
-    if (currentObject != m_objects.end()) {
-        CAP_THROW_ASSERT(*currentObject != nullptr, "currentObject is null.");
-        while (currentObject != this->m_objects.end()) {
-            // compare this object with the rest of the objects
-            auto otherObject = currentObject++;
-            while (otherObject != this->m_objects.end()) {
-                CAP_THROW_ASSERT(*otherObject != nullptr,
-                                 "otherObject is null.");
-
-                CollisionType collisionType =
-                    detectMBRCollision((*currentObject)->boundingPolygon(),
-                                       (*otherObject)->boundingPolygon());
-
-                if (collisionType != CollisionType::COLLISION_NONE) {
-                    collisions.push_back(CollisionEvent{
-                        *currentObject, *otherObject, collisionType,
-                        CollisionClass::COLLISION_ENTITY});
-                }
-
-                otherObject++;
+    const auto &objects = m_objects.values();
+
+    for (std::size_t i = 0; i < objects.size(); i++) {
+        CAP_THROW_ASSERT(objects[i] != nullptr, "currentObject is null.");
+
+        // compare this object with the rest of the objects
+        for (std::size_t j = i + 1; j < objects.size(); j++) {
+            CAP_THROW_ASSERT(objects[j] != nullptr, "otherObject is null.");
+
+            CollisionType collisionType = detectMBRCollision(
+                objects[i]->boundingPolygon(), objects[j]->boundingPolygon());
+
+            if (collisionType != CollisionType::COLLISION_NONE) {
+                collisions.push_back(CollisionEvent{
+                    m_objects.handleAt(i), m_objects.handleAt(j),
+                    objects[i]->getObjectID(), objects[j]->getObjectID(),
+                    collisionType, CollisionClass::COLLISION_ENTITY});
             }
         }
     }
@@ -81,22 +138,49 @@ std::vector<CollisionEvent> SimpleObjectManager::getCollisions() const
 /**
  \param in_pObject
    \li The object to add.
+ \return
+   A handle that stays valid until the object is removed.
 */
-void SimpleObjectManager::addObject(std::shared_ptr<GameObject> in_pObject)
+ObjectHandle SimpleObjectManager::addObject(std::shared_ptr<GameObject> in_pObject)
 {
-    m_objects.push_back(std::move(in_pObject));
+    CAP_THROW_NULL(in_pObject, "Cannot add a null object");
+
+    const ObjectID objectId = in_pObject->getObjectID();
+    ObjectHandle handle = m_objects.insert(std::move(in_pObject));
+    m_handles[objectId] = handle;
+
+    return handle;
 }
 
 /**
  * @brief Deletes dead objects.
+ *
+ * Dead objects that came from an ObjectPool are returned to it instead. The
+ * last object is moved into the place of each removed one.
  */
 void SimpleObjectManager::removeDeadObjects()
 {
-    const auto newEnd = std::remove_if(
-        m_objects.begin(), m_objects.end(), [](const auto &object) {
-            return object->getObjectState() == GameObject::Dead;
-        });
-    m_objects.erase(newEnd, m_objects.end());
+    auto &objects = m_objects.values();
+
+    // walk backwards so that objects moved into a hole have already been seen
+    for (std::size_t i = objects.size(); i-- > 0;) {
+        if (objects[i]->getObjectState() != GameObject::Dead) {
+            continue;
+        }
+
+        const ObjectHandle handle = m_objects.handleAt(i);
+        std::shared_ptr<GameObject> pObject = std::move(objects[i]);
+        m_objects.erase(handle);
+
+        auto it = m_handles.find(pObject->getObjectID());
+        if (it != m_handles.end() && it->second == handle) {
+            m_handles.erase(it);
+        }
+
+        if (ObjectPool *pPool = pObject->getPool(); pPool != nullptr) {
+            pPool->release(std::move(pObject));
+        }
+    }
 }
 
 } // namespace CapEngine
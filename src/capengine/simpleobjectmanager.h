@@ -4,6 +4,9 @@
 #include "collision.h"
 #include "gameobject.h"
 #include "objectmanager.h"
+#include "slotmap.h"
+
+#include <unordered_map>
 
 namespace CapEngine
 {
@@ -15,15 +18,23 @@ class SimpleObjectManager final : public ObjectManager
     std::vector<std::shared_ptr<GameObject>> &getObjects() override;
     std::vector<std::shared_ptr<GameObject>>
         getObjects(const Rectangle &in_rectangle) override;
+    void forEachObject(const Rectangle &in_rectangle,
+                       FunctionRef<void(GameObject &)> in_func) override;
+
+    GameObject *getObject(ObjectHandle in_handle) override;
+    GameObject *findObject(ObjectID in_objectId) override;
+    ObjectHandle getHandle(ObjectID in_objectId) const override;
 
     std::vector<CollisionEvent> getCollisions() const override;
 
-    void addObject(std::shared_ptr<GameObject> in_pObject) override;
+    ObjectHandle addObject(std::shared_ptr<GameObject> in_pObject) override;
     void removeDeadObjects() override;
 
   private:
-    //! Holds the objects
-    std::vector<std::shared_ptr<GameObject>> m_objects;
+    //! Holds the objects packed for iteration
+    SlotMap<std::shared_ptr<GameObject>, GameObject> m_objects;
+    //! The handle of each object by the id it was added with
+    std::unordered_map<ObjectID, ObjectHandle> m_handles;
 };
 
 } // namespace CapEngine
@@ -0,0 +1,263 @@
+#ifndef CAPENGINE_SLOTMAP_H
+#define CAPENGINE_SLOTMAP_H
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace CapEngine {
+
+//! A generational reference into a SlotMap.
+/**
+   Packs a 32 bit slot index and a 32 bit generation into 64 bits.  The
+   generation changes each time a slot is reused so handles to erased values
+   are detected rather than silently resolving to whatever took their place.
+   Tag only exists to stop handles for different types being mixed up.
+*/
+template <typename Tag>
+class Handle {
+   public:
+    constexpr Handle() = default;
+    constexpr Handle(uint32_t in_index, uint32_t in_generation)
+        : m_value((static_cast<uint64_t>(in_generation) << 32) | in_index)
+    {
+    }
+
+    [[nodiscard]] constexpr uint32_t index() const
+    {
+        return static_cast<uint32_t>(m_value);
+    }
+    [[nodiscard]] constexpr uint32_t generation() const
+    {
+        return static_cast<uint32_t>(m_value >> 32);
+    }
+    [[nodiscard]] constexpr uint64_t value() const
+    {
+        return m_value;
+    }
+    [[nodiscard]] constexpr bool isNull() const
+    {
+        return m_value == kNullValue;
+    }
+
+    constexpr bool operator==(const Handle&) const = default;
+
+   private:
+    static constexpr uint64_t kNullValue = std::numeric_limits<uint64_t>::max();
+    uint64_t m_value = kNullValue;  //!< generation in the high bits, index in the low.
+};
+
+template <typename Tag>
+std::ostream& operator<<(std::ostream& stream, const Handle<Tag>& handle)
+{
+    if (handle.isNull()) {
+        return stream << "Handle{null}";
+    }
+    return stream << "Handle{" << handle.index() << ":" << handle.generation() << "}";
+}
+
+//! Stores values densely and hands out generational handles to them.
+/**
+   Lookup through a handle is O(1) and validated.  Values live contiguously in
+   insertion order until something is erased, at which point the last value is
+   moved into the hole, so iteration is always over a packed array.
+*/
+template <typename T, typename Tag = T>
+class SlotMap {
+   public:
+    using handle_type = Handle<Tag>;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    handle_type insert(T in_value);
+    bool erase(handle_type in_handle);
+    void clear();
+
+    [[nodiscard]] T* get(handle_type in_handle);
+    [[nodiscard]] const T* get(handle_type in_handle) const;
+    [[nodiscard]] bool contains(handle_type in_handle) const;
+    [[nodiscard]] handle_type handleAt(std::size_t in_denseIndex) const;
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return m_values.size();
+    }
+    [[nodiscard]] bool empty() const
+    {
+        return m_values.empty();
+    }
+
+    //! The packed values.  Don't add or remove through this.
+    [[nodiscard]] std::vector<T>& values()
+    {
+        return m_values;
+    }
+    [[nodiscard]] const std::vector<T>& values() const
+    {
+        return m_values;
+    }
+
+    iterator begin()
+    {
+        return m_values.begin();
+    }
+    iterator end()
+    {
+        return m_values.end();
+    }
+    const_iterator begin() const
+    {
+        return m_values.begin();
+    }
+    const_iterator end() const
+    {
+        return m_values.end();
+    }
+
+   private:
+    //! Indirection from a handle index to the packed values.
+    struct Slot {
+        uint32_t denseIndex = 0;
+        uint32_t generation = 0;
+        bool occupied = false;
+    };
+
+    std::vector<T> m_values;               //!< The packed values.
+    std::vector<uint32_t> m_denseToSlot;   //!< The slot of each packed value.
+    std::vector<Slot> m_slots;             //!< Slots indexed by handle index.
+    std::vector<uint32_t> m_freeSlots;     //!< Unoccupied slots to reuse.
+};
+
+//! Adds a value.
+/**
+ \param in_value
+   The value.
+ \return
+   A handle to the value.
+*/
+template <typename T, typename Tag>
+typename SlotMap<T, Tag>::handle_type SlotMap<T, Tag>::insert(T in_value)
+{
+    uint32_t slotIndex = 0;
+    if (!m_freeSlots.empty()) {
+        slotIndex = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else {
+        slotIndex = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+
+    Slot& slot = m_slots[slotIndex];
+    slot.denseIndex = static_cast<uint32_t>(m_values.size());
+    slot.occupied = true;
+
+    m_values.push_back(std::move(in_value));
+    m_denseToSlot.push_back(slotIndex);
+
+    return handle_type{slotIndex, slot.generation};
+}
+
+//! Removes a value.
+/**
+ The last value is moved into its place.
+ \param in_handle
+   The handle of the value.
+ \return
+   false if the handle was stale or null.
+*/
+template <typename T, typename Tag>
+bool SlotMap<T, Tag>::erase(handle_type in_handle)
+{
+    if (!this->contains(in_handle)) {
+        return false;
+    }
+
+    Slot& slot = m_slots[in_handle.index()];
+    const uint32_t denseIndex = slot.denseIndex;
+    const uint32_t lastIndex = static_cast<uint32_t>(m_values.size() - 1);
+
+    if (denseIndex != lastIndex) {
+        m_values[denseIndex] = std::move(m_values[lastIndex]);
+        m_denseToSlot[denseIndex] = m_denseToSlot[lastIndex];
+        m_slots[m_denseToSlot[denseIndex]].denseIndex = denseIndex;
+    }
+
+    m_values.pop_back();
+    m_denseToSlot.pop_back();
+
+    slot.occupied = false;
+    slot.generation++;
+    m_freeSlots.push_back(in_handle.index());
+
+    return true;
+}
+
+//! Removes all values, invalidating every handle.
+template <typename T, typename Tag>
+void SlotMap<T, Tag>::clear()
+{
+    for (uint32_t slotIndex : m_denseToSlot) {
+        m_slots[slotIndex].occupied = false;
+        m_slots[slotIndex].generation++;
+        m_freeSlots.push_back(slotIndex);
+    }
+
+    m_values.clear();
+    m_denseToSlot.clear();
+}
+
+//! Resolves a handle.
+/**
+ \param in_handle
+   The handle.
+ \return
+   The value or nullptr if the handle is stale or null.
+*/
+template <typename T, typename Tag>
+T* SlotMap<T, Tag>::get(handle_type in_handle)
+{
+    return this->contains(in_handle) ? &m_values[m_slots[in_handle.index()].denseIndex] : nullptr;
+}
+
+//! \copydoc SlotMap::get
+template <typename T, typename Tag>
+const T* SlotMap<T, Tag>::get(handle_type in_handle) const
+{
+    return this->contains(in_handle) ? &m_values[m_slots[in_handle.index()].denseIndex] : nullptr;
+}
+
+//! Checks that a handle refers to a value.
+template <typename T, typename Tag>
+bool SlotMap<T, Tag>::contains(handle_type in_handle) const
+{
+    if (in_handle.isNull() || in_handle.index() >= m_slots.size()) {
+        return false;
+    }
+
+    const Slot& slot = m_slots[in_handle.index()];
+    return slot.occupied && slot.generation == in_handle.generation();
+}
+
+//! Gets the handle of a packed value.
+/**
+ \param in_denseIndex
+   The position of the value in values().
+ \return
+   The handle.
+*/
+template <typename T, typename Tag>
+typename SlotMap<T, Tag>::handle_type SlotMap<T, Tag>::handleAt(std::size_t in_denseIndex) const
+{
+    assert(in_denseIndex < m_denseToSlot.size());
+
+    const uint32_t slotIndex = m_denseToSlot[in_denseIndex];
+    return handle_type{slotIndex, m_slots[slotIndex].generation};
+}
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_SLOTMAP_H
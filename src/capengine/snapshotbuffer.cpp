@@ -0,0 +1,268 @@
+#include "snapshotbuffer.h"
+
+#include "CapEngineException.h"
+#include "serialization.h"
+
+#include <cassert>
+#include <utility>
+
+namespace CapEngine {
+
+namespace {
+
+//! Writes every object as [id, size, state].
+void serializeObjects(ObjectManager& in_objectManager, std::vector<std::byte>& out_bytes)
+{
+    out_bytes.clear();
+    ByteWriter writer{out_bytes};
+
+    auto& objects = in_objectManager.getObjects();
+    writer.write(static_cast<uint32_t>(objects.size()));
+
+    for (auto&& pObject : objects) {
+        CAP_THROW_NULL(pObject, "Object in objectmanager is null");
+
+        writer.write(pObject->getObjectID());
+        const std::size_t sizeOffset = writer.size();
+        writer.write(uint32_t{0});
+
+        pObject->serialize(writer);
+        writer.patch(sizeOffset, static_cast<uint32_t>(writer.size() - sizeOffset - sizeof(uint32_t)));
+    }
+}
+
+//! Restores objects from bytes written by serializeObjects().
+void deserializeObjects(const std::vector<std::byte>& in_bytes, ObjectManager& io_objectManager)
+{
+    ByteReader reader{in_bytes};
+
+    const auto objectCount = reader.read<uint32_t>();
+    for (uint32_t i = 0; i < objectCount; i++) {
+        const auto objectId = reader.read<ObjectID>();
+        const auto size = reader.read<uint32_t>();
+        auto state = reader.readBytes(size);
+
+        if (GameObject* pObject = io_objectManager.findObject(objectId); pObject != nullptr) {
+            ByteReader objectReader{state};
+            pObject->deserialize(objectReader);
+        }
+    }
+}
+
+//! Byte at an index, or zero past the end.
+std::byte byteAt(const std::vector<std::byte>& in_bytes, std::size_t in_index)
+{
+    return in_index < in_bytes.size() ? in_bytes[in_index] : std::byte{0};
+}
+
+//! Encodes in_target as runs of bytes that differ from in_reference.
+/**
+   The encoding is the target size followed by (unchanged count, changed count,
+   changed bytes xor reference) runs.
+*/
+void encodeDelta(const std::vector<std::byte>& in_target, const std::vector<std::byte>& in_reference,
+                 std::vector<std::byte>& out_delta)
+{
+    out_delta.clear();
+    ByteWriter writer{out_delta};
+    writer.write(static_cast<uint32_t>(in_target.size()));
+
+    std::size_t i = 0;
+    while (i < in_target.size()) {
+        const std::size_t unchangedStart = i;
+        while (i < in_target.size() && in_target[i] == byteAt(in_reference, i)) {
+            i++;
+        }
+        const std::size_t changedStart = i;
+        while (i < in_target.size() && in_target[i] != byteAt(in_reference, i)) {
+            i++;
+        }
+
+        writer.write(static_cast<uint32_t>(changedStart - unchangedStart));
+        writer.write(static_cast<uint32_t>(i - changedStart));
+        for (std::size_t j = changedStart; j < i; j++) {
+            writer.write(in_target[j] ^ byteAt(in_reference, j));
+        }
+    }
+}
+
+//! Reverses encodeDelta().
+void decodeDelta(const std::vector<std::byte>& in_delta, const std::vector<std::byte>& in_reference,
+                 std::vector<std::byte>& out_target)
+{
+    ByteReader reader{in_delta};
+    const auto size = reader.read<uint32_t>();
+
+    out_target.resize(size);
+    std::size_t i = 0;
+    while (reader.remaining() > 0) {
+        const auto unchanged = reader.read<uint32_t>();
+        const auto changed = reader.read<uint32_t>();
+        CAP_THROW_ASSERT(i + unchanged + changed <= size, "Corrupt snapshot delta");
+
+        for (uint32_t j = 0; j < unchanged; j++, i++) {
+            out_target[i] = byteAt(in_reference, i);
+        }
+
+        auto changedBytes = reader.readBytes(changed);
+        for (uint32_t j = 0; j < changed; j++, i++) {
+            out_target[i] = changedBytes[j] ^ byteAt(in_reference, i);
+        }
+    }
+
+    CAP_THROW_ASSERT(i == size, "Corrupt snapshot delta");
+}
+
+}  // namespace
+
+//! Constructor.
+/**
+ \param in_capacity
+   The number of frames to keep.  Must be at least 1.
+*/
+SnapshotBuffer::SnapshotBuffer(std::size_t in_capacity) : m_capacity(in_capacity)
+{
+    CAP_THROW_ASSERT(in_capacity > 0, "SnapshotBuffer capacity must be at least 1");
+    m_deltas.resize(m_capacity - 1);
+}
+
+//! Captures the state of the world.
+/**
+ The oldest frame is dropped if the buffer is full.
+ \param in_frame
+   The frame number.  Must be greater than the last captured frame.
+ \param in_objectManager
+   The objects to capture.
+*/
+void SnapshotBuffer::capture(uint64_t in_frame, ObjectManager& in_objectManager)
+{
+    CAP_THROW_ASSERT(!m_latestFrame.has_value() || in_frame > *m_latestFrame,
+                     "Snapshots must be captured in frame order");
+
+    serializeObjects(in_objectManager, m_scratch);
+
+    if (m_latestFrame.has_value() && !m_deltas.empty()) {
+        if (m_deltaCount == m_deltas.size()) {
+            // drop the oldest and reuse its storage
+            m_head = (m_head + 1) % m_deltas.size();
+            m_deltaCount--;
+        }
+
+        Delta& delta = this->deltaAt(m_deltaCount);
+        delta.frame = *m_latestFrame;
+        encodeDelta(m_latest, m_scratch, delta.bytes);
+        m_deltaCount++;
+    }
+
+    std::swap(m_latest, m_scratch);
+    m_latestFrame = in_frame;
+}
+
+//! Restores the world to a captured frame.
+/**
+ \param in_frame
+   The frame number.
+ \param io_objectManager
+   The objects to restore.
+ \return
+   false if the frame is not in the buffer.
+*/
+bool SnapshotBuffer::restore(uint64_t in_frame, ObjectManager& io_objectManager)
+{
+    if (!this->contains(in_frame)) {
+        return false;
+    }
+
+    // walk back from the newest frame, each delta being relative to the frame
+    // after it
+    while (*m_latestFrame != in_frame) {
+        assert(m_deltaCount > 0);
+        Delta& delta = this->deltaAt(m_deltaCount - 1);
+
+        decodeDelta(delta.bytes, m_latest, m_decoded);
+        std::swap(m_latest, m_decoded);
+        m_latestFrame = delta.frame;
+        m_deltaCount--;
+    }
+
+    deserializeObjects(m_latest, io_objectManager);
+    return true;
+}
+
+//! Discards all frames.
+void SnapshotBuffer::clear()
+{
+    m_head = 0;
+    m_deltaCount = 0;
+    m_latestFrame.reset();
+    m_latest.clear();
+}
+
+//! Checks if a frame can be restored.
+bool SnapshotBuffer::contains(uint64_t in_frame) const
+{
+    if (m_latestFrame == in_frame) {
+        return true;
+    }
+
+    for (std::size_t i = 0; i < m_deltaCount; i++) {
+        if (this->deltaAt(i).frame == in_frame) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//! Gets the oldest frame that can be restored.
+std::optional<uint64_t> SnapshotBuffer::oldestFrame() const
+{
+    if (m_deltaCount > 0) {
+        return this->deltaAt(0).frame;
+    }
+
+    return m_latestFrame;
+}
+
+//! Gets the newest frame that can be restored.
+std::optional<uint64_t> SnapshotBuffer::latestFrame() const
+{
+    return m_latestFrame;
+}
+
+//! Gets the number of frames that can be restored.
+std::size_t SnapshotBuffer::size() const
+{
+    return m_latestFrame.has_value() ? m_deltaCount + 1 : 0;
+}
+
+//! Gets the most frames the buffer holds.
+std::size_t SnapshotBuffer::capacity() const
+{
+    return m_capacity;
+}
+
+//! Gets the number of bytes the stored frames take up.
+std::size_t SnapshotBuffer::bytesUsed() const
+{
+    std::size_t bytes = m_latest.size();
+    for (std::size_t i = 0; i < m_deltaCount; i++) {
+        bytes += this->deltaAt(i).bytes.size();
+    }
+
+    return bytes;
+}
+
+//! Gets a delta by age, 0 being the oldest.
+SnapshotBuffer::Delta& SnapshotBuffer::deltaAt(std::size_t in_index)
+{
+    return m_deltas[(m_head + in_index) % m_deltas.size()];
+}
+
+//! \copydoc SnapshotBuffer::deltaAt
+const SnapshotBuffer::Delta& SnapshotBuffer::deltaAt(std::size_t in_index) const
+{
+    return m_deltas[(m_head + in_index) % m_deltas.size()];
+}
+
+}  // namespace CapEngine
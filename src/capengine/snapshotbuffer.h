@@ -0,0 +1,65 @@
+#ifndef CAPENGINE_SNAPSHOTBUFFER_H
+#define CAPENGINE_SNAPSHOTBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "objectmanager.h"
+
+namespace CapEngine {
+
+//! Ring buffer of world snapshots for rollback and replay.
+/**
+   Each capture serialises every object (see GameObject::serialize) into a
+   binary frame.  Only the newest frame is kept whole.  Older frames are
+   stored as run length encoded differences from the frame after them, which
+   are mostly zero when little has changed, so restoring a frame n captures
+   back decodes n deltas.
+
+   Restoring writes the saved state into the objects that still exist.
+   Objects spawned or removed since the frame are not added or removed.
+   Frames newer than the restored frame are discarded, ready to be captured
+   again as the world is resimulated.
+*/
+class SnapshotBuffer final {
+   public:
+    explicit SnapshotBuffer(std::size_t in_capacity = kDefaultCapacity);
+
+    void capture(uint64_t in_frame, ObjectManager& in_objectManager);
+    bool restore(uint64_t in_frame, ObjectManager& io_objectManager);
+    void clear();
+
+    [[nodiscard]] bool contains(uint64_t in_frame) const;
+    [[nodiscard]] std::optional<uint64_t> oldestFrame() const;
+    [[nodiscard]] std::optional<uint64_t> latestFrame() const;
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] std::size_t capacity() const;
+    [[nodiscard]] std::size_t bytesUsed() const;
+
+    static constexpr std::size_t kDefaultCapacity = 16;
+
+   private:
+    //! An older frame stored as a difference from the frame after it.
+    struct Delta {
+        uint64_t frame = 0;
+        std::vector<std::byte> bytes;
+    };
+
+    [[nodiscard]] Delta& deltaAt(std::size_t in_index);
+    [[nodiscard]] const Delta& deltaAt(std::size_t in_index) const;
+
+    std::size_t m_capacity;              //!< The most frames held, including the newest.
+    std::vector<Delta> m_deltas;         //!< Ring of older frames, oldest at m_head.
+    std::size_t m_head = 0;              //!< The index of the oldest delta.
+    std::size_t m_deltaCount = 0;        //!< The number of deltas in use.
+    std::optional<uint64_t> m_latestFrame;  //!< The frame number of m_latest.
+    std::vector<std::byte> m_latest;     //!< The newest frame, whole.
+    std::vector<std::byte> m_scratch;    //!< Reused while capturing and restoring.
+    std::vector<std::byte> m_decoded;    //!< Reused while restoring.
+};
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_SNAPSHOTBUFFER_H
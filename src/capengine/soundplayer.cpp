@@ -29,6 +29,10 @@ SoundPlayer::SoundPlayer() : idCounter(0)
     targetFormat.channels = CHANNELS;
     targetFormat.callback = (void (*)(void*, unsigned char*, int)) & audioCallback;
 
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+        throw CapEngineException(std::string("Couldn't initialize audio: ") + SDL_GetError());
+    }
+
     if (SDL_OpenAudio(&targetFormat, &this->audioFormat) < 0) {
         ostringstream errorMsg;
         errorMsg << "Couldn't open audio: " << SDL_GetError();
@@ -0,0 +1,109 @@
+#include "stringinterner.h"
+
+#include "CapEngineException.h"
+
+#include <mutex>
+
+namespace CapEngine {
+
+//! Interns a string.
+/**
+ \param in_string
+   The string.
+*/
+StringId::StringId(std::string_view in_string) : m_id(StringInterner::getInstance().intern(in_string).m_id) {}
+
+//! Gets the interned string.
+/**
+ \return
+   The string.  Valid for the life of the program.
+*/
+std::string_view StringId::str() const
+{
+    return StringInterner::getInstance().lookup(*this);
+}
+
+//! Gets the global interner.
+StringInterner& StringInterner::getInstance()
+{
+    static StringInterner interner;
+    return interner;
+}
+
+//! Constructor.
+StringInterner::StringInterner()
+{
+    // id 0 is the empty string so that a default StringId is valid
+    m_strings.emplace_back();
+    m_ids.emplace(m_strings.back(), 0);
+}
+
+//! Interns a string.
+/**
+ \param in_string
+   The string.
+ \return
+   The id of the string.  The same string always gets the same id.
+*/
+StringId StringInterner::intern(std::string_view in_string)
+{
+    {
+        std::shared_lock lock{m_mutex};
+        if (auto it = m_ids.find(in_string); it != m_ids.end()) {
+            return StringId{it->second};
+        }
+    }
+
+    std::unique_lock lock{m_mutex};
+    // another thread may have added it while unlocked
+    if (auto it = m_ids.find(in_string); it != m_ids.end()) {
+        return StringId{it->second};
+    }
+
+    const auto id = static_cast<uint32_t>(m_strings.size());
+    m_strings.emplace_back(in_string);
+    m_ids.emplace(m_strings.back(), id);
+
+    return StringId{id};
+}
+
+//! Gets the id of a string without interning it.
+/**
+ \param in_string
+   The string.
+ \return
+   The id of the string, or std::nullopt if it has never been interned.
+*/
+std::optional<StringId> StringInterner::find(std::string_view in_string) const
+{
+    std::shared_lock lock{m_mutex};
+    if (auto it = m_ids.find(in_string); it != m_ids.end()) {
+        return StringId{it->second};
+    }
+
+    return std::nullopt;
+}
+
+//! Gets an interned string.
+/**
+ \param in_id
+   The id of the string.
+ \return
+   The string.
+*/
+std::string_view StringInterner::lookup(StringId in_id) const
+{
+    std::shared_lock lock{m_mutex};
+    CAP_THROW_ASSERT(in_id.id() < m_strings.size(), "Unknown string id");
+
+    return m_strings[in_id.id()];
+}
+
+//! Gets the number of interned strings.
+std::size_t StringInterner::size() const
+{
+    std::shared_lock lock{m_mutex};
+    return m_strings.size();
+}
+
+}  // namespace CapEngine
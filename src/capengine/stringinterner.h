@@ -0,0 +1,72 @@
+#ifndef CAPENGINE_STRINGINTERNER_H
+#define CAPENGINE_STRINGINTERNER_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace CapEngine {
+
+//! An interned string.
+/**
+   Comparing and hashing is on the id, so it is as cheap as an integer.
+   Ids are only meaningful within one run of the program.
+*/
+class StringId {
+   public:
+    constexpr StringId() = default;
+    explicit StringId(std::string_view in_string);
+
+    [[nodiscard]] constexpr uint32_t id() const
+    {
+        return m_id;
+    }
+    [[nodiscard]] std::string_view str() const;
+
+    constexpr auto operator<=>(const StringId&) const = default;
+
+   private:
+    friend class StringInterner;
+    constexpr explicit StringId(uint32_t in_id) : m_id(in_id) {}
+
+    uint32_t m_id = 0;  //!< 0 is the empty string.
+};
+
+//! Global table of interned strings.
+/**
+   Strings are never removed, so views returned by lookup() stay valid for the
+   life of the program.  Safe to use from multiple threads.
+*/
+class StringInterner final {
+   public:
+    static StringInterner& getInstance();
+
+    StringId intern(std::string_view in_string);
+    [[nodiscard]] std::optional<StringId> find(std::string_view in_string) const;
+    [[nodiscard]] std::string_view lookup(StringId in_id) const;
+    [[nodiscard]] std::size_t size() const;
+
+   private:
+    StringInterner();
+
+    mutable std::shared_mutex m_mutex;
+    std::deque<std::string> m_strings;                    //!< Indexed by id.  A deque so elements don't move.
+    std::unordered_map<std::string_view, uint32_t> m_ids;  //!< Views into m_strings.
+};
+
+}  // namespace CapEngine
+
+template <>
+struct std::hash<CapEngine::StringId> {
+    std::size_t operator()(const CapEngine::StringId& in_id) const noexcept
+    {
+        return std::hash<uint32_t>{}(in_id.id());
+    }
+};
+
+#endif  // CAPENGINE_STRINGINTERNER_H
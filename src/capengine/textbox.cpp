@@ -98,6 +98,7 @@ void TextBox::setPosition(int x, int y)
 	m_rect.y = y;
 	m_textRect = {0, 0, 0, 0};
 	m_textureDirty = true;
+	this->invalidate();
 }
 
 //! \copydoc Widget::setSize
@@ -107,6 +108,7 @@ void TextBox::setSize(int width, int height)
 	m_rect.h = height;
 	m_textRect = {0, 0, 0, 0};
 	m_textureDirty = true;
+	this->invalidate();
 }
 
 //! \copydoc Widget::update
@@ -116,6 +118,8 @@ void TextBox::update(double ms)
 	if (m_cursorTimerMs + ms >= kCursorBlinkTime)
 	{
 		m_cursorState = !m_cursorState;
+		// the cursor is only drawn with focus
+		if (m_hasFocus) this->invalidate();
 		m_cursorTimerMs =
 			(m_cursorTimerMs + static_cast<unsigned int>(ms + 0.5)) %
 			kCursorBlinkTime;
@@ -213,6 +217,7 @@ bool TextBox::doFocus(bool focus, int downX, int downY, int upX, int upY)
             assert(!SDL_IsTextInputActive());
 
             m_hasFocus = false;
+            this->invalidate();
         }
 
         return false;
@@ -228,6 +233,7 @@ bool TextBox::doFocus(bool focus, int downX, int downY, int upX, int upY)
                 m_hasFocus = true;
                 m_cursorTimerMs = 0;
                 m_cursorState = false;
+                this->invalidate();
             }
 
             return true;
@@ -491,6 +497,7 @@ void TextBox::handleMouseButtonEvent(SDL_MouseButtonEvent event)
             // set the current cursor position
             m_cursorPosition = currentCursorPosition;
             m_lastMouseDownPosition = std::nullopt;
+            this->invalidate();
         }
     }
 }
@@ -506,6 +513,7 @@ void TextBox::handleKeyboardEvent(SDL_KeyboardEvent event)
 		if (handler != m_keyPressHandlers.end())
 		{
 			handler->second(event);
+			this->invalidate();
 		}
 	}
 }
@@ -522,6 +530,7 @@ void TextBox::handleTextInputEvent(SDL_TextInputEvent event)
 
 		this->insertText(event.text);
 		m_textureDirty = true;
+		this->invalidate();
 	}
 }
 
@@ -1077,6 +1086,7 @@ void TextBox::setCursorSelectStart(int pos)
 	if (m_cursorSelectStart != pos)
 	{
 		m_textureDirty = true;
+		this->invalidate();
 	}
 
 	m_cursorSelectStart = pos;
@@ -1092,6 +1102,7 @@ void TextBox::setCursorSelectEnd(int pos)
 	if (m_cursorSelectEnd != pos)
 	{
 		m_textureDirty = true;
+		this->invalidate();
 	}
 
 	m_cursorSelectEnd = pos;
@@ -49,7 +49,7 @@ TextButton::TextButton(Uint32 windowID, std::string text, std::string font,
     // Locator::eventDispatcher->subscribe(this, mouseEvent);
     // IEventSubscriber::subscribe(Locator::eventDispatcher, mouseEvent);
     assert(Locator::eventSubscriber != nullptr);
-    Locator::eventSubscriber->m_mouseButtonEventSignal.connect(
+    m_mouseButtonEventConnection = Locator::eventSubscriber->m_mouseButtonEventSignal.connect(
         std::bind(&TextButton::receiveEvent, this, std::placeholders::_1));
 }
 
@@ -1,14 +1,13 @@
 #ifndef TEXTBUTTON_H
 #define TEXTBUTTON_H
 
-#include <boost/signals2.hpp>
-#include <boost/signals2/connection.hpp>
 #include <string>
 
 #include "IEventSubscriber.h"
 #include "button.h"
 #include "captypes.h"
 #include "colour.h"
+#include "delegatesignal.h"
 
 namespace CapEngine {
 
@@ -59,7 +58,7 @@ class TextButton : public Button {
     // void (*m_callback)(void *);
     std::function<void()> m_callback;
     void* m_context;
-    boost::signals2::scoped_connection m_mouseButtonEventConnection;
+    ScopedConnection m_mouseButtonEventConnection;
 
    protected:
     bool mouseInButton(CapEngine::Vector position);
@@ -0,0 +1,76 @@
+#include "threadpool.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace CapEngine {
+
+//! Starts the workers.
+/**
+ \param in_threadCount
+   The number of workers.  Must be at least 1.
+*/
+ThreadPool::ThreadPool(std::size_t in_threadCount)
+{
+    assert(in_threadCount > 0);
+
+    m_workers.reserve(in_threadCount);
+    for (std::size_t i = 0; i < in_threadCount; ++i) {
+        m_workers.emplace_back([this]() { this->run(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::scoped_lock lock{m_mutex};
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+
+    for (auto&& worker : m_workers) {
+        worker.join();
+    }
+}
+
+//! Returns the number of workers.
+std::size_t ThreadPool::threadCount() const
+{
+    return m_workers.size();
+}
+
+//! Returns the number of jobs waiting for a worker.
+std::size_t ThreadPool::pendingCount() const
+{
+    std::scoped_lock lock{m_mutex};
+    return m_queue.size();
+}
+
+//! Returns one less than the hardware thread count, leaving a core for the main thread.
+std::size_t ThreadPool::defaultThreadCount()
+{
+    const std::size_t hardwareThreads = std::thread::hardware_concurrency();
+    return std::max<std::size_t>(1, hardwareThreads > 0 ? hardwareThreads - 1 : 1);
+}
+
+//! The body of each worker.
+void ThreadPool::run()
+{
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock lock{m_mutex};
+            m_wake.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+            if (m_stopping) {
+                return;
+            }
+
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        job();
+    }
+}
+
+}  // namespace CapEngine
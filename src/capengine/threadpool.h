@@ -0,0 +1,78 @@
+#ifndef CAPENGINE_THREADPOOL_H
+#define CAPENGINE_THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace CapEngine {
+
+//! A fixed set of worker threads that run submitted jobs in FIFO order.
+/**
+   Jobs must not touch SDL video or the renderer, since those belong to the
+   thread that created the window.  Exceptions thrown by a job are stored in its
+   future and rethrown from get().
+
+   The destructor lets running jobs finish but drops any that haven't started,
+   whose futures then throw std::future_error.
+*/
+class ThreadPool final {
+   public:
+    explicit ThreadPool(std::size_t in_threadCount = defaultThreadCount());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template <typename F>
+    auto submit(F&& in_job) -> std::future<std::invoke_result_t<std::decay_t<F>>>;
+
+    [[nodiscard]] std::size_t threadCount() const;
+    [[nodiscard]] std::size_t pendingCount() const;
+
+    static std::size_t defaultThreadCount();
+
+   private:
+    void run();
+
+    mutable std::mutex m_mutex;                 //!< Guards the queue and m_stopping.
+    std::condition_variable m_wake;             //!< Signalled when a job is queued or the pool stops.
+    std::deque<std::function<void()>> m_queue;  //!< Jobs that no worker has taken yet.
+    std::vector<std::thread> m_workers;         //!< The worker threads.
+    bool m_stopping = false;                    //!< Set by the destructor.
+};
+
+//! Queues a job.
+/**
+ \param in_job
+   A callable taking no arguments.
+ \return
+   A future for the job's result.
+*/
+template <typename F>
+auto ThreadPool::submit(F&& in_job) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+{
+    using Result = std::invoke_result_t<std::decay_t<F>>;
+
+    // std::function needs a copyable target, so the task is shared.
+    auto pTask = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(in_job));
+    std::future<Result> future = pTask->get_future();
+    {
+        std::scoped_lock lock{m_mutex};
+        m_queue.emplace_back([pTask]() { (*pTask)(); });
+    }
+    m_wake.notify_one();
+
+    return future;
+}
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_THREADPOOL_H
@@ -0,0 +1,332 @@
+#include "tilecollisiongrid.h"
+
+#include "CapEngineException.h"
+#include "tiledmap.h"
+#include "tiledtilelayer.h"
+#include "tiledtileset.h"
+
+#include <algorithm>
+#include <bit>
+#include <boost/throw_exception.hpp>
+#include <cmath>
+#include <fstream>
+
+namespace CapEngine {
+
+namespace {
+
+constexpr int kBitsPerWord = 64;
+
+}  // namespace
+
+//! Constructor.  All tiles start empty.
+/**
+ \param in_columns
+   The width of the map in tiles.
+ \param in_rows
+   The height of the map in tiles.
+ \param in_tileWidth
+   The width of a tile.
+ \param in_tileHeight
+   The height of a tile.
+*/
+TileCollisionGrid::TileCollisionGrid(int in_columns, int in_rows, int in_tileWidth, int in_tileHeight)
+    : m_columns(in_columns),
+      m_rows(in_rows),
+      m_tileWidth(in_tileWidth),
+      m_tileHeight(in_tileHeight),
+      m_wordsPerRow((in_columns + kBitsPerWord - 1) / kBitsPerWord)
+{
+    CAP_THROW_ASSERT(in_columns >= 0 && in_rows >= 0, "Grid size cannot be negative");
+    CAP_THROW_ASSERT(in_tileWidth > 0 && in_tileHeight > 0, "Tile size must be positive");
+
+    m_bits.resize(static_cast<std::size_t>(m_wordsPerRow) * m_rows, 0);
+}
+
+//! Builds a grid from a Tiled map.
+/**
+ A tile is solid if its layer or the tile itself in its tileset has the
+ "capengine-collision" property set to true.
+ \param in_map
+   The map.
+ \return
+   The grid.
+*/
+TileCollisionGrid TileCollisionGrid::fromTiledMap(const TiledMap& in_map)
+{
+    TileCollisionGrid grid{in_map.width(), in_map.height(), in_map.tileWidth(), in_map.tileHeight()};
+
+    // which tileset a global id belongs to
+    auto findTileset = [&](unsigned int in_gid) -> const TiledTileset* {
+        const TiledTileset* pFound = nullptr;
+        for (auto&& pTileset : in_map.tilesets()) {
+            if (static_cast<unsigned int>(pTileset->firstGid()) <= in_gid &&
+                (pFound == nullptr || pTileset->firstGid() > pFound->firstGid())) {
+                pFound = pTileset.get();
+            }
+        }
+        return pFound;
+    };
+
+    for (auto&& layer : in_map.layers()) {
+        grid.markLayer(layer.data(), layer.width(), layer.height(), layer.collides(), [&](unsigned int in_gid) {
+            const TiledTileset* pTileset = findTileset(in_gid);
+            return pTileset != nullptr && pTileset->isSolid(in_gid);
+        });
+    }
+
+    return grid;
+}
+
+//! Builds a grid from the json of a Tiled map.
+/**
+ Only reads what is needed to know which tiles are solid, so unlike
+ fromTiledMap() no textures are created and the tileset images aren't
+ loaded.
+ \param in_map
+   The map json.
+ \param in_path
+   The path of the map, for finding external tilesets.
+ \return
+   The grid.
+*/
+TileCollisionGrid TileCollisionGrid::fromTiledJson(const jsoncons::json& in_map,
+                                                   const std::optional<std::filesystem::path>& in_path)
+{
+    TileCollisionGrid grid{in_map["width"].as<int>(), in_map["height"].as<int>(), in_map["tilewidth"].as<int>(),
+                           in_map["tileheight"].as<int>()};
+
+    // the solid tiles of each tileset
+    struct Tileset {
+        unsigned int firstGid;
+        std::vector<int> solidTiles;
+    };
+
+    std::vector<Tileset> tilesets;
+    for (auto&& tileset : in_map["tilesets"].array_range()) {
+        if (!tileset.contains("firstgid")) {
+            BOOST_THROW_EXCEPTION(CapEngineException{"tileset missing firstGid property"});
+        }
+        const auto firstGid = tileset["firstgid"].as<unsigned int>();
+
+        if (tileset.contains("source")) {
+            std::filesystem::path tilesetPath = tileset["source"].as<std::string>();
+            if (in_path) {
+                tilesetPath = in_path->parent_path() / tilesetPath;
+            }
+
+            std::ifstream f{tilesetPath};
+            tilesets.push_back(Tileset{firstGid, readTiledSolidTiles(jsoncons::json::parse(f))});
+        }
+        else {
+            tilesets.push_back(Tileset{firstGid, readTiledSolidTiles(tileset)});
+        }
+    }
+
+    // highest first gid first, so the first match is the owner
+    std::ranges::sort(tilesets, std::ranges::greater{}, &Tileset::firstGid);
+
+    for (auto&& layer : in_map["layers"].array_range()) {
+        if (layer["type"].as<std::string>() != "tilelayer") {
+            continue;
+        }
+
+        grid.markLayer(layer["data"].as<std::vector<unsigned int>>(), layer["width"].as<int>(),
+                       layer["height"].as<int>(), hasTiledCollisionProperty(layer), [&](unsigned int in_gid) {
+                           auto it = std::ranges::find_if(
+                               tilesets, [&](const Tileset& in_tileset) { return in_tileset.firstGid <= in_gid; });
+                           return it != tilesets.end() &&
+                                  std::ranges::binary_search(it->solidTiles, static_cast<int>(in_gid - it->firstGid));
+                       });
+    }
+
+    return grid;
+}
+
+//! Builds a grid from a Tiled map file.
+/**
+ \param in_mapPath
+   The path of the map.
+ \return
+   The grid.
+ \sa fromTiledJson
+*/
+TileCollisionGrid TileCollisionGrid::fromTiledFile(const std::filesystem::path& in_mapPath)
+{
+    std::ifstream f{in_mapPath};
+    if (!f) {
+        BOOST_THROW_EXCEPTION(CapEngineException{"Unable to open Tiled map " + in_mapPath.string()});
+    }
+
+    return fromTiledJson(jsoncons::json::parse(f), in_mapPath);
+}
+
+//! Checks if a tile is solid.
+/**
+ \param in_column
+   The column.
+ \param in_row
+   The row.
+ \return
+   true if the tile is solid, false if it is empty or outside the grid.
+*/
+bool TileCollisionGrid::isSolid(int in_column, int in_row) const
+{
+    if (in_column < 0 || in_column >= m_columns || in_row < 0 || in_row >= m_rows) {
+        return false;
+    }
+
+    const uint64_t word = m_bits[in_row * m_wordsPerRow + in_column / kBitsPerWord];
+    return (word >> (in_column % kBitsPerWord)) & 1U;
+}
+
+//! Marks a tile as solid or empty.
+/**
+ \param in_column
+   The column.
+ \param in_row
+   The row.
+ \param in_solid
+   Whether the tile is solid.
+*/
+void TileCollisionGrid::setSolid(int in_column, int in_row, bool in_solid)
+{
+    CAP_THROW_ASSERT(in_column >= 0 && in_column < m_columns && in_row >= 0 && in_row < m_rows,
+                     "Tile is outside the grid");
+
+    uint64_t& word = m_bits[in_row * m_wordsPerRow + in_column / kBitsPerWord];
+    const uint64_t mask = uint64_t{1} << (in_column % kBitsPerWord);
+    word = in_solid ? (word | mask) : (word & ~mask);
+}
+
+//! Gets the area a tile covers.
+/**
+ \param in_column
+   The column.
+ \param in_row
+   The row.
+ \return
+   The rectangle of the tile.
+*/
+Rectangle TileCollisionGrid::tileRect(int in_column, int in_row) const
+{
+    return Rectangle{static_cast<double>(in_column * m_tileWidth), static_cast<double>(in_row * m_tileHeight),
+                     static_cast<double>(m_tileWidth), static_cast<double>(m_tileHeight)};
+}
+
+//! Calls a function for each solid tile a box overlaps.
+/**
+ Tiles the box only touches along an edge are not included.
+ \param in_box
+   The box.
+ \param in_func
+   Called with the column and row of each solid tile.
+*/
+void TileCollisionGrid::forEachSolidTile(const Rectangle& in_box, FunctionRef<void(int, int)> in_func) const
+{
+    CellRange range{};
+    if (!this->cellRange(in_box, range)) {
+        return;
+    }
+
+    const int firstWord = range.firstColumn / kBitsPerWord;
+    const int lastWord = range.lastColumn / kBitsPerWord;
+
+    for (int row = range.firstRow; row <= range.lastRow; row++) {
+        const uint64_t* pRow = m_bits.data() + static_cast<std::ptrdiff_t>(row) * m_wordsPerRow;
+
+        for (int wordIndex = firstWord; wordIndex <= lastWord; wordIndex++) {
+            uint64_t word = pRow[wordIndex];
+
+            // mask off the columns outside the box
+            if (wordIndex == firstWord) {
+                word &= ~uint64_t{0} << (range.firstColumn % kBitsPerWord);
+            }
+            if (wordIndex == lastWord) {
+                const int lastBit = range.lastColumn % kBitsPerWord;
+                if (lastBit < kBitsPerWord - 1) {
+                    word &= (uint64_t{1} << (lastBit + 1)) - 1;
+                }
+            }
+
+            while (word != 0) {
+                const int bit = std::countr_zero(word);
+                in_func(wordIndex * kBitsPerWord + bit, row);
+                word &= word - 1;
+            }
+        }
+    }
+}
+
+//! Checks if a box overlaps any solid tile.
+/**
+ \param in_box
+   The box.
+ \return
+   true if it does.
+*/
+bool TileCollisionGrid::anySolid(const Rectangle& in_box) const
+{
+    bool found = false;
+    this->forEachSolidTile(in_box, [&](int, int) { found = true; });
+    return found;
+}
+
+//! Marks the tiles of a Tiled layer as solid.
+/**
+ \param in_data
+   The global tile ids of the layer, row major.
+ \param in_width
+   The width of the layer in tiles.
+ \param in_height
+   The height of the layer in tiles.
+ \param in_collides
+   Whether every tile in the layer is solid.
+ \param in_isSolid
+   Checks if a global tile id is solid in its tileset.
+*/
+void TileCollisionGrid::markLayer(const std::vector<unsigned int>& in_data, int in_width, int in_height,
+                                  bool in_collides, FunctionRef<bool(unsigned int)> in_isSolid)
+{
+    CAP_THROW_ASSERT(in_data.size() >= static_cast<std::size_t>(in_width) * in_height,
+                     "Tiled layer has less data than its size");
+
+    const int columns = std::min(in_width, m_columns);
+    const int rows = std::min(in_height, m_rows);
+
+    for (int row = 0; row < rows; row++) {
+        for (int column = 0; column < columns; column++) {
+            const unsigned int gid = getGlobalTileInfo(in_data[row * in_width + column]).globalTileId;
+            if (gid != 0 && (in_collides || in_isSolid(gid))) {
+                this->setSolid(column, row, true);
+            }
+        }
+    }
+}
+
+//! Works out the cells a box overlaps, clamped to the grid.
+/**
+ \param in_box
+   The box.
+ \param out_range
+   The cells.
+ \return
+   false if the box doesn't overlap the grid.
+*/
+bool TileCollisionGrid::cellRange(const Rectangle& in_box, CellRange& out_range) const
+{
+    if (m_columns == 0 || m_rows == 0 || in_box.width <= 0.0 || in_box.height <= 0.0) {
+        return false;
+    }
+
+    out_range.firstColumn = std::max(0, static_cast<int>(std::floor(in_box.x / m_tileWidth)));
+    out_range.lastColumn =
+        std::min(m_columns - 1, static_cast<int>(std::ceil((in_box.x + in_box.width) / m_tileWidth)) - 1);
+    out_range.firstRow = std::max(0, static_cast<int>(std::floor(in_box.y / m_tileHeight)));
+    out_range.lastRow =
+        std::min(m_rows - 1, static_cast<int>(std::ceil((in_box.y + in_box.height) / m_tileHeight)) - 1);
+
+    return out_range.firstColumn <= out_range.lastColumn && out_range.firstRow <= out_range.lastRow;
+}
+
+}  // namespace CapEngine
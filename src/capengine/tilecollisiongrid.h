@@ -0,0 +1,93 @@
+#ifndef CAPENGINE_TILECOLLISIONGRID_H
+#define CAPENGINE_TILECOLLISIONGRID_H
+
+#include <cstdint>
+#include <filesystem>
+#include <jsoncons/json.hpp>
+#include <optional>
+#include <vector>
+
+#include "collision.h"
+#include "functionref.h"
+
+namespace CapEngine {
+
+class TiledMap;  // forward declaration
+
+//! Packed grid of which tiles in a map are solid.
+/**
+   One bit per tile, row major, with rows padded to whole 64 bit words.
+   Queries only visit the cells a box overlaps and skip empty runs a word at a
+   time.  Coordinates are relative to the top left of the map with y down,
+   the same as Tiled.
+*/
+class TileCollisionGrid final {
+   public:
+    TileCollisionGrid() = default;
+    TileCollisionGrid(int in_columns, int in_rows, int in_tileWidth, int in_tileHeight);
+
+    static TileCollisionGrid fromTiledMap(const TiledMap& in_map);
+    static TileCollisionGrid fromTiledJson(const jsoncons::json& in_map,
+                                           const std::optional<std::filesystem::path>& in_path = std::nullopt);
+    static TileCollisionGrid fromTiledFile(const std::filesystem::path& in_mapPath);
+
+    [[nodiscard]] int columns() const;
+    [[nodiscard]] int rows() const;
+    [[nodiscard]] int tileWidth() const;
+    [[nodiscard]] int tileHeight() const;
+
+    [[nodiscard]] bool isSolid(int in_column, int in_row) const;
+    void setSolid(int in_column, int in_row, bool in_solid);
+    [[nodiscard]] Rectangle tileRect(int in_column, int in_row) const;
+
+    void forEachSolidTile(const Rectangle& in_box, FunctionRef<void(int, int)> in_func) const;
+    [[nodiscard]] bool anySolid(const Rectangle& in_box) const;
+
+   private:
+    //! The inclusive range of cells a box overlaps, if any.
+    struct CellRange {
+        int firstColumn;
+        int lastColumn;
+        int firstRow;
+        int lastRow;
+    };
+
+    [[nodiscard]] bool cellRange(const Rectangle& in_box, CellRange& out_range) const;
+    void markLayer(const std::vector<unsigned int>& in_data, int in_width, int in_height, bool in_collides,
+                   FunctionRef<bool(unsigned int)> in_isSolid);
+
+    int m_columns = 0;
+    int m_rows = 0;
+    int m_tileWidth = 0;
+    int m_tileHeight = 0;
+    int m_wordsPerRow = 0;
+    std::vector<uint64_t> m_bits;  //!< Solid flags, m_wordsPerRow words per row.
+};
+
+//! Gets the number of columns.
+inline int TileCollisionGrid::columns() const
+{
+    return m_columns;
+}
+
+//! Gets the number of rows.
+inline int TileCollisionGrid::rows() const
+{
+    return m_rows;
+}
+
+//! Gets the width of a tile.
+inline int TileCollisionGrid::tileWidth() const
+{
+    return m_tileWidth;
+}
+
+//! Gets the height of a tile.
+inline int TileCollisionGrid::tileHeight() const
+{
+    return m_tileHeight;
+}
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_TILECOLLISIONGRID_H
@@ -0,0 +1,255 @@
+#include "tilecollisionlayer.h"
+
+#include "game_management.h"
+#include "gameobject.h"
+#include "logging.h"
+#include "scene2dutils.h"
+
+#include <boost/log/trivial.hpp>
+#include <filesystem>
+#include <vector>
+
+namespace CapEngine
+{
+
+//! Constructor.
+/**
+ \param in_grid
+   The solid tiles.
+ \param in_position
+   Where the map is in the world.
+*/
+TileCollisionLayer::TileCollisionLayer(TileCollisionGrid in_grid,
+                                       Vector in_position)
+    : m_grid(std::move(in_grid)), m_position(in_position)
+{
+}
+
+//! Creates the layer from json.
+/**
+ The "map" is a Tiled map, relative to the asset path.  Tiles are solid if
+ they or their layer have the "capengine-collision" property.  Only the
+ json is read; the map isn't loaded for rendering.
+ \param in_json
+   The json.
+ \return
+   The layer.
+*/
+std::unique_ptr<TileCollisionLayer>
+    TileCollisionLayer::makeLayer(const jsoncons::json &in_json)
+{
+    using namespace Schema::Scene2d;
+
+    try {
+        std::filesystem::path mapPath = in_json[kTiledMap].as<std::string>();
+        if (mapPath.is_relative()) {
+            mapPath = getAssetPath() / mapPath;
+        }
+
+        Vector position;
+        if (in_json.contains(kPosition)) {
+            position = JSONUtils::readVector(in_json[kPosition]);
+        }
+
+        return std::make_unique<TileCollisionLayer>(
+            TileCollisionGrid::fromTiledFile(mapPath), position);
+    }
+
+    catch (const std::exception &e) {
+        throw LayerCreationError(kTileCollisionLayerType,
+                                 boost::diagnostic_information(e));
+    }
+}
+
+//! Register the layer constructor with a factory.
+/**
+ \param in_factory
+   The factory to register with.
+*/
+void TileCollisionLayer::registerConstructor(LayerFactory &in_factory)
+{
+    in_factory.registerLayerType(
+        Schema::Scene2d::kTileCollisionLayerType,
+        [](const jsoncons::json &in_json) -> std::unique_ptr<Layer> {
+            return makeLayer(in_json);
+        });
+}
+
+//! \copydoc Layer::checkCollisions
+TileCollisionLayer::CollisionType_t
+    TileCollisionLayer::checkCollisions(const GameObject &in_object) const
+{
+    std::pmr::vector<std::pair<CollisionType, Vector>> buffer;
+    this->checkCollisions(in_object, buffer);
+    return CollisionType_t{buffer.begin(), buffer.end()};
+}
+
+//! \copydoc Layer::checkCollisions(const GameObject&, CollisionBuffer_t&)
+void TileCollisionLayer::checkCollisions(const GameObject &in_object,
+                                         CollisionBuffer_t &out_collisions) const
+{
+    out_collisions.clear();
+
+    const YAxisOrientation orientation = in_object.getYAxisOrientation();
+    const Rectangle box = in_object.boundingPolygon();
+
+    m_grid.forEachSolidTile(
+        this->toGrid(box, orientation), [&](int in_column, int in_row) {
+            const Rectangle tile =
+                this->toWorld(m_grid.tileRect(in_column, in_row), orientation);
+            const auto collision = detectBoxCollision(box, tile);
+            if (collision) {
+                out_collisions.emplace_back(
+                    collision->collisionType,
+                    Vector{collision->representativePoint.x,
+                           collision->representativePoint.y});
+            }
+        });
+}
+
+//! Pushes an object out of any solid tiles.
+/**
+ The object is told about each collision first and is only moved if it
+ doesn't handle it.
+ \param in_object
+   The object.
+ \return
+   true if the object no longer overlaps any solid tile.
+*/
+bool TileCollisionLayer::resolveCollisions(GameObject &in_object) const
+{
+    const int maxAttempts = 4;
+    const YAxisOrientation orientation = in_object.getYAxisOrientation();
+
+    for (int attempt = 0; attempt < maxAttempts; attempt++) {
+        bool collided = false;
+
+        const Rectangle box = in_object.boundingPolygon();
+        Vector push{0.0, 0.0, 0.0, 0.0};
+
+        m_grid.forEachSolidTile(
+            this->toGrid(box, orientation), [&](int in_column, int in_row) {
+                const Rectangle tile = this->toWorld(
+                    m_grid.tileRect(in_column, in_row), orientation);
+                const auto collision = detectBoxCollision(box, tile);
+                if (!collision) {
+                    return;
+                }
+
+                collided = true;
+                const Vector location{collision->representativePoint.x,
+                                      collision->representativePoint.y};
+                if (in_object.handleCollision(collision->collisionType,
+                                              COLLISION_WALL, nullptr,
+                                              location)) {
+                    return;
+                }
+
+                // move back out along the normal by the overlap, keeping
+                // the largest push needed on each axis
+                const Vector &normal = collision->collisionNormal;
+                if (normal.getX() > 0.0) {
+                    push.setX(std::min(push.getX(), tile.x - (box.x + box.width)));
+                }
+                else if (normal.getX() < 0.0) {
+                    push.setX(std::max(push.getX(), (tile.x + tile.width) - box.x));
+                }
+                else if (normal.getY() > 0.0) {
+                    push.setY(std::min(push.getY(), tile.y - (box.y + box.height)));
+                }
+                else if (normal.getY() < 0.0) {
+                    push.setY(std::max(push.getY(), (tile.y + tile.height) - box.y));
+                }
+            });
+
+        if (!collided) {
+            return true;
+        }
+
+        if (push.getX() == 0.0 && push.getY() == 0.0) {
+            // the object handled all of the collisions itself
+            return true;
+        }
+
+        Vector position = in_object.getPosition();
+        position.setX(position.getX() + push.getX());
+        position.setY(position.getY() + push.getY());
+        in_object.setPosition(position);
+    }
+
+    BOOST_LOG_SEV(CapEngine::log, boost::log::trivial::error)
+        << "max attempts reached attempting to resolve tile collision";
+    return false;
+}
+
+//! \copydoc Layer::castBox
+std::optional<SweptBoxCollision>
+    TileCollisionLayer::castBox(const Rectangle &in_box,
+                                const Vector &in_displacement,
+                                YAxisOrientation in_orientation) const
+{
+    // every tile the box passes over, padded so a ray along a tile edge
+    // still has some area to look in
+    constexpr double padding = 1e-6;
+    const Rectangle end{in_box.x + in_displacement.getX(),
+                        in_box.y + in_displacement.getY(), in_box.width,
+                        in_box.height};
+    Rectangle swept = join(in_box, end);
+    swept = Rectangle{swept.x - padding, swept.y - padding,
+                      swept.width + 2 * padding, swept.height + 2 * padding};
+
+    std::optional<SweptBoxCollision> closest;
+    m_grid.forEachSolidTile(
+        this->toGrid(swept, in_orientation), [&](int in_column, int in_row) {
+            const Rectangle tile = this->toWorld(
+                m_grid.tileRect(in_column, in_row), in_orientation);
+            const auto collision =
+                detectSweptBoxCollision(in_box, in_displacement, 1000.0, tile);
+            if (collision &&
+                (!closest || collision->timeOfImpact < closest->timeOfImpact)) {
+                closest = collision;
+            }
+        });
+
+    return closest;
+}
+
+//! \copydoc Layer::overlaps
+bool TileCollisionLayer::overlaps(const Rectangle &in_box,
+                                  YAxisOrientation in_orientation) const
+{
+    return m_grid.anySolid(this->toGrid(in_box, in_orientation));
+}
+
+//! Converts a box in world coordinates to grid coordinates.
+Rectangle TileCollisionLayer::toGrid(const Rectangle &in_box,
+                                     YAxisOrientation in_orientation) const
+{
+    Rectangle box{in_box.x - m_position.getX(), in_box.y - m_position.getY(),
+                  in_box.width, in_box.height};
+
+    if (in_orientation == YAxisOrientation::BottomZero) {
+        const double mapHeight = m_grid.rows() * m_grid.tileHeight();
+        box.y = mapHeight - (box.y + box.height);
+    }
+
+    return box;
+}
+
+//! Converts a tile in grid coordinates to world coordinates.
+Rectangle TileCollisionLayer::toWorld(const Rectangle &in_tile,
+                                      YAxisOrientation in_orientation) const
+{
+    Rectangle tile = in_tile;
+
+    if (in_orientation == YAxisOrientation::BottomZero) {
+        const double mapHeight = m_grid.rows() * m_grid.tileHeight();
+        tile.y = mapHeight - (tile.y + tile.height);
+    }
+
+    tile.x += m_position.getX();
+    tile.y += m_position.getY();
+    return tile;
+}
+
+} // namespace CapEngine
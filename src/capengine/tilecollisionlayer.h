@@ -0,0 +1,78 @@
+#ifndef CAPENGINE_TILECOLLISIONLAYER_H
+#define CAPENGINE_TILECOLLISIONLAYER_H
+
+#include "layer.h"
+#include "layerfactory.h"
+#include "scene2dschema.h"
+#include "tilecollisiongrid.h"
+
+#include <jsoncons/json.hpp>
+#include <memory>
+#include <optional>
+
+namespace CapEngine
+{
+
+//! Collidable layer made of solid tiles.
+/**
+   The position is the top left of the map for objects with
+   YAxisOrientation::TopZero and the bottom left for
+   YAxisOrientation::BottomZero.
+*/
+class TileCollisionLayer final : public Layer
+{
+  public:
+    TileCollisionLayer(TileCollisionGrid in_grid, Vector in_position);
+    ~TileCollisionLayer() override = default;
+
+    static std::unique_ptr<TileCollisionLayer>
+        makeLayer(const jsoncons::json &in_json);
+    static void registerConstructor(LayerFactory &in_factory);
+
+    const std::string type() const override;
+    void update(double /*in_ms*/) override {}
+    void render(const Camera2d & /*in_camera*/,
+                uint32_t /*in_windowId*/) override
+    {
+    }
+    bool canCollide() const override;
+    CollisionType_t checkCollisions(const GameObject &in_object) const override;
+    void checkCollisions(const GameObject &in_object,
+                         CollisionBuffer_t &out_collisions) const override;
+    bool resolveCollisions(GameObject &in_object) const override;
+    std::optional<SweptBoxCollision>
+        castBox(const Rectangle &in_box, const Vector &in_displacement,
+                YAxisOrientation in_orientation) const override;
+    bool overlaps(const Rectangle &in_box,
+                  YAxisOrientation in_orientation) const override;
+
+    [[nodiscard]] const TileCollisionGrid &grid() const;
+
+  private:
+    Rectangle toGrid(const Rectangle &in_box,
+                     YAxisOrientation in_orientation) const;
+    Rectangle toWorld(const Rectangle &in_tile,
+                      YAxisOrientation in_orientation) const;
+
+    TileCollisionGrid m_grid; //!< Which tiles are solid.
+    Vector m_position;        //!< Where the map is in the world.
+};
+
+//! \copydoc Layer::type
+inline const std::string TileCollisionLayer::type() const
+{
+    return Schema::Scene2d::kTileCollisionLayerType;
+}
+
+//! \copydoc Layer::canCollide
+inline bool TileCollisionLayer::canCollide() const { return true; }
+
+//! Gets the solid tiles.
+inline const TileCollisionGrid &TileCollisionLayer::grid() const
+{
+    return m_grid;
+}
+
+} // namespace CapEngine
+
+#endif // CAPENGINE_TILECOLLISIONLAYER_H
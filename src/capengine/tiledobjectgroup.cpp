@@ -125,6 +125,16 @@ TiledObjectGroup::Object::Object(const jsoncons::json& in_json)
         y = y - height;
     }
 
+    auto readPoints = [&](const char* in_key, std::vector<Point>& out_points) {
+        if (in_json.contains(in_key)) {
+            for (const auto& point : in_json[in_key].array_range()) {
+                out_points.push_back(Point{point["x"].as_double(), point["y"].as_double()});
+            }
+        }
+    };
+    readPoints("polygon", polygon);
+    readPoints("polyline", polyline);
+
     if (in_json.contains("properties")) {
         for (const auto& property : in_json["properties"].array_range()) {
             properties.push_back(TiledCustomProperty{property["name"].as_string(), property["type"].as_string(),
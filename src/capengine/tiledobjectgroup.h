@@ -7,6 +7,7 @@
 #include <string_view>
 
 #include "captypes.h"
+#include "collision.h"
 #include "tiledcustomproperty.h"
 #include "tiledtileset.h"
 
@@ -62,6 +63,8 @@ class TiledObjectGroup {
         std::optional<Text> text;                     //!< Optional text properties if this is a text object
         std::optional<uint32_t> gid;                  //!< Optional global tile ID if this is a tile object
         std::vector<TiledCustomProperty> properties;  //!< Custom properties attached to this object
+        std::vector<Point> polygon;                   //!< Closed outline relative to x and y, if a polygon
+        std::vector<Point> polyline;                  //!< Open outline relative to x and y, if a polyline
 
         explicit Object(const jsoncons::json& in_json);
     };
@@ -48,6 +48,8 @@ TiledTileLayer::TiledTileLayer(const jsoncons::json& in_data, std::vector<std::u
     m_visible = in_data["visible"].as<bool>();
     m_data = in_data["data"].as<std::vector<unsigned int>>();
 
+    m_collides = hasTiledCollisionProperty(in_data);
+
     assert(Locator::videoManager != nullptr);
 
     // create the texture
@@ -131,6 +133,18 @@ TiledTileLayer TiledTileLayer::create(std::filesystem::path in_path,
     return TiledTileLayer(json, in_tilesets, in_tileWidth, in_tileHeight, in_mapWidth, in_mapHeight, in_path);
 }
 
+/**
+ * \brief Gets the name of the layer.
+ * \return The name.
+ */
+const std::string& TiledTileLayer::name() const { return m_name; }
+
+/**
+ * \brief Checks if the layer has the "capengine-collision" property set.
+ * \return true if every tile in the layer is solid.
+ */
+bool TiledTileLayer::collides() const { return m_collides; }
+
 /**
  * \brief Gets the width of the layer in tiles.
  * \return The layer width in tiles.
@@ -47,6 +47,8 @@ class TiledTileLayer
         std::vector<std::unique_ptr<TiledTileset>>& in_tilesets,
         int in_tileWidth, int in_tileHeight, int in_mapWidth, int in_mapHeight);
 
+    [[nodiscard]] const std::string& name() const;
+    [[nodiscard]] bool collides() const;
     [[nodiscard]] int width() const;
     [[nodiscard]] int height() const;
     [[nodiscard]] int x() const;
@@ -68,6 +70,7 @@ class TiledTileLayer
     int m_tileWidth{0};                                   //!< Width of individual tiles in pixels
     int m_tileHeight{0};                                  //!< Height of individual tiles in pixels
     bool m_visible{true};                                 //!< Whether the layer is visible
+    bool m_collides{false};                               //!< Whether every tile in the layer is solid
     std::vector<unsigned int> m_data;                     //!< Raw tile data (global tile IDs)
     TexturePtr m_texture;                                 //!< Rendered texture of the layer
     std::vector<std::unique_ptr<TiledTileset>>& m_tilesets; //!< Reference to the map's tilesets
@@ -1,5 +1,6 @@
 #include "tiledtileset.h"
 
+#include <algorithm>
 #include <boost/throw_exception.hpp>
 #include <fstream>
 #include <optional>
@@ -35,6 +36,9 @@ TiledTileset::TiledTileset(std::string in_name, const jsoncons::json& in_data, i
     if (in_data.contains("grid")) {
         BOOST_THROW_EXCEPTION(CapEngineException("\"grid\" property not yet supported."));
     }
+
+    // tiles marked solid for TileCollisionLayer
+    m_solidTiles = readTiledSolidTiles(in_data);
 }
 
 TiledTileset TiledTileset::create(std::string in_name, std::filesystem::path in_path, int in_firstGid)
@@ -73,6 +77,17 @@ Rectangle TiledTileset::tileRect(int in_tileId) const
                      static_cast<double>(this->tileWidth()), static_cast<double>(this->tileHeight())};
 }
 
+/**
+ * \brief Checks if a tile has the "capengine-collision" property set.
+ * \param in_gid The global id of the tile.
+ * \return true if the tile is solid.
+ */
+bool TiledTileset::isSolid(unsigned int in_gid) const
+{
+    const int localId = static_cast<int>(in_gid) - m_firstGid;
+    return localId >= 0 && std::ranges::binary_search(m_solidTiles, localId);
+}
+
 void TiledTileset::drawTile(uint32_t in_gid, Texture* io_texture, int in_x, int in_y, std::optional<int> in_destWidth,
                             std::optional<int> in_destHeight)
 {
@@ -96,4 +111,45 @@ void TiledTileset::drawTile(uint32_t in_gid, Texture* io_texture, int in_x, int
     Locator::getVideoManager().drawTexture(io_texture, m_texture.get(), dstRect, srcRect);
 }
 
+/**
+ * \brief Checks if a tile or layer has the "capengine-collision" property set to true.
+ * \param in_element The json of the tile or layer.
+ * \return true if it is solid.
+ */
+bool hasTiledCollisionProperty(const jsoncons::json& in_element)
+{
+    if (!in_element.contains("properties")) {
+        return false;
+    }
+
+    bool solid = false;
+    for (const auto& property : in_element["properties"].array_range()) {
+        if (property["name"].as_string() == kTiledCollisionPropertyName) {
+            solid = property["value"].as_string() == "true";
+        }
+    }
+    return solid;
+}
+
+/**
+ * \brief Reads the tiles in a tileset with the "capengine-collision" property set.
+ * \param in_tileset The json of the tileset.
+ * \return The sorted local ids of the solid tiles.
+ */
+std::vector<int> readTiledSolidTiles(const jsoncons::json& in_tileset)
+{
+    std::vector<int> solidTiles;
+    if (!in_tileset.contains("tiles")) {
+        return solidTiles;
+    }
+
+    for (const auto& tile : in_tileset["tiles"].array_range()) {
+        if (hasTiledCollisionProperty(tile)) {
+            solidTiles.push_back(tile["id"].as<int>());
+        }
+    }
+    std::ranges::sort(solidTiles);
+    return solidTiles;
+}
+
 }  // namespace CapEngine
@@ -8,6 +8,7 @@
 #include <jsoncons/json.hpp>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace CapEngine {
 
@@ -28,6 +29,7 @@ class TiledTileset final {
     void loadTexture();
     std::optional<Texture*> texture();
     [[nodiscard]] Rectangle tileRect(int tileId) const;
+    [[nodiscard]] bool isSolid(unsigned int in_gid) const;
 
     void drawTile(uint32_t in_gid, Texture* io_texture, int in_x, int in_y,
                   std::optional<int> in_destWidth = std::nullopt, std::optional<int> in_destHeight = std::nullopt);
@@ -42,7 +44,14 @@ class TiledTileset final {
     int m_tileHeight{0};
     int m_tileWidth{0};
     TexturePtr m_texture;
+    std::vector<int> m_solidTiles;  //!< Sorted local ids of tiles with the collision property set.
 };
+
+//! Tiled tile and layer property that marks tiles as solid.
+inline constexpr char kTiledCollisionPropertyName[] = "capengine-collision";
+
+[[nodiscard]] bool hasTiledCollisionProperty(const jsoncons::json& in_element);
+[[nodiscard]] std::vector<int> readTiledSolidTiles(const jsoncons::json& in_tileset);
 } // namespace CapEngine
 
 #endif /* CAPENGINE_TILEDTILESET_H */
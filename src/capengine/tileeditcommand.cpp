@@ -0,0 +1,87 @@
+#include "tileeditcommand.h"
+
+#include <ranges>
+
+#include "CapEngineException.h"
+#include "map2d.h"
+
+namespace CapEngine {
+
+//! Creates a command with no changes.
+/**
+ \param in_pMap
+   The map to change.
+ \param in_mergeId
+   Edits made with the same id, e.g. the parts of one stroke, are merged when
+   run one after the other.  kNoMerge never merges.
+*/
+TileEditCommand::TileEditCommand(std::shared_ptr<Map2D> in_pMap, int in_mergeId)
+    : m_pMap(std::move(in_pMap)), m_mergeId(in_mergeId)
+{
+    CAP_THROW_NULL(m_pMap, "Null map");
+}
+
+//! Adds a tile to change when the command is executed.
+/**
+ The tile's current index is kept for undoing, so tiles have to be added
+ before the command is run.
+ \param in_x
+   The x location of the tile.
+ \param in_y
+   The y location of the tile.
+ \param in_index
+   The index into the tileset, or a negative index to clear the tile.
+*/
+void TileEditCommand::setTile(int in_x, int in_y, int in_index)
+{
+    const int oldIndex = m_pMap->getTileIndex(in_x, in_y);
+    const int newIndex = in_index < 0 ? -1 : in_index;
+
+    if (!m_runs.empty()) {
+        Run& last = m_runs.back();
+        if (last.y == in_y && last.x + last.length == in_x && last.oldIndex == oldIndex &&
+            last.newIndex == newIndex) {
+            last.length++;
+            return;
+        }
+    }
+
+    m_runs.push_back(Run{in_x, in_y, 1, oldIndex, newIndex});
+}
+
+//! \copydoc Command::execute
+void TileEditCommand::execute()
+{
+    for (auto&& run : m_runs) {
+        m_pMap->setTiles(run.x, run.y, run.length, run.newIndex);
+    }
+}
+
+//! \copydoc Command::unExecute
+void TileEditCommand::unExecute()
+{
+    // backwards, so a tile changed more than once ends with its first index.
+    for (auto&& run : m_runs | std::views::reverse) {
+        m_pMap->setTiles(run.x, run.y, run.length, run.oldIndex);
+    }
+}
+
+//! \copydoc Command::byteSize
+std::size_t TileEditCommand::byteSize() const
+{
+    return sizeof(*this) + m_runs.capacity() * sizeof(Run);
+}
+
+//! \copydoc Command::merge
+bool TileEditCommand::merge(Command& io_next)
+{
+    auto* pNext = dynamic_cast<TileEditCommand*>(&io_next);
+    if (pNext == nullptr || m_mergeId == kNoMerge || pNext->m_mergeId != m_mergeId || pNext->m_pMap != m_pMap) {
+        return false;
+    }
+
+    m_runs.insert(m_runs.end(), pNext->m_runs.begin(), pNext->m_runs.end());
+    return true;
+}
+
+}  // namespace CapEngine
@@ -0,0 +1,60 @@
+#ifndef CAPENGINE_TILEEDITCOMMAND_H
+#define CAPENGINE_TILEEDITCOMMAND_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "command.h"
+
+namespace CapEngine {
+
+class Map2D;
+
+//! A command that changes tiles in a Map2D.
+/**
+   Changes are stored as runs of adjacent tiles in a row that had the same
+   index and are given the same index, so filling an area stores one run per
+   row rather than a command per tile.  Each run is written back with a single
+   Map2D::setTiles().
+*/
+class TileEditCommand final : public Command {
+   public:
+    //! Tiles changed from one index to another.
+    struct Run {
+        int32_t x;
+        int32_t y;
+        int32_t length;
+        int32_t oldIndex;  //!< negative if there was no tile.
+        int32_t newIndex;  //!< negative to clear the tiles.
+    };
+
+    static constexpr int kNoMerge = 0;
+
+    explicit TileEditCommand(std::shared_ptr<Map2D> in_pMap, int in_mergeId = kNoMerge);
+
+    void setTile(int in_x, int in_y, int in_index);
+    [[nodiscard]] const std::vector<Run>& runs() const;
+
+    void execute() override;
+    void unExecute() override;
+    [[nodiscard]] std::size_t byteSize() const override;
+    bool merge(Command& io_next) override;
+
+   private:
+    std::shared_ptr<Map2D> m_pMap;
+    //! Edits with the same id, other than kNoMerge, merge into one.
+    int m_mergeId;
+    //! In the order they were made.
+    std::vector<Run> m_runs;
+};
+
+//! Returns the runs of changed tiles, in the order they were made.
+inline const std::vector<TileEditCommand::Run>& TileEditCommand::runs() const
+{
+    return m_runs;
+}
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_TILEEDITCOMMAND_H
@@ -0,0 +1,338 @@
+#include "tilegrid.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+
+#include "CapEngineException.h"
+#include "mappedfile.h"
+#include "serialization.h"
+
+namespace CapEngine {
+
+namespace {
+
+constexpr uint16_t kNoTile16 = std::numeric_limits<uint16_t>::max();
+constexpr std::size_t kTilesPerChunk = TileGrid::kChunkSize * TileGrid::kChunkSize;
+
+//! The offset of a tile's index within its chunk.
+std::size_t offsetInChunk(int in_x, int in_y, std::size_t in_indexSize)
+{
+    return (static_cast<std::size_t>(in_y % TileGrid::kChunkSize) * TileGrid::kChunkSize +
+            static_cast<std::size_t>(in_x % TileGrid::kChunkSize)) *
+           in_indexSize;
+}
+
+//! Throws if a tile file is malformed.
+void checkTileFile(bool in_condition, const std::filesystem::path& in_path, const std::string& in_details)
+{
+    if (!in_condition) {
+        CAP_THROW(CapEngineException("Invalid tile file " + in_path.string() + ": " + in_details));
+    }
+}
+
+}  // namespace
+
+//! Creates a grid with no tiles set.
+/**
+ \param in_width
+   The width in tiles.
+ \param in_height
+   The height in tiles.
+*/
+TileGrid::TileGrid(int in_width, int in_height)
+{
+    this->resize(in_width, in_height);
+}
+
+//! Gets the index at a location.
+/**
+ \param in_x
+   The x location, which must be within the grid.
+ \param in_y
+   The y location, which must be within the grid.
+ \return
+   The index, or kNoTile.
+*/
+uint32_t TileGrid::get(int in_x, int in_y) const
+{
+    assert(in_x >= 0 && in_x < m_width && in_y >= 0 && in_y < m_height);
+
+    const Chunk& chunk = *m_chunks[(in_y / kChunkSize) * m_chunksWide + (in_x / kChunkSize)];
+    const std::byte* pTile = chunk.data() + offsetInChunk(in_x, in_y, m_indexSize);
+
+    if (m_indexSize == sizeof(uint16_t)) {
+        uint16_t index = 0;
+        std::memcpy(&index, pTile, sizeof(index));
+        return index == kNoTile16 ? kNoTile : index;
+    }
+
+    uint32_t index = 0;
+    std::memcpy(&index, pTile, sizeof(index));
+    return index;
+}
+
+//! Sets the index at a location.
+/**
+ \param in_x
+   The x location, which must be within the grid.
+ \param in_y
+   The y location, which must be within the grid.
+ \param in_index
+   The index, or kNoTile to clear it.
+*/
+void TileGrid::set(int in_x, int in_y, uint32_t in_index)
+{
+    assert(in_x >= 0 && in_x < m_width && in_y >= 0 && in_y < m_height);
+
+    if (m_indexSize == sizeof(uint16_t) && in_index != kNoTile && in_index >= kNoTile16) {
+        this->widen();
+    }
+
+    std::byte* pTile = this->tileForWriting(in_x, in_y);
+    if (m_indexSize == sizeof(uint16_t)) {
+        const uint16_t index = in_index == kNoTile ? kNoTile16 : static_cast<uint16_t>(in_index);
+        std::memcpy(pTile, &index, sizeof(index));
+    }
+    else {
+        std::memcpy(pTile, &in_index, sizeof(in_index));
+    }
+}
+
+//! Sets a run of tiles in a row to the same index.
+/**
+ Each chunk the run crosses is written with a single fill.
+ \param in_x
+   The x location of the first tile.
+ \param in_y
+   The y location of the tiles.
+ \param in_count
+   The number of tiles.  The run must be within the grid.
+ \param in_index
+   The index, or kNoTile to clear them.
+*/
+void TileGrid::fillRow(int in_x, int in_y, int in_count, uint32_t in_index)
+{
+    assert(in_x >= 0 && in_count >= 0 && in_x + in_count <= m_width && in_y >= 0 && in_y < m_height);
+    if (in_count == 0) {
+        return;
+    }
+
+    // set() widens if needed, and the rest of the run is filled to match.
+    this->set(in_x, in_y, in_index);
+
+    std::array<std::byte, sizeof(uint32_t)> value{};
+    std::memcpy(value.data(), this->tileForWriting(in_x, in_y), m_indexSize);
+
+    for (int x = in_x + 1; x < in_x + in_count;) {
+        const int segment = std::min(in_x + in_count - x, kChunkSize - x % kChunkSize);
+        std::byte* pTile = this->tileForWriting(x, in_y);
+        for (int i = 0; i < segment; i++) {
+            std::memcpy(pTile + i * m_indexSize, value.data(), m_indexSize);
+        }
+        x += segment;
+    }
+}
+
+//! Changes the size of the grid.
+/**
+ Tiles within both the old and new size are kept.
+ \param in_width
+   The new width in tiles.
+ \param in_height
+   The new height in tiles.
+*/
+void TileGrid::resize(int in_width, int in_height)
+{
+    CAP_THROW_ASSERT(in_width >= 0 && in_height >= 0, "Invalid tile grid size");
+
+    TileGrid old = std::move(*this);
+
+    m_width = in_width;
+    m_height = in_height;
+    m_chunksWide = (in_width + kChunkSize - 1) / kChunkSize;
+    m_chunksHigh = (in_height + kChunkSize - 1) / kChunkSize;
+    m_indexSize = old.m_chunks.empty() ? sizeof(uint16_t) : old.m_indexSize;
+    m_chunks.assign(static_cast<std::size_t>(m_chunksWide) * m_chunksHigh, this->makeEmptyChunk());
+
+    // whole chunks are kept where the chunk grid still lines up.
+    for (int y = 0; y < std::min(m_chunksHigh, old.m_chunksHigh); y++) {
+        for (int x = 0; x < std::min(m_chunksWide, old.m_chunksWide); x++) {
+            m_chunks[y * m_chunksWide + x] = old.m_chunks[y * old.m_chunksWide + x];
+        }
+    }
+
+    // but tiles kept chunks hold outside the new size have to be cleared, as
+    // the padding is always kNoTile.  Only chunks with such a tile set are
+    // written, so the rest stay shared with copies of the grid.
+    const int keptWidth = std::min(m_chunksWide * kChunkSize, old.m_width);
+    const int keptHeight = std::min(m_chunksHigh * kChunkSize, old.m_height);
+    for (int y = 0; y < keptHeight; y++) {
+        for (int x = y < m_height ? m_width : 0; x < keptWidth; x++) {
+            const Chunk& chunk = *m_chunks[(y / kChunkSize) * m_chunksWide + (x / kChunkSize)];
+            const std::byte* pTile = chunk.data() + offsetInChunk(x, y, m_indexSize);
+            const bool isSet =
+                std::any_of(pTile, pTile + m_indexSize, [](std::byte in_byte) { return in_byte != std::byte{0xff}; });
+            if (isSet) {
+                std::memset(this->tileForWriting(x, y), 0xff, m_indexSize);
+            }
+        }
+    }
+}
+
+//! Checks if a chunk is shared with another grid.
+/**
+ \param in_other
+   A copy of this grid, made before either was changed.
+ \param in_chunk
+   The chunk.
+ \return
+   true if neither grid has changed the chunk since the copy.
+*/
+bool TileGrid::sharesChunk(const TileGrid& in_other, std::size_t in_chunk) const
+{
+    return in_chunk < m_chunks.size() && in_chunk < in_other.m_chunks.size() &&
+           m_chunks[in_chunk] == in_other.m_chunks[in_chunk];
+}
+
+//! Reads a grid written by save().
+/**
+ \param in_path
+   The file.  Throws CapEngineException if it can't be read or is malformed.
+ \return
+   The grid.
+*/
+TileGrid TileGrid::load(const std::filesystem::path& in_path)
+{
+    MappedFile file{in_path};
+    ByteReader reader{file.bytes()};
+
+    checkTileFile(file.bytes().size() >= sizeof(TileGridHeader), in_path, "too small");
+    const auto header = reader.read<TileGridHeader>();
+    checkTileFile(header.magic == kMagic, in_path, "bad magic");
+    checkTileFile(header.version == kVersion, in_path, "unsupported version");
+    checkTileFile(header.chunkSize == kChunkSize, in_path, "unsupported chunk size");
+    checkTileFile(header.indexSize == sizeof(uint16_t) || header.indexSize == sizeof(uint32_t), in_path,
+                  "bad index size");
+    checkTileFile(header.width <= static_cast<uint32_t>(std::numeric_limits<int>::max() - kChunkSize) &&
+                      header.height <= static_cast<uint32_t>(std::numeric_limits<int>::max() - kChunkSize),
+                  in_path, "too large");
+
+    // the header is checked against the file before anything is allocated
+    // for it, so a corrupt size can't ask for more memory than the file has.
+    const uint64_t chunksWide = (uint64_t{header.width} + kChunkSize - 1) / kChunkSize;
+    const uint64_t chunksHigh = (uint64_t{header.height} + kChunkSize - 1) / kChunkSize;
+    const uint64_t chunkBytes = uint64_t{kTilesPerChunk} * header.indexSize;
+    checkTileFile(file.bytes().size() - sizeof(TileGridHeader) == chunksWide * chunksHigh * chunkBytes, in_path,
+                  "size doesn't match the header");
+
+    TileGrid grid{static_cast<int>(header.width), static_cast<int>(header.height)};
+    grid.m_indexSize = header.indexSize;
+
+    for (auto&& pChunk : grid.m_chunks) {
+        const auto bytes = reader.readBytes(grid.chunkBytes());
+        pChunk = std::make_shared<Chunk>(bytes.begin(), bytes.end());
+    }
+
+    return grid;
+}
+
+//! Writes the grid to a file.
+/**
+ \param in_path
+   The file.  Throws CapEngineException if it can't be written.
+ \param in_pSaved
+   The grid as it was last saved to in_path, or null.  If given and the file
+   still has its size and index size, only chunks this grid has changed since
+   are written.
+*/
+void TileGrid::save(const std::filesystem::path& in_path, const TileGrid* in_pSaved) const
+{
+    const bool incremental = in_pSaved != nullptr && in_pSaved->m_width == m_width &&
+                             in_pSaved->m_height == m_height && in_pSaved->m_indexSize == m_indexSize &&
+                             std::filesystem::exists(in_path) &&
+                             std::filesystem::file_size(in_path) == sizeof(TileGridHeader) + m_chunks.size() * chunkBytes();
+
+    std::fstream stream;
+    if (incremental) {
+        stream.open(in_path, std::ios::binary | std::ios::in | std::ios::out);
+    }
+    else {
+        stream.open(in_path, std::ios::binary | std::ios::out | std::ios::trunc);
+
+        const TileGridHeader header{kMagic,
+                                    kVersion,
+                                    static_cast<uint32_t>(m_width),
+                                    static_cast<uint32_t>(m_height),
+                                    kChunkSize,
+                                    static_cast<uint32_t>(m_indexSize)};
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    if (!stream) {
+        CAP_THROW(CapEngineException("Unable to open tile file " + in_path.string()));
+    }
+
+    for (std::size_t i = 0; i < m_chunks.size(); i++) {
+        if (incremental && this->sharesChunk(*in_pSaved, i)) {
+            continue;
+        }
+
+        stream.seekp(static_cast<std::streamoff>(sizeof(TileGridHeader) + i * chunkBytes()));
+        stream.write(reinterpret_cast<const char*>(m_chunks[i]->data()), static_cast<std::streamsize>(chunkBytes()));
+    }
+
+    stream.close();
+    if (!stream) {
+        CAP_THROW(CapEngineException("Unable to write tile file " + in_path.string()));
+    }
+}
+
+//! Returns the size of a chunk in bytes.
+std::size_t TileGrid::chunkBytes() const
+{
+    return kTilesPerChunk * m_indexSize;
+}
+
+//! Makes a chunk with no tiles set.
+std::shared_ptr<TileGrid::Chunk> TileGrid::makeEmptyChunk() const
+{
+    // kNoTile is all ones at either index size.
+    return std::make_shared<Chunk>(this->chunkBytes(), std::byte{0xff});
+}
+
+//! Gets a tile's index for writing, copying its chunk first if it is shared.
+std::byte* TileGrid::tileForWriting(int in_x, int in_y)
+{
+    auto& pChunk = m_chunks[(in_y / kChunkSize) * m_chunksWide + (in_x / kChunkSize)];
+    if (pChunk.use_count() > 1) {
+        pChunk = std::make_shared<Chunk>(*pChunk);
+    }
+
+    return pChunk->data() + offsetInChunk(in_x, in_y, m_indexSize);
+}
+
+//! Switches to 32 bit indexes.
+void TileGrid::widen()
+{
+    assert(m_indexSize == sizeof(uint16_t));
+
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    chunks.reserve(m_chunks.size());
+    for (auto&& pChunk : m_chunks) {
+        auto pWide = std::make_shared<Chunk>(kTilesPerChunk * sizeof(uint32_t));
+        for (std::size_t i = 0; i < kTilesPerChunk; i++) {
+            uint16_t narrow = 0;
+            std::memcpy(&narrow, pChunk->data() + i * sizeof(uint16_t), sizeof(narrow));
+            const uint32_t wide = narrow == kNoTile16 ? kNoTile : narrow;
+            std::memcpy(pWide->data() + i * sizeof(uint32_t), &wide, sizeof(wide));
+        }
+        chunks.push_back(std::move(pWide));
+    }
+
+    m_chunks = std::move(chunks);
+    m_indexSize = sizeof(uint32_t);
+}
+
+}  // namespace CapEngine
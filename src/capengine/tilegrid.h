@@ -0,0 +1,111 @@
+#ifndef CAPENGINE_TILEGRID_H
+#define CAPENGINE_TILEGRID_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace CapEngine {
+
+/**
+   \file
+   Tile file layout:
+     TileGridHeader
+     every chunk in row major order, each kChunkSize * kChunkSize indexes of
+     indexSize bytes in row major order.  Chunks on the right and bottom edges
+     are padded with kNoTile.
+
+   Values are in native byte order.  Since chunks are a fixed size, a file can
+   be updated in place by writing only the chunks that changed.
+*/
+
+//! The start of a tile file.
+struct TileGridHeader {
+    std::array<char, 4> magic;
+    uint32_t version;
+    uint32_t width;      //!< The width in tiles.
+    uint32_t height;     //!< The height in tiles.
+    uint32_t chunkSize;  //!< The width and height of a chunk in tiles.
+    uint32_t indexSize;  //!< The size of an index in bytes, 2 or 4.
+};
+
+//! A grid of indexes into a TileSet.
+/**
+   Tiles are stored in square chunks of 16 bit indexes, which are widened to 32
+   bits if an index that needs them is stored.  Chunks are shared between copies
+   until one of them is changed, so copying a grid, e.g. to snapshot a map, only
+   copies pointers.  A new grid shares a single empty chunk.
+*/
+class TileGrid final {
+   public:
+    static constexpr uint32_t kNoTile = std::numeric_limits<uint32_t>::max();
+    static constexpr int kChunkSize = 32;
+    static constexpr std::array<char, 4> kMagic = {'C', 'P', 'T', 'G'};
+    static constexpr uint32_t kVersion = 1;
+
+    TileGrid() = default;
+    TileGrid(int in_width, int in_height);
+
+    [[nodiscard]] int width() const;
+    [[nodiscard]] int height() const;
+    [[nodiscard]] uint32_t get(int in_x, int in_y) const;
+    void set(int in_x, int in_y, uint32_t in_index);
+    void fillRow(int in_x, int in_y, int in_count, uint32_t in_index);
+    void resize(int in_width, int in_height);
+
+    [[nodiscard]] std::size_t indexSize() const;
+    [[nodiscard]] std::size_t numChunks() const;
+    [[nodiscard]] bool sharesChunk(const TileGrid& in_other, std::size_t in_chunk) const;
+
+    static TileGrid load(const std::filesystem::path& in_path);
+    void save(const std::filesystem::path& in_path, const TileGrid* in_pSaved = nullptr) const;
+
+   private:
+    using Chunk = std::vector<std::byte>;
+
+    [[nodiscard]] std::size_t chunkBytes() const;
+    [[nodiscard]] std::shared_ptr<Chunk> makeEmptyChunk() const;
+    std::byte* tileForWriting(int in_x, int in_y);
+    void widen();
+
+    int m_width = 0;
+    int m_height = 0;
+    int m_chunksWide = 0;
+    int m_chunksHigh = 0;
+    std::size_t m_indexSize = sizeof(uint16_t);
+    //! Shared with copies of the grid until written to.
+    std::vector<std::shared_ptr<Chunk>> m_chunks;
+};
+
+//! Returns the width in tiles.
+inline int TileGrid::width() const
+{
+    return m_width;
+}
+
+//! Returns the height in tiles.
+inline int TileGrid::height() const
+{
+    return m_height;
+}
+
+//! Returns the size of the stored indexes in bytes.
+inline std::size_t TileGrid::indexSize() const
+{
+    return m_indexSize;
+}
+
+//! Returns the number of chunks, in the order they are saved.
+inline std::size_t TileGrid::numChunks() const
+{
+    return m_chunks.size();
+}
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_TILEGRID_H
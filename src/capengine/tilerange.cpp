@@ -0,0 +1,97 @@
+#include "tilerange.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "utils.h"
+
+namespace CapEngine {
+
+//! Gets the range of tiles that are in or intersect with the given rect.
+/**
+ Computed from the view's origin and tile size, so it costs the same however
+ big the grid is.  A rect ending exactly on a tile edge doesn't include the
+ next tile.
+ \param in_rect
+   \li The rect in window coordinates.
+ \param in_view
+   \li Where the grid is drawn.
+ \return
+   \li The first tile's x, y indexes and the number of tiles across and down,
+   or nullopt if the rect doesn't touch the grid.
+*/
+std::optional<SDL_Rect> getTileRange(const SDL_Rect& in_rect, const TileView& in_view)
+{
+    if (in_view.tileSize <= 0.0 || in_rect.w <= 0 || in_rect.h <= 0) return std::nullopt;
+
+    const int firstX = std::max(0, static_cast<int>(std::floor((in_rect.x - in_view.originX) / in_view.tileSize)));
+    const int firstY = std::max(0, static_cast<int>(std::floor((in_rect.y - in_view.originY) / in_view.tileSize)));
+    const int endX = std::min(in_view.tilesWide,
+                              static_cast<int>(std::ceil((in_rect.x + in_rect.w - in_view.originX) / in_view.tileSize)));
+    const int endY = std::min(in_view.tilesHigh,
+                              static_cast<int>(std::ceil((in_rect.y + in_rect.h - in_view.originY) / in_view.tileSize)));
+
+    if (firstX >= endX || firstY >= endY) return std::nullopt;
+
+    return SDL_Rect{firstX, firstY, endX - firstX, endY - firstY};
+}
+
+//! Gets all tiles that are in or intersect with the given rect.
+/**
+ \param in_rect
+   \li The rect in window coordinates.  It may have a negative width or
+   height, e.g. when dragging up or left.
+ \param in_visibleExtents
+   \li The part of the window the grid is visible in.  Tiles outside it are
+   left out.
+ \param in_view
+   \li Where the grid is drawn.
+ \return
+   \li The x, y indexes of the tiles, a row at a time.
+*/
+std::vector<std::pair<int, int>> getTilesInRect(const SDL_Rect& in_rect, const SDL_Rect& in_visibleExtents,
+                                                const TileView& in_view)
+{
+    const SDL_Rect normalizedRect = {std::min(in_rect.x, in_rect.x + in_rect.w),
+                                     std::min(in_rect.y, in_rect.y + in_rect.h), std::abs(in_rect.w),
+                                     std::abs(in_rect.h)};
+
+    std::vector<std::pair<int, int>> tilesInRect;
+    const std::optional<SDL_Rect> maybeVisibleRect = intersectRects(normalizedRect, in_visibleExtents);
+    if (maybeVisibleRect == std::nullopt) return tilesInRect;
+
+    const std::optional<SDL_Rect> maybeTileRange = getTileRange(*maybeVisibleRect, in_view);
+    if (maybeTileRange == std::nullopt) return tilesInRect;
+
+    tilesInRect.reserve(maybeTileRange->w * maybeTileRange->h);
+    for (int y = maybeTileRange->y; y < maybeTileRange->y + maybeTileRange->h; y++) {
+        for (int x = maybeTileRange->x; x < maybeTileRange->x + maybeTileRange->w; x++) {
+            tilesInRect.emplace_back(x, y);
+        }
+    }
+
+    return tilesInRect;
+}
+
+//! Checks if so many tiles changed that redrawing the whole grid is cheaper.
+/**
+ Drawing or uploading many tiles a piece at a time is slower than doing them
+ all at once, so past a quarter of the grid it is done all at once.
+ \param in_changedTiles
+   \li The number of tiles changed.
+ \param in_tilesWide
+   \li The width of the grid in tiles.
+ \param in_tilesHigh
+   \li The height of the grid in tiles.
+ \return
+   \li true if the whole grid should be redrawn.
+*/
+bool exceedsPartialUpdateLimit(std::size_t in_changedTiles, int in_tilesWide, int in_tilesHigh)
+{
+    const std::size_t maxChangedTiles =
+        static_cast<std::size_t>(std::max(0, in_tilesWide)) * static_cast<std::size_t>(std::max(0, in_tilesHigh)) / 4;
+    return in_changedTiles > maxChangedTiles;
+}
+
+}  // namespace CapEngine
@@ -0,0 +1,32 @@
+#ifndef CAPENGINE_TILERANGE_H
+#define CAPENGINE_TILERANGE_H
+
+#include <SDL2/SDL.h>
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace CapEngine {
+
+//! Where a grid of tiles is drawn in a window.
+struct TileView {
+    //! the window x location of the grid's top left corner
+    double originX = 0.0;
+    //! the window y location of the grid's top left corner
+    double originY = 0.0;
+    //! the displayed size of a tile, after zooming
+    double tileSize = 0.0;
+    int tilesWide = 0;
+    int tilesHigh = 0;
+};
+
+std::optional<SDL_Rect> getTileRange(const SDL_Rect& in_rect, const TileView& in_view);
+std::vector<std::pair<int, int>> getTilesInRect(const SDL_Rect& in_rect, const SDL_Rect& in_visibleExtents,
+                                                const TileView& in_view);
+bool exceedsPartialUpdateLimit(std::size_t in_changedTiles, int in_tilesWide, int in_tilesHigh);
+
+}  // namespace CapEngine
+
+#endif  // CAPENGINE_TILERANGE_H
@@ -73,6 +73,7 @@ void TileSetPanel::setPosition(int x, int y)
     m_rect.y = y;
 
     m_updateDrawLocations = true;
+    this->invalidate();
   }
 }
 
@@ -84,6 +85,7 @@ void TileSetPanel::setSize(int width, int height)
     m_rect.h = height;
 
     m_updateDrawLocations = true;
+    this->invalidate();
   }
 }
 
@@ -63,6 +63,7 @@ void Button::setPosition(int x, int y)
   m_rect.y = y;
 
   m_updateLabel = true;
+  this->invalidate();
 }
 
 //! \copydoc Widget::setSize
@@ -72,6 +73,7 @@ void Button::setSize(int width, int height)
   m_rect.h = height;
 
   m_updateLabel = true;
+  this->invalidate();
 }
 
 //! \copydoc Widget::render
@@ -123,6 +125,9 @@ void Button::setText(const std::string &text)
 {
   m_text = text;
   m_pLabel = Label::create(m_text);
+  m_pLabel->setWindowId(m_windowId);
+  m_updateLabel = true;
+  this->invalidate();
 }
 
 //! updates the size and position of the child label
@@ -236,6 +241,8 @@ SDL_Rect Button::getRenderRect() const
 //! \copydoc Widdget::handleMouseMotionEvent
 void Button::handleMouseMotionEvent(SDL_MouseMotionEvent event)
 {
+    const State previousState = m_state;
+
     SDL_Rect rect = this->getRenderRect();
     // hovered
     if (pointInRect(Point{static_cast<double>(event.x), static_cast<double>(event.y)}, Rectangle(rect)) &&
@@ -245,11 +252,17 @@ void Button::handleMouseMotionEvent(SDL_MouseMotionEvent event)
     // neutral (not hovered)
     else if (m_state != State::Pressed)
         m_state = State::Neutral;
+
+    if (m_state != previousState) {
+        this->invalidate();
+    }
 }
 
 //! \copydoc Widget::handleMouseButtonEvent
 void Button::handleMouseButtonEvent(SDL_MouseButtonEvent event)
 {
+    const State previousState = m_state;
+
     SDL_Rect rect = this->getRenderRect();
 
     // button event inside of button
@@ -269,6 +282,10 @@ void Button::handleMouseButtonEvent(SDL_MouseButtonEvent event)
     else {
         m_state = State::Neutral;
     }
+
+    if (m_state != previousState) {
+        this->invalidate();
+    }
 }
 
 //! Registers a button click handler.
@@ -1,28 +1,392 @@
 #include "vectorcollisionlayer.h"
+
 #include "collision.h"
+#include "game_management.h"
+#include "gameobject.h"
+#include "logging.h"
+#include "scene2dutils.h"
+#include "tiledmap.h"
+#include "tiledobjectgroup.h"
+
+#include <boost/log/trivial.hpp>
+#include <filesystem>
+#include <string>
 
 namespace CapEngine
 {
 
-VectorCollisionLayer::VectorCollisionLayer(const jsoncons::json &in_json) {}
+namespace
+{
 
-void registerConstructor(LayerFactory &in_factory)
+//! How much further than the penetration objects are pushed, so rounding on
+//! diagonal segments doesn't leave them just touching the inside.
+constexpr double kResolveSlop = 1e-6;
+
+//! Appends the segments of an outline.
+/**
+ \param in_points
+   The points.
+ \param in_offset
+   Added to each point.
+ \param in_closed
+   Whether the last point joins back to the first.
+ \param out_segments
+   Receives the segments.
+*/
+void addOutline(const std::vector<Point> &in_points, Point in_offset,
+                bool in_closed, std::vector<Segment> &out_segments)
 {
-    in_factory.registerLayerType(
-        "test", [](const jsoncons::json &in_json) { return nullptr; });
+    if (in_points.size() < 2) {
+        return;
+    }
+
+    auto at = [&](std::size_t in_index) {
+        return Point{in_points[in_index].x + in_offset.x,
+                     in_points[in_index].y + in_offset.y};
+    };
+
+    for (std::size_t i = 0; i + 1 < in_points.size(); i++) {
+        out_segments.push_back(Segment{at(i), at(i + 1)});
+    }
+
+    if (in_closed && in_points.size() > 2) {
+        out_segments.push_back(Segment{at(in_points.size() - 1), at(0)});
+    }
+}
+
+//! Reads an array of outlines, each an array of points, from json.
+void readOutlines(const jsoncons::json &in_json, bool in_closed,
+                  std::vector<Segment> &out_segments)
+{
+    for (const auto &outline : in_json.array_range()) {
+        std::vector<Point> points;
+        for (const auto &point : outline.array_range()) {
+            const Vector vector = JSONUtils::readVector(point);
+            points.push_back(Point{vector.getX(), vector.getY()});
+        }
+        addOutline(points, Point{}, in_closed, out_segments);
+    }
+}
+
+//! Reads the polygons and polylines of a Tiled object group.
+void readObjectGroup(const TiledObjectGroup &in_group,
+                     std::vector<Segment> &out_segments)
+{
+    for (auto &&[id, object] : in_group.objects()) {
+        const Point offset{object.x, object.y};
+        addOutline(object.polygon, offset, true, out_segments);
+        addOutline(object.polyline, offset, false, out_segments);
+    }
 }
 
-void render(const Camera2d &in_camera, uint32_t in_windowId) {}
+} // namespace
 
-Layer::CollisionType_t
+//! Constructor.
+/**
+ \param in_segments
+   The geometry.
+ \param in_position
+   Where the geometry is in the world.
+ \param in_tiledHeight
+   The height of the Tiled map the geometry came from, if it did.
+*/
+VectorCollisionLayer::VectorCollisionLayer(std::vector<Segment> in_segments,
+                                           Vector in_position,
+                                           std::optional<double> in_tiledHeight)
+    : m_bvh(std::move(in_segments)), m_position(in_position),
+      m_tiledHeight(in_tiledHeight)
+{
+}
+
+//! Creates the layer from json.
+/**
+ The geometry is either "polygons" and "polylines", arrays of arrays of
+ points, or the polygon and polyline objects of a Tiled "map" relative to the
+ asset path.  With a map, "objectGroup" limits it to one object group.
+ \param in_json
+   The json.
+ \return
+   The layer.
+*/
+std::unique_ptr<VectorCollisionLayer>
+    VectorCollisionLayer::makeLayer(const jsoncons::json &in_json)
+{
+    using namespace Schema::Scene2d;
+
+    try {
+        Vector position;
+        if (in_json.contains(kPosition)) {
+            position = JSONUtils::readVector(in_json[kPosition]);
+        }
+
+        std::vector<Segment> segments;
+
+        if (in_json.contains(kTiledMap)) {
+            std::filesystem::path mapPath = in_json[kTiledMap].as<std::string>();
+            if (mapPath.is_relative()) {
+                mapPath = getAssetPath() / mapPath;
+            }
+
+            const TiledMap map{mapPath};
+            if (in_json.contains(kObjectGroup)) {
+                const std::string groupName =
+                    in_json[kObjectGroup].as<std::string>();
+                auto group = map.objectGroupByName(groupName);
+                if (!group) {
+                    throw LayerCreationError(kVectorCollisionLayerType,
+                                             "No object group named " +
+                                                 groupName);
+                }
+                readObjectGroup(group->get(), segments);
+            }
+            else {
+                for (auto &&group : map.objectGroups()) {
+                    readObjectGroup(group, segments);
+                }
+            }
+
+            const double height =
+                static_cast<double>(map.height()) * map.tileHeight();
+            return std::make_unique<VectorCollisionLayer>(std::move(segments),
+                                                          position, height);
+        }
+
+        if (in_json.contains(kPolygons)) {
+            readOutlines(in_json[kPolygons], true, segments);
+        }
+        if (in_json.contains(kPolylines)) {
+            readOutlines(in_json[kPolylines], false, segments);
+        }
+
+        return std::make_unique<VectorCollisionLayer>(std::move(segments),
+                                                      position);
+    }
+
+    catch (const LayerCreationError &) {
+        throw;
+    }
+
+    catch (const std::exception &e) {
+        throw LayerCreationError(kVectorCollisionLayerType,
+                                 boost::diagnostic_information(e));
+    }
+}
+
+//! Register the layer constructor with a factory.
+/**
+ \param in_factory
+   The factory to register with.
+*/
+void VectorCollisionLayer::registerConstructor(LayerFactory &in_factory)
+{
+    in_factory.registerLayerType(
+        Schema::Scene2d::kVectorCollisionLayerType,
+        [](const jsoncons::json &in_json) -> std::unique_ptr<Layer> {
+            return makeLayer(in_json);
+        });
+}
+
+//! \copydoc Layer::checkCollisions
+VectorCollisionLayer::CollisionType_t
     VectorCollisionLayer::checkCollisions(const GameObject &in_object) const
 {
-    return {};
+    std::pmr::vector<std::pair<CollisionType, Vector>> buffer;
+    this->checkCollisions(in_object, buffer);
+    return CollisionType_t{buffer.begin(), buffer.end()};
 }
 
-bool VectorCollisionLayer::resolveCollisions(const GameObject &in_object) const
+//! \copydoc Layer::checkCollisions(const GameObject&, CollisionBuffer_t&)
+void VectorCollisionLayer::checkCollisions(
+    const GameObject &in_object, CollisionBuffer_t &out_collisions) const
 {
+    out_collisions.clear();
+
+    this->contacts(in_object.boundingPolygon(), in_object.getYAxisOrientation(),
+                   [&](const SegmentCollision &in_collision) {
+                       out_collisions.emplace_back(
+                           in_collision.collisionType,
+                           Vector{in_collision.representativePoint.x,
+                                  in_collision.representativePoint.y});
+                   });
+}
+
+//! Pushes an object out of the geometry.
+/**
+ The object is told about each collision first.  Each attempt then moves it
+ out of the deepest segment it didn't handle, along that segment's normal,
+ so it slides along slopes rather than being pushed straight back.
+ \param in_object
+   The object.
+ \return
+   true if the object no longer overlaps the geometry.
+*/
+bool VectorCollisionLayer::resolveCollisions(GameObject &in_object) const
+{
+    const int maxAttempts = 8;
+    const YAxisOrientation orientation = in_object.getYAxisOrientation();
+
+    for (int attempt = 0; attempt < maxAttempts; attempt++) {
+        bool collided = false;
+        std::optional<SegmentCollision> deepest;
+
+        this->contacts(
+            in_object.boundingPolygon(), orientation,
+            [&](const SegmentCollision &in_collision) {
+                collided = true;
+                const Vector location{in_collision.representativePoint.x,
+                                      in_collision.representativePoint.y};
+                if (in_object.handleCollision(in_collision.collisionType,
+                                              COLLISION_WALL, nullptr,
+                                              location)) {
+                    return;
+                }
+
+                if (!deepest ||
+                    in_collision.penetration > deepest->penetration) {
+                    deepest = in_collision;
+                }
+            });
+
+        if (!collided || !deepest) {
+            // nothing hit or the object handled all of the collisions itself
+            return true;
+        }
+
+        const double distance = deepest->penetration + kResolveSlop;
+        Vector position = in_object.getPosition();
+        position.setX(position.getX() -
+                      deepest->collisionNormal.getX() * distance);
+        position.setY(position.getY() -
+                      deepest->collisionNormal.getY() * distance);
+        in_object.setPosition(position);
+    }
+
+    BOOST_LOG_SEV(CapEngine::log, boost::log::trivial::error)
+        << "max attempts reached attempting to resolve vector collision";
     return false;
 }
 
+//! Finds the segments a box overlaps.
+/**
+ \param in_box
+   The box in world coordinates.
+ \param in_orientation
+   The y axis orientation of the box.
+ \param in_func
+   Called with the normal, penetration depth and location of each overlap,
+   in world coordinates.
+*/
+void VectorCollisionLayer::contacts(
+    const Rectangle &in_box, YAxisOrientation in_orientation,
+    FunctionRef<void(const SegmentCollision &)> in_func) const
+{
+    const Rectangle box = this->toLocal(in_box, in_orientation);
+
+    m_bvh.query(box, [&](const Segment &in_segment) {
+        auto collision = detectBoxSegmentCollision(box, in_segment);
+        if (collision) {
+            this->toWorld(collision->representativePoint,
+                          collision->collisionNormal,
+                          collision->collisionType, in_orientation);
+            in_func(*collision);
+        }
+    });
+}
+
+//! \copydoc Layer::castBox
+std::optional<SweptBoxCollision>
+    VectorCollisionLayer::castBox(const Rectangle &in_box,
+                                  const Vector &in_displacement,
+                                  YAxisOrientation in_orientation) const
+{
+    const Rectangle box = this->toLocal(in_box, in_orientation);
+    const Vector displacement{in_displacement.getX(),
+                              this->flips(in_orientation)
+                                  ? -in_displacement.getY()
+                                  : in_displacement.getY()};
+    const Rectangle end{box.x + displacement.getX(),
+                        box.y + displacement.getY(), box.width, box.height};
+
+    std::optional<SweptBoxCollision> closest;
+    m_bvh.query(join(box, end), [&](const Segment &in_segment) {
+        const auto collision =
+            detectSweptBoxSegmentCollision(box, displacement, 1000.0, in_segment);
+        if (collision &&
+            (!closest || collision->timeOfImpact < closest->timeOfImpact)) {
+            closest = collision;
+        }
+    });
+
+    if (closest) {
+        BoxCollision &collision = closest->collision;
+        this->toWorld(collision.representativePoint, collision.collisionNormal,
+                      collision.collisionType, in_orientation);
+    }
+
+    return closest;
+}
+
+//! \copydoc Layer::overlaps
+bool VectorCollisionLayer::overlaps(const Rectangle &in_box,
+                                    YAxisOrientation in_orientation) const
+{
+    const Rectangle box = this->toLocal(in_box, in_orientation);
+
+    bool found = false;
+    m_bvh.query(box, [&](const Segment &in_segment) {
+        found = found || detectBoxSegmentCollision(box, in_segment).has_value();
+    });
+    return found;
+}
+
+//! Checks if y is flipped between world and layer coordinates.
+bool VectorCollisionLayer::flips(YAxisOrientation in_orientation) const
+{
+    return m_tiledHeight && in_orientation == YAxisOrientation::BottomZero;
+}
+
+//! Converts a box in world coordinates to layer coordinates.
+Rectangle VectorCollisionLayer::toLocal(const Rectangle &in_box,
+                                        YAxisOrientation in_orientation) const
+{
+    Rectangle box{in_box.x - m_position.getX(), in_box.y - m_position.getY(),
+                  in_box.width, in_box.height};
+
+    if (this->flips(in_orientation)) {
+        box.y = *m_tiledHeight - (box.y + box.height);
+    }
+
+    return box;
+}
+
+//! Converts a collision in layer coordinates to world coordinates.
+/**
+ \param io_point
+   Where the collision is.
+ \param io_normal
+   The normal.
+ \param io_side
+   The side of the box that was hit.
+ \param in_orientation
+   The y axis orientation of the box.
+*/
+void VectorCollisionLayer::toWorld(Point &io_point, Vector &io_normal,
+                                   CollisionType &io_side,
+                                   YAxisOrientation in_orientation) const
+{
+    if (this->flips(in_orientation)) {
+        io_point.y = *m_tiledHeight - io_point.y;
+        io_normal.setY(-io_normal.getY());
+        if (io_side == COLLISION_TOP) {
+            io_side = COLLISION_BOTTOM;
+        }
+        else if (io_side == COLLISION_BOTTOM) {
+            io_side = COLLISION_TOP;
+        }
+    }
+
+    io_point.x += m_position.getX();
+    io_point.y += m_position.getY();
+}
+
 } // namespace CapEngine
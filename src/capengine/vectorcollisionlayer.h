@@ -1,40 +1,86 @@
 #ifndef CAPENGINE_VECTORCOLLISIONLAYER_H
 #define CAPENGINE_VECTORCOLLISIONLAYER_H
 
+#include "functionref.h"
 #include "layer.h"
 #include "layerfactory.h"
+#include "scene2dschema.h"
+#include "segmentbvh.h"
 
-#include "jsoncons/json.hpp"
+#include <jsoncons/json.hpp>
+#include <memory>
+#include <optional>
+#include <vector>
 
 namespace CapEngine
 {
 
 //! Layer that implements collisions using vector data
+/**
+   The geometry is a set of line segments from polygons and polylines, held
+   in a SegmentBvh so an object only tests the segments near it.  Geometry
+   from json is in world coordinates relative to the position.  Geometry
+   from a Tiled map has y down from the top of the map and is flipped for
+   objects with YAxisOrientation::BottomZero, the same as TileCollisionLayer.
+*/
 class VectorCollisionLayer final : public Layer
 {
   public:
-    VectorCollisionLayer(const jsoncons::json &in_json);
-    ~VectorCollisionLayer() override;
+    VectorCollisionLayer(std::vector<Segment> in_segments, Vector in_position,
+                         std::optional<double> in_tiledHeight = std::nullopt);
+    ~VectorCollisionLayer() override = default;
 
+    static std::unique_ptr<VectorCollisionLayer>
+        makeLayer(const jsoncons::json &in_json);
     static void registerConstructor(LayerFactory &in_factory);
 
     const std::string type() const override;
-    void update(double in_ms) override {}
-    void render(const Camera2d &in_camera, uint32_t in_windowId) override{};
+    void update(double /*in_ms*/) override {}
+    void render(const Camera2d & /*in_camera*/,
+                uint32_t /*in_windowId*/) override
+    {
+    }
     bool canCollide() const override;
     CollisionType_t checkCollisions(const GameObject &in_object) const override;
-    bool resolveCollisions(const GameObject &in_object) const override;
+    void checkCollisions(const GameObject &in_object,
+                         CollisionBuffer_t &out_collisions) const override;
+    bool resolveCollisions(GameObject &in_object) const override;
+    std::optional<SweptBoxCollision>
+        castBox(const Rectangle &in_box, const Vector &in_displacement,
+                YAxisOrientation in_orientation) const override;
+    bool overlaps(const Rectangle &in_box,
+                  YAxisOrientation in_orientation) const override;
+
+    void contacts(const Rectangle &in_box, YAxisOrientation in_orientation,
+                  FunctionRef<void(const SegmentCollision &)> in_func) const;
+
+    [[nodiscard]] const SegmentBvh &bvh() const;
+
+  private:
+    Rectangle toLocal(const Rectangle &in_box,
+                      YAxisOrientation in_orientation) const;
+    void toWorld(Point &io_point, Vector &io_normal, CollisionType &io_side,
+                 YAxisOrientation in_orientation) const;
+    [[nodiscard]] bool flips(YAxisOrientation in_orientation) const;
+
+    SegmentBvh m_bvh;  //!< The segments in layer coordinates.
+    Vector m_position; //!< Where the geometry is in the world.
+    //! The height of the Tiled map the geometry came from, if it did.
+    std::optional<double> m_tiledHeight;
 };
 
-//! \override Layer::type()
+//! \copydoc Layer::type
 inline const std::string VectorCollisionLayer::type() const
 {
-    return Schema::Scene2d::kBitmapCollisionLayer;
+    return Schema::Scene2d::kVectorCollisionLayerType;
 }
 
 //! \copydoc Layer::canCollide
 inline bool VectorCollisionLayer::canCollide() const { return true; }
 
+//! Gets the segments.
+inline const SegmentBvh &VectorCollisionLayer::bvh() const { return m_bvh; }
+
 } // namespace CapEngine
 
 #endif /* CAPENGINE_VECTORCOLLISIONLAYER_H */
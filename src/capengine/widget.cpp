@@ -2,7 +2,13 @@
 
 #include "CapEngineException.h"
 #include "VideoManager.h"
+#include "defer.h"
 #include "locator.h"
+#include "logging.h"
+
+#include <algorithm>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/log/trivial.hpp>
 
 namespace CapEngine
 {
@@ -29,5 +35,218 @@ Widget::Widget(Widget *pParent) : m_pParent(pParent)
   }
 }
 
+//! Marks the widget as changed so its window renders it again.
+/**
+ Widgets call this when anything that affects how they look changes, e.g.
+ their text, size, hover or focus state.  It is passed up to the parents, so
+ the window holding the widget redraws its cache.  Layouts call it when they
+ move their children, so children don't need to for position changes.
+*/
+void Widget::invalidate()
+{
+  m_dirty = true;
+  if (m_pParent != nullptr) {
+    m_pParent->invalidate();
+  }
+}
+
+//! Checks if the widget and everything under it can be cached.
+/**
+ \return
+   \li true if every widget in the subtree is retained; false otherwise.
+*/
+bool Widget::isSubtreeRetained()
+{
+  if (!this->isRetained()) {
+    return false;
+  }
+
+  for (auto &&pChild : this->getChildren()) {
+    if (pChild != nullptr && !pChild->isSubtreeRetained()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//! Marks the widget and everything under it as rendered.
+void Widget::markClean()
+{
+  m_dirty = false;
+  for (auto &&pChild : this->getChildren()) {
+    if (pChild != nullptr) {
+      pChild->markClean();
+    }
+  }
+}
+
+//! Marks the widget as needing its children measured and arranged again.
+/**
+ Layouts call this when their size or their children change.  The layout
+ itself happens in updateLayout().
+*/
+void Widget::invalidateMeasure()
+{
+  m_measureDirty = true;
+  this->invalidateArrange();
+}
+
+//! Marks the widget as needing its children arranged again.
+/**
+ Layouts call this when only their position changed, so children keep their
+ measured rects and are just moved.
+*/
+void Widget::invalidateArrange()
+{
+  m_arrangeDirty = true;
+
+  // ancestors already flagged have flagged theirs too.
+  for (Widget *pAncestor = m_pParent;
+       pAncestor != nullptr && !pAncestor->m_descendantLayoutDirty;
+       pAncestor = pAncestor->m_pParent) {
+    pAncestor->m_descendantLayoutDirty = true;
+  }
+
+  this->invalidate();
+}
+
+//! Lays out the parts of the subtree that were invalidated.
+/**
+ Clean subtrees are skipped, so a change deep in the tree only measures and
+ arranges the widgets it affected.  Does nothing while a LayoutBatch is open
+ on the widget or one of its ancestors.
+*/
+void Widget::updateLayout()
+{
+  if (this->isLayoutBatched()) {
+    return;
+  }
+
+  bool arranged = m_arrangeDirty;
+  if (m_measureDirty) {
+    this->measure();
+    m_measureDirty = false;
+  }
+
+  if (m_arrangeDirty) {
+    this->arrange();
+    m_arrangeDirty = false;
+  }
+
+  // arranging may have moved every child, otherwise only flagged paths need
+  // visiting.
+  if (arranged || m_descendantLayoutDirty) {
+    m_descendantLayoutDirty = false;
+    for (auto &&pChild : this->getChildren()) {
+      if (pChild != nullptr) {
+        pChild->updateLayout();
+      }
+    }
+  }
+}
+
+//! Checks if a LayoutBatch is open on the widget or one of its ancestors.
+/**
+ \return
+   \li true if layout is deferred; false otherwise.
+*/
+bool Widget::isLayoutBatched() const
+{
+  for (const Widget *pWidget = this; pWidget != nullptr;
+       pWidget = pWidget->m_pParent) {
+    if (pWidget->m_layoutBatches > 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//! Opens a batch.
+/**
+ \param widget
+   \li The widget about to be changed.
+*/
+LayoutBatch::LayoutBatch(Widget &widget) : m_widget(widget)
+{
+  m_widget.m_layoutBatches++;
+}
+
+//! Closes the batch, laying the widget out if it was the outermost one.
+LayoutBatch::~LayoutBatch()
+{
+  m_widget.m_layoutBatches--;
+
+  try {
+    m_widget.updateLayout();
+  } catch (...) {
+    // the widget stays dirty and is laid out again when next rendered.
+    BOOST_LOG_SEV(CapEngine::log, boost::log::trivial::error)
+        << "Error laying out widgets: "
+        << boost::current_exception_diagnostic_information();
+  }
+}
+
+//! Renders the widget, from its cache if its window caches it.
+/**
+ Layouts render their children with this so that retained children of a
+ layout that isn't retained are drawn from their own cache.  A cached widget
+ is only rendered into its cache after it has been invalidated or resized.
+*/
+void Widget::renderCached()
+{
+  if (m_pRenderCache == nullptr) {
+    this->render();
+    return;
+  }
+
+  assert(Locator::videoManager != nullptr);
+
+  this->fitRenderCache();
+
+  // the cache only covers the widget's rect, so it is drawn into with its
+  // origin at the widget's position since widgets draw in window coordinates
+  const SDL_Rect rect = this->getPosition();
+  if (m_dirty) {
+    Locator::videoManager->setRenderTarget(m_windowId, m_pRenderCache.get(),
+                                           rect.x, rect.y);
+    Defer resetTarget([this]() {
+      Locator::videoManager->setRenderTarget(m_windowId, nullptr);
+    });
+
+    Locator::videoManager->clearRenderTarget(m_windowId);
+    this->render();
+    this->markClean();
+  }
+
+  const auto [width, height] =
+      Locator::videoManager->getTextureDims(m_pRenderCache.get());
+  Rect dstRect{rect.x, rect.y, width, height};
+  Locator::videoManager->drawTexture(m_windowId, dstRect,
+                                     m_pRenderCache.get(), nullptr, false);
+}
+
+//! Sizes the widget's cache to its rect.
+/**
+ A new cache is empty, so the widget is marked dirty to render into it.  An
+ empty widget still gets a one pixel cache, since a texture can't be empty.
+*/
+void Widget::fitRenderCache()
+{
+  assert(Locator::videoManager != nullptr);
+
+  const SDL_Rect rect = this->getPosition();
+  const int width = std::max(rect.w, 1);
+  const int height = std::max(rect.h, 1);
+  if (m_pRenderCache == nullptr ||
+      Locator::videoManager->getTextureDims(m_pRenderCache.get()) !=
+          std::make_pair(width, height)) {
+    m_pRenderCache =
+        Locator::videoManager->createRenderTargetPtr(m_windowId, width, height);
+    m_dirty = true;
+  }
+}
+
 } // namespace UI
 } // namespace CapEngine
@@ -37,6 +37,21 @@ public:
   {
   }
 
+  // retained rendering
+  virtual void invalidate();
+  virtual bool isRetained() const { return true; }
+  bool isSubtreeRetained();
+  bool isDirty() const { return m_dirty; }
+  void markClean();
+  void renderCached();
+  Texture *getRenderCache() const { return m_pRenderCache.get(); }
+
+  // layout
+  void invalidateMeasure();
+  void invalidateArrange();
+  void updateLayout();
+  bool isLayoutDirty() const { return m_measureDirty || m_arrangeDirty; }
+
   virtual void handleMouseMotionEvent(SDL_MouseMotionEvent /*event*/) {}
   virtual void handleMouseButtonEvent(SDL_MouseButtonEvent /*event*/) {}
   virtual void handleMouseWheelEvent(SDL_MouseWheelEvent /*event*/) {}
@@ -45,8 +60,49 @@ public:
   virtual void handleTextInputEvent(SDL_TextInputEvent /*event*/) {}
 
 protected:
+  virtual void measure() {}
+  virtual void arrange() {}
+
   Uint32 m_windowId = VideoManager::kInvalidWindowId; //<! The owning window id
   Widget *m_pParent = nullptr;                        //<! The parent widget
+  bool m_dirty = true; //<! flag indicating the widget changed since it was
+                       //<! last rendered into its window's cache
+
+private:
+  friend class LayoutBatch;
+  friend class WindowWidget;
+
+  bool isLayoutBatched() const;
+  void fitRenderCache();
+
+  bool m_measureDirty = true; //<! flag indicating measure() needs to run
+  bool m_arrangeDirty = true; //<! flag indicating arrange() needs to run
+  bool m_descendantLayoutDirty = false; //<! flag indicating a descendant
+                                        //<! needs laying out
+  int m_layoutBatches = 0; //<! The number of open LayoutBatches on the widget
+  TexturePtr m_pRenderCache =
+      getNullTexturePtr(); //<! The widget's rect as last rendered, if its
+                           //<! window caches it
+};
+
+//! Defers laying out a widget until the end of a bulk change.
+/**
+ While a batch is open the widget and everything under it only record what
+ needs laying out again.  The outermost batch lays the widget out when it
+ closes, so adding many children or changing several properties measures and
+ arranges each affected widget once.
+*/
+class LayoutBatch final
+{
+public:
+  explicit LayoutBatch(Widget &widget);
+  ~LayoutBatch();
+
+  LayoutBatch(const LayoutBatch &) = delete;
+  LayoutBatch &operator=(const LayoutBatch &) = delete;
+
+private:
+  Widget &m_widget; //<! The widget being changed
 };
 
 } // namespace UI
@@ -91,6 +147,43 @@ protected:
    \li true if focus was received, false otherwise.
 */
 
+/**
+ \fn Widget::isRetained
+ \brief Checks if the widget only changes when it calls invalidate().
+ Widgets that draw something different every frame, or depend on state they
+ aren't told about, return false so their window doesn't cache them.
+ \return
+   \li true if the widget can be cached; false otherwise.
+*/
+
+/**
+ \fn Widget::isDirty
+ \brief Checks if the widget was invalidated since it was last rendered.
+ \return
+   \li true if dirty; false otherwise.
+*/
+
+/**
+ \fn Widget::isLayoutDirty
+ \brief Checks if the widget needs laying out again.
+ \return
+   \li true if measure() or arrange() needs to run; false otherwise.
+*/
+
+/**
+ \fn Widget::measure
+ \brief Computes the size dependent part of the widget's layout.
+ Layouts compute their children's rects relative to themselves here.  Only
+ called after invalidateMeasure(), i.e. when the widget's size or the set of
+ children changed.
+*/
+
+/**
+ \fn Widget::arrange
+ \brief Positions the widget's children using what measure() computed.
+ Only called after invalidateArrange() or invalidateMeasure().
+*/
+
 /**
  \fn Widget::getWindowId
  \brief Gets the window id of the widget.
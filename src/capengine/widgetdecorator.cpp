@@ -27,7 +27,7 @@ void WidgetDecorator::setPosition(int x, int y)
 void WidgetDecorator::setSize(int width, int height)
 {
   assert(m_pWidget != nullptr);
-  m_pWidget->setPosition(width, height);
+  m_pWidget->setSize(width, height);
 }
 
 //! \copydoc Widget::render
@@ -93,6 +93,13 @@ void WidgetDecorator::handleWindowEvent(SDL_WindowEvent event)
   m_pWidget->handleWindowEvent(event);
 }
 
+//! \copydoc Widget::isRetained
+bool WidgetDecorator::isRetained() const
+{
+  assert(m_pWidget != nullptr);
+  return m_pWidget->isRetained();
+}
+
 //! \copydoc Widget::getChildren
 std::vector<std::shared_ptr<Widget>> WidgetDecorator::getChildren()
 {
@@ -24,6 +24,7 @@ public:
   virtual void setWindowId(Uint32 windowId) override;
   virtual std::vector<std::shared_ptr<Widget>> getChildren() override;
   virtual bool canFocus() const override;
+  virtual bool isRetained() const override;
 
   virtual void handleMouseMotionEvent(SDL_MouseMotionEvent event) override;
   virtual void handleMouseButtonEvent(SDL_MouseButtonEvent event) override;
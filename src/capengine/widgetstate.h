@@ -94,17 +94,17 @@ class WidgetState : public GameState
 
     // signal connections
     //! connection for keyboard events
-    boost::signals2::scoped_connection m_keyboardEventConnection;
+    ScopedConnection m_keyboardEventConnection;
     //! connection for mouse button events
-    boost::signals2::scoped_connection m_mouseButtonEventConnection;
+    ScopedConnection m_mouseButtonEventConnection;
     //! connection for mouse motion events
-    boost::signals2::scoped_connection m_mouseMotionEventConnection;
+    ScopedConnection m_mouseMotionEventConnection;
     //! connection for mouse wheel events
-    boost::signals2::scoped_connection m_mouseWheelEventConnection;
+    ScopedConnection m_mouseWheelEventConnection;
     //! connection for window events
-    boost::signals2::scoped_connection m_windowEventConnection;
+    ScopedConnection m_windowEventConnection;
     //! connection for text input events
-    boost::signals2::scoped_connection m_textInputEventConnection;
+    ScopedConnection m_textInputEventConnection;
 };
 
 } // namespace UI
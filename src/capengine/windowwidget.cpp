@@ -136,6 +136,23 @@ void WindowWidget::setLayout(std::shared_ptr<Widget> pLayout)
   m_pLayout->setWindowId(m_windowId);
   m_pLayout->setPosition(0, 0);
   m_pLayout->setSize(m_width, m_height);
+  this->invalidate();
+}
+
+//! Sets whether the layout is cached between frames.
+/**
+ When enabled the layout is rendered into a texture only after a widget in it
+ has been invalidated, and the texture is drawn every other frame.  If the
+ layout contains widgets that aren't retained, each retained subtree under it
+ gets its own texture and only the rest is rendered directly.
+
+ \param enabled
+   \li flag indicating if the layout should be cached.
+*/
+void WindowWidget::setRetainedRendering(bool enabled)
+{
+  m_retainedRendering = enabled;
+  this->invalidate();
 }
 
 //! @copydoc Widget::setPosition()
@@ -179,6 +196,56 @@ void WindowWidget::updateSize(int width, int height)
 
   if (m_pLayout)
     m_pLayout->setSize(width, height);
+
+  this->invalidate();
+}
+
+//! Gives each largest retained subtree under a widget its own cache.
+/**
+ Widgets that aren't retained, and the layouts holding them, are rendered
+ directly every frame while the retained subtrees under them are drawn from
+ their caches.  Each cache is the size of the root of its subtree.
+
+ \param widget
+   \li The root of the subtree.
+*/
+void WindowWidget::updateCaches(Widget &widget)
+{
+  assert(Locator::videoManager != nullptr);
+
+  if (m_retainedRendering && widget.isSubtreeRetained()) {
+    widget.fitRenderCache();
+
+    // render targets can't nest, so only the root of the subtree is cached
+    for (auto &&pChild : widget.getChildren()) {
+      if (pChild != nullptr)
+        releaseCaches(*pChild);
+    }
+    return;
+  }
+
+  // rendered every frame, so there is nothing to keep clean
+  widget.m_pRenderCache.reset();
+  widget.m_dirty = false;
+
+  for (auto &&pChild : widget.getChildren()) {
+    if (pChild != nullptr)
+      this->updateCaches(*pChild);
+  }
+}
+
+//! Removes the caches from a widget and everything under it.
+/**
+ \param widget
+   \li The root of the subtree.
+*/
+void WindowWidget::releaseCaches(Widget &widget)
+{
+  widget.m_pRenderCache.reset();
+  for (auto &&pChild : widget.getChildren()) {
+    if (pChild != nullptr)
+      releaseCaches(*pChild);
+  }
 }
 
 //! \copydoc WindowWidget::update
@@ -196,8 +263,19 @@ void WindowWidget::render()
     CAP_THROW_ASSERT(m_windowId != VideoManager::kInvalidWindowId,
                      "WindowId is invalid");
 
-    if (m_pLayout)
-      m_pLayout->render();
+    if (!m_pLayout)
+      return;
+
+    m_pLayout->updateLayout();
+
+    // a change can add or remove widgets that aren't retained, so work out
+    // which subtrees are cached again
+    if (m_dirty) {
+      this->updateCaches(*m_pLayout);
+      m_dirty = false;
+    }
+
+    m_pLayout->renderCached();
   }
 }
 
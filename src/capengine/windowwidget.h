@@ -1,7 +1,9 @@
 #ifndef WINDOWWIDGET_H
 #define WINDOWWIDGET_H
 
+#include "captypes.h"
 #include "colour.h"
+#include "delegatesignal.h"
 #include "widget.h"
 
 #include <boost/signals2.hpp>
@@ -49,6 +51,7 @@ public:
   void setLayout(std::shared_ptr<Widget> pLayout);
   void setMaximized(bool maximized = true);
   void setFullScreen(bool fullScreen = true);
+  void setRetainedRendering(bool enabled);
 
   boost::signals2::scoped_connection
       registerWindowClosedSignal(std::function<void(WindowWidget *)> slot);
@@ -58,6 +61,8 @@ private:
                bool resizable = true);
 
   void updateSize(int width, int height);
+  void updateCaches(Widget &widget);
+  static void releaseCaches(Widget &widget);
 
   std::string m_windowName;  //<! The name of the window
   int m_x = 0;               //<! The x position of the window
@@ -70,15 +75,16 @@ private:
   bool m_shown = false;      //<! flag indicacting if window has been shown yet
   std::shared_ptr<Widget> m_pLayout; //<! The layout of the window
   Colour m_backgroundColour = {150, 150, 150, 255};
+  bool m_retainedRendering = true; //<! flag indicating if the layout may be cached
 
   // connections
   //! connection for mouse motion event signals
-  boost::signals2::scoped_connection m_handleMouseMotionConnection;
-  boost::signals2::scoped_connection m_handleMouseButtonConnection;
-  boost::signals2::scoped_connection m_handleMouseWheelConnection;
-  boost::signals2::scoped_connection m_handleKeyboardConnection;
-  boost::signals2::scoped_connection m_handleWindowConnection;
-  boost::signals2::scoped_connection m_handleTextInputConnection;
+  ScopedConnection m_handleMouseMotionConnection;
+  ScopedConnection m_handleMouseButtonConnection;
+  ScopedConnection m_handleMouseWheelConnection;
+  ScopedConnection m_handleKeyboardConnection;
+  ScopedConnection m_handleWindowConnection;
+  ScopedConnection m_handleTextInputConnection;
 
   // signals
   boost::signals2::signal<void(WindowWidget *)> m_windowClosedSignal;